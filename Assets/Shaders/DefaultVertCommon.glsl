@@ -14,6 +14,12 @@ layout(location = 3) in vec3 B_VIn_Tangent;
 layout(location = 4) in vec4 B_VIn_VertexBonesIds; // Max 4 bones per vertex
 layout(location = 5) in vec4 B_VIn_VertexBonesWeights;
 
+// Per-instance model and normal matrices, only used when drawing instanced
+// batches. The normal matrices are computed on the CPU.
+uniform bool B_UseInstancing;
+layout(location = 6) in mat4 B_VIn_InstanceModel; // Locations 6 to 9
+layout(location = 10) in mat4 B_VIn_InstanceNormal; // Locations 10 to 13
+
 #ifndef ONLY_OUT_MODEL_POS_VEC4
     out vec3 B_FIn_Position;
     out vec3 B_FIn_Normal;
@@ -24,6 +30,15 @@ layout(location = 5) in vec4 B_VIn_VertexBonesWeights;
     #endif
 #endif
 
+mat4 GetModelMatrix()
+{
+    return B_UseInstancing ? B_VIn_InstanceModel : B_Model;
+}
+mat4 GetNormalMatrix()
+{
+    return B_UseInstancing ? B_VIn_InstanceNormal : B_Normal;
+}
+
 vec4 GetWorldVertexNormal()
 {
     vec4 modelNormal = vec4(B_VIn_Normal, 0);
@@ -39,7 +54,7 @@ vec4 GetWorldVertexNormal()
         bonedNormal += (B_BoneAnimationMatrices[boneIds[3]] * modelNormal) * boneWeights[3];
         modelNormal = vec4(bonedNormal.xyz, 0);
     }
-    return B_Normal * modelNormal;
+    return GetNormalMatrix() * modelNormal;
 }
 
 vec4 GetModelVertexPosition()
@@ -60,10 +75,14 @@ vec4 GetModelVertexPosition()
 }
 vec4 GetWorldVertexPosition(vec4 vertexModelPosition)
 {
-    return B_Model * vertexModelPosition;
+    return GetModelMatrix() * vertexModelPosition;
 }
 vec4 GetProjectedVertexPosition(vec4 vertexModelPosition)
 {
+    if (B_UseInstancing)
+    {
+        return B_ProjectionView * (B_VIn_InstanceModel * vertexModelPosition);
+    }
     return B_PVM * vertexModelPosition;
 }
 
@@ -86,7 +105,7 @@ void main()
         // Calculate TBN for normal mapping
         if (B_HasNormalMapTexture)
         {
-            vec3 tangent = (B_Normal * vec4(B_VIn_Tangent, 0)).xyz;
+            vec3 tangent = (GetNormalMatrix() * vec4(B_VIn_Tangent, 0)).xyz;
             vec3 T = (tangent);
             vec3 N = (B_FIn_Normal);
             vec3 B = cross(N, T);
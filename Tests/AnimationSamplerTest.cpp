@@ -0,0 +1,498 @@
+#include <random>
+
+#include "Bang/Animation.h"
+#include "Bang/AnimationSampler.h"
+#include "Bang/Array.tcc"
+#include "Bang/AssetHandle.h"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/Map.tcc"
+#include "Bang/Set.tcc"
+#include "BangMath/Math.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Transformation.h"
+#include "BangMath/Vector3.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+template <class T>
+using KeyFrames = Array<Animation::KeyFrame<T>>;
+
+// Sorted times, some of them repeated, as the model importers give them
+template <class T>
+void AddRandomTimes(std::mt19937 *rng,
+                    uint numKeyFrames,
+                    float durationInFrames,
+                    KeyFrames<T> *keyFrames)
+{
+    std::uniform_real_distribution<float> timeDist(0.0f, durationInFrames);
+    Array<float> times;
+    for (uint i = 0; i < numKeyFrames; ++i)
+    {
+        times.PushBack((i > 0 && (*rng)() % 8 == 0) ? times.Back()
+                                                    : timeDist(*rng));
+    }
+    times.Sort();
+
+    keyFrames->Resize(numKeyFrames);
+    for (uint i = 0; i < numKeyFrames; ++i)
+    {
+        (*keyFrames)[i].timeInFrames = times[i];
+    }
+}
+
+Vector3 RandomVector3(std::mt19937 *rng)
+{
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    return Vector3(dist(*rng), dist(*rng), dist(*rng));
+}
+
+Quaternion RandomQuaternion(std::mt19937 *rng)
+{
+    std::uniform_real_distribution<float> dist(-3.0f, 3.0f);
+    return Quaternion::AngleAxis(dist(*rng),
+                                 RandomVector3(rng).NormalizedSafe());
+}
+
+void AddRandomBoneTrack(std::mt19937 *rng,
+                        const String &boneName,
+                        uint maxKeyFrames,
+                        Animation *animation)
+{
+    const float duration = animation->GetDurationInFrames();
+    KeyFrames<Vector3> positionKeyFrames, scaleKeyFrames;
+    KeyFrames<Quaternion> rotationKeyFrames;
+    auto NumKeyFrames = [rng, maxKeyFrames]() {
+        return 1 + (*rng)() % maxKeyFrames;
+    };
+    AddRandomTimes(rng, NumKeyFrames(), duration, &positionKeyFrames);
+    AddRandomTimes(rng, NumKeyFrames(), duration, &rotationKeyFrames);
+    AddRandomTimes(rng, NumKeyFrames(), duration, &scaleKeyFrames);
+    for (auto &keyFrame : positionKeyFrames)
+    {
+        keyFrame.value = RandomVector3(rng);
+        animation->AddPositionKeyFrame(boneName, keyFrame);
+    }
+    for (auto &keyFrame : rotationKeyFrames)
+    {
+        keyFrame.value = RandomQuaternion(rng);
+        animation->AddRotationKeyFrame(boneName, keyFrame);
+    }
+    for (auto &keyFrame : scaleKeyFrames)
+    {
+        keyFrame.value = RandomVector3(rng);
+        animation->AddScaleKeyFrame(boneName, keyFrame);
+    }
+}
+
+// The search sampling did before the cursors: the first pair of keyframes
+// around the time, looked for from the beginning
+template <class T>
+bool FindKeyFramesLinearly(const KeyFrames<T> &keyFrames,
+                           float timeInFrames,
+                           uint *prevKeyFrame)
+{
+    for (uint i = 0; i + 1 < keyFrames.Size(); ++i)
+    {
+        if (timeInFrames >= keyFrames[i].timeInFrames &&
+            timeInFrames <= keyFrames[i + 1].timeInFrames)
+        {
+            *prevKeyFrame = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Checks the keyframes that the cursors point to after sampling, which are
+// the ones that were interpolated
+template <class T>
+bool CursorMatchesLinearSearch(const KeyFrames<T> *keyFrames,
+                               double timeInFrames,
+                               uint cursor)
+{
+    uint expectedKeyFrame = 0;
+    if (!keyFrames ||
+        !FindKeyFramesLinearly(*keyFrames, timeInFrames, &expectedKeyFrame))
+    {
+        return true;
+    }
+    return (cursor == expectedKeyFrame);
+}
+
+// How the animator used to put a layer on top of the lower ones, by bone
+// name. No mask means all the bones.
+void CombineByBoneName(const Map<String, Transformation> &layerTransformations,
+                       const Set<String> *layerMask,
+                       Map<String, Transformation> *combinedTransformations)
+{
+    for (const auto &pair : layerTransformations)
+    {
+        const String &boneName = pair.first;
+        const Transformation &layerTransformation = pair.second;
+        if (layerMask && !layerMask->Contains(boneName))
+        {
+            continue;
+        }
+
+        auto it = combinedTransformations->Find(boneName);
+        if (it != combinedTransformations->End())
+        {
+            it->second.Translate(layerTransformation.GetPosition());
+            it->second.Rotate(layerTransformation.GetRotation());
+            it->second.Scale(layerTransformation.GetScale());
+        }
+        else
+        {
+            combinedTransformations->Add(boneName, layerTransformation);
+        }
+    }
+}
+
+void CheckPoseMatchesBoneNames(
+    const AnimationPose &pose,
+    const AnimationSkeleton &skeleton,
+    const Map<String, Transformation> &byBoneName,
+    const String &step)
+{
+    for (uint boneIndex = 0; boneIndex < skeleton.GetNumBones(); ++boneIndex)
+    {
+        const String &boneName = skeleton.GetBoneName(boneIndex);
+        const auto it = byBoneName.Find(boneName);
+        const bool isAnimated = (it != byBoneName.End());
+        BANG_CHECK_MSG(pose.IsBoneAnimated(boneIndex) == isAnimated,
+                       step << ", " << boneName);
+        if (isAnimated && pose.IsBoneAnimated(boneIndex))
+        {
+            const Transformation &transformation =
+                pose.boneTransformations[boneIndex];
+            BANG_CHECK_MSG(
+                transformation.GetPosition() == it->second.GetPosition(),
+                step << ", " << boneName);
+            BANG_CHECK_MSG(
+                transformation.GetRotation() == it->second.GetRotation(),
+                step << ", " << boneName);
+            BANG_CHECK_MSG(transformation.GetScale() == it->second.GetScale(),
+                           step << ", " << boneName);
+        }
+    }
+}
+
+// Times of a character playing the animation forward, with some jumps
+// back and forth, and some frames sampled twice
+Array<Time> CreatePlaybackTimes(std::mt19937 *rng, uint numTimes)
+{
+    std::uniform_real_distribution<double> stepDist(0.0, 0.05);
+    std::uniform_real_distribution<double> jumpDist(-5.0, 5.0);
+    Array<Time> times;
+    double seconds = 0.0;
+    for (uint i = 0; i < numTimes; ++i)
+    {
+        switch ((*rng)() % 16)
+        {
+            case 0: seconds = Math::Max(seconds + jumpDist(*rng), 0.0); break;
+            case 1: break;
+            default: seconds += stepDist(*rng); break;
+        }
+        times.PushBack(Time::Seconds(seconds));
+    }
+    return times;
+}
+}
+
+BANG_TEST(AnimationCursorsMatchLinearSearch)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(97531);
+    for (uint iteration = 0; iteration < 50; ++iteration)
+    {
+        AH<Animation> animationAH = Assets::Create<Animation>();
+        Animation *animation = animationAH.Get();
+        animation->SetDurationInFrames(30.0f + rng() % 60);
+        animation->SetFramesPerSecond(30.0f);
+        animation->SetWrapMode((iteration % 2 == 0)
+                                   ? AnimationWrapMode::REPEAT
+                                   : AnimationWrapMode::PING_PONG);
+        for (uint i = 0; i < 8; ++i)
+        {
+            AddRandomBoneTrack(
+                &rng, "Bone" + String::ToString(i), 12, animation);
+        }
+
+        const Array<Animation::BoneTrack> &boneTracks =
+            animation->GetBoneTracks();
+        Array<Animation::BoneTrackCursor> cursors;
+        cursors.Resize(boneTracks.Size());
+        for (Time time : CreatePlaybackTimes(&rng, 1000))
+        {
+            const double timeInFrames =
+                Animation::GetSampleTimeInFrames(animation, time);
+            for (uint i = 0; i < boneTracks.Size(); ++i)
+            {
+                const Animation::BoneTrack &boneTrack = boneTracks[i];
+                Animation::BoneTrackCursor &cursor = cursors[i];
+
+                // Searching from scratch must give the same as the cursors
+                Animation::BoneTrackCursor newCursor;
+                const Transformation withCursor = Animation::SampleBoneTrack(
+                    boneTrack, timeInFrames, &cursor);
+                const Transformation withNewCursor = Animation::SampleBoneTrack(
+                    boneTrack, timeInFrames, &newCursor);
+                BANG_CHECK(withCursor.GetPosition() ==
+                           withNewCursor.GetPosition());
+                BANG_CHECK(withCursor.GetRotation() ==
+                           withNewCursor.GetRotation());
+                BANG_CHECK(withCursor.GetScale() == withNewCursor.GetScale());
+
+                BANG_CHECK_MSG(
+                    CursorMatchesLinearSearch(boneTrack.positionKeyFrames,
+                                              timeInFrames,
+                                              cursor.positionKeyFrame),
+                    "iteration " << iteration << ", time " << timeInFrames);
+                BANG_CHECK_MSG(
+                    CursorMatchesLinearSearch(boneTrack.rotationKeyFrames,
+                                              timeInFrames,
+                                              cursor.rotationKeyFrame),
+                    "iteration " << iteration << ", time " << timeInFrames);
+                BANG_CHECK_MSG(
+                    CursorMatchesLinearSearch(boneTrack.scaleKeyFrames,
+                                              timeInFrames,
+                                              cursor.scaleKeyFrame),
+                    "iteration " << iteration << ", time " << timeInFrames);
+            }
+        }
+    }
+}
+
+BANG_TEST(AnimationSamplerMatchesBoneNameSampling)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(13579);
+    AH<Animation> animationAH = Assets::Create<Animation>();
+    Animation *animation = animationAH.Get();
+    animation->SetDurationInFrames(60.0f);
+    animation->SetFramesPerSecond(24.0f);
+    for (uint i = 0; i < 20; ++i)
+    {
+        AddRandomBoneTrack(&rng, "Bone" + String::ToString(i), 20, animation);
+    }
+
+    // Some bones of the skeleton are not animated, and some tracks have no
+    // bone in the skeleton
+    AnimationSkeleton skeleton;
+    for (uint i = 5; i < 30; ++i)
+    {
+        skeleton.AddBone("Bone" + String::ToString(i));
+    }
+
+    AnimationSampler sampler;
+    sampler.Bind(animation, &skeleton);
+    BANG_CHECK(sampler.GetNumBoundBoneTracks() == 15);
+
+    AnimationPose pose;
+    for (Time time : CreatePlaybackTimes(&rng, 500))
+    {
+        pose.Reset(skeleton.GetNumBones());
+        sampler.Sample(time, &pose);
+        const Map<String, Transformation> byBoneName =
+            Animation::GetBoneAnimationTransformations(animation, time);
+        for (uint boneIndex = 0; boneIndex < skeleton.GetNumBones();
+             ++boneIndex)
+        {
+            const auto it = byBoneName.Find(skeleton.GetBoneName(boneIndex));
+            const bool isAnimated = (it != byBoneName.End());
+            BANG_CHECK(pose.IsBoneAnimated(boneIndex) == isAnimated);
+            if (isAnimated)
+            {
+                const Transformation &sampled =
+                    pose.boneTransformations[boneIndex];
+                BANG_CHECK(sampled.GetPosition() == it->second.GetPosition());
+                BANG_CHECK(sampled.GetRotation() == it->second.GetRotation());
+                BANG_CHECK(sampled.GetScale() == it->second.GetScale());
+            }
+        }
+    }
+}
+
+BANG_TEST(AnimationPoseBlendsMatchBoneNameBlends)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(86420);
+
+    // Two animations sharing some of their bones, as a walk and a wave
+    AH<Animation> firstAnimationAH = Assets::Create<Animation>();
+    AH<Animation> secondAnimationAH = Assets::Create<Animation>();
+    Animation *firstAnimation = firstAnimationAH.Get();
+    Animation *secondAnimation = secondAnimationAH.Get();
+    firstAnimation->SetDurationInFrames(45.0f);
+    firstAnimation->SetFramesPerSecond(30.0f);
+    secondAnimation->SetDurationInFrames(70.0f);
+    secondAnimation->SetFramesPerSecond(24.0f);
+    secondAnimation->SetWrapMode(AnimationWrapMode::PING_PONG);
+    for (uint i = 0; i < 12; ++i)
+    {
+        AddRandomBoneTrack(
+            &rng, "Bone" + String::ToString(i), 10, firstAnimation);
+        AddRandomBoneTrack(
+            &rng, "Bone" + String::ToString(i + 6), 10, secondAnimation);
+    }
+
+    // Some bones of the skeleton are not animated by any of them
+    AnimationSkeleton skeleton;
+    for (uint i = 0; i < 20; ++i)
+    {
+        skeleton.AddBone("Bone" + String::ToString(i));
+    }
+
+    AnimationSampler firstSampler, secondSampler;
+    firstSampler.Bind(firstAnimation, &skeleton);
+    secondSampler.Bind(secondAnimation, &skeleton);
+
+    AnimationPose firstPose, secondPose, crossFadedPose, blendedPose,
+        combinedPose;
+    std::uniform_real_distribution<float> weightDist(0.0f, 1.0f);
+    const Array<Time> firstTimes = CreatePlaybackTimes(&rng, 300);
+    const Array<Time> secondTimes = CreatePlaybackTimes(&rng, 300);
+    for (uint t = 0; t < firstTimes.Size(); ++t)
+    {
+        firstPose.Reset(skeleton.GetNumBones());
+        secondPose.Reset(skeleton.GetNumBones());
+        firstSampler.Sample(firstTimes[t], &firstPose);
+        secondSampler.Sample(secondTimes[t], &secondPose);
+        const Map<String, Transformation> firstByBoneName =
+            Animation::GetBoneAnimationTransformations(firstAnimation,
+                                                       firstTimes[t]);
+        const Map<String, Transformation> secondByBoneName =
+            Animation::GetBoneAnimationTransformations(secondAnimation,
+                                                       secondTimes[t]);
+
+        // Cross-fade, into another pose and in place (as blend trees do)
+        const float weight = ((t % 10 == 0) ? (t % 20 == 0 ? 0.0f : 1.0f)
+                                            : weightDist(rng));
+        const Map<String, Transformation> crossFadedByBoneName =
+            Animation::GetInterpolatedBoneTransformations(
+                firstByBoneName, secondByBoneName, weight);
+        crossFadedPose.Reset(skeleton.GetNumBones());
+        AnimationPose::Interpolate(
+            firstPose, secondPose, weight, &crossFadedPose);
+        CheckPoseMatchesBoneNames(crossFadedPose,
+                                  skeleton,
+                                  crossFadedByBoneName,
+                                  "cross-fade " + String::ToString(t));
+
+        blendedPose = firstPose;
+        AnimationPose::Interpolate(
+            blendedPose, secondPose, weight, &blendedPose);
+        CheckPoseMatchesBoneNames(blendedPose,
+                                  skeleton,
+                                  crossFadedByBoneName,
+                                  "blend " + String::ToString(t));
+
+        // Layers: a base layer, a masked one on top, and an unmasked one
+        Set<String> layerMask;
+        Array<float> layerMaskWeights;
+        for (uint i = 0; i < skeleton.GetNumBones(); ++i)
+        {
+            const bool isMasked = (rng() % 2 == 0);
+            if (isMasked)
+            {
+                layerMask.Add(skeleton.GetBoneName(i));
+            }
+            layerMaskWeights.PushBack(isMasked ? 1.0f : 0.0f);
+        }
+
+        Map<String, Transformation> combinedByBoneName;
+        CombineByBoneName(firstByBoneName, nullptr, &combinedByBoneName);
+        CombineByBoneName(secondByBoneName, &layerMask, &combinedByBoneName);
+        CombineByBoneName(crossFadedByBoneName, nullptr, &combinedByBoneName);
+        combinedPose.Reset(skeleton.GetNumBones());
+        combinedPose.Combine(firstPose, Array<float>());
+        combinedPose.Combine(secondPose, layerMaskWeights);
+        combinedPose.Combine(crossFadedPose, Array<float>());
+        CheckPoseMatchesBoneNames(combinedPose,
+                                  skeleton,
+                                  combinedByBoneName,
+                                  "layers " + String::ToString(t));
+    }
+}
+
+BANG_BENCHMARK(AnimationSampling500Characters)
+{
+    BangTestApplication::InitIfNeeded();
+
+    // A few animations of a 60 bone skeleton, shared by all the characters
+    const uint numCharacters = 500;
+    const uint numBones = 60;
+    const uint numFrames = 300;
+    std::mt19937 rng(24680);
+    Array<AH<Animation>> animationAHs;
+    for (uint i = 0; i < 4; ++i)
+    {
+        AH<Animation> animationAH = Assets::Create<Animation>();
+        animationAH.Get()->SetDurationInFrames(90.0f);
+        animationAH.Get()->SetFramesPerSecond(30.0f);
+        for (uint j = 0; j < numBones; ++j)
+        {
+            AddRandomBoneTrack(&rng,
+                               "Bone" + String::ToString(j),
+                               60,
+                               animationAH.Get());
+        }
+        animationAHs.PushBack(animationAH);
+    }
+
+    Array<AnimationSkeleton> skeletons;
+    Array<AnimationSampler> samplers;
+    Array<AnimationPose> poses;
+    Array<Time> startTimes;
+    skeletons.Resize(numCharacters);
+    samplers.Resize(numCharacters);
+    poses.Resize(numCharacters);
+    for (uint i = 0; i < numCharacters; ++i)
+    {
+        for (uint j = 0; j < numBones; ++j)
+        {
+            skeletons[i].AddBone("Bone" + String::ToString(j));
+        }
+        samplers[i].Bind(animationAHs[i % animationAHs.Size()].Get(),
+                         &skeletons[i]);
+        startTimes.PushBack(Time::Seconds((rng() % 3000) / 1000.0));
+    }
+
+    const Time frameTime = Time::Seconds(1.0 / 60.0);
+    Time beginTime = BangTest::GetNow();
+    uint numSampledBones = 0;
+    for (uint frame = 0; frame < numFrames; ++frame)
+    {
+        for (uint i = 0; i < numCharacters; ++i)
+        {
+            const Map<String, Transformation> boneTransformations =
+                Animation::GetBoneAnimationTransformations(
+                    animationAHs[i % animationAHs.Size()].Get(),
+                    startTimes[i] + frameTime * frame);
+            numSampledBones += boneTransformations.Size();
+        }
+    }
+    BangTest::Report("By bone name, per character frame",
+                     BangTest::GetNow() - beginTime,
+                     numCharacters * numFrames);
+
+    beginTime = BangTest::GetNow();
+    for (uint frame = 0; frame < numFrames; ++frame)
+    {
+        for (uint i = 0; i < numCharacters; ++i)
+        {
+            samplers[i].Sample(startTimes[i] + frameTime * frame,
+                               &poses[i]);
+        }
+    }
+    BangTest::Report("Sampler with cursors, per character frame",
+                     BangTest::GetNow() - beginTime,
+                     numCharacters * numFrames);
+
+    BANG_CHECK(numSampledBones == numCharacters * numFrames * numBones);
+}
@@ -0,0 +1,217 @@
+#include <string>
+
+#include "Bang/Array.tcc"
+#include "Bang/Asset.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/AsyncAssetHandle.h"
+#include "Bang/File.h"
+#include "Bang/GUID.h"
+#include "Bang/Path.h"
+#include "Bang/Paths.h"
+#include "Bang/String.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// Asset that only keeps the contents of its file, so that it can be loaded
+// without a GL context
+class TestAsset : public Asset
+{
+    ASSET(TestAsset)
+
+public:
+    TestAsset() = default;
+    virtual ~TestAsset() override = default;
+
+    const String &GetContents() const
+    {
+        return m_contents;
+    }
+
+    // Asset
+    virtual std::size_t GetResidentBytes() const override
+    {
+        return Asset::GetResidentBytes() + m_contents.Size();
+    }
+
+protected:
+    // Asset
+    virtual void Import(const Path &assetFilepath) override
+    {
+        m_contents = File::GetContents(assetFilepath);
+    }
+
+    virtual void ImportAsync(const Path &assetFilepath) override
+    {
+        m_contents = File::GetContents(assetFilepath);
+    }
+
+    virtual void ImportAsyncFinish(const Path &assetFilepath) override
+    {
+        BANG_UNUSED(assetFilepath);
+    }
+
+private:
+    String m_contents;
+};
+
+// Same as the one of the meta files manager tests, leaving the project and
+// the unused assets budget as they were when destroyed
+class TempProject
+{
+public:
+    TempProject()
+    {
+        BangTestApplication::InitIfNeeded();
+        m_prevProjectDir = Paths::GetProjectDir();
+        m_prevUnusedAssetsBudget = Assets::GetUnusedAssetsBudget();
+        m_tempDir = BangTest::CreateTempDir();
+        Paths::SetProjectRoot(m_tempDir);
+        m_assetsDir = m_tempDir.Append("Assets");
+        File::CreateDir(m_assetsDir);
+    }
+
+    ~TempProject()
+    {
+        Assets::SetUnusedAssetsBudget(0);
+        Assets::SetUnusedAssetsBudget(m_prevUnusedAssetsBudget);
+        Paths::SetProjectRoot(m_prevProjectDir);
+        File::Remove(m_tempDir);
+    }
+
+    const Path &GetAssetsDir() const
+    {
+        return m_assetsDir;
+    }
+
+private:
+    Path m_prevProjectDir;
+    std::size_t m_prevUnusedAssetsBudget = 0;
+    Path m_tempDir;
+    Path m_assetsDir;
+};
+}
+
+BANG_TEST(AssetsKeepsUnusedAssetsUntilTheBudgetAndCountsThem)
+{
+    TempProject project;
+
+    // Nothing unused left by other tests
+    Assets::SetUnusedAssetsBudget(0);
+    Assets::SetUnusedAssetsBudget(1024u * 1024u);
+    Assets::ResetCacheStats();
+    const Assets::CacheStats prevStats = Assets::GetCacheStats();
+    BANG_CHECK(prevStats.hits == 0 && prevStats.misses == 0);
+    BANG_CHECK(prevStats.numUnusedAssets == 0 && prevStats.unusedBytes == 0);
+
+    const uint numAssets = 4;
+    Array<Path> paths;
+    Array<String> contents;
+    for (uint i = 0; i < numAssets; ++i)
+    {
+        paths.PushBack(project.GetAssetsDir().Append(
+            "Asset" + String::ToString(i) + ".txt"));
+        contents.PushBack(String(std::string(1000, SCAST<char>('a' + i))));
+        File::Write(paths[i], contents[i]);
+    }
+
+    // Read in the workers, and a miss each once finished
+    Array<AsyncAH<TestAsset>> asyncAHs;
+    for (const Path &path : paths)
+    {
+        asyncAHs.PushBack(Assets::LoadAsync<TestAsset>(path));
+        BANG_CHECK(asyncAHs.Back().IsValid());
+    }
+    for (const AsyncAH<TestAsset> &asyncAH : asyncAHs)
+    {
+        asyncAH.Wait();
+        BANG_CHECK(asyncAH.IsDone());
+    }
+    Assets::FinishAsyncLoads();
+
+    Array<GUID> guids;
+    for (uint i = 0; i < numAssets; ++i)
+    {
+        AH<TestAsset> assetAH = asyncAHs[i].Get();
+        BANG_CHECK(assetAH);
+        BANG_CHECK(assetAH.Get()->GetContents() == contents[i]);
+        guids.PushBack(assetAH.Get()->GetGUID());
+    }
+
+    const std::size_t assetBytes =
+        Assets::GetCached<TestAsset>(guids[0])->GetResidentBytes();
+    BANG_CHECK(assetBytes >= 1000);
+
+    Assets::CacheStats stats = Assets::GetCacheStats();
+    BANG_CHECK(stats.hits == 0 && stats.misses == numAssets);
+    BANG_CHECK(stats.numAssets == prevStats.numAssets + numAssets);
+    BANG_CHECK(stats.residentBytes ==
+               prevStats.residentBytes + numAssets * assetBytes);
+    BANG_CHECK(stats.numUnusedAssets == 0);
+
+    // Loading them again, async or not, finds them in the cache
+    for (uint i = 0; i < numAssets; ++i)
+    {
+        AH<TestAsset> assetAH = Assets::Load<TestAsset>(paths[i]);
+        BANG_CHECK(assetAH && assetAH.Get()->GetGUID() == guids[i]);
+
+        AsyncAH<TestAsset> asyncAH = Assets::LoadAsync<TestAsset>(paths[i]);
+        BANG_CHECK(asyncAH.IsDone());
+        BANG_CHECK(asyncAH.Get().Get() == assetAH.Get());
+    }
+    stats = Assets::GetCacheStats();
+    BANG_CHECK(stats.hits == 2 * numAssets && stats.misses == numAssets);
+
+    // Released in order, the first ones are evicted once over the budget
+    Assets::SetUnusedAssetsBudget(assetBytes * 5 / 2);
+    for (uint i = 0; i < numAssets; ++i)
+    {
+        asyncAHs[i] = AsyncAH<TestAsset>();
+    }
+    BANG_CHECK(!Assets::Contains(guids[0]) && !Assets::Contains(guids[1]));
+    BANG_CHECK(Assets::Contains(guids[2]) && Assets::Contains(guids[3]));
+    stats = Assets::GetCacheStats();
+    BANG_CHECK(stats.numAssets == prevStats.numAssets + 2);
+    BANG_CHECK(stats.numUnusedAssets == 2);
+    BANG_CHECK(stats.unusedBytes == 2 * assetBytes);
+    BANG_CHECK(stats.residentBytes ==
+               prevStats.residentBytes + 2 * assetBytes);
+
+    // Using one again makes it the most recently used one
+    {
+        AH<TestAsset> assetAH = Assets::Load<TestAsset>(paths[2]);
+        BANG_CHECK(assetAH && assetAH.Get()->GetGUID() == guids[2]);
+        stats = Assets::GetCacheStats();
+        BANG_CHECK(stats.hits == 2 * numAssets + 1);
+        BANG_CHECK(stats.numUnusedAssets == 1);
+        BANG_CHECK(stats.unusedBytes == assetBytes);
+    }
+    Assets::SetUnusedAssetsBudget(assetBytes * 3 / 2);
+    BANG_CHECK(Assets::Contains(guids[2]) && !Assets::Contains(guids[3]));
+    stats = Assets::GetCacheStats();
+    BANG_CHECK(stats.numUnusedAssets == 1);
+    BANG_CHECK(stats.unusedBytes == assetBytes);
+
+    // Evicted ones are read again from their file
+    {
+        AH<TestAsset> assetAH = Assets::Load<TestAsset>(paths[0]);
+        BANG_CHECK(assetAH && assetAH.Get()->GetContents() == contents[0]);
+        stats = Assets::GetCacheStats();
+        BANG_CHECK(stats.misses == numAssets + 1);
+    }
+
+    // And without budget, nothing is kept once released
+    Assets::SetUnusedAssetsBudget(0);
+    for (const GUID &guid : guids)
+    {
+        BANG_CHECK(!Assets::Contains(guid));
+    }
+    stats = Assets::GetCacheStats();
+    BANG_CHECK(stats.numAssets == prevStats.numAssets);
+    BANG_CHECK(stats.numUnusedAssets == 0 && stats.unusedBytes == 0);
+}
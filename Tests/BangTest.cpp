@@ -0,0 +1,120 @@
+#include "BangTest.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "Bang/Array.tcc"
+#include "Bang/File.h"
+#include "BangMath/Math.h"
+
+using namespace Bang;
+
+bool BangTest::Register(const String &name,
+                        const TestFunction &function,
+                        bool isBenchmark)
+{
+    Entry entry;
+    entry.name = name;
+    entry.function = function;
+    entry.isBenchmark = isBenchmark;
+    BangTest::GetEntries().PushBack(entry);
+    return true;
+}
+
+void BangTest::Fail(const char *file, int line, const String &message)
+{
+    std::cerr << "    " << file << ":" << line << ": " << message << std::endl;
+    BangTest::GetCurrentFailed() = true;
+}
+
+Time BangTest::GetNow()
+{
+    return Time::Nanos(SCAST<uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch() /
+        std::chrono::nanoseconds(1)));
+}
+
+Path BangTest::CreateTempDir()
+{
+#ifdef _WIN32
+    const char *systemTempDir = std::getenv("TEMP");
+#else
+    const char *systemTempDir = std::getenv("TMPDIR");
+#endif
+    const Path tempDir(String(systemTempDir ? systemTempDir : "/tmp"));
+
+    static uint numTempDirs = 0;
+    const Path dir = tempDir.Append(
+        "BangTests_" + String::ToString(BangTest::GetNow().GetNanos()) + "_" +
+        String::ToString(numTempDirs++));
+    File::CreateDir(dir);
+    return dir;
+}
+
+void BangTest::Report(const String &what, Time totalTime, uint numIterations)
+{
+    const double totalMillis = totalTime.GetNanos() / 1e6;
+    const double nanosPerIteration =
+        SCAST<double>(totalTime.GetNanos()) / Math::Max(numIterations, 1u);
+    std::cout << "    " << what << ": " << totalMillis << " ms, "
+              << nanosPerIteration << " ns per iteration (" << numIterations
+              << " iterations)" << std::endl;
+}
+
+int BangTest::Run(int argc, char **argv)
+{
+    const bool runBenchmarks =
+        (argc > 1 && std::strcmp(argv[1], "--benchmarks") == 0);
+    const String onlyName =
+        (argc > 1 && !runBenchmarks) ? String(argv[1]) : String("");
+
+    uint numRun = 0;
+    uint numFailed = 0;
+    for (const Entry &entry : BangTest::GetEntries())
+    {
+        const bool selected = onlyName.IsEmpty()
+                                  ? (entry.isBenchmark == runBenchmarks)
+                                  : (entry.name == onlyName);
+        if (!selected)
+        {
+            continue;
+        }
+
+        std::cout << "[ RUN  ] " << entry.name << std::endl;
+        BangTest::GetCurrentFailed() = false;
+        entry.function();
+        ++numRun;
+        if (BangTest::GetCurrentFailed())
+        {
+            ++numFailed;
+            std::cout << "[ FAIL ] " << entry.name << std::endl;
+        }
+        else
+        {
+            std::cout << "[  OK  ] " << entry.name << std::endl;
+        }
+    }
+
+    std::cout << numRun - numFailed << "/" << numRun << " passed"
+              << std::endl;
+    return (numFailed == 0 && numRun > 0) ? 0 : 1;
+}
+
+Array<BangTest::Entry> &BangTest::GetEntries()
+{
+    static Array<Entry> entries;
+    return entries;
+}
+
+bool &BangTest::GetCurrentFailed()
+{
+    static bool currentFailed = false;
+    return currentFailed;
+}
+
+int main(int argc, char **argv)
+{
+    return BangTest::Run(argc, argv);
+}
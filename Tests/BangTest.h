@@ -0,0 +1,85 @@
+#ifndef BANGTEST_H
+#define BANGTEST_H
+
+#include <functional>
+#include <sstream>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Path.h"
+#include "Bang/String.h"
+#include "Bang/Time.h"
+
+namespace Bang
+{
+// Minimal runner for the engine tests and benchmarks. They register
+// themselves with the macros below from any .cpp of this directory. Tests
+// run under ctest, and benchmarks only when asked with --benchmarks, since
+// they take a while.
+class BangTest
+{
+public:
+    using TestFunction = std::function<void()>;
+
+    static bool Register(const String &name,
+                         const TestFunction &function,
+                         bool isBenchmark);
+
+    // Marks the running test as failed, but lets it go on
+    static void Fail(const char *file, int line, const String &message);
+
+    // Monotonic clock. Time::GetNow needs an Application, and most tests
+    // run without one.
+    static Time GetNow();
+
+    // New empty directory in the system temporary one. Tests remove it with
+    // File::Remove when they are done.
+    static Path CreateTempDir();
+
+    // Prints the total time and the time per iteration of a benchmark
+    static void Report(const String &what, Time totalTime, uint numIterations);
+
+    // No arguments runs all the tests, --benchmarks all the benchmarks, and
+    // anything else the tests or benchmarks with that name
+    static int Run(int argc, char **argv);
+
+    BangTest() = delete;
+
+private:
+    struct Entry
+    {
+        String name;
+        TestFunction function;
+        bool isBenchmark = false;
+    };
+
+    static Array<Entry> &GetEntries();
+    static bool &GetCurrentFailed();
+};
+}
+
+#define BANG_TEST_REGISTER_(NAME, IS_BENCHMARK)                  \
+    static void BangTestFunction_##NAME();                       \
+    static const bool BangTestRegistered_##NAME =                \
+        Bang::BangTest::Register(                                \
+            #NAME, BangTestFunction_##NAME, IS_BENCHMARK);       \
+    static void BangTestFunction_##NAME()
+
+#define BANG_TEST(NAME) BANG_TEST_REGISTER_(NAME, false)
+#define BANG_BENCHMARK(NAME) BANG_TEST_REGISTER_(NAME, true)
+
+#define BANG_CHECK_MSG(CONDITION, MSG)                           \
+    do                                                           \
+    {                                                            \
+        if (!(CONDITION))                                        \
+        {                                                        \
+            std::ostringstream bangTestOss;                      \
+            bangTestOss << #CONDITION << ": " << MSG;            \
+            Bang::BangTest::Fail(                                \
+                __FILE__, __LINE__, String(bangTestOss.str()));  \
+        }                                                        \
+    } while (false)
+
+#define BANG_CHECK(CONDITION) BANG_CHECK_MSG(CONDITION, "")
+
+#endif  // BANGTEST_H
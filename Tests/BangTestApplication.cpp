@@ -0,0 +1,26 @@
+#include "BangTestApplication.h"
+
+#include "Bang/Assets.h"
+#include "Bang/Path.h"
+#include "Bang/Physics.h"
+
+using namespace Bang;
+
+void BangTestApplication::InitIfNeeded()
+{
+    static BangTestApplication application;
+    if (!Application::GetInstance())
+    {
+        application.Init(Path(BANG_TESTS_ENGINE_ROOT));
+    }
+}
+
+void BangTestApplication::InitAfterPathsInit_()
+{
+    // The rest needs a window or a GL context. The assets without their
+    // factories are enough to create and keep assets in memory.
+    m_physics = new Physics();
+    m_physics->Init();
+
+    m_assets = new Assets();
+}
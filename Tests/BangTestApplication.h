@@ -0,0 +1,26 @@
+#ifndef BANGTESTAPPLICATION_H
+#define BANGTESTAPPLICATION_H
+
+#include "Bang/Application.h"
+#include "Bang/BangDefines.h"
+
+namespace Bang
+{
+// Application with only the parts of the engine that work without a window
+// or a GL context (class ids, paths, jobs, GUIDs, physics and assets in
+// memory). Enough to create game objects, components, events, assets and
+// particles in the tests.
+class BangTestApplication : public Application
+{
+public:
+    BangTestApplication() = default;
+
+    // Inits the one shared by all the tests, the first time it is called
+    static void InitIfNeeded();
+
+protected:
+    virtual void InitAfterPathsInit_() override;
+};
+}
+
+#endif  // BANGTESTAPPLICATION_H
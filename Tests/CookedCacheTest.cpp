@@ -0,0 +1,323 @@
+#include <cstring>
+#include <ctime>
+#include <random>
+
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include "Bang/Array.tcc"
+#include "Bang/CookedCache.h"
+#include "Bang/File.h"
+#include "Bang/Image.h"
+#include "Bang/ImageIO.h"
+#include "Bang/MappedFile.h"
+#include "Bang/ModelIO.h"
+#include "Bang/Path.h"
+#include "Bang/Paths.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// Makes the cooked cache live in a temporary project, and leaves everything
+// as it was when destroyed
+class TempCookedCache
+{
+public:
+    TempCookedCache()
+    {
+        BangTestApplication::InitIfNeeded();
+        m_prevProjectDir = Paths::GetProjectDir();
+        m_tempDir = BangTest::CreateTempDir();
+        Paths::SetProjectRoot(m_tempDir);
+    }
+
+    ~TempCookedCache()
+    {
+        Paths::SetProjectRoot(m_prevProjectDir);
+        CookedCache::SetEnabled(true);
+        File::Remove(m_tempDir);
+    }
+
+    const Path &GetDir() const
+    {
+        return m_tempDir;
+    }
+
+private:
+    Path m_prevProjectDir;
+    Path m_tempDir;
+};
+
+void CreateRandomImage(std::mt19937 *rng, int width, int height, Image *img)
+{
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    img->Create(width, height);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            img->SetPixel(
+                x, y, Color(dist(*rng), dist(*rng), dist(*rng), dist(*rng)));
+        }
+    }
+}
+
+void SetModificationTime(const Path &path, std::time_t modificationTime)
+{
+    struct utimbuf times;
+    times.actime = modificationTime;
+    times.modtime = modificationTime;
+    utime(path.GetAbsolute().ToCString(), &times);
+}
+
+bool AreIdentical(const Image &lhs, const Image &rhs)
+{
+    return lhs.GetWidth() == rhs.GetWidth() &&
+           lhs.GetHeight() == rhs.GetHeight() &&
+           std::memcmp(lhs.GetData(),
+                       rhs.GetData(),
+                       lhs.GetWidth() * lhs.GetHeight() * 4) == 0;
+}
+
+// Cube with positions, uvs and normals, and a material
+const char *CubeOBJ =
+    "mtllib Cube.mtl\n"
+    "o Cube\n"
+    "v -1 -1 1\nv 1 -1 1\nv 1 1 1\nv -1 1 1\n"
+    "v -1 -1 -1\nv 1 -1 -1\nv 1 1 -1\nv -1 1 -1\n"
+    "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+    "vn 0 0 1\nvn 0 0 -1\nvn 1 0 0\nvn -1 0 0\nvn 0 1 0\nvn 0 -1 0\n"
+    "usemtl Red\n"
+    "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+    "f 6/1/2 5/2/2 8/3/2 7/4/2\n"
+    "f 2/1/3 6/2/3 7/3/3 3/4/3\n"
+    "f 5/1/4 1/2/4 4/3/4 8/4/4\n"
+    "f 4/1/5 3/2/5 7/3/5 8/4/5\n"
+    "f 5/1/6 6/2/6 2/3/6 1/4/6\n";
+
+const char *CubeMTL =
+    "newmtl Red\n"
+    "Kd 1 0 0\n"
+    "map_Kd Red.png\n";
+}
+
+BANG_TEST(CookedReaderReadsWhatWriterWrote)
+{
+    const Array<float> values = {1.5f, -2.0f, 0.0f, 1e30f};
+    CookedWriter writer;
+    writer.Write(42u);
+    writer.Write(3.25f);
+    writer.Write(String("Cooked"));
+    writer.Write(String(""));
+    writer.WriteArray(values);
+    writer.WriteData(SCAST<uint64_t>(0x0123456789ABCDEFull));
+
+    const Array<Byte> &bytes = writer.GetBytes();
+    CookedReader reader(bytes.Data(), bytes.Size());
+    uint32_t u = 0;
+    float f = 0.0f;
+    String str, emptyStr = "NotEmpty";
+    Array<float> readValues;
+    uint64_t data = 0;
+    reader.Read(&u);
+    reader.Read(&f);
+    reader.Read(&str);
+    reader.Read(&emptyStr);
+    reader.ReadArray(&readValues);
+    reader.ReadData(&data);
+    BANG_CHECK(reader.IsOk() && reader.IsAtEnd());
+    BANG_CHECK(u == 42u && f == 3.25f);
+    BANG_CHECK(str == "Cooked" && emptyStr.IsEmpty());
+    BANG_CHECK(readValues == values);
+    BANG_CHECK(data == 0x0123456789ABCDEFull);
+
+    // Past the end every read fails, and so do the following ones
+    BANG_CHECK(!reader.Read(&u));
+    BANG_CHECK(!reader.IsOk());
+
+    // Truncated anywhere, it never reads past the end
+    for (uint size = 0; size < bytes.Size(); ++size)
+    {
+        CookedReader truncatedReader(bytes.Data(), size);
+        truncatedReader.Read(&u);
+        truncatedReader.Read(&f);
+        truncatedReader.Read(&str);
+        truncatedReader.Read(&emptyStr);
+        truncatedReader.ReadArray(&readValues);
+        truncatedReader.ReadData(&data);
+        BANG_CHECK_MSG(!truncatedReader.IsOk(), "size " << size);
+    }
+}
+
+BANG_TEST(CookedImagesMatchSourceImports)
+{
+    TempCookedCache tempCookedCache;
+    std::mt19937 rng(2468);
+    for (const char *extension : {"png", "tga", "jpg"})
+    {
+        const Path imgPath =
+            tempCookedCache.GetDir().Append("Image." + String(extension));
+        Image sourceImg;
+        CreateRandomImage(&rng, 67, 45, &sourceImg);
+        ImageIO::Export(imgPath, sourceImg);
+
+        // Uncooked, then cooking it, then from the cooked entry
+        Image uncookedImg, cookingImg, cookedImg;
+        bool ok = false;
+        CookedCache::SetEnabled(false);
+        ImageIO::Import(imgPath, &uncookedImg, &ok);
+        BANG_CHECK_MSG(ok, extension);
+        CookedCache::SetEnabled(true);
+
+        const String cookedKey = CookedCache::GetKey(imgPath, "image", 2);
+        BANG_CHECK_MSG(!CookedCache::GetEntryPath(cookedKey).IsFile(),
+                       extension);
+        ImageIO::Import(imgPath, &cookingImg, &ok);
+        BANG_CHECK_MSG(ok, extension);
+        BANG_CHECK_MSG(CookedCache::GetEntryPath(cookedKey).IsFile(),
+                       extension);
+        ImageIO::Import(imgPath, &cookedImg, &ok);
+        BANG_CHECK_MSG(ok, extension);
+
+        BANG_CHECK_MSG(AreIdentical(uncookedImg, cookingImg), extension);
+        BANG_CHECK_MSG(AreIdentical(uncookedImg, cookedImg), extension);
+
+        // A broken entry is ignored, and the source decoded again
+        File::Write(CookedCache::GetEntryPath(cookedKey),
+                    String("Not an image"));
+        Image fromBrokenEntryImg;
+        ImageIO::Import(imgPath, &fromBrokenEntryImg, &ok);
+        BANG_CHECK_MSG(ok, extension);
+        BANG_CHECK_MSG(AreIdentical(uncookedImg, fromBrokenEntryImg),
+                       extension);
+
+        // Editing the source changes the key, so the old entry is not used
+        Image editedSourceImg, editedUncookedImg, editedImg;
+        CreateRandomImage(&rng, 45, 67, &editedSourceImg);
+        ImageIO::Export(imgPath, editedSourceImg);
+        CookedCache::SetEnabled(false);
+        ImageIO::Import(imgPath, &editedUncookedImg, &ok);
+        CookedCache::SetEnabled(true);
+        ImageIO::Import(imgPath, &editedImg, &ok);
+        BANG_CHECK_MSG(ok, extension);
+        BANG_CHECK_MSG(AreIdentical(editedUncookedImg, editedImg), extension);
+        BANG_CHECK_MSG(!AreIdentical(uncookedImg, editedImg), extension);
+    }
+}
+
+BANG_TEST(CookedModelsMatchSourceImports)
+{
+    TempCookedCache tempCookedCache;
+    const Path modelPath = tempCookedCache.GetDir().Append("Cube.obj");
+    File::Write(modelPath, String(CubeOBJ));
+    File::Write(tempCookedCache.GetDir().Append("Cube.mtl"), String(CubeMTL));
+
+    Array<Byte> uncookedBytes, cookingBytes, cookedBytes;
+    CookedCache::SetEnabled(false);
+    BANG_CHECK(ModelIO::ImportModelRaw(modelPath, &uncookedBytes));
+    CookedCache::SetEnabled(true);
+
+    const String cookedKey = CookedCache::GetKey(modelPath, "model", 1);
+    BANG_CHECK(ModelIO::ImportModelRaw(modelPath, &cookingBytes));
+    BANG_CHECK(CookedCache::GetEntryPath(cookedKey).IsFile());
+    BANG_CHECK(ModelIO::ImportModelRaw(modelPath, &cookedBytes));
+
+    BANG_CHECK(!uncookedBytes.IsEmpty());
+    BANG_CHECK(cookingBytes == uncookedBytes);
+    BANG_CHECK(cookedBytes == uncookedBytes);
+
+    // What was cooked is exactly what a cooked import reads
+    MappedFile cookedFile;
+    BANG_CHECK(CookedCache::Read(cookedKey, &cookedFile));
+    BANG_CHECK(cookedFile.GetSize() == uncookedBytes.Size() &&
+               std::memcmp(cookedFile.GetData(),
+                           uncookedBytes.Data(),
+                           uncookedBytes.Size()) == 0);
+}
+
+BANG_TEST(CookedCacheHashesSourcesOnlyWhenTheyChange)
+{
+    TempCookedCache tempCookedCache;
+    const Path sourcePath = tempCookedCache.GetDir().Append("Source.txt");
+    const std::time_t oldTime = std::time(nullptr) - 3600;
+    File::Write(sourcePath, String("First contents"));
+    SetModificationTime(sourcePath, oldTime);
+    const String firstKey = CookedCache::GetKey(sourcePath, "text", 1);
+    BANG_CHECK(!firstKey.IsEmpty());
+    BANG_CHECK(CookedCache::GetEntryPath(
+                   CookedCache::GetSourceStampKey(sourcePath))
+                   .IsFile());
+
+    // Same time and size, so the hash of the stamp is trusted, even if the
+    // contents are not the same
+    File::Write(sourcePath, String("Other contents"));
+    SetModificationTime(sourcePath, oldTime);
+    BANG_CHECK(CookedCache::GetKey(sourcePath, "text", 1) == firstKey);
+
+    // Any other time hashes them again
+    SetModificationTime(sourcePath, oldTime + 1);
+    const String otherKey = CookedCache::GetKey(sourcePath, "text", 1);
+    BANG_CHECK(otherKey != firstKey);
+    BANG_CHECK(otherKey == CookedCache::GetKey(sourcePath, "text", 1));
+    BANG_CHECK(CookedCache::GetKey(sourcePath, "text", 2) != otherKey);
+
+    // Edited again right after being hashed, within the resolution of the
+    // modification times, and with the same size
+    for (uint i = 0; i < 10; ++i)
+    {
+        const String contents = "Edit number " + String::ToString(i);
+        File::Write(sourcePath, contents);
+        const String key = CookedCache::GetKey(sourcePath, "text", 1);
+        const Path otherSourcePath =
+            tempCookedCache.GetDir().Append("Other" + String::ToString(i));
+        File::Write(otherSourcePath, contents);
+        BANG_CHECK_MSG(
+            key == CookedCache::GetKey(otherSourcePath, "text", 1), i);
+    }
+}
+
+BANG_BENCHMARK(CookedCacheGetKey)
+{
+    TempCookedCache tempCookedCache;
+    const uint numSources = 20;
+    const uint sourceSize = 16 * 1024 * 1024;
+    std::mt19937 rng(1357);
+    Array<Path> sourcePaths;
+    for (uint i = 0; i < numSources; ++i)
+    {
+        Array<Byte> contents(sourceSize);
+        for (Byte &byte : contents)
+        {
+            byte = SCAST<Byte>(rng());
+        }
+        const Path sourcePath = tempCookedCache.GetDir().Append(
+            "Source" + String::ToString(i) + ".bin");
+        File::Write(sourcePath, contents.Data(), contents.Size());
+        SetModificationTime(sourcePath, std::time(nullptr) - 3600);
+        sourcePaths.PushBack(sourcePath);
+    }
+
+    Time beginTime = BangTest::GetNow();
+    for (const Path &sourcePath : sourcePaths)
+    {
+        CookedCache::GetKey(sourcePath, "text", 1);
+    }
+    BangTest::Report("GetKey, hashing 16MB sources",
+                     BangTest::GetNow() - beginTime,
+                     numSources);
+
+    beginTime = BangTest::GetNow();
+    for (const Path &sourcePath : sourcePaths)
+    {
+        CookedCache::GetKey(sourcePath, "text", 1);
+    }
+    BangTest::Report("GetKey, from the source stamps",
+                     BangTest::GetNow() - beginTime,
+                     numSources);
+}
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+
+#include "Bang/Array.tcc"
+#include "Bang/EventEmitter.h"
+#include "Bang/EventEmitter.tcc"
+#include "Bang/EventListener.h"
+#include "Bang/EventListener.tcc"
+#include "Bang/IEvents.h"
+#include "BangTest.h"
+
+using namespace Bang;
+
+namespace
+{
+class IEventsCounter
+{
+    IEVENTS(IEventsCounter);
+
+public:
+    virtual void OnCount(int amount) = 0;
+};
+
+class CounterEmitter : public EventEmitter<IEventsCounter>
+{
+public:
+    void Emit(int amount)
+    {
+        PropagateToListeners(&IEventsCounter::OnCount, amount);
+    }
+
+    // Listeners in order, without the empty slots
+    Array<EventListener<IEventsCounter> *> GetLiveListeners() const
+    {
+        Array<EventListener<IEventsCounter> *> liveListeners;
+        for (EventListener<IEventsCounter> *listener : GetListeners())
+        {
+            if (listener)
+            {
+                liveListeners.PushBack(listener);
+            }
+        }
+        return liveListeners;
+    }
+};
+
+class CounterListener : public EventListener<IEventsCounter>
+{
+public:
+    int count = 0;
+
+    // Run when receiving the event, to change the emitter meanwhile
+    std::function<void()> onCount;
+
+    void OnCount(int amount) override
+    {
+        count += amount;
+        if (onCount)
+        {
+            onCount();
+        }
+    }
+};
+}
+
+BANG_TEST(EventEmitterChangesWhilePropagating)
+{
+    CounterEmitter emitter;
+    Array<CounterListener *> listeners;
+    for (uint i = 0; i < 100; ++i)
+    {
+        listeners.PushBack(new CounterListener());
+        emitter.RegisterListener(listeners.Back());
+    }
+
+    // One in the middle unregisters some already called and some not yet
+    // called, deletes one not yet called, and registers a new one
+    CounterListener *newListener = new CounterListener();
+    listeners[50]->onCount = [&]() {
+        for (uint i = 40; i < 60; ++i)
+        {
+            emitter.UnRegisterListener(listeners[i]);
+        }
+        delete listeners[70];
+        listeners[70] = nullptr;
+        emitter.RegisterListener(newListener);
+        emitter.RegisterListener(listeners[10]);
+    };
+    emitter.Emit(1);
+    for (uint i = 0; i < listeners.Size(); ++i)
+    {
+        if (listeners[i])
+        {
+            const int expectedCount = (i <= 50 || i >= 60) ? 1 : 0;
+            BANG_CHECK_MSG(listeners[i]->count == expectedCount,
+                           "listener " << i);
+        }
+    }
+    BANG_CHECK(newListener->count == 0);
+
+    // The new one is called from the next propagation, after the rest
+    listeners[50]->onCount = nullptr;
+    emitter.Emit(1);
+    BANG_CHECK(newListener->count == 1);
+    BANG_CHECK(listeners[10]->count == 2);
+    BANG_CHECK(listeners[45]->count == 1);
+    BANG_CHECK(listeners[99]->count == 2);
+    BANG_CHECK(emitter.GetLiveListeners().Size() == 100 - 20 - 1 + 1);
+    BANG_CHECK(emitter.GetLiveListeners().Back() == newListener);
+
+    // Propagating from inside a propagation reaches everyone again
+    listeners[0]->onCount = [&]() {
+        listeners[0]->onCount = nullptr;
+        emitter.Emit(10);
+    };
+    emitter.Emit(1);
+    BANG_CHECK(listeners[1]->count == 2 + 1 + 10);
+    BANG_CHECK(newListener->count == 1 + 1 + 10);
+
+    delete newListener;
+    for (CounterListener *listener : listeners)
+    {
+        delete listener;
+    }
+    BANG_CHECK(emitter.GetLiveListeners().IsEmpty());
+}
+
+BANG_TEST(EventEmitterKeepsRegistrationOrder)
+{
+    // Random registrations against an array, which is what emitters were
+    std::mt19937 rng(5555);
+    CounterEmitter emitter;
+    Array<CounterListener *> listeners;
+    for (uint i = 0; i < 200; ++i)
+    {
+        listeners.PushBack(new CounterListener());
+    }
+
+    Array<EventListener<IEventsCounter> *> expectedListeners;
+    for (uint step = 0; step < 20000; ++step)
+    {
+        CounterListener *listener = listeners[rng() % listeners.Size()];
+        if (rng() % 2 == 0)
+        {
+            emitter.RegisterListener(listener);
+            if (!expectedListeners.Contains(listener))
+            {
+                expectedListeners.PushBack(listener);
+            }
+        }
+        else
+        {
+            emitter.UnRegisterListener(listener);
+            expectedListeners.Remove(listener);
+        }
+
+        if (step % 10 == 0)
+        {
+            BANG_CHECK_MSG(emitter.GetLiveListeners() == expectedListeners,
+                           "step " << step);
+        }
+    }
+
+    // Deleting the emitter unregisters it from the listeners left
+    CounterEmitter *tempEmitter = new CounterEmitter();
+    tempEmitter->RegisterListener(listeners[0]);
+    tempEmitter->RegisterListener(listeners[1]);
+    delete tempEmitter;
+    emitter.Emit(1);
+    for (CounterListener *listener : listeners)
+    {
+        const bool isRegistered = expectedListeners.Contains(listener);
+        BANG_CHECK(listener->count == (isRegistered ? 1 : 0));
+        delete listener;
+    }
+    BANG_CHECK(emitter.GetLiveListeners().IsEmpty());
+}
+
+BANG_BENCHMARK(EventEmitter10kListeners)
+{
+    const uint numListeners = 10000;
+    const uint numPropagations = 1000;
+    Array<CounterListener *> listeners;
+    for (uint i = 0; i < numListeners; ++i)
+    {
+        listeners.PushBack(new CounterListener());
+    }
+
+    CounterEmitter emitter;
+    Time beginTime = BangTest::GetNow();
+    for (CounterListener *listener : listeners)
+    {
+        emitter.RegisterListener(listener);
+    }
+    BangTest::Report(
+        "Register", BangTest::GetNow() - beginTime, numListeners);
+
+    beginTime = BangTest::GetNow();
+    for (uint i = 0; i < numPropagations; ++i)
+    {
+        emitter.Emit(1);
+    }
+    BangTest::Report("Propagate, per listener call",
+                     BangTest::GetNow() - beginTime,
+                     numListeners * numPropagations);
+
+    // With half of them unregistered in the middle of the propagation
+    listeners[0]->onCount = [&]() {
+        for (uint i = 1; i < numListeners; i += 2)
+        {
+            emitter.UnRegisterListener(listeners[i]);
+        }
+    };
+    emitter.Emit(1);
+    listeners[0]->onCount = nullptr;
+    beginTime = BangTest::GetNow();
+    for (uint i = 0; i < numPropagations; ++i)
+    {
+        emitter.Emit(1);
+    }
+    BangTest::Report("Propagate after unregistering half, per listener call",
+                     BangTest::GetNow() - beginTime,
+                     (numListeners / 2) * numPropagations);
+
+    // In random order, which used to be a search each
+    std::mt19937 rng(1010);
+    Array<CounterListener *> listenersToUnregister;
+    for (uint i = 0; i < numListeners; i += 2)
+    {
+        listenersToUnregister.PushBack(listeners[i]);
+    }
+    std::shuffle(
+        listenersToUnregister.Begin(), listenersToUnregister.End(), rng);
+    beginTime = BangTest::GetNow();
+    for (CounterListener *listener : listenersToUnregister)
+    {
+        emitter.UnRegisterListener(listener);
+    }
+    BangTest::Report("Unregister in random order",
+                     BangTest::GetNow() - beginTime,
+                     listenersToUnregister.Size());
+
+    BANG_CHECK(emitter.GetListeners().IsEmpty());
+    BANG_CHECK(listeners[0]->count == SCAST<int>(2 * numPropagations + 1));
+    BANG_CHECK(listeners[1]->count == SCAST<int>(numPropagations));
+    for (CounterListener *listener : listeners)
+    {
+        delete listener;
+    }
+}
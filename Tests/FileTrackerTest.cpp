@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <ctime>
+
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include "Bang/Array.tcc"
+#include "Bang/EventListener.h"
+#include "Bang/EventListener.tcc"
+#include "Bang/File.h"
+#include "Bang/FileTracker.h"
+#include "Bang/IEventsFileTracker.h"
+#include "Bang/Path.h"
+#include "Bang/StreamOperators.h"
+#include "BangTest.h"
+
+using namespace Bang;
+
+namespace
+{
+// Events as "Added a.txt", relative to the tracked directory. Modification
+// times have a resolution of one second and directories change with their
+// entries, so directory modifications are not recorded.
+class FileTrackerRecorder : public EventListener<IEventsFileTracker>
+{
+public:
+    explicit FileTrackerRecorder(const Path &dir) : m_dir(dir)
+    {
+    }
+
+    void OnPathAdded(const Path &addedPath) override
+    {
+        Record("Added", addedPath);
+    }
+
+    void OnPathModified(const Path &modifiedPath) override
+    {
+        if (!modifiedPath.IsDir())
+        {
+            Record("Modified", modifiedPath);
+        }
+    }
+
+    void OnPathRemoved(const Path &removedPath) override
+    {
+        Record("Removed", removedPath);
+    }
+
+    // Sorted, and forgotten for the next ones
+    Array<String> TakeEvents()
+    {
+        Array<String> events = m_events;
+        std::sort(events.Begin(), events.End());
+        m_events.Clear();
+        return events;
+    }
+
+private:
+    Path m_dir;
+    Array<String> m_events;
+
+    void Record(const String &eventName, const Path &path)
+    {
+        String relativePath = path.GetRelativePath(m_dir).GetAbsolute();
+        if (relativePath.BeginsWith(Path::GetSeparatorString()))
+        {
+            relativePath = relativePath.SubString(1);
+        }
+        m_events.PushBack(eventName + " " +
+                          (relativePath.IsEmpty() ? "." : relativePath));
+    }
+};
+
+// One hour ago, so that writing the file now is always a modification
+void SetOldModificationTime(const Path &path)
+{
+    struct utimbuf times;
+    times.actime = std::time(nullptr) - 3600;
+    times.modtime = times.actime;
+    utime(path.GetAbsolute().ToCString(), &times);
+}
+
+void CreateFile(const Path &path)
+{
+    File::Write(path, "Contents of " + path.GetNameExt());
+    SetOldModificationTime(path);
+}
+
+Array<String> CheckFiles(FileTracker *fileTracker,
+                         FileTrackerRecorder *recorder)
+{
+    fileTracker->CheckFiles();
+    return recorder->TakeEvents();
+}
+
+// Same steps and same events whether the tracker watches or polls
+void CheckFileTrackerEvents(bool forcePolling)
+{
+    const Path dir = BangTest::CreateTempDir();
+    File::CreateDir(dir.Append("Sub"));
+    File::CreateDir(dir.Append("Sub").Append("Deep"));
+    File::CreateDir(dir.Append("Other"));
+    CreateFile(dir.Append("a.txt"));
+    CreateFile(dir.Append("b.txt"));
+    CreateFile(dir.Append("Sub").Append("c.txt"));
+    CreateFile(dir.Append("Sub").Append("Deep").Append("d.txt"));
+    CreateFile(dir.Append("Other").Append("g.txt"));
+
+    FileTracker fileTracker;
+    fileTracker.SetForcePolling(forcePolling);
+#ifdef __linux__
+    BANG_CHECK(fileTracker.IsPolling() == forcePolling);
+#endif
+
+    FileTrackerRecorder recorder(dir);
+    fileTracker.RegisterListener(&recorder);
+    fileTracker.TrackPath(dir);
+    BANG_CHECK(fileTracker.GetTrackedPaths().Size() == 9);
+    Array<String> expectedEvents = {"Added .",
+                                    "Added Other",
+                                    "Added Other/g.txt",
+                                    "Added Sub",
+                                    "Added Sub/Deep",
+                                    "Added Sub/Deep/d.txt",
+                                    "Added Sub/c.txt",
+                                    "Added a.txt",
+                                    "Added b.txt"};
+    Array<String> events = recorder.TakeEvents();
+    BANG_CHECK_MSG(events == expectedEvents, events);
+
+    events = CheckFiles(&fileTracker, &recorder);
+    BANG_CHECK_MSG(events.IsEmpty(), events);
+
+    // New files, and a new directory with files already inside
+    File::Write(dir.Append("e.txt"), "e");
+    File::CreateDir(dir.Append("New"));
+    File::Write(dir.Append("New").Append("f.txt"), "f");
+    expectedEvents = {"Added New", "Added New/f.txt", "Added e.txt"};
+    events = CheckFiles(&fileTracker, &recorder);
+    BANG_CHECK_MSG(events == expectedEvents, events);
+
+    // Many writes between two checks are a single modification
+    for (uint i = 0; i < 100; ++i)
+    {
+        File::Write(dir.Append("a.txt"), "a" + String::ToString(i));
+    }
+    File::Write(dir.Append("Sub").Append("c.txt"), "c");
+    expectedEvents = {"Modified Sub/c.txt", "Modified a.txt"};
+    events = CheckFiles(&fileTracker, &recorder);
+    BANG_CHECK_MSG(events == expectedEvents, events);
+
+    File::Rename(dir.Append("b.txt"), dir.Append("Renamed.txt"));
+    expectedEvents = {"Added Renamed.txt", "Removed b.txt"};
+    events = CheckFiles(&fileTracker, &recorder);
+    BANG_CHECK_MSG(events == expectedEvents, events);
+
+    // A renamed directory takes its contents with it
+    File::Rename(dir.Append("Other"), dir.Append("Moved"));
+    expectedEvents = {"Added Moved",
+                      "Added Moved/g.txt",
+                      "Removed Other",
+                      "Removed Other/g.txt"};
+    events = CheckFiles(&fileTracker, &recorder);
+    BANG_CHECK_MSG(events == expectedEvents, events);
+
+    File::Remove(dir.Append("Sub"));
+    File::Remove(dir.Append("e.txt"));
+    expectedEvents = {"Removed Sub",
+                      "Removed Sub/Deep",
+                      "Removed Sub/Deep/d.txt",
+                      "Removed Sub/c.txt",
+                      "Removed e.txt"};
+    events = CheckFiles(&fileTracker, &recorder);
+    BANG_CHECK_MSG(events == expectedEvents, events);
+
+    // Still tracking the right paths after all of it
+    File::Write(dir.Append("Moved").Append("h.txt"), "h");
+    expectedEvents = {"Added Moved/h.txt"};
+    events = CheckFiles(&fileTracker, &recorder);
+    BANG_CHECK_MSG(events == expectedEvents, events);
+    BANG_CHECK(fileTracker.GetTrackedPaths().Size() == 8);
+    for (const Path &path : dir.GetSubPaths(FindFlag::RECURSIVE_HIDDEN))
+    {
+        BANG_CHECK_MSG(fileTracker.GetTrackedPaths().Contains(path), path);
+    }
+
+    File::Remove(dir);
+    events = CheckFiles(&fileTracker, &recorder);
+    BANG_CHECK_MSG(events.Size() == 8, events);
+    BANG_CHECK(fileTracker.GetTrackedPaths().IsEmpty());
+}
+}
+
+BANG_TEST(FileTrackerWatchingNotifiesChanges)
+{
+    CheckFileTrackerEvents(false);
+}
+
+BANG_TEST(FileTrackerPollingNotifiesChanges)
+{
+    CheckFileTrackerEvents(true);
+}
+
+BANG_BENCHMARK(FileTracker20kFiles)
+{
+    const uint numDirs = 200;
+    const uint numFilesPerDir = 100;
+    const uint numChecks = 20;
+    const Path dir = BangTest::CreateTempDir();
+    for (uint i = 0; i < numDirs; ++i)
+    {
+        const Path subDir = dir.Append("Dir" + String::ToString(i));
+        File::CreateDir(subDir);
+        for (uint j = 0; j < numFilesPerDir; ++j)
+        {
+            CreateFile(subDir.Append("File" + String::ToString(j) + ".txt"));
+        }
+    }
+
+    for (bool forcePolling : {true, false})
+    {
+        const String name = (forcePolling ? "polling" : "watching");
+        FileTracker fileTracker;
+        fileTracker.SetForcePolling(forcePolling);
+        FileTrackerRecorder recorder(dir);
+        fileTracker.RegisterListener(&recorder);
+
+        Time beginTime = BangTest::GetNow();
+        fileTracker.TrackPath(dir);
+        BangTest::Report("TrackPath, " + name,
+                         BangTest::GetNow() - beginTime,
+                         numDirs * numFilesPerDir);
+
+        beginTime = BangTest::GetNow();
+        for (uint i = 0; i < numChecks; ++i)
+        {
+            fileTracker.CheckFiles();
+        }
+        BangTest::Report("CheckFiles without changes, " + name,
+                         BangTest::GetNow() - beginTime,
+                         numChecks);
+
+        // A file modified before each check
+        recorder.TakeEvents();
+        beginTime = BangTest::GetNow();
+        for (uint i = 0; i < numChecks; ++i)
+        {
+            const Path path = dir.Append("Dir" + String::ToString(i))
+                                  .Append("File0.txt");
+            File::Write(path, name);
+            fileTracker.CheckFiles();
+        }
+        BangTest::Report("CheckFiles with a modified file, " + name,
+                         BangTest::GetNow() - beginTime,
+                         numChecks);
+        BANG_CHECK(recorder.TakeEvents().Size() == numChecks);
+
+        // Older again, for the next run
+        for (uint i = 0; i < numChecks; ++i)
+        {
+            SetOldModificationTime(dir.Append("Dir" + String::ToString(i))
+                                       .Append("File0.txt"));
+        }
+    }
+
+    File::Remove(dir);
+}
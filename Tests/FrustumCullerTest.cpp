@@ -0,0 +1,255 @@
+#include <array>
+#include <random>
+
+#include "Bang/Array.tcc"
+#include "Bang/Frustum.h"
+#include "Bang/FrustumCuller.h"
+#include "BangMath/AABox.h"
+#include "BangMath/Math.h"
+#include "BangMath/Matrix4.h"
+#include "BangMath/Sphere.h"
+#include "BangMath/Vector3.h"
+#include "BangMath/Vector4.h"
+#include "BangTest.h"
+
+using namespace Bang;
+
+namespace
+{
+const float ZNear = 0.5f;
+const float ZFar = 100.0f;
+
+// Looking from the camera position towards the origin
+Matrix4 CreateViewProjection(const Vector3 &cameraPosition)
+{
+    return Matrix4::Perspective(
+               Math::DegToRad(60.0f), 16.0f / 9.0f, ZNear, ZFar) *
+           Matrix4::LookAt(cameraPosition, Vector3::Zero(), Vector3::Up());
+}
+
+// Inside or outside of each clip plane, in the same order as the planes of
+// the frustum: -w <= x <= w, -w <= y <= w and -w <= z <= w
+std::array<bool, Frustum::NumPlanes> GetInsideClipPlanes(
+    const Matrix4 &viewProjection,
+    const Vector3 &point)
+{
+    const Vector4 clip = viewProjection * Vector4(point, 1.0f);
+    return {{clip.x >= -clip.w,
+             clip.x <= clip.w,
+             clip.y >= -clip.w,
+             clip.y <= clip.w,
+             clip.z >= -clip.w,
+             clip.z <= clip.w}};
+}
+
+bool IsInsideClipVolume(const Matrix4 &viewProjection,
+                        const Vector3 &point,
+                        bool testDepth)
+{
+    const std::array<bool, Frustum::NumPlanes> inside =
+        GetInsideClipPlanes(viewProjection, point);
+    const uint numPlanesToTest = (testDepth ? Frustum::NumPlanes : 4);
+    for (uint i = 0; i < numPlanesToTest; ++i)
+    {
+        if (!inside[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Points of the box, its corners among them
+Array<Vector3> GetBoxPoints(const AABox &aaBox)
+{
+    Array<Vector3> points;
+    const Vector3 &min = aaBox.GetMin();
+    const Vector3 &max = aaBox.GetMax();
+    const uint numSteps = 4;
+    for (uint i = 0; i <= numSteps; ++i)
+    {
+        for (uint j = 0; j <= numSteps; ++j)
+        {
+            for (uint k = 0; k <= numSteps; ++k)
+            {
+                const Vector3 t(SCAST<float>(i) / numSteps,
+                                SCAST<float>(j) / numSteps,
+                                SCAST<float>(k) / numSteps);
+                points.PushBack(min + (max - min) * t);
+            }
+        }
+    }
+    return points;
+}
+
+// Whether all the corners of the box are outside of the same clip plane, in
+// which case nothing of it can be seen
+bool IsOutsideOneClipPlane(const Matrix4 &viewProjection,
+                           const AABox &aaBox,
+                           bool testDepth)
+{
+    const uint numPlanesToTest = (testDepth ? Frustum::NumPlanes : 4);
+    std::array<bool, Frustum::NumPlanes> allOutside;
+    allOutside.fill(true);
+    const Vector3 &min = aaBox.GetMin();
+    const Vector3 &max = aaBox.GetMax();
+    for (uint corner = 0; corner < 8; ++corner)
+    {
+        const Vector3 point((corner & 1) ? max.x : min.x,
+                            (corner & 2) ? max.y : min.y,
+                            (corner & 4) ? max.z : min.z);
+        const std::array<bool, Frustum::NumPlanes> inside =
+            GetInsideClipPlanes(viewProjection, point);
+        for (uint i = 0; i < numPlanesToTest; ++i)
+        {
+            allOutside[i] = allOutside[i] && !inside[i];
+        }
+    }
+    for (uint i = 0; i < numPlanesToTest; ++i)
+    {
+        if (allOutside[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+AABox CreateRandomAABox(std::mt19937 *rng)
+{
+    std::uniform_real_distribution<float> posDist(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> sizeDist(0.01f, 20.0f);
+    const Vector3 center(posDist(*rng), posDist(*rng), posDist(*rng));
+    const Vector3 halfSize(sizeDist(*rng), sizeDist(*rng), sizeDist(*rng));
+    return AABox(center - halfSize, center + halfSize);
+}
+}
+
+BANG_TEST(FrustumCullerAABoxesAreConservative)
+{
+    std::mt19937 rng(1001);
+    const Array<Vector3> cameraPositions = {Vector3(0, 0, 50),
+                                            Vector3(30, 20, -40),
+                                            Vector3(-60, -10, 5)};
+    for (const Vector3 &cameraPosition : cameraPositions)
+    {
+        const Matrix4 viewProjection = CreateViewProjection(cameraPosition);
+        const Frustum frustum(viewProjection);
+        for (bool testDepth : {true, false})
+        {
+            uint numVisible = 0, numCulled = 0;
+            for (uint i = 0; i < 2000; ++i)
+            {
+                const AABox aaBox = CreateRandomAABox(&rng);
+                const bool visible =
+                    FrustumCuller::IsVisible(frustum, aaBox, testDepth);
+                (visible ? numVisible : numCulled) += 1;
+
+                // Never culled if any of it is inside
+                for (const Vector3 &point : GetBoxPoints(aaBox))
+                {
+                    if (IsInsideClipVolume(viewProjection, point, testDepth))
+                    {
+                        BANG_CHECK_MSG(visible,
+                                       "box " << i << ", point " << point);
+                        break;
+                    }
+                }
+
+                // Always culled if all of it is behind one plane
+                if (IsOutsideOneClipPlane(viewProjection, aaBox, testDepth))
+                {
+                    BANG_CHECK_MSG(!visible, "box " << i);
+                }
+            }
+
+            // Both cases, so that the checks above mean something
+            BANG_CHECK(numVisible > 100 && numCulled > 100);
+        }
+    }
+}
+
+BANG_TEST(FrustumCullerSpheresAreConservative)
+{
+    std::mt19937 rng(2002);
+    std::uniform_real_distribution<float> posDist(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> radiusDist(0.01f, 20.0f);
+    std::uniform_real_distribution<float> dirDist(-1.0f, 1.0f);
+    const Matrix4 viewProjection = CreateViewProjection(Vector3(10, 5, 60));
+    const Frustum frustum(viewProjection);
+    uint numVisible = 0, numCulled = 0;
+    for (uint i = 0; i < 5000; ++i)
+    {
+        const Vector3 center(posDist(rng), posDist(rng), posDist(rng));
+        const float radius = radiusDist(rng);
+        const Sphere sphere(center, radius);
+        const bool visible = frustum.Intersects(sphere);
+        (visible ? numVisible : numCulled) += 1;
+
+        // Never culled if any of it is inside
+        if (IsInsideClipVolume(viewProjection, center, true))
+        {
+            BANG_CHECK_MSG(visible, "sphere " << i);
+        }
+        for (uint j = 0; j < 50; ++j)
+        {
+            Vector3 dir(dirDist(rng), dirDist(rng), dirDist(rng));
+            if (dir.Length() < 0.01f)
+            {
+                continue;
+            }
+            const Vector3 point = center + dir.Normalized() * radius * 0.999f;
+            if (IsInsideClipVolume(viewProjection, point, true))
+            {
+                BANG_CHECK_MSG(visible, "sphere " << i << ", point " << point);
+                break;
+            }
+        }
+
+        // Always culled if its box is behind one plane, as it is inside it
+        const Vector3 halfSize = Vector3(radius);
+        const AABox sphereAABox(center - halfSize, center + halfSize);
+        if (IsOutsideOneClipPlane(viewProjection, sphereAABox, true))
+        {
+            BANG_CHECK_MSG(!visible, "sphere " << i);
+        }
+    }
+    BANG_CHECK(numVisible > 100 && numCulled > 100);
+}
+
+BANG_TEST(FrustumCullerCullsAABoxesAndCountsThem)
+{
+    const Frustum frustum(CreateViewProjection(Vector3(0, 0, 50)));
+
+    // In front, behind the camera, beyond the far plane and to a side
+    const Array<AABox> aaBoxes = {
+        AABox(Vector3(-1, -1, -1), Vector3(1, 1, 1)),
+        AABox(Vector3(-1, -1, 60), Vector3(1, 1, 62)),
+        AABox(Vector3(-1, -1, -200), Vector3(1, 1, -198)),
+        AABox(Vector3(500, -1, -1), Vector3(502, 1, 1))};
+    BANG_CHECK(frustum.Contains(Vector3::Zero()));
+    BANG_CHECK(!frustum.Contains(Vector3(0, 0, 60)));
+
+    Array<uint> visibleIndices;
+    FrustumCullingStats stats =
+        FrustumCuller::CullAABoxes(frustum, aaBoxes, &visibleIndices);
+    BANG_CHECK(visibleIndices == Array<uint>({0}));
+    BANG_CHECK(stats.numTested == 4 && stats.numVisible == 1 &&
+               stats.numCulled == 3);
+
+    // Without depth, what is too far away is kept. What is right behind the
+    // camera is still outside of the side planes.
+    visibleIndices.Clear();
+    stats = FrustumCuller::CullAABoxes(
+        frustum, aaBoxes, &visibleIndices, false);
+    BANG_CHECK(visibleIndices == Array<uint>({0, 2}));
+    BANG_CHECK(stats.numTested == 4 && stats.numVisible == 2 &&
+               stats.numCulled == 2);
+
+    FrustumCullingStats totalStats;
+    totalStats.Accumulate(stats);
+    totalStats.Accumulate(stats);
+    BANG_CHECK(totalStats.numTested == 8 && totalStats.numCulled == 4);
+    totalStats.Reset();
+    BANG_CHECK(totalStats.numTested == 0 && totalStats.numVisible == 0);
+}
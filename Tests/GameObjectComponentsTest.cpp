@@ -0,0 +1,207 @@
+#include "Bang/Animator.h"
+#include "Bang/Array.tcc"
+#include "Bang/Component.h"
+#include "Bang/ComponentMacros.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/Transform.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// Without a class id of their own, like the user components
+class PlainComponent : public Component
+{
+    COMPONENT_WITHOUT_CLASS_ID(PlainComponent)
+
+public:
+    PlainComponent() = default;
+};
+
+class OtherPlainComponent : public PlainComponent
+{
+    COMPONENT_WITHOUT_CLASS_ID(OtherPlainComponent)
+
+public:
+    OtherPlainComponent() = default;
+};
+
+// How GetComponent and GetComponents looked components up before the class
+// id ranges
+template <class T>
+T *GetComponentWithDCAST(const GameObject *go)
+{
+    for (Component *comp : go->GetComponents())
+    {
+        if (T *tcomp = DCAST<T *>(comp))
+        {
+            return tcomp;
+        }
+    }
+    return nullptr;
+}
+
+template <class T>
+Array<T *> GetComponentsWithDCAST(const GameObject *go)
+{
+    Array<T *> comps;
+    for (Component *comp : go->GetComponents())
+    {
+        if (T *tcomp = DCAST<T *>(comp))
+        {
+            comps.PushBack(tcomp);
+        }
+    }
+    return comps;
+}
+
+// Some plain components, the transform somewhere in between and the
+// animator last, the worst case for a linear search
+Array<GameObject *> CreateGameObjects(uint numGameObjects)
+{
+    Array<GameObject *> gos;
+    for (uint i = 0; i < numGameObjects; ++i)
+    {
+        GameObject *go = new GameObject();
+        const uint numPlainComponents = 2 + i % 5;
+        for (uint j = 0; j < numPlainComponents; ++j)
+        {
+            if (j == 1)
+            {
+                go->AddComponent<Transform>();
+            }
+            if (j % 2 == 0)
+            {
+                go->AddComponent<PlainComponent>();
+            }
+            else
+            {
+                go->AddComponent<OtherPlainComponent>();
+            }
+        }
+        if (i % 4 != 0)
+        {
+            go->AddComponent<Animator>();
+        }
+        gos.PushBack(go);
+    }
+    return gos;
+}
+
+template <class T>
+void CheckLikeDCAST(const GameObject *go, uint i)
+{
+    BANG_CHECK_MSG(go->GetComponent<T>() == GetComponentWithDCAST<T>(go),
+                   T::GetClassNameStatic() << ", game object " << i);
+    BANG_CHECK_MSG(go->GetComponents<T>() == GetComponentsWithDCAST<T>(go),
+                   T::GetClassNameStatic() << ", game object " << i);
+}
+
+template <class T>
+void BenchmarkGetComponent(const Array<GameObject *> &gos, uint numRounds)
+{
+    const String className = T::GetClassNameStatic();
+    uint numFound = 0, numFoundWithDCAST = 0;
+    Time beginTime = BangTest::GetNow();
+    for (uint round = 0; round < numRounds; ++round)
+    {
+        for (const GameObject *go : gos)
+        {
+            numFound += (go->GetComponent<T>() ? 1 : 0);
+        }
+    }
+    BangTest::Report("GetComponent<" + className + ">",
+                     BangTest::GetNow() - beginTime,
+                     numRounds * gos.Size());
+
+    beginTime = BangTest::GetNow();
+    for (uint round = 0; round < numRounds; ++round)
+    {
+        for (const GameObject *go : gos)
+        {
+            numFoundWithDCAST += (GetComponentWithDCAST<T>(go) ? 1 : 0);
+        }
+    }
+    BangTest::Report("GetComponent<" + className + "> with DCAST",
+                     BangTest::GetNow() - beginTime,
+                     numRounds * gos.Size());
+    BANG_CHECK(numFound == numFoundWithDCAST);
+
+    uint numComps = 0, numCompsWithDCAST = 0;
+    beginTime = BangTest::GetNow();
+    for (uint round = 0; round < numRounds; ++round)
+    {
+        for (const GameObject *go : gos)
+        {
+            numComps += go->GetComponents<T>().Size();
+        }
+    }
+    BangTest::Report("GetComponents<" + className + ">",
+                     BangTest::GetNow() - beginTime,
+                     numRounds * gos.Size());
+
+    beginTime = BangTest::GetNow();
+    for (uint round = 0; round < numRounds; ++round)
+    {
+        for (const GameObject *go : gos)
+        {
+            numCompsWithDCAST += GetComponentsWithDCAST<T>(go).Size();
+        }
+    }
+    BangTest::Report("GetComponents<" + className + "> with DCAST",
+                     BangTest::GetNow() - beginTime,
+                     numRounds * gos.Size());
+    BANG_CHECK(numComps == numCompsWithDCAST);
+}
+}
+
+BANG_TEST(GameObjectFindsComponentsLikeDCAST)
+{
+    BangTestApplication::InitIfNeeded();
+    Array<GameObject *> gos = CreateGameObjects(100);
+    for (uint i = 0; i < gos.Size(); ++i)
+    {
+        const GameObject *go = gos[i];
+        CheckLikeDCAST<Component>(go, i);
+        CheckLikeDCAST<Transform>(go, i);
+        CheckLikeDCAST<Animator>(go, i);
+        CheckLikeDCAST<PlainComponent>(go, i);
+        CheckLikeDCAST<OtherPlainComponent>(go, i);
+    }
+
+    // Still right after removing some of them
+    for (uint i = 0; i < gos.Size(); i += 3)
+    {
+        GameObject *go = gos[i];
+        Component::DestroyImmediate(go->GetComponents().Front());
+        if (Transform *transform = go->GetComponent<Transform>())
+        {
+            Component::DestroyImmediate(transform);
+        }
+        CheckLikeDCAST<Transform>(go, i);
+        CheckLikeDCAST<Animator>(go, i);
+        CheckLikeDCAST<PlainComponent>(go, i);
+    }
+
+    for (GameObject *go : gos)
+    {
+        GameObject::DestroyImmediate(go);
+    }
+}
+
+BANG_BENCHMARK(GameObjectGetComponent)
+{
+    BangTestApplication::InitIfNeeded();
+    const uint numRounds = 100;
+    Array<GameObject *> gos = CreateGameObjects(10000);
+    BenchmarkGetComponent<Transform>(gos, numRounds);
+    BenchmarkGetComponent<Animator>(gos, numRounds);
+    BenchmarkGetComponent<PlainComponent>(gos, numRounds);
+    for (GameObject *go : gos)
+    {
+        GameObject::DestroyImmediate(go);
+    }
+}
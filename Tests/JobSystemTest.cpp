@@ -0,0 +1,191 @@
+#include <atomic>
+#include <memory>
+
+#include "Bang/Array.tcc"
+#include "Bang/JobSystem.h"
+#include "Bang/Time.h"
+#include "BangTest.h"
+
+using namespace Bang;
+
+BANG_TEST(JobSystemParallelForVisitsEveryIndexOnce)
+{
+    JobSystem jobSystem;
+    jobSystem.Init();
+
+    const uint numIndices = 100000;
+    for (uint grainSize : {0u, 1u, 7u, 1000u, numIndices * 2})
+    {
+        std::unique_ptr<std::atomic<int>[]> visits(
+            new std::atomic<int>[numIndices]);
+        for (uint i = 0; i < numIndices; ++i)
+        {
+            visits[i] = 0;
+        }
+
+        jobSystem.ParallelFor(0, numIndices, grainSize, [&](uint b, uint e) {
+            for (uint i = b; i < e; ++i)
+            {
+                ++visits[i];
+            }
+        });
+
+        uint numWrong = 0;
+        for (uint i = 0; i < numIndices; ++i)
+        {
+            numWrong += (visits[i] != 1) ? 1 : 0;
+        }
+        BANG_CHECK_MSG(numWrong == 0,
+                       numWrong << " indices not visited once with grain "
+                                << grainSize);
+    }
+}
+
+BANG_TEST(JobSystemDependenciesRunInOrder)
+{
+    JobSystem jobSystem;
+    jobSystem.Init();
+
+    // A chain where every job must see the count left by the previous one
+    const int chainLength = 2000;
+    std::atomic<int> count(0);
+    std::atomic<int> numOutOfOrder(0);
+    JobHandle prevJob;
+    for (int i = 0; i < chainLength; ++i)
+    {
+        Array<JobHandle> dependencies;
+        if (prevJob.IsValid())
+        {
+            dependencies.PushBack(prevJob);
+        }
+        prevJob = jobSystem.Schedule(
+            [&count, &numOutOfOrder, i]() {
+                if (count.fetch_add(1) != i)
+                {
+                    ++numOutOfOrder;
+                }
+            },
+            dependencies);
+    }
+    jobSystem.Wait(prevJob);
+
+    BANG_CHECK(count == chainLength);
+    BANG_CHECK(numOutOfOrder == 0);
+}
+
+BANG_TEST(JobSystemFanOutFanInStress)
+{
+    JobSystem jobSystem;
+    jobSystem.Init();
+
+    // Many small graphs: a parallel for, a join depending on it, and a
+    // last job depending on both
+    for (uint round = 0; round < 500; ++round)
+    {
+        std::atomic<int> sum(0);
+        std::atomic<bool> joinSawAll(false);
+        std::atomic<bool> lastSawJoin(false);
+
+        JobHandle forJob = jobSystem.ScheduleParallelFor(
+            0, 256, 3, [&sum](uint b, uint e) {
+                sum += SCAST<int>(e - b);
+            });
+        JobHandle joinJob = jobSystem.Schedule(
+            [&]() { joinSawAll = (sum == 256); }, {forJob});
+        JobHandle lastJob = jobSystem.Schedule(
+            [&]() { lastSawJoin = joinSawAll.load(); }, {forJob, joinJob});
+        jobSystem.Wait(lastJob);
+
+        BANG_CHECK_MSG(forJob.IsDone() && joinJob.IsDone(), "round " << round);
+        BANG_CHECK_MSG(lastSawJoin, "round " << round);
+    }
+}
+
+BANG_TEST(JobSystemNestedWaitsStress)
+{
+    JobSystem jobSystem;
+    jobSystem.Init();
+
+    // Jobs that schedule jobs and wait on them from inside a worker, which
+    // must help instead of blocking, or the pool deadlocks
+    const uint numOuterJobs = 200;
+    const uint numInnerJobs = 50;
+    std::atomic<uint> numInnerRun(0);
+    Array<JobHandle> outerJobs;
+    for (uint i = 0; i < numOuterJobs; ++i)
+    {
+        outerJobs.PushBack(jobSystem.Schedule([&]() {
+            Array<JobHandle> innerJobs;
+            for (uint j = 0; j < numInnerJobs; ++j)
+            {
+                innerJobs.PushBack(
+                    jobSystem.Schedule([&numInnerRun]() { ++numInnerRun; }));
+            }
+            jobSystem.Wait(innerJobs);
+        }));
+    }
+    jobSystem.Wait(outerJobs);
+
+    BANG_CHECK(numInnerRun == numOuterJobs * numInnerJobs);
+}
+
+BANG_TEST(JobSystemDependsOnFinishedJob)
+{
+    JobSystem jobSystem;
+    jobSystem.Init();
+
+    std::atomic<int> numRun(0);
+    JobHandle firstJob = jobSystem.Schedule([&numRun]() { ++numRun; });
+    jobSystem.Wait(firstJob);
+
+    JobHandle secondJob =
+        jobSystem.Schedule([&numRun]() { ++numRun; }, {firstJob});
+    jobSystem.Wait(secondJob);
+    BANG_CHECK(numRun == 2);
+}
+
+BANG_BENCHMARK(JobSystemThroughput)
+{
+    JobSystem jobSystem;
+    jobSystem.Init();
+
+    // Scheduling cost of many tiny jobs
+    const uint numJobs = 1000000;
+    std::atomic<uint> numRun(0);
+    Array<JobHandle> jobs;
+    jobs.Reserve(numJobs);
+    Time beginTime = BangTest::GetNow();
+    for (uint i = 0; i < numJobs; ++i)
+    {
+        jobs.PushBack(jobSystem.Schedule([&numRun]() { ++numRun; }));
+    }
+    jobSystem.Wait(jobs);
+    BangTest::Report(
+        "Schedule + Wait", BangTest::GetNow() - beginTime, numJobs);
+    BANG_CHECK(numRun == numJobs);
+
+    // Parallel for against the serial loop, on some arithmetic per index
+    const uint numIndices = 20000000;
+    Array<float> values;
+    values.Resize(numIndices);
+    auto work = [&values](uint b, uint e) {
+        for (uint i = b; i < e; ++i)
+        {
+            const float x = SCAST<float>(i);
+            values[i] = x * x * 0.5f + x * 3.0f + 1.0f;
+        }
+    };
+
+    beginTime = BangTest::GetNow();
+    work(0, numIndices);
+    BangTest::Report(
+        "Serial loop", BangTest::GetNow() - beginTime, numIndices);
+
+    beginTime = BangTest::GetNow();
+    jobSystem.ParallelFor(0, numIndices, 0, work);
+    BangTest::Report("ParallelFor (" +
+                         String::ToString(jobSystem.GetNumWorkers() + 1) +
+                         " threads)",
+                     BangTest::GetNow() - beginTime,
+                     numIndices);
+}
@@ -0,0 +1,77 @@
+#include "Bang/Array.tcc"
+#include "Bang/MeshRenderer.h"
+#include "BangTest.h"
+
+using namespace Bang;
+
+BANG_TEST(MeshRendererSelectsLODsByScreenSize)
+{
+    const Array<float> lodScreenSizes = {0.5f, 0.25f, 0.1f};
+    BANG_CHECK(MeshRenderer::SelectLOD(1.0f, 0, 4, lodScreenSizes, 0) == 0);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.5f, 0, 4, lodScreenSizes, 0) == 0);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.4f, 0, 4, lodScreenSizes, 0) == 1);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.2f, 0, 4, lodScreenSizes, 0) == 2);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.05f, 0, 4, lodScreenSizes, 0) == 3);
+
+    // Never beyond the LODs of the mesh
+    BANG_CHECK(MeshRenderer::SelectLOD(0.01f, 0, 1, lodScreenSizes, 0) == 0);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.01f, 0, 2, lodScreenSizes, 0) == 1);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.01f, 3, 0, lodScreenSizes, 0) == 0);
+}
+
+BANG_TEST(MeshRendererHalvesMissingLODScreenSizes)
+{
+    // 0.5, 0.25 and 0.125 without thresholds
+    BANG_CHECK(MeshRenderer::SelectLOD(0.6f, 0, 4, {}, 0) == 0);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.3f, 0, 4, {}, 0) == 1);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.2f, 0, 4, {}, 0) == 2);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.1f, 0, 4, {}, 0) == 3);
+
+    // And halving the last one given: 0.4, 0.2 and 0.1
+    BANG_CHECK(MeshRenderer::SelectLOD(0.3f, 0, 4, {0.4f}, 0) == 1);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.15f, 0, 4, {0.4f}, 0) == 2);
+    BANG_CHECK(MeshRenderer::SelectLOD(0.05f, 0, 4, {0.4f}, 0) == 3);
+}
+
+BANG_TEST(MeshRendererLODHysteresisAvoidsPopping)
+{
+    const Array<float> lodScreenSizes = {0.5f, 0.25f};
+    const float hysteresis = 0.2f;
+
+    // Coarser only once under 0.4, finer only once over 0.6
+    BANG_CHECK(MeshRenderer::SelectLOD(
+                   0.45f, 0, 3, lodScreenSizes, hysteresis) == 0);
+    BANG_CHECK(MeshRenderer::SelectLOD(
+                   0.35f, 0, 3, lodScreenSizes, hysteresis) == 1);
+    BANG_CHECK(MeshRenderer::SelectLOD(
+                   0.55f, 1, 3, lodScreenSizes, hysteresis) == 1);
+    BANG_CHECK(MeshRenderer::SelectLOD(
+                   0.65f, 1, 3, lodScreenSizes, hysteresis) == 0);
+    BANG_CHECK(MeshRenderer::SelectLOD(
+                   0.15f, 0, 3, lodScreenSizes, hysteresis) == 2);
+    BANG_CHECK(MeshRenderer::SelectLOD(
+                   0.35f, 2, 3, lodScreenSizes, hysteresis) == 1);
+
+    // Sweeping the screen size, the LOD never gets finer as the object gets
+    // smaller, and once selected it is kept for the same screen size
+    for (float h : {0.0f, 0.1f, 0.3f})
+    {
+        for (int currentLOD = 0; currentLOD < 3; ++currentLOD)
+        {
+            int prevLOD = 0;
+            for (float screenSize = 1.0f; screenSize > 0.0f;
+                 screenSize -= 0.005f)
+            {
+                const int lod = MeshRenderer::SelectLOD(
+                    screenSize, currentLOD, 3, lodScreenSizes, h);
+                BANG_CHECK_MSG(lod >= prevLOD,
+                               "screen size " << screenSize << ", h " << h);
+                BANG_CHECK_MSG(MeshRenderer::SelectLOD(
+                                   screenSize, lod, 3, lodScreenSizes, h) ==
+                                   lod,
+                               "screen size " << screenSize << ", h " << h);
+                prevLOD = lod;
+            }
+        }
+    }
+}
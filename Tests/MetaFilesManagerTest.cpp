@@ -0,0 +1,153 @@
+#include "Bang/Array.tcc"
+#include "Bang/File.h"
+#include "Bang/GUID.h"
+#include "Bang/GUIDManager.h"
+#include "Bang/MetaFilesManager.h"
+#include "Bang/MetaNode.h"
+#include "Bang/MetaNode.tcc"
+#include "Bang/Path.h"
+#include "Bang/Paths.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// Makes the meta files index live in the cooked cache of a temporary
+// project, and leaves everything as it was when destroyed
+class TempProject
+{
+public:
+    TempProject()
+    {
+        BangTestApplication::InitIfNeeded();
+        m_prevProjectDir = Paths::GetProjectDir();
+        m_tempDir = BangTest::CreateTempDir();
+        Paths::SetProjectRoot(m_tempDir);
+        m_assetsDir = m_tempDir.Append("Assets");
+        File::CreateDir(m_assetsDir);
+    }
+
+    ~TempProject()
+    {
+        Paths::SetProjectRoot(m_prevProjectDir);
+        File::Remove(m_tempDir);
+    }
+
+    const Path &GetAssetsDir() const
+    {
+        return m_assetsDir;
+    }
+
+private:
+    Path m_prevProjectDir;
+    Path m_tempDir;
+    Path m_assetsDir;
+};
+
+GUID WriteMetaFile(const Path &filepath)
+{
+    const GUID guid = GUIDManager::GetNewGUID();
+    MetaNode metaNode;
+    metaNode.Set("GUID", guid);
+    File::Write(MetaFilesManager::GetMetaFilepath(filepath),
+                metaNode.ToString());
+    return guid;
+}
+}
+
+BANG_TEST(MetaFilesManagerAnswersGUIDsFromTheIndex)
+{
+    TempProject project;
+    const Path &dir = project.GetAssetsDir();
+    const Path withMetaPath = dir.Append("WithMeta.txt");
+    const Path withoutMetaPath = dir.Append("WithoutMeta.txt");
+    File::Write(withMetaPath, "a");
+    File::Write(withoutMetaPath, "b");
+    const GUID withMetaGUID = WriteMetaFile(withMetaPath);
+
+    MetaFilesManager::LoadMetaFilepathGUIDs(dir);
+    BANG_CHECK(MetaFilesManager::GetGUID(withMetaPath) == withMetaGUID);
+    BANG_CHECK(MetaFilesManager::GetGUID(withoutMetaPath).IsEmpty());
+    BANG_CHECK(MetaFilesManager::GetGUID(dir.Append("Missing.txt")).IsEmpty());
+
+    // A meta file written behind its back is not looked for in every miss,
+    // but it is found when asked to create it
+    const GUID lateGUID = WriteMetaFile(withoutMetaPath);
+    BANG_CHECK(MetaFilesManager::GetGUID(withoutMetaPath).IsEmpty());
+    BANG_CHECK(MetaFilesManager::CreateMetaFileIfMissing(withoutMetaPath)
+                   .second == lateGUID);
+    BANG_CHECK(MetaFilesManager::GetGUID(withoutMetaPath) == lateGUID);
+
+    const Path newPath = dir.Append("New.txt");
+    File::Write(newPath, "c");
+    const GUID newGUID =
+        MetaFilesManager::CreateMetaFileIfMissing(newPath).second;
+    BANG_CHECK(!newGUID.IsEmpty());
+    BANG_CHECK(MetaFilesManager::GetGUID(newPath) == newGUID);
+    BANG_CHECK(MetaFilesManager::GetFilepath(newGUID) == newPath);
+
+    // Same GUIDs from the index, the second time
+    MetaFilesManager::LoadMetaFilepathGUIDs(dir);
+    BANG_CHECK(MetaFilesManager::GetGUID(withMetaPath) == withMetaGUID);
+    BANG_CHECK(MetaFilesManager::GetGUID(withoutMetaPath) == lateGUID);
+    BANG_CHECK(MetaFilesManager::GetGUID(newPath) == newGUID);
+}
+
+BANG_BENCHMARK(MetaFilesManager50kAssets)
+{
+    TempProject project;
+    const uint numDirs = 100;
+    const uint numFilesPerDir = 500;
+    const uint numFiles = numDirs * numFilesPerDir;
+    const Path &dir = project.GetAssetsDir();
+    Array<Path> filepaths;
+    Array<GUID> guids;
+    for (uint i = 0; i < numDirs; ++i)
+    {
+        const Path subDir = dir.Append("Dir" + String::ToString(i));
+        File::CreateDir(subDir);
+        for (uint j = 0; j < numFilesPerDir; ++j)
+        {
+            const Path filepath =
+                subDir.Append("Asset" + String::ToString(j) + ".txt");
+            File::Write(filepath, filepath.GetNameExt());
+            filepaths.PushBack(filepath);
+            guids.PushBack(WriteMetaFile(filepath));
+        }
+    }
+
+    Time beginTime = BangTest::GetNow();
+    MetaFilesManager::LoadMetaFilepathGUIDs(dir);
+    BangTest::Report("LoadMetaFilepathGUIDs, reading the meta files",
+                     BangTest::GetNow() - beginTime,
+                     numFiles);
+
+    beginTime = BangTest::GetNow();
+    MetaFilesManager::LoadMetaFilepathGUIDs(dir);
+    BangTest::Report("LoadMetaFilepathGUIDs, from the index",
+                     BangTest::GetNow() - beginTime,
+                     numFiles);
+
+    beginTime = BangTest::GetNow();
+    for (uint i = 0; i < numFiles; ++i)
+    {
+        BANG_CHECK(MetaFilesManager::GetGUID(filepaths[i]) == guids[i]);
+    }
+    BangTest::Report("GetGUID hits", BangTest::GetNow() - beginTime, numFiles);
+
+    // Assets looked up before they exist, as the cache lookups do
+    Array<Path> missingPaths;
+    for (const Path &filepath : filepaths)
+    {
+        missingPaths.PushBack(filepath.WithExtension("png"));
+    }
+    beginTime = BangTest::GetNow();
+    for (const Path &missingPath : missingPaths)
+    {
+        BANG_CHECK(MetaFilesManager::GetGUID(missingPath).IsEmpty());
+    }
+    BangTest::Report(
+        "GetGUID misses", BangTest::GetNow() - beginTime, numFiles);
+}
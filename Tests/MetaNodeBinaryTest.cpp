@@ -0,0 +1,288 @@
+#include <iostream>
+#include <random>
+
+#include "Bang/Array.tcc"
+#include "Bang/File.h"
+#include "Bang/MetaNode.h"
+#include "Bang/MetaNodeBinary.h"
+#include "Bang/Path.h"
+#include "BangTest.h"
+
+using namespace Bang;
+
+namespace
+{
+// Pieces that YAML has to quote or escape to keep them as they are
+const Array<String> TrickyStrings = {"",
+                                     " ",
+                                     "~",
+                                     "null",
+                                     "true",
+                                     "No",
+                                     "0",
+                                     "-1.5e3",
+                                     "0x1F",
+                                     "a: b",
+                                     "- item",
+                                     "# not a comment",
+                                     "\"quoted\"",
+                                     "'single'",
+                                     "{ map }",
+                                     "[1, 2, 3]",
+                                     "&anchor",
+                                     "*alias",
+                                     "!tag",
+                                     "|",
+                                     ">",
+                                     "%",
+                                     "@",
+                                     "`",
+                                     "back\\slash",
+                                     "tab\there",
+                                     " leading and trailing ",
+                                     "(1.0, 2.5, -3.25)"};
+
+String RandomString(std::mt19937 *rng)
+{
+    std::uniform_int_distribution<uint> numPiecesDist(0, 3);
+    std::uniform_int_distribution<uint> trickyDist(0,
+                                                   TrickyStrings.Size() - 1);
+    std::uniform_int_distribution<int> charDist(' ', '~');
+
+    String str = "";
+    const uint numPieces = numPiecesDist(*rng);
+    for (uint i = 0; i < numPieces; ++i)
+    {
+        if ((*rng)() % 2 == 0)
+        {
+            str += TrickyStrings[trickyDist(*rng)];
+        }
+        else
+        {
+            str += SCAST<char>(charDist(*rng));
+        }
+    }
+    return str;
+}
+
+// Names of the attributes and children containers of a node must be unique
+// among them, since YAML keeps them as keys of the same map
+MetaNode RandomMetaNode(std::mt19937 *rng, uint depth)
+{
+    MetaNode metaNode(RandomString(rng));
+
+    Array<String> keys;
+    const uint numAttributes = (*rng)() % 6;
+    for (uint i = 0; i < numAttributes; ++i)
+    {
+        const String attrName = RandomString(rng);
+        if (!keys.Contains(attrName))
+        {
+            metaNode.Set(attrName, RandomString(rng));
+            keys.PushBack(attrName);
+        }
+    }
+
+    const uint numContainers = (depth < 4) ? ((*rng)() % 3) : 0;
+    for (uint i = 0; i < numContainers; ++i)
+    {
+        const String containerName = RandomString(rng);
+        if (keys.Contains(containerName))
+        {
+            continue;
+        }
+        keys.PushBack(containerName);
+
+        metaNode.CreateChildrenContainer(containerName);
+        const uint numChildren = (*rng)() % 4;
+        for (uint j = 0; j < numChildren; ++j)
+        {
+            metaNode.AddChild(RandomMetaNode(rng, depth + 1), containerName);
+        }
+    }
+    return metaNode;
+}
+
+uint CountNodes(const MetaNodeBinaryView &view)
+{
+    uint numNodes = 1;
+    for (uint i = 0; i < view.GetNumChildrenContainers(); ++i)
+    {
+        MetaNodeBinaryView child = view.GetFirstChild(i);
+        for (uint j = 0; j < view.GetNumChildren(i); ++j)
+        {
+            numNodes += CountNodes(child);
+            child = child.GetNextSibling();
+        }
+    }
+    return numNodes;
+}
+
+// Game objects as the scenes serialize them, with a transform, a renderer
+// and some children each
+MetaNode CreateSceneGameObjectMeta(uint *numGameObjects, uint depth)
+{
+    const uint id = (*numGameObjects)++;
+    MetaNode goMeta("GameObject");
+    goMeta.Set("GUID", "1234567 " + String::ToString(id) + " 0");
+    goMeta.Set("Name", "GameObject_" + String::ToString(id));
+    goMeta.Set("Enabled", "true");
+    goMeta.Set("Visible", "true");
+    goMeta.Set("DontDestroyOnLoad", "false");
+
+    MetaNode transformMeta("Transform");
+    transformMeta.Set("GUID", "1234567 " + String::ToString(id) + " 1");
+    transformMeta.Set("LocalPosition", "(1.5, -2.25, 3.125)");
+    transformMeta.Set("LocalRotation", "(0, 0.7071068, 0, 0.7071068)");
+    transformMeta.Set("LocalScale", "(1, 1, 1)");
+    goMeta.AddChild(transformMeta, "Components");
+
+    MetaNode rendererMeta("MeshRenderer");
+    rendererMeta.Set("GUID", "1234567 " + String::ToString(id) + " 2");
+    rendererMeta.Set("Enabled", "true");
+    rendererMeta.Set("Mesh", "7654321 " + String::ToString(id % 16) + " 0");
+    rendererMeta.Set("Material", "7654321 " + String::ToString(id % 8) + " 1");
+    rendererMeta.Set("CastsShadows", "true");
+    rendererMeta.Set("ReceivesShadows", "true");
+    goMeta.AddChild(rendererMeta, "Components");
+
+    goMeta.CreateChildrenContainer("Children");
+    if (depth < 4)
+    {
+        for (uint i = 0; i < 8; ++i)
+        {
+            goMeta.AddChild(
+                CreateSceneGameObjectMeta(numGameObjects, depth + 1),
+                "Children");
+        }
+    }
+    return goMeta;
+}
+}
+
+BANG_TEST(MetaNodeBinaryRoundTripFuzz)
+{
+    std::mt19937 rng(4321);
+    for (uint iteration = 0; iteration < 2000; ++iteration)
+    {
+        const MetaNode metaNode = RandomMetaNode(&rng, 0);
+
+        Array<Byte> bytes;
+        metaNode.ToBinary(&bytes);
+        BANG_CHECK(MetaNodeBinary::IsBinary(bytes.Data(), bytes.Size()));
+
+        MetaNode fromBinary;
+        BANG_CHECK(fromBinary.Import(bytes.Data(), bytes.Size()));
+        BANG_CHECK_MSG(fromBinary == metaNode,
+                       "iteration " << iteration << ":\n"
+                                    << metaNode.ToString());
+
+        const String yaml = metaNode.ToString();
+        MetaNode fromYAML;
+        fromYAML.Import(yaml);
+        BANG_CHECK_MSG(fromYAML == metaNode,
+                       "iteration " << iteration << ":\n"
+                                    << yaml);
+
+        // Binary to YAML and back gives the same bytes
+        Array<Byte> bytesFromYAML;
+        fromYAML.ToBinary(&bytesFromYAML);
+        BANG_CHECK_MSG(bytesFromYAML == bytes, "iteration " << iteration);
+        BANG_CHECK_MSG(fromBinary.ToString() == yaml,
+                       "iteration " << iteration);
+    }
+}
+
+BANG_TEST(MetaNodeBinaryRejectsCorruptData)
+{
+    std::mt19937 rng(8765);
+    for (uint iteration = 0; iteration < 500; ++iteration)
+    {
+        Array<Byte> bytes;
+        RandomMetaNode(&rng, 0).ToBinary(&bytes);
+
+        // Truncated it is always rejected. With some random bytes changed
+        // it may still be valid, but must never be read out of bounds.
+        Array<Byte> corrupted = bytes;
+        corrupted.Resize(rng() % bytes.Size());
+        MetaNode metaNode;
+        BANG_CHECK(!metaNode.Import(corrupted.Data(), corrupted.Size()));
+
+        corrupted = bytes;
+        const uint numChanges = 1 + rng() % 4;
+        for (uint i = 0; i < numChanges; ++i)
+        {
+            corrupted[rng() % corrupted.Size()] = SCAST<Byte>(rng());
+        }
+        MetaNodeBinaryView view =
+            MetaNodeBinaryView::FromData(corrupted.Data(), corrupted.Size());
+        if (view.IsValid())
+        {
+            MetaNode decoded;
+            view.ToMetaNode(&decoded);
+            CountNodes(view);
+        }
+    }
+}
+
+// Scenes are saved as YAML. This compares both formats on a big tree like
+// theirs, the binary one being what a Model meta is read with.
+BANG_BENCHMARK(MetaNodeBinaryLargeSceneLoad)
+{
+    uint numGameObjects = 0;
+    MetaNode sceneMeta("Scene");
+    sceneMeta.Set("GUID", "1234567 0 0");
+    sceneMeta.CreateChildrenContainer("Children");
+    for (uint i = 0; i < 4; ++i)
+    {
+        sceneMeta.AddChild(CreateSceneGameObjectMeta(&numGameObjects, 0),
+                           "Children");
+    }
+
+    const Path tempDir = BangTest::CreateTempDir();
+    const Path yamlPath = tempDir.Append("Scene.bscene");
+    const Path binaryPath = tempDir.Append("Scene.bbscene");
+
+    Time beginTime = BangTest::GetNow();
+    const String yaml = sceneMeta.ToString();
+    File::Write(yamlPath, yaml);
+    BangTest::Report(
+        "Export YAML", BangTest::GetNow() - beginTime, numGameObjects);
+
+    beginTime = BangTest::GetNow();
+    Array<Byte> bytes;
+    sceneMeta.ToBinary(&bytes);
+    File::Write(binaryPath, bytes.Data(), bytes.Size());
+    BangTest::Report(
+        "Export binary", BangTest::GetNow() - beginTime, numGameObjects);
+
+    std::cout << "    " << numGameObjects << " game objects, YAML "
+              << yaml.Size() / 1024 << " KiB, binary "
+              << bytes.Size() / 1024 << " KiB" << std::endl;
+
+    beginTime = BangTest::GetNow();
+    MetaNode fromYAML;
+    fromYAML.Import(yamlPath);
+    BangTest::Report(
+        "Load YAML", BangTest::GetNow() - beginTime, numGameObjects);
+
+    beginTime = BangTest::GetNow();
+    MetaNode fromBinary;
+    fromBinary.Import(binaryPath);
+    BangTest::Report(
+        "Load binary", BangTest::GetNow() - beginTime, numGameObjects);
+
+    // Only walking the mapped buffer, without building the MetaNode tree
+    beginTime = BangTest::GetNow();
+    MetaNodeBinaryView view =
+        MetaNodeBinaryView::FromData(bytes.Data(), bytes.Size());
+    const uint numNodes = CountNodes(view);
+    BangTest::Report(
+        "Walk binary view", BangTest::GetNow() - beginTime, numGameObjects);
+
+    BANG_CHECK(fromYAML == sceneMeta);
+    BANG_CHECK(fromBinary == sceneMeta);
+    BANG_CHECK(numNodes == 1 + numGameObjects * 3);
+
+    File::Remove(tempDir);
+}
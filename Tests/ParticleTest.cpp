@@ -0,0 +1,240 @@
+#include "Bang/Array.tcc"
+#include "Bang/Particle.h"
+#include "Bang/Time.h"
+#include "BangMath/Color.h"
+#include "BangMath/Vector3.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// Cheap, so that respawning a million particles does not dominate the steps
+class ParticleRandom
+{
+public:
+    explicit ParticleRandom(uint seed) : m_state(seed * 2654435761u + 1u)
+    {
+    }
+
+    float Range(float min, float max)
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return min + (max - min) * ((m_state & 0xFFFFFF) / 16777216.0f);
+    }
+
+    Vector3 RangeVector3(float min, float max)
+    {
+        const float x = Range(min, max);
+        const float y = Range(min, max);
+        const float z = Range(min, max);
+        return Vector3(x, y, z);
+    }
+
+private:
+    uint m_state;
+};
+
+// Some of them wait before starting. With short lives, particles die and are
+// respawned during the steps.
+Particle::Data CreateParticle(uint index, uint numSpawns, float maxLifeTime)
+{
+    ParticleRandom random(index * 7919u + numSpawns);
+    Particle::Data pData;
+    pData.position = random.RangeVector3(-10.0f, 10.0f);
+    pData.prevPosition = pData.position - random.RangeVector3(-0.1f, 0.1f);
+    pData.velocity = random.RangeVector3(-5.0f, 5.0f);
+    pData.extraForce = random.RangeVector3(-2.0f, 2.0f);
+    pData.startColor = Color(random.Range(0, 1), random.Range(0, 1), 0, 1);
+    pData.endColor = Color(0, random.Range(0, 1), random.Range(0, 1), 0);
+    pData.currentColor = pData.startColor;
+    pData.totalLifeTime = random.Range(0.05f, 1.0f) * maxLifeTime;
+    pData.remainingLifeTime = pData.totalLifeTime;
+    pData.remainingStartTime =
+        (random.Range(0, 1) < 0.25f) ? random.Range(0.0f, 0.2f) : 0.0f;
+    pData.prevDeltaTimeSecs = 1.0f / 60.0f;
+    pData.size = random.Range(0.1f, 1.0f);
+    return pData;
+}
+
+Particle::Parameters CreateParameters(Particle::PhysicsStepMode stepMode)
+{
+    Particle::Parameters params;
+    params.physicsStepMode = stepMode;
+    params.damping = 0.98f;
+    params.gravityMultiplier = 0.5f;
+    params.animationSpeed = 24.0f;
+    params.animationSheetSize = Vector2i(4, 4);
+    return params;
+}
+
+bool AreNear(float lhs, float rhs)
+{
+    return Math::Abs(lhs - rhs) <= 1e-4f * (1.0f + Math::Abs(lhs));
+}
+
+bool AreNear(const Vector3 &lhs, const Vector3 &rhs)
+{
+    return AreNear(lhs.x, rhs.x) && AreNear(lhs.y, rhs.y) &&
+           AreNear(lhs.z, rhs.z);
+}
+
+bool AreNear(const Color &lhs, const Color &rhs)
+{
+    return AreNear(lhs.r, rhs.r) && AreNear(lhs.g, rhs.g) &&
+           AreNear(lhs.b, rhs.b) && AreNear(lhs.a, rhs.a);
+}
+
+String GetStepModeName(Particle::PhysicsStepMode stepMode)
+{
+    switch (stepMode)
+    {
+        case Particle::PhysicsStepMode::EULER: return "EULER";
+        case Particle::PhysicsStepMode::EULER_SEMI: return "EULER_SEMI";
+        case Particle::PhysicsStepMode::VERLET: return "VERLET";
+    }
+    return "";
+}
+
+const Array<Particle::PhysicsStepMode> StepModes = {
+    Particle::PhysicsStepMode::EULER,
+    Particle::PhysicsStepMode::EULER_SEMI,
+    Particle::PhysicsStepMode::VERLET};
+}
+
+BANG_TEST(ParticleStreamsStepLikeParticleDatas)
+{
+    BangTestApplication::InitIfNeeded();
+    const uint numParticles = 1000;
+    const float maxLifeTime = 1.0f;
+    const Time fixedStepTime = Time::Seconds(1.0 / 60.0);
+    for (Particle::PhysicsStepMode stepMode : StepModes)
+    {
+        const Particle::Parameters params = CreateParameters(stepMode);
+        Array<Particle::Data> pDatas;
+        Particle::Streams pStreams;
+        pStreams.Resize(numParticles);
+        for (uint i = 0; i < numParticles; ++i)
+        {
+            pDatas.PushBack(CreateParticle(i, 0, maxLifeTime));
+            pStreams.Set(i, pDatas.Back());
+        }
+
+        Array<uint> dataSpawns, streamSpawns;
+        dataSpawns.Resize(numParticles, 0);
+        streamSpawns.Resize(numParticles, 0);
+        for (uint step = 0; step < 200; ++step)
+        {
+            // Sometimes several fixed steps in the same call
+            const Time deltaTime = fixedStepTime * (1 + step % 3);
+            Particle::FixedStepAll(
+                &pDatas,
+                deltaTime,
+                fixedStepTime,
+                params,
+                [&](uint i, const Particle::Parameters &) {
+                    pDatas[i] = CreateParticle(i, ++dataSpawns[i], maxLifeTime);
+                });
+            Particle::FixedStepAll(
+                &pStreams,
+                deltaTime,
+                fixedStepTime,
+                params,
+                [&](uint i, const Particle::Parameters &) {
+                    pStreams.Set(
+                        i, CreateParticle(i, ++streamSpawns[i], maxLifeTime));
+                });
+
+            BANG_CHECK_MSG(dataSpawns == streamSpawns,
+                           GetStepModeName(stepMode) << ", step " << step);
+            uint numWrong = 0;
+            for (uint i = 0; i < numParticles; ++i)
+            {
+                const Particle::Data &pData = pDatas[i];
+                const Particle::Data streamData = pStreams.Get(i);
+                const bool isRight =
+                    AreNear(pData.position, streamData.position) &&
+                    AreNear(pData.prevPosition, streamData.prevPosition) &&
+                    AreNear(pData.velocity, streamData.velocity) &&
+                    AreNear(pData.currentColor, streamData.currentColor) &&
+                    pData.remainingLifeTime == streamData.remainingLifeTime &&
+                    pData.remainingStartTime == streamData.remainingStartTime &&
+                    pData.currentFrame == streamData.currentFrame;
+                numWrong += isRight ? 0 : 1;
+            }
+            BANG_CHECK_MSG(numWrong == 0,
+                           numWrong << " particles differ, "
+                                    << GetStepModeName(stepMode) << ", step "
+                                    << step);
+        }
+    }
+}
+
+BANG_BENCHMARK(ParticleStreams1M)
+{
+    BangTestApplication::InitIfNeeded();
+    const uint numParticles = 1000000;
+    const uint numSteps = 20;
+    const Time fixedStepTime = Time::Seconds(1.0 / 60.0);
+
+    // Only stepping, and stepping with about a third of them respawned
+    for (float maxLifeTime : {100.0f, 1.0f})
+    {
+        for (Particle::PhysicsStepMode stepMode : StepModes)
+        {
+            const String name = GetStepModeName(stepMode) +
+                                (maxLifeTime < 100.0f ? ", respawning" : "");
+            const Particle::Parameters params = CreateParameters(stepMode);
+            Array<Particle::Data> pDatas;
+            Particle::Streams pStreams;
+            pDatas.Reserve(numParticles);
+            pStreams.Resize(numParticles);
+            for (uint i = 0; i < numParticles; ++i)
+            {
+                pDatas.PushBack(CreateParticle(i, 0, maxLifeTime));
+                pStreams.Set(i, pDatas.Back());
+            }
+
+            Array<uint> numSpawns;
+            numSpawns.Resize(numParticles, 0);
+            Time beginTime = BangTest::GetNow();
+            for (uint step = 0; step < numSteps; ++step)
+            {
+                Particle::FixedStepAll(
+                    &pDatas,
+                    fixedStepTime,
+                    fixedStepTime,
+                    params,
+                    [&](uint i, const Particle::Parameters &) {
+                        pDatas[i] =
+                            CreateParticle(i, ++numSpawns[i], maxLifeTime);
+                    });
+            }
+            BangTest::Report("Particle::Data, " + name,
+                             BangTest::GetNow() - beginTime,
+                             numParticles * numSteps);
+
+            numSpawns.Clear();
+            numSpawns.Resize(numParticles, 0);
+            beginTime = BangTest::GetNow();
+            for (uint step = 0; step < numSteps; ++step)
+            {
+                Particle::FixedStepAll(
+                    &pStreams,
+                    fixedStepTime,
+                    fixedStepTime,
+                    params,
+                    [&](uint i, const Particle::Parameters &) {
+                        pStreams.Set(
+                            i, CreateParticle(i, ++numSpawns[i], maxLifeTime));
+                    });
+            }
+            BangTest::Report("Particle::Streams, " + name,
+                             BangTest::GetNow() - beginTime,
+                             numParticles * numSteps);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#include "Bang/Animator.h"
+#include "Bang/Array.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/MetaNode.h"
+#include "Bang/PrefabTemplate.h"
+#include "Bang/Transform.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Vector3.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// A transform, imported through the compiled field assignments, and an
+// animator, whose own ImportMeta has to be called
+GameObject *CreateGameObject(uint depth)
+{
+    GameObject *go = new GameObject();
+    go->SetName("GameObject" + String::ToString(depth));
+
+    Transform *transform = go->AddComponent<Transform>();
+    transform->SetLocalPosition(Vector3(1.5f, -2.0f, depth * 3.0f));
+    transform->SetLocalRotation(
+        Quaternion::AngleAxis(0.5f * (depth + 1), Vector3::Up()));
+    transform->SetLocalScale(Vector3(2.0f, 1.0f, 0.5f));
+
+    Animator *animator = go->AddComponent<Animator>();
+    animator->SetPlayOnStart(depth % 2 == 0);
+    animator->SetEnabled(depth % 2 == 1);
+
+    if (depth < 2)
+    {
+        for (uint i = 0; i < 2; ++i)
+        {
+            CreateGameObject(depth + 1)->SetParent(go);
+        }
+    }
+    return go;
+}
+}
+
+BANG_TEST(PrefabTemplateInstantiatesLikeImportMeta)
+{
+    BangTestApplication::InitIfNeeded();
+    GameObject *go = CreateGameObject(0);
+    const MetaNode metaNode = go->GetMeta();
+    const String metaString = metaNode.ToString();
+
+    PrefabTemplate prefabTemplate(metaNode);
+    Array<GameObject *> instances;
+    instances.PushBack(prefabTemplate.Instantiate());
+    prefabTemplate.Instantiate(3, &instances);
+    BANG_CHECK(instances.Size() == 4);
+
+    // The first instance compiles the assignments, the rest reuse them
+    for (uint i = 0; i < instances.Size(); ++i)
+    {
+        GameObject *instance = instances[i];
+        BANG_CHECK_MSG(instance->GetMeta().ToString() == metaString,
+                       "instance " << i);
+
+        const Transform *transform = instance->GetComponent<Transform>();
+        BANG_CHECK(transform && transform->GetLocalPosition() ==
+                                    go->GetTransform()->GetLocalPosition());
+        const Animator *animator = instance->GetComponent<Animator>();
+        BANG_CHECK(animator && animator->GetPlayOnStart() &&
+                   !animator->IsEnabled());
+        BANG_CHECK(instance->GetChildren().Size() == 2);
+    }
+
+    for (GameObject *instance : instances)
+    {
+        GameObject::DestroyImmediate(instance);
+    }
+    GameObject::DestroyImmediate(go);
+}
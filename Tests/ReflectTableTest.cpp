@@ -0,0 +1,400 @@
+#include <random>
+
+#include "Bang/Array.tcc"
+#include "Bang/MetaNode.h"
+#include "Bang/MetaNode.tcc"
+#include "Bang/ReflectStruct.h"
+#include "Bang/ReflectTable.h"
+#include "Bang/Serializable.h"
+#include "Bang/Variant.h"
+#include "BangMath/Color.h"
+#include "BangMath/Vector3.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+enum class ThingShape
+{
+    BOX,
+    SPHERE,
+    CAPSULE
+};
+
+// Reflected in all the ways components reflect their variables: members,
+// captureless accessors, an enum, a variable bound to the instance (which
+// has no accessor) and a button
+class ReflectedThing : public Serializable
+{
+    SERIALIZABLE(ReflectedThing)
+
+public:
+    ReflectedThing() = default;
+
+    void SetIntensity(float intensity)
+    {
+        m_intensity = intensity;
+    }
+    void SetCount(int count)
+    {
+        m_count = count;
+    }
+    void SetLayers(uint layers)
+    {
+        m_layers = layers;
+    }
+    void SetEnabled(bool enabled)
+    {
+        m_enabled = enabled;
+    }
+    void SetLabel(const String &label)
+    {
+        m_label = label;
+    }
+    void SetOffset(const Vector3 &offset)
+    {
+        m_offset = offset;
+    }
+    void SetTint(const Color &tint)
+    {
+        m_tint = tint;
+    }
+    void SetShape(ThingShape shape)
+    {
+        m_shape = shape;
+    }
+    void SetScale(float scale)
+    {
+        m_scale = scale;
+    }
+    void SetMass(float mass)
+    {
+        m_mass = mass;
+    }
+
+    float GetIntensity() const
+    {
+        return m_intensity;
+    }
+    int GetCount() const
+    {
+        return m_count;
+    }
+    uint GetLayers() const
+    {
+        return m_layers;
+    }
+    bool GetEnabled() const
+    {
+        return m_enabled;
+    }
+    const String &GetLabel() const
+    {
+        return m_label;
+    }
+    const Vector3 &GetOffset() const
+    {
+        return m_offset;
+    }
+    const Color &GetTint() const
+    {
+        return m_tint;
+    }
+    ThingShape GetShape() const
+    {
+        return m_shape;
+    }
+    float GetScale() const
+    {
+        return m_scale;
+    }
+    float GetMass() const
+    {
+        return m_mass;
+    }
+    uint GetNumResets() const
+    {
+        return m_numResets;
+    }
+
+    bool HasSameValues(const ReflectedThing &rhs) const
+    {
+        return GetIntensity() == rhs.GetIntensity() &&
+               GetCount() == rhs.GetCount() &&
+               GetLayers() == rhs.GetLayers() &&
+               GetEnabled() == rhs.GetEnabled() &&
+               GetLabel() == rhs.GetLabel() &&
+               GetOffset() == rhs.GetOffset() && GetTint() == rhs.GetTint() &&
+               GetShape() == rhs.GetShape() && GetScale() == rhs.GetScale() &&
+               GetMass() == rhs.GetMass();
+    }
+
+protected:
+    void Reflect() override
+    {
+        Serializable::Reflect();
+
+        BANG_REFLECT_VAR_MEMBER(
+            ReflectedThing, "Intensity", SetIntensity, GetIntensity);
+        BANG_REFLECT_VAR_MEMBER(ReflectedThing, "Count", SetCount, GetCount);
+        BANG_REFLECT_VAR_MEMBER(
+            ReflectedThing, "Layers", SetLayers, GetLayers);
+        BANG_REFLECT_VAR_MEMBER(
+            ReflectedThing, "Enabled", SetEnabled, GetEnabled);
+        BANG_REFLECT_VAR_MEMBER(ReflectedThing, "Label", SetLabel, GetLabel);
+        BANG_REFLECT_VAR_MEMBER(
+            ReflectedThing, "Offset", SetOffset, GetOffset);
+        BANG_REFLECT_VAR_MEMBER(ReflectedThing, "Tint", SetTint, GetTint);
+        BANG_REFLECT_VAR_ENUM("Shape", SetShape, GetShape, ThingShape);
+
+        ReflectVar<ReflectedThing, float>(
+            "Scale",
+            [](ReflectedThing *t, float s) { t->SetScale(s); },
+            [](const ReflectedThing *t) { return t->GetScale(); });
+
+        ReflectVar<float>("Mass",
+                          [this](float mass) { SetMass(mass); },
+                          [this]() { return GetMass(); });
+
+        BANG_REFLECT_BUTTON(ReflectedThing, "Reset", [this]() {
+            ++m_numResets;
+        });
+    }
+
+private:
+    float m_intensity = 1.0f;
+    int m_count = 0;
+    uint m_layers = 1;
+    bool m_enabled = true;
+    String m_label = "";
+    Vector3 m_offset = Vector3::Zero();
+    Color m_tint = Color::White();
+    ThingShape m_shape = ThingShape::BOX;
+    float m_scale = 1.0f;
+    float m_mass = 1.0f;
+    uint m_numResets = 0;
+};
+
+// Meta of a thing with random values, as they are in the scene files
+MetaNode CreateRandomMeta(std::mt19937 *rng)
+{
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    ReflectedThing thing;
+    thing.SetIntensity(dist(*rng));
+    thing.SetCount(SCAST<int>(dist(*rng)));
+    thing.SetLayers((*rng)() % 256);
+    thing.SetEnabled((*rng)() % 2 == 0);
+    thing.SetLabel("Thing" + String::ToString(SCAST<int>((*rng)() % 1000)));
+    thing.SetOffset(Vector3(dist(*rng), dist(*rng), dist(*rng)));
+    thing.SetTint(Color(dist(*rng), dist(*rng), dist(*rng), 1.0f));
+    thing.SetShape(SCAST<ThingShape>((*rng)() % 3));
+    thing.SetScale(dist(*rng));
+    thing.SetMass(dist(*rng));
+    return thing.GetMeta();
+}
+
+// How Serializable::ImportMeta used to import, through the ReflectStruct
+// reflected again for each object and the values boxed in Variants
+void ImportMetaThroughReflectStruct(Serializable *serializable,
+                                    const MetaNode &metaNode)
+{
+    const ReflectStruct &reflStruct = serializable->GetReflectStruct();
+    for (const ReflectVariable &reflVar : reflStruct.GetVariables())
+    {
+        const String &varName = reflVar.GetName();
+        if (!metaNode.Contains(varName) || !reflVar.GetSetter() ||
+            reflVar.GetHints().GetIsButton())
+        {
+            continue;
+        }
+
+        Variant variant;
+        switch (reflVar.GetVariant().GetType())
+        {
+            case Variant::Type::FLOAT:
+                variant = Variant::FromFloat(metaNode.Get<float>(varName));
+                break;
+            case Variant::Type::INT:
+                variant = Variant::FromInt(metaNode.Get<int>(varName));
+                break;
+            case Variant::Type::UINT:
+                variant = Variant::FromUint(metaNode.Get<uint>(varName));
+                break;
+            case Variant::Type::BOOL:
+                variant = Variant::FromBool(metaNode.Get<bool>(varName));
+                break;
+            case Variant::Type::STRING:
+                variant = Variant::FromString(metaNode.Get<String>(varName));
+                break;
+            case Variant::Type::COLOR:
+                variant = Variant::FromColor(metaNode.Get<Color>(varName));
+                break;
+            case Variant::Type::VECTOR3:
+                variant = Variant::FromVector3(metaNode.Get<Vector3>(varName));
+                break;
+            default: break;
+        }
+        reflVar.GetSetter()(variant);
+    }
+}
+
+// How Serializable::ExportMeta used to export, without the buttons
+MetaNode ExportMetaThroughReflectStruct(const Serializable *serializable)
+{
+    MetaNode metaNode;
+    metaNode.Set<GUID>("GUID", serializable->GetGUID());
+    metaNode.Import(serializable->GetReflectStruct().GetMeta());
+    metaNode.RemoveAttribute("Reset");
+    metaNode.SetName(serializable->GetClassName());
+    return metaNode;
+}
+}
+
+BANG_TEST(ReflectTableSharedByInstances)
+{
+    BangTestApplication::InitIfNeeded();
+    ReflectedThing thing, otherThing;
+    const ReflectTable &reflTable = thing.GetReflectTable();
+    BANG_CHECK(&otherThing.GetReflectTable() == &reflTable);
+
+    // Same variables as the ReflectStruct, and all but the one bound to the
+    // instance and the button get an accessor
+    const Array<ReflectVariable> &reflStructVars =
+        thing.GetReflectStruct().GetVariables();
+    BANG_CHECK(reflTable.GetVariables().Size() == reflStructVars.Size());
+    for (uint i = 0; i < reflTable.GetVariables().Size(); ++i)
+    {
+        const ReflectVariable &reflVar = reflTable.GetVariables()[i];
+        const bool hasAccessor =
+            (reflVar.GetName() != "Mass" && reflVar.GetName() != "Reset");
+        BANG_CHECK_MSG(reflVar.GetName() == reflStructVars[i].GetName(),
+                       "variable " << i);
+        BANG_CHECK_MSG((reflVar.GetAccessor() != nullptr) == hasAccessor,
+                       reflVar.GetName());
+        BANG_CHECK(!reflVar.GetSetter() && !reflVar.GetGetter());
+    }
+}
+
+BANG_TEST(ReflectTableImportsAndExportsLikeReflectStruct)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(4242);
+    for (uint i = 0; i < 500; ++i)
+    {
+        const MetaNode metaNode = CreateRandomMeta(&rng);
+        ReflectedThing thing, referenceThing;
+        thing.ImportMeta(metaNode);
+        ImportMetaThroughReflectStruct(&referenceThing, metaNode);
+        BANG_CHECK_MSG(thing.HasSameValues(referenceThing), "meta " << i);
+        BANG_CHECK(thing.GetGUID() == metaNode.Get<GUID>("GUID"));
+
+        // Same text, so the files written before and after are the same
+        MetaNode exportedMeta;
+        thing.ExportMeta(&exportedMeta);
+        BANG_CHECK_MSG(exportedMeta.ToString() ==
+                           ExportMetaThroughReflectStruct(&thing).ToString(),
+                       "meta " << i);
+        BANG_CHECK(!exportedMeta.Contains("Reset"));
+
+        ReflectedThing *clone = thing.Clone(false);
+        BANG_CHECK_MSG(clone->HasSameValues(thing), "meta " << i);
+        BANG_CHECK(clone->GetGUID() != thing.GetGUID());
+        BANG_CHECK(clone->GetNumResets() == 0);
+        delete clone;
+    }
+}
+
+BANG_TEST(ReflectTableCompiledImportLikeImportMeta)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(5151);
+    for (uint i = 0; i < 200; ++i)
+    {
+        MetaNode metaNode = CreateRandomMeta(&rng);
+        if (i % 2 == 1)
+        {
+            metaNode.RemoveAttribute("Intensity");
+            metaNode.RemoveAttribute("Mass");
+        }
+
+        ReflectedThing referenceThing;
+        referenceThing.ImportMeta(metaNode);
+
+        // Compiled from any instance, applied to as many as wanted
+        Array<ReflectImportOp> importOps;
+        ReflectedThing().CompileImportMeta(metaNode, &importOps);
+        for (uint j = 0; j < 2; ++j)
+        {
+            ReflectedThing thing;
+            for (const ReflectImportOp &importOp : importOps)
+            {
+                importOp(&thing);
+            }
+            BANG_CHECK_MSG(thing.HasSameValues(referenceThing), "meta " << i);
+            BANG_CHECK(thing.GetGUID() == referenceThing.GetGUID());
+            BANG_CHECK(thing.GetNumResets() == 0);
+        }
+    }
+}
+
+BANG_BENCHMARK(ReflectTableImport100k)
+{
+    BangTestApplication::InitIfNeeded();
+    const uint numObjects = 100000;
+    std::mt19937 rng(777);
+    Array<MetaNode> metaNodes;
+    metaNodes.Reserve(numObjects);
+    for (uint i = 0; i < numObjects; ++i)
+    {
+        metaNodes.PushBack(CreateRandomMeta(&rng));
+    }
+
+    Array<ReflectedThing *> things;
+    for (uint i = 0; i < numObjects; ++i)
+    {
+        things.PushBack(new ReflectedThing());
+    }
+
+    Time beginTime = BangTest::GetNow();
+    for (uint i = 0; i < numObjects; ++i)
+    {
+        ImportMetaThroughReflectStruct(things[i], metaNodes[i]);
+    }
+    BangTest::Report("Import through ReflectStruct",
+                     BangTest::GetNow() - beginTime,
+                     numObjects);
+
+    beginTime = BangTest::GetNow();
+    for (uint i = 0; i < numObjects; ++i)
+    {
+        things[i]->ImportMeta(metaNodes[i]);
+    }
+    BangTest::Report("Import through ReflectTable",
+                     BangTest::GetNow() - beginTime,
+                     numObjects);
+
+    beginTime = BangTest::GetNow();
+    for (uint i = 0; i < numObjects; ++i)
+    {
+        metaNodes[i] = ExportMetaThroughReflectStruct(things[i]);
+    }
+    BangTest::Report("Export through ReflectStruct",
+                     BangTest::GetNow() - beginTime,
+                     numObjects);
+
+    beginTime = BangTest::GetNow();
+    for (uint i = 0; i < numObjects; ++i)
+    {
+        metaNodes[i] = things[i]->GetMeta();
+    }
+    BangTest::Report("Export through ReflectTable",
+                     BangTest::GetNow() - beginTime,
+                     numObjects);
+
+    for (ReflectedThing *thing : things)
+    {
+        delete thing;
+    }
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <random>
+
+#include "Bang/Array.tcc"
+#include "Bang/RenderPass.h"
+#include "Bang/RenderQueue.h"
+#include "BangTest.h"
+
+using namespace Bang;
+
+namespace
+{
+// The queue only compares these pointers, so they do not need to point to
+// real objects, which would need a GL context
+template <class T>
+T *FakePointer(uint id)
+{
+    static Array<Byte> fakeObjects(1024);
+    return RCAST<T *>(&fakeObjects[id]);
+}
+
+// The index of the item in the order it was added, in the renderer pointer
+uint GetAddIndex(const RenderQueueItem &item)
+{
+    return SCAST<uint>(RCAST<Byte *>(item.renderer) -
+                       RCAST<Byte *>(FakePointer<Renderer>(0)));
+}
+
+void AddRandomItems(RenderQueue *renderQueue, uint numItems, uint seed)
+{
+    std::mt19937 rng(seed);
+    const Array<RenderPass> renderPasses = {RenderPass::SCENE_OPAQUE,
+                                            RenderPass::SCENE_TRANSPARENT,
+                                            RenderPass::OVERLAY};
+    for (uint i = 0; i < numItems; ++i)
+    {
+        renderQueue->Add(renderPasses[rng() % renderPasses.Size()],
+                         FakePointer<Renderer>(i),
+                         FakePointer<ShaderProgram>(rng() % 3),
+                         FakePointer<Material>(rng() % 6),
+                         FakePointer<Mesh>(rng() % 4),
+                         Matrix4::Identity(),
+                         (rng() % 5 != 0));
+    }
+}
+}
+
+BANG_TEST(RenderQueueSortKeysOrderByPassShaderMaterialAndMesh)
+{
+    const uint64_t key = RenderQueue::BuildSortKey(1, 1, 1, 1);
+    BANG_CHECK(RenderQueue::BuildSortKey(2, 0, 0, 0) > key);
+    BANG_CHECK(RenderQueue::BuildSortKey(1, 2, 0, 0) > key);
+    BANG_CHECK(RenderQueue::BuildSortKey(1, 1, 2, 0) > key);
+    BANG_CHECK(RenderQueue::BuildSortKey(1, 1, 1, 2) > key);
+    BANG_CHECK(RenderQueue::BuildSortKey(1, 1, 1, 0) < key);
+
+    // Each id stays in its bits
+    BANG_CHECK(RenderQueue::BuildSortKey(0, 0, 0, 0xFFFFF) <
+               RenderQueue::BuildSortKey(0, 0, 1, 0));
+    BANG_CHECK(RenderQueue::BuildSortKey(0, 0, 0xFFFFF, 0xFFFFF) <
+               RenderQueue::BuildSortKey(0, 1, 0, 0));
+    BANG_CHECK(RenderQueue::BuildSortKey(0, 0xFFFF, 0xFFFFF, 0xFFFFF) <
+               RenderQueue::BuildSortKey(1, 0, 0, 0));
+}
+
+BANG_TEST(RenderQueueRadixSortIsAStableSort)
+{
+    std::mt19937 rng(99);
+    for (uint numItems : {0u, 1u, 2u, 17u, 1000u})
+    {
+        Array<RenderQueueItem> items;
+        for (uint i = 0; i < numItems; ++i)
+        {
+            RenderQueueItem item;
+            item.renderer = FakePointer<Renderer>(i);
+
+            // Few different keys, spread over all the digits
+            item.sortKey = RenderQueue::BuildSortKey(
+                rng() % 3, rng() % 3, rng() % 300, rng() % 5);
+            items.PushBack(item);
+        }
+
+        Array<RenderQueueItem> expectedItems = items;
+        std::stable_sort(
+            expectedItems.Begin(),
+            expectedItems.End(),
+            [](const RenderQueueItem &lhs, const RenderQueueItem &rhs) {
+                return lhs.sortKey < rhs.sortKey;
+            });
+
+        RenderQueue::RadixSort(&items);
+        BANG_CHECK(items.Size() == numItems);
+        for (uint i = 0; i < numItems; ++i)
+        {
+            BANG_CHECK_MSG(items[i].sortKey == expectedItems[i].sortKey &&
+                               items[i].renderer == expectedItems[i].renderer,
+                           "item " << i << " of " << numItems);
+        }
+    }
+}
+
+BANG_TEST(RenderQueueBatchesConsecutiveInstanceableItems)
+{
+    for (uint minInstancesPerBatch : {2u, 3u, 8u})
+    {
+        RenderQueue renderQueue;
+        const uint numItems = 500;
+        AddRandomItems(&renderQueue, numItems, 7 + minInstancesPerBatch);
+        renderQueue.Prepare(minInstancesPerBatch);
+
+        const Array<RenderQueueItem> &items = renderQueue.GetItems();
+        const Array<RenderQueueBatch> &batches = renderQueue.GetBatches();
+        BANG_CHECK(items.Size() == numItems);
+
+        // Sorted, with every item added once
+        Array<bool> found(numItems, false);
+        for (uint i = 0; i < items.Size(); ++i)
+        {
+            BANG_CHECK(i == 0 || items[i - 1].sortKey <= items[i].sortKey);
+            BANG_CHECK(!found[GetAddIndex(items[i])]);
+            found[GetAddIndex(items[i])] = true;
+        }
+
+        // The batches cover all the items in order, and the instanced ones
+        // only have instanceable items with the same state
+        uint nextItemIndex = 0, numInstancedItems = 0;
+        uint numInstancedBatches = 0;
+        for (const RenderQueueBatch &batch : batches)
+        {
+            BANG_CHECK(batch.firstItemIndex == nextItemIndex);
+            BANG_CHECK(batch.numItems >= 1);
+            nextItemIndex += batch.numItems;
+            if (!batch.instanced)
+            {
+                BANG_CHECK(batch.numItems == 1);
+                continue;
+            }
+
+            ++numInstancedBatches;
+            numInstancedItems += batch.numItems;
+            BANG_CHECK(batch.numItems >= minInstancesPerBatch);
+            const RenderQueueItem &firstItem = items[batch.firstItemIndex];
+            for (uint i = 0; i < batch.numItems; ++i)
+            {
+                const RenderQueueItem &item = items[batch.firstItemIndex + i];
+                BANG_CHECK(item.instanceable);
+                BANG_CHECK(item.sortKey == firstItem.sortKey);
+                BANG_CHECK(item.shaderProgram == firstItem.shaderProgram &&
+                           item.material == firstItem.material &&
+                           item.mesh == firstItem.mesh);
+            }
+        }
+        BANG_CHECK(nextItemIndex == numItems);
+
+        // Runs long enough are never left as single draws
+        for (uint i = 0; i < batches.Size(); ++i)
+        {
+            const RenderQueueBatch &batch = batches[i];
+            if (batch.instanced || !items[batch.firstItemIndex].instanceable)
+            {
+                continue;
+            }
+
+            uint runLength = 1;
+            for (uint j = i + 1; j < batches.Size(); ++j)
+            {
+                const RenderQueueItem &item =
+                    items[batches[j].firstItemIndex];
+                if (batches[j].instanced || !item.instanceable ||
+                    item.sortKey != items[batch.firstItemIndex].sortKey)
+                {
+                    break;
+                }
+                ++runLength;
+            }
+            BANG_CHECK_MSG(runLength < minInstancesPerBatch, "batch " << i);
+        }
+
+        const RenderQueueStats &stats = renderQueue.GetStats();
+        BANG_CHECK(stats.numItems == numItems);
+        BANG_CHECK(stats.numDrawCalls == batches.Size());
+        BANG_CHECK(stats.numInstancedDrawCalls == numInstancedBatches);
+        BANG_CHECK(stats.numInstancedItems == numInstancedItems);
+        BANG_CHECK(minInstancesPerBatch > 2 || numInstancedBatches > 0);
+
+        // At most one change of each per different value in each pass
+        BANG_CHECK(stats.numShaderProgramChanges <= 3 * 3);
+        BANG_CHECK(stats.numMaterialChanges <= 3 * 3 * 6);
+        BANG_CHECK(stats.numMeshChanges <= 3 * 3 * 6 * 4);
+    }
+}
+
+BANG_TEST(RenderQueueClearsEverything)
+{
+    RenderQueue renderQueue;
+    AddRandomItems(&renderQueue, 100, 5);
+    renderQueue.Prepare();
+    BANG_CHECK(!renderQueue.GetBatches().IsEmpty());
+
+    renderQueue.Clear();
+    BANG_CHECK(renderQueue.GetItems().IsEmpty());
+    BANG_CHECK(renderQueue.GetBatches().IsEmpty());
+    BANG_CHECK(renderQueue.GetStats().numDrawCalls == 0);
+
+    // The ids start again, so the keys are the same as the first time
+    AddRandomItems(&renderQueue, 100, 5);
+    RenderQueue otherRenderQueue;
+    AddRandomItems(&otherRenderQueue, 100, 5);
+    for (uint i = 0; i < 100; ++i)
+    {
+        BANG_CHECK(renderQueue.GetItems()[i].sortKey ==
+                   otherRenderQueue.GetItems()[i].sortKey);
+    }
+}
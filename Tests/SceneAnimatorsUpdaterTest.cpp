@@ -0,0 +1,256 @@
+#include <random>
+
+#include "Bang/Animation.h"
+#include "Bang/AnimationSampler.h"
+#include "Bang/Animator.h"
+#include "Bang/AnimatorStateMachine.h"
+#include "Bang/AnimatorStateMachineBlendTreeNode.h"
+#include "Bang/AnimatorStateMachineLayer.h"
+#include "Bang/AnimatorStateMachineNode.h"
+#include "Bang/AnimatorStateMachineTransition.h"
+#include "Bang/Array.tcc"
+#include "Bang/AssetHandle.h"
+#include "Bang/Assets.h"
+#include "Bang/Assets.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/JobSystem.h"
+#include "Bang/SceneAnimatorsUpdater.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Transformation.h"
+#include "BangMath/Vector3.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// Animation of one second over some bones of a 40 bone skeleton, with a
+// keyframe every few frames
+AH<Animation> CreateRandomAnimation(std::mt19937 *rng,
+                                    uint firstBone,
+                                    uint numBones)
+{
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    AH<Animation> animationAH = Assets::Create<Animation>();
+    Animation *animation = animationAH.Get();
+    animation->SetDurationInFrames(30.0f);
+    animation->SetFramesPerSecond(30.0f);
+    for (uint i = firstBone; i < firstBone + numBones; ++i)
+    {
+        const String boneName = "Bone" + String::ToString(i % 40);
+        for (uint frame = 0; frame <= 30; frame += 3)
+        {
+            const float time = SCAST<float>(frame);
+            const Vector3 v(dist(*rng), dist(*rng), dist(*rng));
+            animation->AddPositionKeyFrame(boneName, {time, v});
+            animation->AddRotationKeyFrame(
+                boneName,
+                {time, Quaternion::AngleAxis(dist(*rng), v.NormalizedSafe())});
+            animation->AddScaleKeyFrame(boneName,
+                                        {time, Vector3::One() + v * 0.25f});
+        }
+    }
+    return animationAH;
+}
+
+// Two layers. The first one goes from a simple node to a blend tree and
+// back, cross fading once each animation finishes. The second one plays a
+// single animation over part of the bones.
+AH<AnimatorStateMachine> CreateStateMachine(
+    const Array<AH<Animation>> &animationAHs)
+{
+    AH<AnimatorStateMachine> stateMachineAH =
+        Assets::Create<AnimatorStateMachine>();
+    AnimatorStateMachine *stateMachine = stateMachineAH.Get();
+
+    AnimatorStateMachineLayer *baseLayer = stateMachine->CreateNewLayer();
+    AnimatorStateMachineNode *simpleNode = new AnimatorStateMachineNode();
+    simpleNode->SetAnimation(animationAHs[0].Get());
+    AnimatorStateMachineBlendTreeNode *blendNode =
+        new AnimatorStateMachineBlendTreeNode();
+    blendNode->SetAnimation(animationAHs[1].Get());
+    blendNode->SetSecondAnimation(animationAHs[2].Get());
+    blendNode->SetSecondAnimationSpeed(1.5f);
+    blendNode->SetBlendVariableName("Blend");
+    blendNode->SetSpeed(0.75f);
+    baseLayer->AddNode(simpleNode);
+    baseLayer->AddNode(blendNode);
+    baseLayer->SetEntryNode(simpleNode);
+    for (AnimatorStateMachineTransition *transition :
+         {simpleNode->CreateTransitionTo(blendNode),
+          blendNode->CreateTransitionTo(simpleNode)})
+    {
+        transition->SetTransitionDuration(Time::Seconds(0.25));
+        transition->SetWaitForAnimationToFinish(true);
+    }
+
+    AnimatorStateMachineLayer *upperLayer = stateMachine->CreateNewLayer();
+    AnimatorStateMachineNode *upperNode = new AnimatorStateMachineNode();
+    upperNode->SetAnimation(animationAHs[3].Get());
+    upperNode->SetSpeed(1.25f);
+    upperLayer->AddNode(upperNode);
+    return stateMachineAH;
+}
+
+Array<AH<Animation>> CreateAnimations(std::mt19937 *rng)
+{
+    return {CreateRandomAnimation(rng, 0, 40),
+            CreateRandomAnimation(rng, 0, 40),
+            CreateRandomAnimation(rng, 5, 30),
+            CreateRandomAnimation(rng, 20, 10)};
+}
+
+// Each with its own blend, and starting to play at its own frame
+Array<Animator *> CreateAnimators(GameObject *root,
+                                  AnimatorStateMachine *stateMachine,
+                                  uint numAnimators)
+{
+    Array<Animator *> animators;
+    for (uint i = 0; i < numAnimators; ++i)
+    {
+        GameObject *go = new GameObject("Character" + String::ToString(i));
+        go->SetParent(root);
+        Animator *animator = go->AddComponent<Animator>();
+        animator->SetPlayOnStart(false);
+        animator->SetStateMachine(stateMachine);
+        animator->SetVariableFloat("Blend", (i % 11) / 10.0f);
+        animators.PushBack(animator);
+    }
+    root->Start();
+    return animators;
+}
+
+bool ArePosesEqual(const Animator *lhs, const Animator *rhs)
+{
+    const AnimationPose &lhsPose = lhs->GetPose();
+    const AnimationPose &rhsPose = rhs->GetPose();
+    if (!(lhs->GetSkeleton().GetBoneNames() ==
+          rhs->GetSkeleton().GetBoneNames()) ||
+        !(lhsPose.animatedBones == rhsPose.animatedBones))
+    {
+        return false;
+    }
+
+    for (uint i = 0; i < lhsPose.GetNumBones(); ++i)
+    {
+        if (lhsPose.IsBoneAnimated(i))
+        {
+            const Transformation &lhsTr = lhsPose.boneTransformations[i];
+            const Transformation &rhsTr = rhsPose.boneTransformations[i];
+            if (lhsTr.GetPosition() != rhsTr.GetPosition() ||
+                lhsTr.GetRotation() != rhsTr.GetRotation() ||
+                lhsTr.GetScale() != rhsTr.GetScale())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+}
+
+BANG_TEST(SceneAnimatorsParallelPosesMatchSerialPoses)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(112358);
+    const Array<AH<Animation>> animationAHs = CreateAnimations(&rng);
+    AH<AnimatorStateMachine> stateMachineAH = CreateStateMachine(animationAHs);
+
+    // Two equal crowds, one evaluated in the main thread, the other one in
+    // the workers
+    const uint numAnimators = 64;
+    GameObject *serialRoot = new GameObject("SerialRoot");
+    GameObject *parallelRoot = new GameObject("ParallelRoot");
+    const Array<Animator *> serialAnimators =
+        CreateAnimators(serialRoot, stateMachineAH.Get(), numAnimators);
+    const Array<Animator *> parallelAnimators =
+        CreateAnimators(parallelRoot, stateMachineAH.Get(), numAnimators);
+
+    SceneAnimatorsUpdater serialUpdater, parallelUpdater;
+    serialUpdater.SetRoot(serialRoot);
+    serialUpdater.SetParallelEvaluation(false);
+    parallelUpdater.SetRoot(parallelRoot);
+
+    // Not playing yet, this only sets the same previous frame time to all
+    const Time beginTime = Time::GetNow();
+    serialUpdater.UpdateAnimators(beginTime);
+    parallelUpdater.UpdateAnimators(beginTime);
+
+    const Time frameTime = Time::Seconds(1.0 / 60.0);
+    for (uint frame = 0; frame < 300; ++frame)
+    {
+        for (uint i = 0; i < numAnimators; ++i)
+        {
+            if (frame == i % 16)
+            {
+                serialAnimators[i]->Play();
+                parallelAnimators[i]->Play();
+            }
+        }
+
+        const Time now = beginTime + frameTime * (frame + 1);
+        serialUpdater.UpdateAnimators(now);
+        parallelUpdater.UpdateAnimators(now);
+        BANG_CHECK(parallelUpdater.GetLastUpdatedAnimators().Size() ==
+                   numAnimators);
+        for (uint i = 0; i < numAnimators; ++i)
+        {
+            BANG_CHECK_MSG(
+                ArePosesEqual(serialAnimators[i], parallelAnimators[i]),
+                "frame " << frame << ", animator " << i);
+        }
+    }
+    BANG_CHECK(serialAnimators.Back()->GetSkeleton().GetNumBones() == 40);
+
+    serialUpdater.SetRoot(nullptr);
+    parallelUpdater.SetRoot(nullptr);
+    GameObject::DestroyImmediate(serialRoot);
+    GameObject::DestroyImmediate(parallelRoot);
+}
+
+BANG_BENCHMARK(SceneAnimators1000)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(132134);
+    const Array<AH<Animation>> animationAHs = CreateAnimations(&rng);
+    AH<AnimatorStateMachine> stateMachineAH = CreateStateMachine(animationAHs);
+
+    const uint numAnimators = 1000;
+    const uint numFrames = 200;
+    GameObject *root = new GameObject("Root");
+    const Array<Animator *> animators =
+        CreateAnimators(root, stateMachineAH.Get(), numAnimators);
+    for (Animator *animator : animators)
+    {
+        animator->Play();
+    }
+
+    SceneAnimatorsUpdater updater;
+    updater.SetRoot(root);
+    const Time frameTime = Time::Seconds(1.0 / 60.0);
+    Time now = Time::GetNow();
+    for (bool parallelEvaluation : {false, true})
+    {
+        updater.SetParallelEvaluation(parallelEvaluation);
+        const Time beginTime = BangTest::GetNow();
+        for (uint frame = 0; frame < numFrames; ++frame)
+        {
+            now += frameTime;
+            updater.UpdateAnimators(now);
+        }
+
+        const uint numThreads =
+            parallelEvaluation
+                ? (JobSystem::GetInstance()->GetNumWorkers() + 1)
+                : 1;
+        BangTest::Report("Animator frames, " + String::ToString(numThreads) +
+                             " threads",
+                         BangTest::GetNow() - beginTime,
+                         numAnimators * numFrames);
+    }
+
+    updater.SetRoot(nullptr);
+    GameObject::DestroyImmediate(root);
+}
@@ -0,0 +1,211 @@
+#include <random>
+
+#include "Bang/Array.tcc"
+#include "Bang/Component.h"
+#include "Bang/ComponentMacros.h"
+#include "Bang/GUID.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/SceneObjectIndex.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// Component's constructor is protected
+class IndexedComponent : public Component
+{
+    COMPONENT_WITHOUT_CLASS_ID(IndexedComponent)
+
+public:
+    IndexedComponent() = default;
+};
+
+// Few names, so that many game objects share them
+const Array<String> Names = {"A", "B", "C", "D", "E"};
+
+GameObject *FindByNameWalking(GameObject *go, const String &name)
+{
+    if (go->GetName() == name)
+    {
+        return go;
+    }
+    for (GameObject *child : go->GetChildren())
+    {
+        if (child)
+        {
+            if (GameObject *found = FindByNameWalking(child, name))
+            {
+                return found;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void RemoveWithDescendants(GameObject *go, Array<GameObject *> *gos)
+{
+    for (GameObject *child : go->GetChildren())
+    {
+        if (child)
+        {
+            RemoveWithDescendants(child, gos);
+        }
+    }
+    gos->Remove(go);
+}
+
+bool IsInSubtree(const GameObject *go, const GameObject *subtreeRoot)
+{
+    for (; go; go = go->GetParent())
+    {
+        if (go == subtreeRoot)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+BANG_TEST(SceneObjectIndexRandomMutations)
+{
+    std::mt19937 rng(1234);
+    auto RandomIndex = [&rng](uint size) {
+        return std::uniform_int_distribution<uint>(0, size - 1)(rng);
+    };
+
+    BangTestApplication::InitIfNeeded();
+    GameObject *root = new GameObject("Root");
+    SceneObjectIndex index;
+    index.SetRoot(root);
+
+    Array<GameObject *> gos = {root};
+    Array<Component *> comps;
+    for (uint step = 0; step < 3000; ++step)
+    {
+        GameObject *go = gos[RandomIndex(gos.Size())];
+        switch (RandomIndex(7))
+        {
+            case 0:
+            case 1:
+            {
+                GameObject *newGo =
+                    new GameObject(Names[RandomIndex(Names.Size())]);
+                newGo->SetParent(go,
+                                 RandomIndex(go->GetChildren().Size() + 1));
+                gos.PushBack(newGo);
+            }
+            break;
+
+            case 2:
+            {
+                GameObject *newParent = gos[RandomIndex(gos.Size())];
+                if (go != root && !IsInSubtree(newParent, go))
+                {
+                    go->SetParent(newParent);
+                }
+            }
+            break;
+
+            case 3: go->SetName(Names[RandomIndex(Names.Size())]); break;
+
+            case 4:
+            {
+                Component *comp = new IndexedComponent();
+                go->AddComponent(comp);
+                comps.PushBack(comp);
+            }
+            break;
+
+            case 5:
+                if (go != root)
+                {
+                    for (Component *comp :
+                         go->GetComponentsInDescendantsAndThis<Component>())
+                    {
+                        comps.Remove(comp);
+                    }
+                    RemoveWithDescendants(go, &gos);
+                    GameObject::DestroyImmediate(go);
+                }
+                else if (!comps.IsEmpty())
+                {
+                    Component *comp = comps[RandomIndex(comps.Size())];
+                    comps.Remove(comp);
+                    Component::DestroyImmediate(comp);
+                }
+                break;
+
+            case 6:
+            {
+                // Without a Scene the game object can not find the index to
+                // report it, so do it as the Scene would
+                const GUID previousGUID = go->GetGUID();
+                go->GetGUID() = GUID::GetRandomGUID();
+                index.OnObjectGUIDChanged(go, previousGUID);
+            }
+            break;
+        }
+
+        BANG_CHECK_MSG(index.CheckConsistency(), "step " << step);
+        if (step % 100 == 0)
+        {
+            for (GameObject *indexedGo : gos)
+            {
+                BANG_CHECK(index.FindGameObject(indexedGo->GetGUID(),
+                                                root,
+                                                true) == indexedGo);
+                BANG_CHECK(index.FindObject(indexedGo->GetGUID(), root) ==
+                           indexedGo);
+            }
+            for (Component *comp : comps)
+            {
+                BANG_CHECK(index.FindObject(comp->GetGUID(), root) == comp);
+            }
+            for (const String &name : Names)
+            {
+                BANG_CHECK_MSG(index.FindGameObject(name, root, true) ==
+                                   FindByNameWalking(root, name),
+                               "step " << step << ", name " << name);
+            }
+        }
+    }
+
+    BANG_CHECK(index.GetNumIndexedObjects() == gos.Size() + comps.Size());
+
+    index.SetRoot(nullptr);
+    BANG_CHECK(index.GetNumIndexedObjects() == 0);
+    GameObject::DestroyImmediate(root);
+}
+
+BANG_TEST(SceneObjectIndexFindsInSubtreeOnly)
+{
+    BangTestApplication::InitIfNeeded();
+    GameObject *root = new GameObject("Root");
+    GameObject *lhs = new GameObject("Lhs");
+    GameObject *rhs = new GameObject("Rhs");
+    GameObject *shared = new GameObject("Shared");
+
+    SceneObjectIndex index;
+    index.SetRoot(root);
+    lhs->SetParent(root);
+    rhs->SetParent(root);
+    shared->SetParent(rhs);
+
+    BANG_CHECK(index.FindGameObject("Shared", root, true) == shared);
+    BANG_CHECK(index.FindGameObject("Shared", rhs, false) == shared);
+    BANG_CHECK(index.FindGameObject("Shared", lhs, true) == nullptr);
+    BANG_CHECK(index.FindGameObject("Rhs", rhs, false) == nullptr);
+    BANG_CHECK(index.FindGameObject(shared->GetGUID(), lhs, true) == nullptr);
+
+    shared->SetParent(lhs);
+    BANG_CHECK(index.FindGameObject("Shared", lhs, true) == shared);
+    BANG_CHECK(index.FindGameObject("Shared", rhs, true) == nullptr);
+    BANG_CHECK(index.CheckConsistency());
+
+    index.SetRoot(nullptr);
+    GameObject::DestroyImmediate(root);
+}
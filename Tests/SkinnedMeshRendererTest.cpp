@@ -0,0 +1,207 @@
+#include <array>
+#include <random>
+
+#include "Bang/Animator.h"
+#include "Bang/Array.tcc"
+#include "Bang/SkinnedMeshRenderer.h"
+#include "BangMath/AABox.h"
+#include "BangMath/Matrix4.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Vector3.h"
+#include "BangMath/Vector4.h"
+#include "BangTest.h"
+#include "BangTestApplication.h"
+
+using namespace Bang;
+
+namespace
+{
+// Vertices with up to 4 bones each, with normalized weights. Some of them
+// have no bones, and the last ones are left out of the bones pools, as in
+// the meshes with less bone ids than positions.
+struct SkinnedVertices
+{
+    Array<Vector3> positions;
+    Array<std::array<int, 4>> bonesIds;
+    Array<std::array<float, 4>> bonesWeights;
+};
+
+SkinnedVertices CreateSkinnedVertices(uint numVertices,
+                                      uint numBones,
+                                      std::mt19937 *rng)
+{
+    std::uniform_real_distribution<float> posDist(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> weightDist(0.0f, 1.0f);
+    SkinnedVertices vertices;
+    for (uint i = 0; i < numVertices; ++i)
+    {
+        vertices.positions.PushBack(
+            Vector3(posDist(*rng), posDist(*rng), posDist(*rng)));
+        if (i + 10 >= numVertices)
+        {
+            continue;
+        }
+
+        std::array<int, 4> ids = {{0, 0, 0, 0}};
+        std::array<float, 4> weights = {{0, 0, 0, 0}};
+        const uint numVertexBones = (i % 7 == 0) ? 0 : (1 + (*rng)() % 4);
+        float weightSum = 0.0f;
+        for (uint j = 0; j < numVertexBones; ++j)
+        {
+            ids[j] = SCAST<int>((*rng)() % numBones);
+            weights[j] = 0.1f + weightDist(*rng);
+            weightSum += weights[j];
+        }
+        for (uint j = 0; j < numVertexBones; ++j)
+        {
+            weights[j] /= weightSum;
+        }
+        vertices.bonesIds.PushBack(ids);
+        vertices.bonesWeights.PushBack(weights);
+    }
+    return vertices;
+}
+
+Array<Matrix4> CreateBoneMatrices(uint numBones, std::mt19937 *rng)
+{
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    Array<Matrix4> boneMatrices(Animator::MaxNumBones, Matrix4::Identity());
+    for (uint i = 0; i < numBones; ++i)
+    {
+        const Vector3 axis =
+            Vector3(dist(*rng), dist(*rng), dist(*rng) + 2.0f).Normalized();
+        boneMatrices[i] =
+            Matrix4::TranslateMatrix(
+                Vector3(dist(*rng), dist(*rng), dist(*rng)) * 5.0f) *
+            Matrix4::RotateMatrix(Quaternion::AngleAxis(dist(*rng) * 3, axis)) *
+            Matrix4::ScaleMatrix(Vector3(1.5f + dist(*rng)));
+    }
+    return boneMatrices;
+}
+
+// Linear blend skinning of one vertex at a time, as the vertex shader does
+Vector3 SkinPosition(const SkinnedVertices &vertices,
+                     const Array<Matrix4> &boneMatrices,
+                     uint i)
+{
+    if (i >= vertices.bonesIds.Size())
+    {
+        return vertices.positions[i];
+    }
+
+    Vector4 skinnedPosition = Vector4::Zero();
+    for (uint j = 0; j < 4; ++j)
+    {
+        const float weight = vertices.bonesWeights[i][j];
+        if (weight != 0.0f)
+        {
+            const Matrix4 &boneMatrix = boneMatrices[vertices.bonesIds[i][j]];
+            skinnedPosition +=
+                boneMatrix * Vector4(vertices.positions[i], 1.0f) * weight;
+        }
+    }
+    return skinnedPosition.xyz();
+}
+
+bool AreNear(const Vector3 &lhs, const Vector3 &rhs)
+{
+    return Vector3::Distance(lhs, rhs) <= 1e-3f * (1.0f + lhs.Length());
+}
+
+bool IsInside(const Vector3 &point, const AABox &aaBox)
+{
+    const float eps = 1e-3f * (1.0f + point.Length());
+    for (uint i = 0; i < 3; ++i)
+    {
+        if (point[i] < aaBox.GetMin()[i] - eps ||
+            point[i] > aaBox.GetMax()[i] + eps)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+BANG_TEST(SkinnedMeshRendererSkinsLikeTheVertexShader)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(2121);
+
+    // Small meshes are skinned in this thread, big ones in the jobs
+    for (uint numVertices : {100u, 50000u})
+    {
+        const uint numBones = 20;
+        const SkinnedVertices vertices =
+            CreateSkinnedVertices(numVertices, numBones, &rng);
+        const Array<Matrix4> boneMatrices =
+            CreateBoneMatrices(numBones, &rng);
+
+        Array<Vector3> skinnedPositions;
+        SkinnedMeshRenderer::SkinPositions(vertices.positions,
+                                           vertices.bonesIds,
+                                           vertices.bonesWeights,
+                                           boneMatrices,
+                                           &skinnedPositions);
+        BANG_CHECK(skinnedPositions.Size() == numVertices);
+        for (uint i = 0; i < numVertices; ++i)
+        {
+            const Vector3 expected = SkinPosition(vertices, boneMatrices, i);
+            BANG_CHECK_MSG(AreNear(skinnedPositions[i], expected),
+                           "vertex " << i << " of " << numVertices << ": "
+                                     << skinnedPositions[i] << " vs "
+                                     << expected);
+        }
+    }
+}
+
+BANG_TEST(SkinnedMeshRendererBoundsContainSkinnedPositions)
+{
+    BangTestApplication::InitIfNeeded();
+    std::mt19937 rng(3131);
+    const uint numVertices = 2000;
+    const uint numBones = 30;
+    const SkinnedVertices vertices =
+        CreateSkinnedVertices(numVertices, numBones, &rng);
+    SkinnedMeshRenderer::BoneBounds boneBounds;
+    SkinnedMeshRenderer::ComputeBoneBounds(vertices.positions,
+                                           vertices.bonesIds,
+                                           vertices.bonesWeights,
+                                           &boneBounds);
+
+    // In the bind pose they are the bounds of the positions, plus the origin
+    // for the vertices without bones
+    Array<Matrix4> boneMatrices(Animator::MaxNumBones, Matrix4::Identity());
+    AABox expectedAABox;
+    expectedAABox.CreateFromPositions(vertices.positions);
+    expectedAABox.AddPoint(Vector3::Zero());
+    AABox aaBox = SkinnedMeshRenderer::SkinBoneBounds(boneBounds, boneMatrices);
+    BANG_CHECK_MSG(AreNear(aaBox.GetMin(), expectedAABox.GetMin()),
+                   aaBox.GetMin() << " vs " << expectedAABox.GetMin());
+    BANG_CHECK_MSG(AreNear(aaBox.GetMax(), expectedAABox.GetMax()),
+                   aaBox.GetMax() << " vs " << expectedAABox.GetMax());
+
+    // Posed, every skinned position is inside them
+    for (uint pose = 0; pose < 20; ++pose)
+    {
+        boneMatrices = CreateBoneMatrices(numBones, &rng);
+        aaBox = SkinnedMeshRenderer::SkinBoneBounds(boneBounds, boneMatrices);
+        Array<Vector3> skinnedPositions;
+        SkinnedMeshRenderer::SkinPositions(vertices.positions,
+                                           vertices.bonesIds,
+                                           vertices.bonesWeights,
+                                           boneMatrices,
+                                           &skinnedPositions);
+        for (uint i = 0; i < numVertices; ++i)
+        {
+            BANG_CHECK_MSG(IsInside(skinnedPositions[i], aaBox),
+                           "pose " << pose << ", vertex " << i << ": "
+                                   << skinnedPositions[i]);
+        }
+    }
+
+    // Nothing to bound without positions
+    SkinnedMeshRenderer::ComputeBoneBounds({}, {}, {}, &boneBounds);
+    BANG_CHECK(SkinnedMeshRenderer::SkinBoneBounds(boneBounds, boneMatrices) ==
+               AABox::Empty());
+}
@@ -0,0 +1,200 @@
+#include <random>
+
+#include "Bang/Array.tcc"
+#include "Bang/TriangleBVH.h"
+#include "BangMath/Geometry.h"
+#include "BangMath/Math.h"
+#include "BangMath/Segment.h"
+#include "BangMath/Triangle.h"
+#include "BangMath/Vector3.h"
+#include "BangTest.h"
+
+using namespace Bang;
+
+namespace
+{
+// Closest triangle crossed by the segment, testing all of them
+bool IntersectSegmentBruteForce(const Segment &segment,
+                                const Array<Vector3> &positions,
+                                const Array<uint> &trianglesVertexIds,
+                                Vector3 *intersectionPoint,
+                                uint *triangleId)
+{
+    bool intersected = false;
+    float closestSqDist = Math::Infinity<float>();
+    for (uint triId = 0; triId < trianglesVertexIds.Size() / 3; ++triId)
+    {
+        const Triangle tri(positions[trianglesVertexIds[triId * 3 + 0]],
+                           positions[trianglesVertexIds[triId * 3 + 1]],
+                           positions[trianglesVertexIds[triId * 3 + 2]]);
+
+        bool intersectedTri = false;
+        Vector3 triIntersectionPoint;
+        Geometry::IntersectSegmentTriangle(
+            segment, tri, &intersectedTri, &triIntersectionPoint);
+        if (intersectedTri)
+        {
+            const float sqDist =
+                Vector3::SqDistance(segment.GetOrigin(), triIntersectionPoint);
+            if (sqDist < closestSqDist)
+            {
+                intersected = true;
+                closestSqDist = sqDist;
+                *intersectionPoint = triIntersectionPoint;
+                *triangleId = triId;
+            }
+        }
+    }
+    return intersected;
+}
+
+// Random triangles, some of them big, around the origin
+void CreateTriangleSoup(uint numTriangles,
+                        std::mt19937 *rng,
+                        Array<Vector3> *positions,
+                        Array<uint> *trianglesVertexIds)
+{
+    std::uniform_real_distribution<float> posDist(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> sizeDist(0.1f, 3.0f);
+    for (uint i = 0; i < numTriangles; ++i)
+    {
+        const Vector3 center(posDist(*rng), posDist(*rng), posDist(*rng));
+        const float size = sizeDist(*rng) * ((i % 50 == 0) ? 10.0f : 1.0f);
+        for (uint j = 0; j < 3; ++j)
+        {
+            trianglesVertexIds->PushBack(positions->Size());
+            positions->PushBack(center + Vector3(posDist(*rng),
+                                                 posDist(*rng),
+                                                 posDist(*rng)) *
+                                             (size / 20.0f));
+        }
+    }
+}
+}
+
+BANG_TEST(TriangleBVHIntersectsLikeTestingAllTriangles)
+{
+    std::mt19937 rng(2402);
+    Array<Vector3> positions;
+    Array<uint> trianglesVertexIds;
+    CreateTriangleSoup(1000, &rng, &positions, &trianglesVertexIds);
+
+    TriangleBVH bvh;
+    bvh.Build(positions, trianglesVertexIds);
+    BANG_CHECK(bvh.GetNumNodes() > 1000 / TriangleBVH::MaxLeafTriangles);
+
+    // Short and long segments, from inside and outside of the triangles box
+    std::uniform_real_distribution<float> posDist(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> lengthDist(0.0f, 1.0f);
+    uint numIntersected = 0;
+    for (uint i = 0; i < 3000; ++i)
+    {
+        const Vector3 origin(posDist(rng), posDist(rng), posDist(rng));
+        const Vector3 dir(posDist(rng), posDist(rng), posDist(rng));
+        const float length = (i % 2 == 0) ? lengthDist(rng) : 2.0f;
+        const Segment segment(origin, origin + dir * length);
+
+        Vector3 bvhPoint, bruteForcePoint;
+        uint bvhTriId = 0, bruteForceTriId = 0;
+        const bool bvhIntersected =
+            bvh.IntersectSegment(segment, &bvhPoint, &bvhTriId);
+        const bool bruteForceIntersected =
+            IntersectSegmentBruteForce(segment,
+                                       positions,
+                                       trianglesVertexIds,
+                                       &bruteForcePoint,
+                                       &bruteForceTriId);
+        BANG_CHECK_MSG(bvhIntersected == bruteForceIntersected,
+                       "segment " << i);
+        if (bvhIntersected && bruteForceIntersected)
+        {
+            ++numIntersected;
+
+            // Another triangle at the same distance is as good
+            BANG_CHECK_MSG(
+                Vector3::Distance(bvhPoint, bruteForcePoint) < 1e-3f,
+                "segment " << i << ", " << bvhPoint << " and "
+                           << bruteForcePoint);
+            BANG_CHECK_MSG(bvhTriId == bruteForceTriId ||
+                               Math::Abs(Vector3::Distance(origin, bvhPoint) -
+                                         Vector3::Distance(
+                                             origin, bruteForcePoint)) < 1e-3f,
+                           "segment " << i);
+        }
+    }
+
+    // Both cases, so that the checks above mean something
+    BANG_CHECK(numIntersected > 100 && numIntersected < 2900);
+
+    // Nothing to hit once cleared
+    Vector3 point;
+    uint triId;
+    bvh.Clear();
+    BANG_CHECK(bvh.IsEmpty());
+    BANG_CHECK(!bvh.IntersectSegment(
+        Segment(Vector3(0, 0, -100), Vector3(0, 0, 100)), &point, &triId));
+}
+
+BANG_TEST(TriangleBVHFastSegmentsDoNotTunnel)
+{
+    // A thin wall at z = 0, made of many small triangles, and the segment
+    // a fast particle moves in one step, much longer than the wall is thick
+    Array<Vector3> positions;
+    Array<uint> trianglesVertexIds;
+    const int gridSize = 16;
+    for (int y = 0; y <= gridSize; ++y)
+    {
+        for (int x = 0; x <= gridSize; ++x)
+        {
+            positions.PushBack(Vector3(x - gridSize / 2, y - gridSize / 2, 0));
+        }
+    }
+    for (int y = 0; y < gridSize; ++y)
+    {
+        for (int x = 0; x < gridSize; ++x)
+        {
+            const uint v = SCAST<uint>(y * (gridSize + 1) + x);
+            const uint vUp = v + gridSize + 1;
+            for (uint vertexId : {v, v + 1, vUp, v + 1, vUp + 1, vUp})
+            {
+                trianglesVertexIds.PushBack(vertexId);
+            }
+        }
+    }
+
+    TriangleBVH bvh;
+    bvh.Build(positions, trianglesVertexIds);
+    BANG_CHECK(bvh.GetAABox().GetSize().z == 0.0f);
+
+    const Array<Segment> crossingSegments = {
+        Segment(Vector3(0.3f, 0.2f, -500.0f), Vector3(0.3f, 0.2f, 500.0f)),
+        Segment(Vector3(3.7f, -2.1f, 1000.0f), Vector3(-1.2f, 4.4f, -0.001f)),
+        Segment(Vector3(-7.3f, 6.9f, 0.01f), Vector3(7.1f, -7.4f, -0.01f))};
+    for (uint i = 0; i < crossingSegments.Size(); ++i)
+    {
+        const Segment &segment = crossingSegments[i];
+        Vector3 bvhPoint, bruteForcePoint;
+        uint bvhTriId = 0, bruteForceTriId = 0;
+        BANG_CHECK_MSG(bvh.IntersectSegment(segment, &bvhPoint, &bvhTriId),
+                       "segment " << i);
+        BANG_CHECK_MSG(Math::Abs(bvhPoint.z) < 1e-3f, "segment " << i);
+        BANG_CHECK(IntersectSegmentBruteForce(segment,
+                                              positions,
+                                              trianglesVertexIds,
+                                              &bruteForcePoint,
+                                              &bruteForceTriId));
+        BANG_CHECK_MSG(Vector3::Distance(bvhPoint, bruteForcePoint) < 1e-3f,
+                       "segment " << i);
+    }
+
+    // Ending right before the wall, or passing by its side
+    const Array<Segment> missingSegments = {
+        Segment(Vector3(0.3f, 0.2f, -500.0f), Vector3(0.3f, 0.2f, -0.01f)),
+        Segment(Vector3(9.0f, 0.0f, -500.0f), Vector3(9.0f, 0.0f, 500.0f))};
+    for (const Segment &segment : missingSegments)
+    {
+        Vector3 point;
+        uint triId;
+        BANG_CHECK(!bvh.IntersectSegment(segment, &point, &triId));
+    }
+}
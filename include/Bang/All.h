@@ -96,6 +96,7 @@
 #include "Bang/ImageIODDS.h"
 #include "Bang/Input.h"
 #include "Bang/IsContainer.h"
+#include "Bang/JobSystem.h"
 #include "Bang/LayoutSizeType.h"
 #include "Bang/Library.h"
 #include "Bang/Light.h"
@@ -38,6 +38,25 @@ public:
         T value;
     };
 
+    // The keyframes of one bone, null for the channels it does not have
+    struct BoneTrack
+    {
+        String boneName;
+        const Array<KeyFrame<Vector3>> *positionKeyFrames = nullptr;
+        const Array<KeyFrame<Quaternion>> *rotationKeyFrames = nullptr;
+        const Array<KeyFrame<Vector3>> *scaleKeyFrames = nullptr;
+    };
+
+    // Per channel (position, rotation and scale) index of the keyframe found
+    // the last time a track was sampled. Playing forward finds the next one
+    // without searching.
+    struct BoneTrackCursor
+    {
+        uint positionKeyFrame = SCAST<uint>(-1);
+        uint rotationKeyFrame = SCAST<uint>(-1);
+        uint scaleKeyFrame = SCAST<uint>(-1);
+    };
+
     void AddPositionKeyFrame(const String &boneName,
                              const Animation::KeyFrame<Vector3> &keyFrame);
     void AddRotationKeyFrame(const String &boneName,
@@ -73,6 +92,8 @@ public:
     const Map<String, Array<Animation::KeyFrame<Vector3>>>
         &GetBoneNameToScaleKeyFrames() const;
 
+    const Array<BoneTrack> &GetBoneTracks() const;
+
     static float WrapTime(float time,
                           float totalDuration,
                           AnimationWrapMode animationWrapMode);
@@ -91,6 +112,13 @@ public:
         const Animation *animation,
         Time animationTime);
 
+    // Wrapped time, or a negative one if there is nothing to sample
+    static double GetSampleTimeInFrames(const Animation *animation,
+                                        Time animationTime);
+    static Transformation SampleBoneTrack(const BoneTrack &boneTrack,
+                                          double timeInFrames,
+                                          BoneTrackCursor *cursor);
+
     static Map<String, Transformation> GetInterpolatedBoneTransformations(
         const Map<String, Transformation> &prevTransformations,
         const Map<String, Transformation> &nextTransformations,
@@ -108,6 +136,12 @@ private:
     Map<String, Array<KeyFrame<Vector3>>> m_boneNameToPositionKeyFrames;
     Map<String, Array<KeyFrame<Quaternion>>> m_boneNameToRotationKeyFrames;
     Map<String, Array<KeyFrame<Vector3>>> m_boneNameToScaleKeyFrames;
+
+    // Point to the arrays in the maps above
+    Array<BoneTrack> m_boneTracks;
+    Map<String, uint> m_boneNameToBoneTrackIndex;
+
+    BoneTrack *GetOrAddBoneTrack(const String &boneName);
 };
 }
 
@@ -0,0 +1,93 @@
+#ifndef ANIMATIONSAMPLER_H
+#define ANIMATIONSAMPLER_H
+
+#include "Bang/Animation.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/String.h"
+#include "Bang/Time.h"
+#include "Bang/UMap.h"
+#include "BangMath/Transformation.h"
+
+namespace Bang
+{
+// Bone names of a skeleton, each with a dense index, so that poses of the
+// skeleton can be plain arrays indexed by bone
+class AnimationSkeleton
+{
+public:
+    AnimationSkeleton() = default;
+
+    uint AddBone(const String &boneName);
+
+    // Samplers bound to the skeleton have to be bound again
+    void Clear();
+
+    int GetBoneIndex(const String &boneName) const;
+    const String &GetBoneName(uint boneIndex) const;
+    const Array<String> &GetBoneNames() const;
+    uint GetNumBones() const;
+
+private:
+    Array<String> m_boneNames;
+    UMap<String, uint> m_boneNameToIndex;
+};
+
+// Transformation of each bone of a skeleton. Only the bones marked as
+// animated have been written.
+struct AnimationPose
+{
+    Array<Transformation> boneTransformations;
+    Array<Byte> animatedBones;
+
+    void Reset(uint numBones);
+
+    // Keeps the bones there are, the new ones are not animated
+    void Grow(uint numBones);
+
+    // Adds the animated bones of the layer pose whose weight is not zero,
+    // on top of the ones of this pose. No weights means all the bones.
+    void Combine(const AnimationPose &layerPose,
+                 const Array<float> &boneWeights);
+
+    bool IsBoneAnimated(uint boneIndex) const;
+    uint GetNumBones() const;
+
+    // Bones animated in only one of the poses are interpolated with the
+    // identity. The output pose can be any of the input ones.
+    static void Interpolate(const AnimationPose &prevPose,
+                            const AnimationPose &nextPose,
+                            float weight,
+                            AnimationPose *outPose);
+};
+
+// An animation bound to a skeleton. Each of its bone tracks is resolved to a
+// skeleton bone index once, and keeps a keyframe cursor between samples.
+class AnimationSampler
+{
+public:
+    AnimationSampler() = default;
+
+    void Bind(const Animation *animation, const AnimationSkeleton *skeleton);
+
+    // Writes the bones of the skeleton that the animation has
+    void Sample(Time animationTime, AnimationPose *pose);
+
+    const Animation *GetAnimation() const;
+    const AnimationSkeleton *GetSkeleton() const;
+    uint GetNumBoundBoneTracks() const;
+
+private:
+    const Animation *p_animation = nullptr;
+    const AnimationSkeleton *p_skeleton = nullptr;
+    uint m_boundSkeletonNumBones = 0;
+
+    // One per bone track of the animation, -1 if it is not in the skeleton
+    Array<int> m_boneTrackBoneIndices;
+    Array<Animation::BoneTrackCursor> m_boneTrackCursors;
+
+    void BindIfNeeded();
+};
+}
+
+#endif  // ANIMATIONSAMPLER_H
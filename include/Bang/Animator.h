@@ -1,16 +1,22 @@
 ﻿#ifndef ANIMATOR_H
 #define ANIMATOR_H
 
+#include "Bang/AnimationSampler.h"
+#include "Bang/AnimatorLayerMask.h"
 #include "Bang/AnimatorStateMachineVariable.h"
 #include "Bang/AssetHandle.h"
 #include "Bang/BangDefines.h"
 #include "Bang/Component.h"
 #include "Bang/ComponentMacros.h"
+#include "Bang/EventListener.h"
+#include "Bang/GUID.h"
 #include "Bang/IEventsAnimatorStateMachine.h"
+#include "Bang/IEventsDestroy.h"
 #include "Bang/Map.h"
 #include "Bang/MetaNode.h"
 #include "Bang/String.h"
 #include "Bang/Time.h"
+#include "Bang/UMap.h"
 #include "BangMath/Matrix4.h"
 #include "BangMath/Transformation.h"
 
@@ -18,10 +24,13 @@ namespace Bang
 {
 class Animation;
 class AnimatorStateMachine;
+class AnimatorStateMachineLayer;
 class AnimatorStateMachinePlayer;
+class SkinnedMeshRenderer;
 
 class Animator : public Component,
-                 public EventListener<IEventsAnimatorStateMachine>
+                 public EventListener<IEventsAnimatorStateMachine>,
+                 public EventListener<IEventsDestroy>
 {
     COMPONENT(Animator)
 
@@ -58,6 +67,19 @@ public:
     AnimatorStateMachine *GetStateMachine() const;
     const Array<AnimatorStateMachinePlayer *> &GetPlayers() const;
 
+    // Poses are indexed by the bones of the skeleton of this animator, which
+    // grows with the bones of every animation it samples
+    void SampleAnimation(const Animation *animation,
+                         Time animationTime,
+                         AnimationPose *pose);
+    const AnimationSkeleton &GetSkeleton() const;
+
+    // Last pose evaluated, the one written into the bones
+    const AnimationPose &GetPose() const;
+
+    // Scratch pose for the nodes that blend several animations
+    AnimationPose *GetBlendPose();
+
     // Serializable
     virtual void CloneInto(Serializable *clone, bool cloneGUID) const override;
 
@@ -75,11 +97,62 @@ private:
 
     bool m_playOnStart = true;
     bool m_playing = false;
+    bool m_updatedByScene = false;
+
+    struct LayerMaskWeights
+    {
+        const AnimatorLayerMask *layerMask = nullptr;
+        Array<AnimatorLayerMask::BoneEntry> boneEntries;
+        GameObject *animatorParent = nullptr;
+        uint animatorParentSubtreeVersion = 0;
+        uint numBones = 0;
+        Array<float> boneWeights;
+    };
+
+    // The skeleton bone each bone GameObject of a renderer takes, resolved
+    // by name once
+    struct SkinnedMeshRendererBones
+    {
+        Array<GameObject *> boneGameObjects;
+        GameObject *rootBoneGameObject = nullptr;
+        uint rootBoneSubtreeVersion = 0;
+        uint numBones = 0;
+
+        // Per bone GameObject, -1 if the skeleton does not have it
+        Array<int> boneIndices;
+
+        // Per bone GameObject, the one the renderer finds by its name
+        Array<GameObject *> namedBoneGameObjects;
+    };
+
+    AnimationSkeleton m_skeleton;
+    UMap<GUID, AnimationSampler> m_animationSamplers;
+    UMap<const AnimatorStateMachineLayer *, LayerMaskWeights>
+        m_layerMaskWeights;
+    UMap<const SkinnedMeshRenderer *, SkinnedMeshRendererBones>
+        m_skinnedMeshRendererBones;
+
+    // Reused every frame
+    AnimationPose m_combinedPose;
+    AnimationPose m_layerPose;
+    AnimationPose m_crossFadePose;
+    AnimationPose m_blendPose;
 
     void ClearPlayers();
 
-    void SetSkinnedMeshRendererBoneTransformations(
-        const Map<String, Transformation> &boneAnimTransformations);
+    // Steps of OnUpdate. Only EvaluatePose can run outside the main thread,
+    // and it only touches this animator.
+    bool StepPlayers(Time now);
+    void EvaluatePose();
+    void ApplyPose();
+
+    // Empty if the layer has no mask
+    const Array<float> &GetLayerMaskWeights(
+        const AnimatorStateMachineLayer *layer);
+
+    void SetSkinnedMeshRendererBoneTransformations(const AnimationPose &pose);
+    const SkinnedMeshRendererBones &GetSkinnedMeshRendererBones(
+        SkinnedMeshRenderer *smr);
 
     // IEventsAnimatorStateMachine
     void OnLayerAdded(AnimatorStateMachine *stateMachine,
@@ -87,6 +160,11 @@ private:
 
     void OnLayerRemoved(AnimatorStateMachine *stateMachine,
                         AnimatorStateMachineLayer *stateMachineLayer) override;
+
+    // IEventsDestroy
+    void OnDestroyed(EventEmitter<IEventsDestroy> *object) override;
+
+    friend class SceneAnimatorsUpdater;
 };
 }
 
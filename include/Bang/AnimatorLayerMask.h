@@ -9,6 +9,7 @@
 namespace Bang
 {
 class Animator;
+class AnimationSkeleton;
 class AnimatorLayerMask : public Asset
 {
     ASSET(AnimatorLayerMask)
@@ -42,6 +43,10 @@ public:
     const Array<AnimatorLayerMask::BoneEntry> &GetBoneEntries() const;
     Set<String> GetBoneMaskNamesSet(Animator *animator) const;
 
+    // 1 for the skeleton bones in the mask, 0 for the rest
+    Array<float> GetBoneMaskWeights(Animator *animator,
+                                    const AnimationSkeleton &skeleton) const;
+
     // Asset
     virtual void Import(const Path &assetFilepath) override;
 
@@ -21,6 +21,9 @@ public:
     virtual Map<String, Transformation> GetBoneTransformations(
         Time animationTime,
         Animator *animator) const override;
+    virtual void SampleBonePose(Time animationTime,
+                                Animator *animator,
+                                AnimationPose *pose) const override;
     Animation *GetSecondAnimation() const;
     const String &GetBlendVariableName() const;
     float GetSecondAnimationSpeed() const;
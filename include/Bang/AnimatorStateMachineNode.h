@@ -24,6 +24,7 @@ namespace Bang
 class Animator;
 class Animation;
 class AnimatorStateMachine;
+struct AnimationPose;
 class AnimatorStateMachineLayer;
 class AnimatorStateMachineTransition;
 
@@ -50,6 +51,11 @@ public:
         Time animationTime,
         Animator *animator) const;
 
+    // Same as GetBoneTransformations, on the bones of the animator skeleton
+    virtual void SampleBonePose(Time animationTime,
+                                Animator *animator,
+                                AnimationPose *pose) const;
+
     void SetSpeed(float speed);
     void SetAnimation(Animation *animation);
 
@@ -12,6 +12,7 @@ class AudioManager;
 class ClassDB;
 class Debug;
 class GEngine;
+class JobSystem;
 class MetaFilesManager;
 class Paths;
 class Physics;
@@ -39,6 +40,7 @@ public:
     Paths *GetPaths() const;
     Debug *GetDebug() const;
     GEngine *GetGEngine() const;
+    JobSystem *GetJobSystem() const;
     Physics *GetPhysics() const;
     Settings *GetSettings() const;
     Assets *GetAssets() const;
@@ -62,6 +64,7 @@ protected:
     Paths *m_paths = nullptr;
     Physics *m_physics = nullptr;
     GEngine *m_gEngine = nullptr;
+    JobSystem *m_jobSystem = nullptr;
     Settings *m_settings = nullptr;
     Assets *m_assets = nullptr;
     SystemUtils *m_systemUtils = nullptr;
@@ -41,6 +41,10 @@ public:
     Asset *GetEmbeddedAsset(GUID::GUIDType embeddedResGUID) const;
     String GetEmbeddedAssetName(GUID::GUIDType embeddedResGUID) const;
 
+    // Approximate memory used by this asset, to budget the unused assets
+    // that Assets keeps cached
+    virtual std::size_t GetResidentBytes() const;
+
 protected:
     Asset();
     virtual ~Asset() override;
@@ -55,6 +59,15 @@ protected:
     virtual void Import(const Path &assetFilepath);
     void Import_(const Path &assetFilepath);
 
+    // Asynchronous import, in two steps. ImportAsync runs in a worker thread,
+    // and must only read and decode the file, without using GL nor other
+    // assets. ImportAsyncFinish runs afterwards in the main thread. By default
+    // everything is done in ImportAsyncFinish, through Import.
+    virtual void ImportAsync(const Path &assetFilepath);
+    virtual void ImportAsyncFinish(const Path &assetFilepath);
+    void ImportAsyncFinish_(const Path &assetFilepath,
+                            const MetaNode *metaNode);
+
 private:
     // Embedded asset related variables
     AH<Asset> p_parentAsset;
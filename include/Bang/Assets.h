@@ -1,13 +1,17 @@
 #ifndef ASSETS_H
 #define ASSETS_H
 
+#include <cstddef>
 #include <functional>
+#include <memory>
 
 #include "Bang/Array.h"
 #include "Bang/Asset.h"
 #include "Bang/AssetHandle.h"
+#include "Bang/AsyncAssetHandle.h"
 #include "Bang/BangDefines.h"
 #include "Bang/IToString.h"
+#include "Bang/List.h"
 #include "Bang/Path.h"
 #include "Bang/String.h"
 #include "Bang/UMap.h"
@@ -33,6 +37,12 @@ private:
     {
         Asset *asset = nullptr;
         uint usageCount = 0;  // Number of AH's using this asset entry
+
+        // Whether it is kept in the unused assets list, with no AH using it
+        bool unused = false;
+        List<GUID>::Iterator unusedIt;
+        std::size_t unusedBytes = 0;
+
         String ToString() const override
         {
             return "AE(" + String(asset) + ", " + String(usageCount) + ")";
@@ -40,6 +50,16 @@ private:
     };
 
 public:
+    struct CacheStats
+    {
+        uint hits = 0;    // Loads of assets that were already loaded
+        uint misses = 0;  // Loads that had to import the asset
+        uint numAssets = 0;
+        uint numUnusedAssets = 0;
+        std::size_t residentBytes = 0;
+        std::size_t unusedBytes = 0;
+    };
+
     Assets();
     virtual ~Assets();
 
@@ -61,6 +81,14 @@ public:
     template <class AssetClass = Asset>
     static AH<AssetClass> Load(const GUID &guid);
 
+    // The file is read and decoded in a worker thread, and the rest of the
+    // import is done in the main thread, in FinishAsyncLoads
+    template <class AssetClass = Asset>
+    static AsyncAH<AssetClass> LoadAsync(const Path &filepath);
+    template <class AssetClass = Asset>
+    static AsyncAH<AssetClass> LoadAsync(const GUID &guid);
+    static void FinishAsyncLoads();
+
     static AH<Asset> LoadFromExtension(const Path &filepath);
 
     static void Import(Asset *asset);
@@ -86,6 +114,16 @@ public:
 
     static Path GetAssetPath(const Asset *asset);
 
+    // Assets loaded from a file are kept cached when no AH uses them anymore,
+    // until they use more bytes than this budget, and then the least
+    // recently used ones are deleted. With a budget of 0 they are deleted
+    // right away.
+    static void SetUnusedAssetsBudget(std::size_t budgetBytes);
+    static std::size_t GetUnusedAssetsBudget();
+
+    static CacheStats GetCacheStats();
+    static void ResetCacheStats();
+
     template <class AssetClass = Asset>
     static Array<AssetClass *> GetAll();
     static Array<Asset *> GetAllAssets();
@@ -108,6 +146,16 @@ private:
     bool m_beingDestroyed = false;
     UMap<GUID, AssetEntry> m_assetsCache;
 
+    // Least recently used first
+    List<GUID> m_unusedAssets;
+    std::size_t m_unusedAssetsBytes = 0;
+    std::size_t m_unusedAssetsBudget = 256u * 1024u * 1024u;
+
+    uint m_cacheHits = 0;
+    uint m_cacheMisses = 0;
+
+    UMap<GUID, std::shared_ptr<AsyncAssetLoad>> m_asyncLoads;
+
     MeshFactory *m_meshFactory = nullptr;
     TextureFactory *m_textureFactory = nullptr;
     MaterialFactory *m_materialFactory = nullptr;
@@ -125,6 +173,20 @@ private:
     AH<Asset> Load_(std::function<Asset *()> creator, const Path &path);
     AH<Asset> Load_(std::function<Asset *()> creator, const GUID &guid);
 
+    std::shared_ptr<AsyncAssetLoad> LoadAsync_(
+        std::function<Asset *()> creator,
+        const Path &path);
+    std::shared_ptr<AsyncAssetLoad> LoadAsync_(
+        std::function<Asset *()> creator,
+        const GUID &guid);
+    void FinishAsyncLoad(const GUID &guid);
+    void FinishAsyncLoad(AsyncAssetLoad *load);
+
+    bool CanKeepUnused(const Asset *asset) const;
+    void AddUnusedAsset(const GUID &guid, AssetEntry *assetEntry);
+    void RemoveUnusedAsset(AssetEntry *assetEntry);
+    void DeleteUnusedAssets(std::size_t budgetBytes);
+
     Asset *GetCached_(const GUID &guid) const;
     Asset *GetCached_(const Path &path) const;
     bool Contains_(Asset *asset) const;
@@ -132,6 +194,7 @@ private:
     friend class Window;
     friend class GUIDManager;
     friend class IAssetHandle;
+    friend class AsyncAssetHandleBase;
 };
 }
 
@@ -62,6 +62,30 @@ AH<AssetClass> Assets::Load(const GUID &guid)
     return resultAH;
 }
 
+template <class AssetClass>
+AsyncAH<AssetClass> Assets::LoadAsync(const Path &filepath)
+{
+    auto creator = []() -> Asset * {
+        return SCAST<Asset *>(Assets::Create_<AssetClass>());
+    };
+
+    AsyncAH<AssetClass> asyncAH;
+    asyncAH.p_load = Assets::GetInstance()->LoadAsync_(creator, filepath);
+    return asyncAH;
+}
+
+template <class AssetClass>
+AsyncAH<AssetClass> Assets::LoadAsync(const GUID &guid)
+{
+    auto creator = []() -> Asset * {
+        return SCAST<Asset *>(Assets::Create_<AssetClass>());
+    };
+
+    AsyncAH<AssetClass> asyncAH;
+    asyncAH.p_load = Assets::GetInstance()->LoadAsync_(creator, guid);
+    return asyncAH;
+}
+
 template <class AssetClass, class... Args>
 AH<AssetClass> Assets::Create(const Args &... args)
 {
@@ -0,0 +1,77 @@
+#ifndef ASYNCASSETHANDLE_H
+#define ASYNCASSETHANDLE_H
+
+#include <memory>
+
+#include "Bang/Asset.h"
+#include "Bang/AssetHandle.h"
+#include "Bang/BangDefines.h"
+#include "Bang/GUID.h"
+#include "Bang/JobSystem.h"
+#include "Bang/MetaNode.h"
+#include "Bang/Path.h"
+
+namespace Bang
+{
+// State of a load started with Assets::LoadAsync
+class AsyncAssetLoad
+{
+private:
+    Path m_path;
+    GUID m_guid;
+
+    // Not in the Assets cache until the load is finished
+    Asset *p_asset = nullptr;
+    AH<Asset> m_assetAH;
+
+    // Read in the worker thread too
+    MetaNode m_metaNode;
+    bool m_hasMetaNode = false;
+
+    JobHandle m_jobHandle;
+    bool m_finished = false;
+
+    friend class Assets;
+    friend class AsyncAssetHandleBase;
+};
+
+class AsyncAssetHandleBase
+{
+public:
+    bool IsValid() const;
+
+    // Loads are finished in the main thread, at the beginning of each frame
+    bool IsDone() const;
+
+    // Finishes the load right away. Only from the main thread.
+    void Wait() const;
+
+protected:
+    AsyncAssetHandleBase() = default;
+
+    Asset *GetAsset() const;
+
+private:
+    std::shared_ptr<AsyncAssetLoad> p_load;
+
+    friend class Assets;
+};
+
+template <class AssetClass>
+class AsyncAssetHandle : public AsyncAssetHandleBase
+{
+public:
+    AsyncAssetHandle() = default;
+
+    // Empty until the load is done
+    AH<AssetClass> Get() const
+    {
+        return AH<AssetClass>(DCAST<AssetClass *>(GetAsset()));
+    }
+};
+
+template <class T>
+using AsyncAH = AsyncAssetHandle<T>;
+}
+
+#endif  // ASYNCASSETHANDLE_H
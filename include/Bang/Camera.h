@@ -15,6 +15,7 @@
 #include "Bang/ComponentMacros.h"
 #include "Bang/EventEmitter.tcc"
 #include "Bang/EventListener.h"
+#include "Bang/Frustum.h"
 #include "Bang/IEvents.h"
 #include "Bang/MetaNode.h"
 #include "BangMath/Ray.h"
@@ -111,6 +112,7 @@ public:
     Quad GetFrustumRightQuad() const;
     Quad GetFrustumTopQuad() const;
     Quad GetFrustumBotQuad() const;
+    Frustum GetFrustum() const;
 
     static Camera *GetActive();
 
@@ -4,6 +4,7 @@
 #include "Bang/Bang.h"
 #include "Bang/ClassDBMacros.h"
 #include "Bang/Map.h"
+#include "Bang/Set.h"
 #include "Bang/String.h"
 
 namespace Bang
@@ -30,11 +31,25 @@ public:
     template <class TBaseClass, class TSubClass>
     static constexpr inline bool IsSubClass(const TSubClass *obj);
 
+    // Whether T declares its own class id range, instead of just inheriting
+    // the one of its base class
+    template <class T>
+    static constexpr inline bool HasOwnClassId();
+
     template <class T>
     static T *Create(const String &className);
 
     static void *Create(const String &className);
 
+    // Null if the class is not registered. It stays valid, so it can be
+    // kept to create many objects without looking the class up each time.
+    static const std::function<void *()> *GetConstructor(
+        const String &className);
+
+    // Whether the class imports its meta with the ImportMeta of Component,
+    // so that its CompileImportMeta does the same
+    static bool HasComponentImportMeta(const String &className);
+
     void RegisterClasses();
 
     static ClassDB *GetInstance();
@@ -45,6 +60,13 @@ private:
     Map<String, ClassIdType> m_classNameToClassIdBegin;
     Map<String, ClassIdType> m_classNameToClassIdEnd;
     Map<String, std::function<void *()>> m_classNameToConstructor;
+    Set<String> m_classNamesWithComponentImportMeta;
+
+    template <class T>
+    static constexpr inline bool HasOwnClassId_(
+        typename T::ClassIdOwnerType *);
+    template <class T>
+    static constexpr inline bool HasOwnClassId_(...);
 };
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 #include "Bang/ClassDB.h"
 #include "Bang/Debug.h"
 
@@ -33,6 +35,24 @@ constexpr inline bool ClassDB::IsSubClass(const TSubClass *obj)
         TBaseClass::GetClassIdBegin(), TBaseClass::GetClassIdEnd(), obj);
 }
 
+template <class T>
+constexpr inline bool ClassDB::HasOwnClassId()
+{
+    return ClassDB::HasOwnClassId_<T>(nullptr);
+}
+
+template <class T>
+constexpr inline bool ClassDB::HasOwnClassId_(typename T::ClassIdOwnerType *)
+{
+    return std::is_same<typename T::ClassIdOwnerType, T>::value;
+}
+
+template <class T>
+constexpr inline bool ClassDB::HasOwnClassId_(...)
+{
+    return false;
+}
+
 template <class T>
 T *ClassDB::Create(const String &className)
 {
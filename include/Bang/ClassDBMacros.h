@@ -38,7 +38,7 @@ using ClassIdType = uint;
     CREATE_STATIC_CLASS_ID(PostProcessEffectBloom, 805, 807);        \
     CREATE_STATIC_CLASS_ID(PostProcessEffectDOF, 808, 809);          \
     CREATE_STATIC_CLASS_ID(PostProcessEffectFXAA, 810, 811);         \
-    CREATE_STATIC_CLASS_ID(PostProcessEffectToneMapping, 810, 811);  \
+    CREATE_STATIC_CLASS_ID(PostProcessEffectToneMapping, 812, 813);  \
     CREATE_STATIC_CLASS_ID(Transform, 901, 1000);                    \
     CREATE_STATIC_CLASS_ID(RectTransform, 910, 920);                 \
     CREATE_STATIC_CLASS_ID(ReflectionProbe, 1101, 1200);             \
@@ -88,6 +88,7 @@ using ClassIdType = uint;
 
 #define SET_CLASS_ID(CLASS)                               \
 public:                                                   \
+    using ClassIdOwnerType = CLASS;                       \
     constexpr static inline ClassIdType GetClassIdBegin() \
     {                                                     \
         return ClassDB::CLASS##CIDBegin;                  \
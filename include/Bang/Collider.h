@@ -8,6 +8,7 @@
 #include "Bang/MetaNode.h"
 #include "Bang/PhysicsComponent.h"
 #include "Bang/String.h"
+#include "BangMath/AABox.h"
 #include "BangMath/Vector3.h"
 #include "BangMath/Matrix4.h"
 
@@ -54,6 +55,7 @@ public:
     PhysicsMaterial *GetSharedPhysicsMaterial() const;
     PhysicsMaterial *GetActivePhysicsMaterial() const;
     PhysicsMaterial *GetPhysicsMaterial() const;
+    AABox GetAABBoxWorld() const;
 
     // Serializable
     virtual void Reflect() override;
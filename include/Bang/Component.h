@@ -7,6 +7,7 @@
 #include "Bang/BangDefines.h"
 #include "Bang/ClassDB.h"
 #include "Bang/ComponentMacros.h"
+#include "Bang/ComponentUpdateAccess.h"
 #include "Bang/EventEmitter.h"
 #include "Bang/EventListener.tcc"
 #include "Bang/IToString.h"
@@ -36,6 +37,13 @@ public:
 
     GameObject *GetGameObject() const;
 
+    virtual ComponentUpdateAccess GetUpdateAccess() const;
+
+    // GameObjects (apart from its own subtree) whose update must have finished
+    // before this component is updated in parallel. The scene caches them, so
+    // call SceneParallelUpdater::InvalidateSubtrees() when they change
+    virtual void GetUpdateDependencies(Array<GameObject *> *dependencies) const;
+
     // Serializable
     virtual void CloneInto(Serializable *clone, bool cloneGUID) const override;
 
@@ -45,6 +53,9 @@ public:
     // Serializable
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
+    virtual void CompileImportMeta(
+        const MetaNode &metaNode,
+        Array<ReflectImportOp> *importOps) const override;
 
 protected:
     Component();
@@ -76,6 +87,9 @@ protected:
     // Object
     bool CalculateEnabledRecursively() const override;
 
+    // Serializable
+    void OnGUIDChanged(const GUID &previousGUID) override;
+
 private:
     GameObject *p_gameObject = nullptr;
 
@@ -17,10 +17,12 @@ namespace Bang
     ASSERT(gameObject->HasComponent<CLASS>())
 
 #define COMPONENT_ABSTRACT_(CLASS) \
+    SET_CLASS_ID(CLASS)            \
     OBJECT_ABSTRACT(CLASS)         \
     friend class Bang::GameObject;
 
 #define COMPONENT_ABSTRACT(CLASS) \
+    SET_CLASS_ID(CLASS)           \
     OBJECT_ABSTRACT(CLASS)        \
     friend class Bang::Component; \
     friend class Bang::GameObject;
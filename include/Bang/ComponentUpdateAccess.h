@@ -0,0 +1,20 @@
+#ifndef COMPONENTUPDATEACCESS_H
+#define COMPONENTUPDATEACCESS_H
+
+#include "Bang/Bang.h"
+
+namespace Bang
+{
+// What the update functions (OnUpdate, OnAfterChildrenUpdate) of a component
+// may touch, so that the scene knows what can be updated in parallel
+enum class ComponentUpdateAccess
+{
+    // Anything. Updated in the main thread.
+    MAIN_THREAD,
+
+    // Only its GameObject, its descendants and the declared dependencies
+    GAMEOBJECT_SUBTREE
+};
+}
+
+#endif  // COMPONENTUPDATEACCESS_H
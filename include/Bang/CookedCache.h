@@ -0,0 +1,107 @@
+#ifndef COOKEDCACHE_H
+#define COOKEDCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Path.h"
+#include "Bang/String.h"
+
+namespace Bang
+{
+class MappedFile;
+
+// Cache of the processed ("cooked") form of imported files, so that later
+// imports of the same contents skip the parsing and decoding. Entries are
+// named after a hash of the source file contents plus the kind and version of
+// the cooked format, so editing the source file or changing the format
+// invalidates them by itself. The hash is kept in a stamp entry of the
+// source, with its modification time and size, and the contents are only
+// hashed again when those change. Entries are written in the native byte order,
+// since the cache is local to the machine. Reading an entry marks it as used,
+// and CollectGarbage removes the ones that have not been used for a while,
+// such as the ones of sources that have been edited since.
+class CookedCache
+{
+public:
+    // Empty if the source file can not be read
+    static String GetKey(const Path &sourceFilepath,
+                         const String &kind,
+                         uint version);
+
+    // Maps the whole entry, if it is there
+    static bool Read(const String &key, MappedFile *mappedFile);
+    static void Write(const String &key, const Array<Byte> &bytes);
+
+    // Removes the entries unused for MaxUnusedTime, and then the least
+    // recently used ones until the cache fits in MaxTotalSize
+    static void CollectGarbage();
+
+    static Path GetDirectory();
+    static Path GetEntryPath(const String &key);
+
+    // Entry with the last hash of the contents of the source
+    static String GetSourceStampKey(const Path &sourceFilepath);
+
+    // To compare cooked and uncooked imports
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+
+    CookedCache() = delete;
+};
+
+class CookedWriter
+{
+public:
+    void Write(uint32_t value);
+    void Write(float value);
+    void Write(const String &str);
+
+    // T must be plain data, like a vector or a matrix, it is copied as is
+    template <class T>
+    void WriteData(const T &data);
+    template <class T>
+    void WriteArray(const Array<T> &array);
+
+    const Array<Byte> &GetBytes() const;
+
+private:
+    Array<Byte> m_bytes;
+
+    void WriteBytes(const void *data, std::size_t size);
+};
+
+// Reads what a CookedWriter wrote. Every read is bounds checked, and once
+// one fails all the following ones fail too.
+class CookedReader
+{
+public:
+    CookedReader(const Byte *data, std::size_t size);
+
+    bool Read(uint32_t *value);
+    bool Read(float *value);
+    bool Read(String *str);
+
+    template <class T>
+    bool ReadData(T *data);
+    template <class T>
+    bool ReadArray(Array<T> *array);
+
+    bool IsOk() const;
+    bool IsAtEnd() const;
+
+private:
+    const Byte *p_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_pos = 0;
+    bool m_ok = true;
+
+    bool ReadBytes(void *data, std::size_t size);
+};
+}
+
+#include "Bang/CookedCache.tcc"
+
+#endif  // COOKEDCACHE_H
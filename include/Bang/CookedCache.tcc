@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Bang/CookedCache.h"
+
+namespace Bang
+{
+template <class T>
+void CookedWriter::WriteData(const T &data)
+{
+    WriteBytes(&data, sizeof(T));
+}
+
+template <class T>
+void CookedWriter::WriteArray(const Array<T> &array)
+{
+    Write(SCAST<uint32_t>(array.Size()));
+    if (array.Size() > 0)
+    {
+        WriteBytes(array.Data(), array.Size() * sizeof(T));
+    }
+}
+
+template <class T>
+bool CookedReader::ReadData(T *data)
+{
+    return ReadBytes(data, sizeof(T));
+}
+
+template <class T>
+bool CookedReader::ReadArray(Array<T> *array)
+{
+    uint32_t arraySize = 0;
+    if (!Read(&arraySize) || arraySize > (m_size - m_pos) / sizeof(T))
+    {
+        m_ok = false;
+        return false;
+    }
+
+    array->Resize(arraySize);
+    return (arraySize == 0) || ReadBytes(array->Data(), arraySize * sizeof(T));
+}
+}
@@ -0,0 +1,99 @@
+#ifndef DYNAMICAABBTREE_H
+#define DYNAMICAABBTREE_H
+
+#include <functional>
+
+#include "BangMath/AABox.h"
+#include "BangMath/Ray.h"
+#include "BangMath/Sphere.h"
+#include "Bang/Array.h"
+#include "Bang/Bang.h"
+#include "Bang/Frustum.h"
+
+namespace Bang
+{
+// Bounding volume hierarchy that can be updated incrementally. Every proxy
+// is stored in a leaf with a fattened box, so that small movements do not
+// need to touch the tree at all. Nodes live in a pool, so inserting and
+// removing proxies does not allocate once the pool has grown enough.
+template <class T>
+class DynamicAABBTree
+{
+public:
+    static constexpr int NullNode = -1;
+
+    // Return false from the callback to stop the query
+    using QueryCallback = std::function<bool(int proxyId, const T &userData)>;
+
+    DynamicAABBTree();
+    ~DynamicAABBTree();
+
+    int CreateProxy(const AABox &aaBox, const T &userData);
+    void DestroyProxy(int proxyId);
+
+    // Returns true if the proxy had to be reinserted in the tree
+    bool MoveProxy(int proxyId, const AABox &aaBox);
+    void Clear();
+
+    void QueryAABox(const AABox &aaBox, const QueryCallback &callback) const;
+    void QuerySphere(const Sphere &sphere,
+                     const QueryCallback &callback) const;
+    void QueryFrustum(const Frustum &frustum,
+                      const QueryCallback &callback,
+                      bool testDepth = true) const;
+    void QueryRay(const Ray &ray,
+                  float maxDistance,
+                  const QueryCallback &callback) const;
+
+    void SetFatMargin(float fatMargin);
+
+    float GetFatMargin() const;
+    const T &GetUserData(int proxyId) const;
+    const AABox &GetFatAABox(int proxyId) const;
+    uint GetNumProxies() const;
+    int GetHeight() const;
+
+    static bool Overlaps(const AABox &lhs, const AABox &rhs);
+    static bool Contains(const AABox &outer, const AABox &inner);
+    static bool Intersects(const AABox &aaBox, const Sphere &sphere);
+    static bool Intersects(const AABox &aaBox,
+                           const Ray &ray,
+                           float maxDistance);
+    static float GetSurfaceArea(const AABox &aaBox);
+    static AABox Merge(const AABox &lhs, const AABox &rhs);
+
+private:
+    struct Node
+    {
+        AABox aaBox;
+        T userData;
+        int parent = NullNode;  // Next free node when in the free list
+        int child1 = NullNode;
+        int child2 = NullNode;
+        int height = -1;  // -1 means free node, 0 means leaf
+
+        bool IsLeaf() const;
+    };
+
+    Array<Node> m_nodes;
+    int m_rootNode = NullNode;
+    int m_freeList = NullNode;
+    uint m_numProxies = 0;
+    float m_fatMargin = 0.1f;
+
+    int AllocateNode();
+    void FreeNode(int nodeId);
+
+    void InsertLeaf(int leafId);
+    void RemoveLeaf(int leafId);
+    int Balance(int nodeId);
+    void RefitAncestors(int nodeId);
+
+    void Query(const std::function<bool(const AABox &)> &nodeTest,
+               const QueryCallback &callback) const;
+};
+}
+
+#include "Bang/DynamicAABBTree.tcc"
+
+#endif  // DYNAMICAABBTREE_H
@@ -0,0 +1,554 @@
+#pragma once
+
+#include "Bang/Assert.h"
+#include "Bang/DynamicAABBTree.h"
+#include "BangMath/Math.h"
+#include "BangMath/Vector3.h"
+
+using namespace Bang;
+
+template <class T>
+bool DynamicAABBTree<T>::Node::IsLeaf() const
+{
+    return (child1 == NullNode);
+}
+
+template <class T>
+DynamicAABBTree<T>::DynamicAABBTree()
+{
+}
+
+template <class T>
+DynamicAABBTree<T>::~DynamicAABBTree()
+{
+}
+
+template <class T>
+int DynamicAABBTree<T>::CreateProxy(const AABox &aaBox, const T &userData)
+{
+    const Vector3 margin = Vector3(GetFatMargin());
+    const int proxyId = AllocateNode();
+    Node &node = m_nodes[proxyId];
+    node.aaBox = AABox(aaBox.GetMin() - margin, aaBox.GetMax() + margin);
+    node.userData = userData;
+    node.height = 0;
+
+    InsertLeaf(proxyId);
+    ++m_numProxies;
+    return proxyId;
+}
+
+template <class T>
+void DynamicAABBTree<T>::DestroyProxy(int proxyId)
+{
+    ASSERT(proxyId >= 0 && proxyId < SCAST<int>(m_nodes.Size()));
+    ASSERT(m_nodes[proxyId].IsLeaf());
+
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    --m_numProxies;
+}
+
+template <class T>
+bool DynamicAABBTree<T>::MoveProxy(int proxyId, const AABox &aaBox)
+{
+    ASSERT(proxyId >= 0 && proxyId < SCAST<int>(m_nodes.Size()));
+    ASSERT(m_nodes[proxyId].IsLeaf());
+
+    const Vector3 margin = Vector3(GetFatMargin());
+    const AABox fatAABox(aaBox.GetMin() - margin, aaBox.GetMax() + margin);
+    const AABox &currentFatAABox = m_nodes[proxyId].aaBox;
+
+    // Reinsert only if the box escaped its fat box, or if it has shrunk so
+    // much that the fat box is not tight anymore
+    if (Contains(currentFatAABox, aaBox) &&
+        GetSurfaceArea(currentFatAABox) <= GetSurfaceArea(fatAABox) * 4.0f)
+    {
+        return false;
+    }
+
+    RemoveLeaf(proxyId);
+    m_nodes[proxyId].aaBox = fatAABox;
+    InsertLeaf(proxyId);
+    return true;
+}
+
+template <class T>
+void DynamicAABBTree<T>::Clear()
+{
+    m_nodes.Clear();
+    m_rootNode = NullNode;
+    m_freeList = NullNode;
+    m_numProxies = 0;
+}
+
+template <class T>
+void DynamicAABBTree<T>::QueryAABox(const AABox &aaBox,
+                                    const QueryCallback &callback) const
+{
+    Query([&aaBox](const AABox &nodeBox) { return Overlaps(nodeBox, aaBox); },
+          callback);
+}
+
+template <class T>
+void DynamicAABBTree<T>::QuerySphere(const Sphere &sphere,
+                                     const QueryCallback &callback) const
+{
+    Query(
+        [&sphere](const AABox &nodeBox) {
+            return Intersects(nodeBox, sphere);
+        },
+        callback);
+}
+
+template <class T>
+void DynamicAABBTree<T>::QueryFrustum(const Frustum &frustum,
+                                      const QueryCallback &callback,
+                                      bool testDepth) const
+{
+    Query(
+        [&frustum, testDepth](const AABox &nodeBox) {
+            return frustum.Intersects(nodeBox, testDepth);
+        },
+        callback);
+}
+
+template <class T>
+void DynamicAABBTree<T>::QueryRay(const Ray &ray,
+                                  float maxDistance,
+                                  const QueryCallback &callback) const
+{
+    Query(
+        [&ray, maxDistance](const AABox &nodeBox) {
+            return Intersects(nodeBox, ray, maxDistance);
+        },
+        callback);
+}
+
+template <class T>
+void DynamicAABBTree<T>::SetFatMargin(float fatMargin)
+{
+    m_fatMargin = fatMargin;
+}
+
+template <class T>
+float DynamicAABBTree<T>::GetFatMargin() const
+{
+    return m_fatMargin;
+}
+
+template <class T>
+const T &DynamicAABBTree<T>::GetUserData(int proxyId) const
+{
+    return m_nodes[proxyId].userData;
+}
+
+template <class T>
+const AABox &DynamicAABBTree<T>::GetFatAABox(int proxyId) const
+{
+    return m_nodes[proxyId].aaBox;
+}
+
+template <class T>
+uint DynamicAABBTree<T>::GetNumProxies() const
+{
+    return m_numProxies;
+}
+
+template <class T>
+int DynamicAABBTree<T>::GetHeight() const
+{
+    return (m_rootNode != NullNode) ? m_nodes[m_rootNode].height : 0;
+}
+
+template <class T>
+bool DynamicAABBTree<T>::Overlaps(const AABox &lhs, const AABox &rhs)
+{
+    const Vector3 &lMin = lhs.GetMin(), &lMax = lhs.GetMax();
+    const Vector3 &rMin = rhs.GetMin(), &rMax = rhs.GetMax();
+    return (lMin.x <= rMax.x && lMax.x >= rMin.x) &&
+           (lMin.y <= rMax.y && lMax.y >= rMin.y) &&
+           (lMin.z <= rMax.z && lMax.z >= rMin.z);
+}
+
+template <class T>
+bool DynamicAABBTree<T>::Contains(const AABox &outer, const AABox &inner)
+{
+    const Vector3 &oMin = outer.GetMin(), &oMax = outer.GetMax();
+    const Vector3 &iMin = inner.GetMin(), &iMax = inner.GetMax();
+    return (oMin.x <= iMin.x && oMin.y <= iMin.y && oMin.z <= iMin.z) &&
+           (oMax.x >= iMax.x && oMax.y >= iMax.y && oMax.z >= iMax.z);
+}
+
+template <class T>
+bool DynamicAABBTree<T>::Intersects(const AABox &aaBox, const Sphere &sphere)
+{
+    const Vector3 &c = sphere.GetCenter();
+    const Vector3 closestPoint =
+        Vector3::Max(aaBox.GetMin(), Vector3::Min(c, aaBox.GetMax()));
+    const Vector3 diff = (closestPoint - c);
+    const float r = sphere.GetRadius();
+    return Vector3::Dot(diff, diff) <= (r * r);
+}
+
+template <class T>
+bool DynamicAABBTree<T>::Intersects(const AABox &aaBox,
+                                    const Ray &ray,
+                                    float maxDistance)
+{
+    // Slab test
+    const Vector3 &o = ray.GetOrigin();
+    const Vector3 &d = ray.GetDirection();
+    const Vector3 &bMin = aaBox.GetMin();
+    const Vector3 &bMax = aaBox.GetMax();
+    const float origin[3] = {o.x, o.y, o.z};
+    const float dir[3] = {d.x, d.y, d.z};
+    const float boxMin[3] = {bMin.x, bMin.y, bMin.z};
+    const float boxMax[3] = {bMax.x, bMax.y, bMax.z};
+
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (Math::Abs(dir[i]) < 1e-8f)
+        {
+            if (origin[i] < boxMin[i] || origin[i] > boxMax[i])
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const float invDir = 1.0f / dir[i];
+            float t1 = (boxMin[i] - origin[i]) * invDir;
+            float t2 = (boxMax[i] - origin[i]) * invDir;
+            if (t1 > t2)
+            {
+                std::swap(t1, t2);
+            }
+            tMin = Math::Max(tMin, t1);
+            tMax = Math::Min(tMax, t2);
+            if (tMin > tMax)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <class T>
+float DynamicAABBTree<T>::GetSurfaceArea(const AABox &aaBox)
+{
+    const Vector3 size = (aaBox.GetMax() - aaBox.GetMin());
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+template <class T>
+AABox DynamicAABBTree<T>::Merge(const AABox &lhs, const AABox &rhs)
+{
+    return AABox(Vector3::Min(lhs.GetMin(), rhs.GetMin()),
+                 Vector3::Max(lhs.GetMax(), rhs.GetMax()));
+}
+
+template <class T>
+int DynamicAABBTree<T>::AllocateNode()
+{
+    if (m_freeList == NullNode)
+    {
+        m_nodes.PushBack(Node());
+        return SCAST<int>(m_nodes.Size()) - 1;
+    }
+
+    const int nodeId = m_freeList;
+    Node &node = m_nodes[nodeId];
+    m_freeList = node.parent;
+    node.parent = node.child1 = node.child2 = NullNode;
+    node.height = 0;
+    return nodeId;
+}
+
+template <class T>
+void DynamicAABBTree<T>::FreeNode(int nodeId)
+{
+    Node &node = m_nodes[nodeId];
+    node.userData = T();
+    node.parent = m_freeList;
+    node.child1 = node.child2 = NullNode;
+    node.height = -1;
+    m_freeList = nodeId;
+}
+
+template <class T>
+void DynamicAABBTree<T>::InsertLeaf(int leafId)
+{
+    if (m_rootNode == NullNode)
+    {
+        m_rootNode = leafId;
+        m_nodes[leafId].parent = NullNode;
+        return;
+    }
+
+    // Find the best sibling, using the surface area heuristic
+    const AABox leafAABox = m_nodes[leafId].aaBox;
+    int nodeId = m_rootNode;
+    while (!m_nodes[nodeId].IsLeaf())
+    {
+        const Node &node = m_nodes[nodeId];
+        const float area = GetSurfaceArea(node.aaBox);
+        const float combinedArea =
+            GetSurfaceArea(Merge(node.aaBox, leafAABox));
+
+        // Cost of creating a new parent for this node and the new leaf
+        const float cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto GetDescendCost = [&](int childId) {
+            const Node &child = m_nodes[childId];
+            const float mergedArea =
+                GetSurfaceArea(Merge(child.aaBox, leafAABox));
+            return child.IsLeaf()
+                       ? (mergedArea + inheritanceCost)
+                       : (mergedArea - GetSurfaceArea(child.aaBox) +
+                          inheritanceCost);
+        };
+        const float cost1 = GetDescendCost(node.child1);
+        const float cost2 = GetDescendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+        nodeId = (cost1 < cost2) ? node.child1 : node.child2;
+    }
+
+    // Create a new parent for the sibling and the leaf. The node pool might
+    // grow here, so do not keep references to nodes across this call.
+    const int siblingId = nodeId;
+    const int oldParentId = m_nodes[siblingId].parent;
+    const int newParentId = AllocateNode();
+    {
+        Node &newParent = m_nodes[newParentId];
+        newParent.parent = oldParentId;
+        newParent.userData = T();
+        newParent.aaBox = Merge(leafAABox, m_nodes[siblingId].aaBox);
+        newParent.height = m_nodes[siblingId].height + 1;
+        newParent.child1 = siblingId;
+        newParent.child2 = leafId;
+    }
+
+    if (oldParentId != NullNode)
+    {
+        Node &oldParent = m_nodes[oldParentId];
+        if (oldParent.child1 == siblingId)
+        {
+            oldParent.child1 = newParentId;
+        }
+        else
+        {
+            oldParent.child2 = newParentId;
+        }
+    }
+    else
+    {
+        m_rootNode = newParentId;
+    }
+    m_nodes[siblingId].parent = newParentId;
+    m_nodes[leafId].parent = newParentId;
+
+    RefitAncestors(newParentId);
+}
+
+template <class T>
+void DynamicAABBTree<T>::RemoveLeaf(int leafId)
+{
+    if (leafId == m_rootNode)
+    {
+        m_rootNode = NullNode;
+        return;
+    }
+
+    const int parentId = m_nodes[leafId].parent;
+    const int grandParentId = m_nodes[parentId].parent;
+    const int siblingId = (m_nodes[parentId].child1 == leafId)
+                              ? m_nodes[parentId].child2
+                              : m_nodes[parentId].child1;
+
+    if (grandParentId != NullNode)
+    {
+        Node &grandParent = m_nodes[grandParentId];
+        if (grandParent.child1 == parentId)
+        {
+            grandParent.child1 = siblingId;
+        }
+        else
+        {
+            grandParent.child2 = siblingId;
+        }
+        m_nodes[siblingId].parent = grandParentId;
+        FreeNode(parentId);
+        RefitAncestors(grandParentId);
+    }
+    else
+    {
+        m_rootNode = siblingId;
+        m_nodes[siblingId].parent = NullNode;
+        FreeNode(parentId);
+    }
+    m_nodes[leafId].parent = NullNode;
+}
+
+template <class T>
+void DynamicAABBTree<T>::RefitAncestors(int nodeId)
+{
+    while (nodeId != NullNode)
+    {
+        nodeId = Balance(nodeId);
+
+        Node &node = m_nodes[nodeId];
+        const Node &child1 = m_nodes[node.child1];
+        const Node &child2 = m_nodes[node.child2];
+        node.height = 1 + Math::Max(child1.height, child2.height);
+        node.aaBox = Merge(child1.aaBox, child2.aaBox);
+
+        nodeId = node.parent;
+    }
+}
+
+template <class T>
+int DynamicAABBTree<T>::Balance(int aId)
+{
+    // Performs a left or right rotation if the node is unbalanced.
+    // Returns the id of the new subtree root.
+    Node &a = m_nodes[aId];
+    if (a.IsLeaf() || a.height < 2)
+    {
+        return aId;
+    }
+
+    const int bId = a.child1;
+    const int cId = a.child2;
+    Node &b = m_nodes[bId];
+    Node &c = m_nodes[cId];
+
+    auto ReplaceChildOfParent = [this](int parentId, int oldId, int newId) {
+        if (parentId != NullNode)
+        {
+            Node &parent = m_nodes[parentId];
+            if (parent.child1 == oldId)
+            {
+                parent.child1 = newId;
+            }
+            else
+            {
+                parent.child2 = newId;
+            }
+        }
+        else
+        {
+            m_rootNode = newId;
+        }
+    };
+
+    const int balance = c.height - b.height;
+    if (balance > 1)
+    {
+        // Rotate c up
+        const int fId = c.child1;
+        const int gId = c.child2;
+        Node &f = m_nodes[fId];
+        Node &g = m_nodes[gId];
+
+        c.child1 = aId;
+        c.parent = a.parent;
+        a.parent = cId;
+        ReplaceChildOfParent(c.parent, aId, cId);
+
+        const bool fIsHigher = (f.height > g.height);
+        const int keptId = fIsHigher ? fId : gId;
+        const int movedId = fIsHigher ? gId : fId;
+        Node &kept = m_nodes[keptId];
+        Node &moved = m_nodes[movedId];
+
+        c.child2 = keptId;
+        a.child2 = movedId;
+        moved.parent = aId;
+        a.aaBox = Merge(b.aaBox, moved.aaBox);
+        c.aaBox = Merge(a.aaBox, kept.aaBox);
+        a.height = 1 + Math::Max(b.height, moved.height);
+        c.height = 1 + Math::Max(a.height, kept.height);
+        return cId;
+    }
+
+    if (balance < -1)
+    {
+        // Rotate b up
+        const int dId = b.child1;
+        const int eId = b.child2;
+        Node &d = m_nodes[dId];
+        Node &e = m_nodes[eId];
+
+        b.child1 = aId;
+        b.parent = a.parent;
+        a.parent = bId;
+        ReplaceChildOfParent(b.parent, aId, bId);
+
+        const bool dIsHigher = (d.height > e.height);
+        const int keptId = dIsHigher ? dId : eId;
+        const int movedId = dIsHigher ? eId : dId;
+        Node &kept = m_nodes[keptId];
+        Node &moved = m_nodes[movedId];
+
+        b.child2 = keptId;
+        a.child1 = movedId;
+        moved.parent = aId;
+        a.aaBox = Merge(c.aaBox, moved.aaBox);
+        b.aaBox = Merge(a.aaBox, kept.aaBox);
+        a.height = 1 + Math::Max(c.height, moved.height);
+        b.height = 1 + Math::Max(a.height, kept.height);
+        return bId;
+    }
+
+    return aId;
+}
+
+template <class T>
+void DynamicAABBTree<T>::Query(
+    const std::function<bool(const AABox &)> &nodeTest,
+    const QueryCallback &callback) const
+{
+    if (m_rootNode == NullNode)
+    {
+        return;
+    }
+
+    Array<int> stack;
+    stack.Reserve(64);
+    stack.PushBack(m_rootNode);
+    while (!stack.IsEmpty())
+    {
+        const int nodeId = stack.Back();
+        stack.PopBack();
+
+        const Node &node = m_nodes[nodeId];
+        if (!nodeTest(node.aaBox))
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            if (!callback(nodeId, node.userData))
+            {
+                return;
+            }
+        }
+        else
+        {
+            stack.PushBack(node.child1);
+            stack.PushBack(node.child2);
+        }
+    }
+}
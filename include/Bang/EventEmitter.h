@@ -1,15 +1,20 @@
 #ifndef EVENTEMITTER_H
 #define EVENTEMITTER_H
 
-#include <functional>
-
 #include "Bang/Array.h"
+#include "Bang/UMap.h"
 
 namespace Bang
 {
 template <class>
 class EventListener;
 
+// Listeners are kept in registration order in an array of slots, plus a hash
+// table from listener to slot, so that registering and unregistering are
+// O(1). Listeners unregistered during a propagation leave an empty slot
+// behind, and the slots are compacted once there are enough empty ones and
+// nothing is being propagated. Listeners registered during a propagation do
+// not receive the event being propagated.
 template <class T>
 class EventEmitter
 {
@@ -28,9 +33,9 @@ public:
                           const TFunction &func,
                           const Args &... args) const;
 
-    void PropagateToArrayFunctor(
-        const Array<EventListener<T> *> &array,
-        std::function<void(EventListener<T> *)> listenerCall) const;
+    template <class TFunctor>
+    void PropagateToArrayFunctor(const Array<EventListener<T> *> &array,
+                                 const TFunctor &listenerCall) const;
 
     template <class TFunction, class... Args>
     void PropagateToListeners(const TFunction &func,
@@ -46,6 +51,7 @@ public:
         const TFunction &func,
         const Args &... args) const;
 
+    // May contain null slots, of listeners unregistered while propagating
     Array<EventListener<T> *> &GetListeners();
     const Array<EventListener<T> *> &GetListeners() const;
 
@@ -57,6 +63,10 @@ private:
     bool m_emitEvents = true;
     mutable int m_iterationDepth = 0;
     Array<EventListener<T> *> m_listeners;
+    UMap<EventListener<T> *, uint> m_listenerSlots;
+    uint m_numDeletedListeners = 0;
+
+    void ClearDeletedListenersIfNeeded();
 };
 }
 
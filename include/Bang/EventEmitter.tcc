@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Bang/EventEmitter.h"
+#include "Bang/UMap.tcc"
 
 using namespace Bang;
 
@@ -32,8 +33,9 @@ bool EventEmitter<T>::IsEmittingEvents() const
 template <class T>
 void EventEmitter<T>::RegisterListener(EventListener<T> *listener)
 {
-    if (!m_listeners.Contains(listener))
+    if (!m_listenerSlots.ContainsKey(listener))
     {
+        m_listenerSlots.Add(listener, m_listeners.Size());
         m_listeners.PushBack(listener);
         listener->AddEmitter(this);
     }
@@ -42,25 +44,27 @@ void EventEmitter<T>::RegisterListener(EventListener<T> *listener)
 template <class T>
 void EventEmitter<T>::UnRegisterListener(EventListener<T> *listener)
 {
-    if (m_iterationDepth == 0)
-    {
-        m_listeners.Remove(listener);
-    }
-    else
-    {
-        MarkListenerAsDeleted(listener);
-    }
+    MarkListenerAsDeleted(listener);
+    ClearDeletedListenersIfNeeded();
     listener->RemoveEmitter(this);
 }
 
 template <class T>
 void EventEmitter<T>::MarkListenerAsDeleted(EventListener<T> *listener)
 {
-    for (uint i = 0; i < GetListeners().Size(); ++i)
+    auto it = m_listenerSlots.Find(listener);
+    if (it != m_listenerSlots.End())
     {
-        if (GetListeners()[i] == listener)
+        const uint slot = it->second;
+        m_listenerSlots.Remove(it);
+        if (slot + 1 == m_listeners.Size() && m_iterationDepth == 0)
+        {
+            m_listeners.PopBack();
+        }
+        else
         {
-            GetListeners()[i] = nullptr;
+            m_listeners[slot] = nullptr;
+            ++m_numDeletedListeners;
         }
     }
 }
@@ -69,7 +73,36 @@ template <class T>
 void EventEmitter<T>::ClearDeletedListeners()
 {
     ASSERT(m_iterationDepth == 0);
-    GetListeners().RemoveAll(nullptr);
+    if (m_numDeletedListeners == 0)
+    {
+        return;
+    }
+
+    // Keeps the registration order
+    uint numListeners = 0;
+    for (uint i = 0; i < m_listeners.Size(); ++i)
+    {
+        if (EventListener<T> *listener = m_listeners[i])
+        {
+            m_listeners[numListeners] = listener;
+            m_listenerSlots[listener] = numListeners;
+            ++numListeners;
+        }
+    }
+    m_listeners.Resize(numListeners);
+    m_numDeletedListeners = 0;
+}
+
+template <class T>
+void EventEmitter<T>::ClearDeletedListenersIfNeeded()
+{
+    // Compacting only when at least half of the slots are empty keeps the
+    // unregistering cost O(1) amortized
+    if (m_iterationDepth == 0 &&
+        m_numDeletedListeners * 2 >= m_listeners.Size())
+    {
+        ClearDeletedListeners();
+    }
 }
 
 template <class T>
@@ -108,9 +141,10 @@ void EventEmitter<T>::PropagateToListenersAndArray(
 }
 
 template <class T>
+template <class TFunctor>
 void EventEmitter<T>::PropagateToArrayFunctor(
     const Array<EventListener<T> *> &array,
-    std::function<void(EventListener<T> *)> listenerCall) const
+    const TFunctor &listenerCall) const
 {
     const bool propagatingToListeners = (&array == &m_listeners);
     const std::size_t arraySize = array.Size();
@@ -121,6 +155,7 @@ void EventEmitter<T>::PropagateToArrayFunctor(
             ++m_iterationDepth;
         }
 
+        // Indexed, since listeners registered meanwhile can grow the array
         for (uint i = 0; i < arraySize; ++i)
         {
             if (EventListener<T> *listener = array[i])
@@ -137,7 +172,7 @@ void EventEmitter<T>::PropagateToArrayFunctor(
             if (--m_iterationDepth == 0)
             {
                 EventEmitter<T> *ncThis = const_cast<EventEmitter<T> *>(this);
-                ncThis->ClearDeletedListeners();
+                ncThis->ClearDeletedListenersIfNeeded();
             }
         }
     }
@@ -2,6 +2,7 @@
 #define EVENTLISTENER_H
 
 #include "Bang/IEventListenerCommon.h"
+#include "Bang/USet.h"
 
 namespace Bang
 {
@@ -22,7 +23,7 @@ protected:
 
 private:
     bool m_receivesEvents = true;
-    Array<EventEmitter<T> *> m_emitters;
+    USet<EventEmitter<T> *> m_emitters;
 
     void AddEmitter(EventEmitter<T> *emitter);
     void RemoveEmitter(EventEmitter<T> *emitter);
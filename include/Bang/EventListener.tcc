@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Bang/EventListener.h"
+#include "Bang/USet.tcc"
 
 using namespace Bang;
 
@@ -9,7 +10,7 @@ EventListener<T>::~EventListener()
 {
     while (!m_emitters.IsEmpty())
     {
-        m_emitters.Front()->UnRegisterListener(this);
+        (*m_emitters.Begin())->UnRegisterListener(this);
     }
 }
 
@@ -34,10 +35,7 @@ bool EventListener<T>::IsReceivingEvents() const
 template <class T>
 void EventListener<T>::AddEmitter(EventEmitter<T> *emitter)
 {
-    if (!m_emitters.Contains(emitter))
-    {
-        m_emitters.PushBack(emitter);
-    }
+    m_emitters.Add(emitter);
 }
 
 template <class T>
@@ -19,6 +19,10 @@ namespace Bang
 class Path;
 class String;
 
+// Tracks paths and notifies when they are added, modified or removed. On
+// Linux the tracked directories are watched with inotify, so that CheckFiles
+// only looks at the paths that had events since the previous check. If that
+// is not possible (or polling is forced), every tracked path is checked.
 class FileTracker : public EventEmitter<IEventsFileTracker>
 {
 public:
@@ -31,6 +35,9 @@ public:
 
     void CheckFiles();
 
+    void SetForcePolling(bool forcePolling);
+    bool IsPolling() const;
+
     Time GetModificationTime(const Path &path) const;
     const USet<Path> &GetTrackedPaths() const;
     Array<Path> GetTrackedPathsWithExtensions(
@@ -42,6 +49,21 @@ private:
     USet<Path> m_trackedPaths;
     USet<Path> m_pathsJustRecentlyTracked;
     UMap<Path, Time> m_pathsToTrackToModificationTime;
+
+    bool m_forcePolling = false;
+    int m_watchFd = -1;
+    UMap<int, Path> m_watchIdToPath;
+    UMap<Path, int> m_pathToWatchId;
+
+    void CheckFilesPolling();
+    void CheckPaths(const USet<Path> &paths);
+
+    bool StartWatching();
+    void StopWatching();
+    bool IsWatching() const;
+    void AddWatch(const Path &path);
+    void RemoveWatch(const Path &path);
+    bool ReadWatchEvents(USet<Path> *changedPaths);
 };
 }  // namespace Bang
 
@@ -0,0 +1,53 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <array>
+
+#include "BangMath/AABox.h"
+#include "BangMath/Matrix4.h"
+#include "BangMath/Sphere.h"
+#include "BangMath/Vector3.h"
+#include "Bang/BangDefines.h"
+
+namespace Bang
+{
+enum class FrustumPlane
+{
+    LEFT = 0,
+    RIGHT = 1,
+    BOT = 2,
+    TOP = 3,
+    NEAR_PLANE = 4,
+    FAR_PLANE = 5
+};
+
+class Frustum
+{
+public:
+    static constexpr uint NumPlanes = 6;
+
+    Frustum();
+    explicit Frustum(const Matrix4 &viewProjectionMatrix);
+    ~Frustum();
+
+    void SetFromViewProjectionMatrix(const Matrix4 &viewProjectionMatrix);
+
+    // All the tests are conservative: something that intersects the frustum
+    // is never reported as outside of it. When testDepth is false, the near
+    // and far planes are ignored (useful for shadow casters, for example).
+    bool Contains(const Vector3 &point) const;
+    bool Intersects(const AABox &aaBox, bool testDepth = true) const;
+    bool Intersects(const Sphere &sphere, bool testDepth = true) const;
+
+    const Vector3 &GetPlaneNormal(FrustumPlane plane) const;
+    float GetPlaneDistance(FrustumPlane plane) const;
+    float GetSignedDistance(FrustumPlane plane, const Vector3 &point) const;
+
+private:
+    // Planes stored as (normal, distance), with normals pointing inside
+    std::array<Vector3, NumPlanes> m_planeNormals;
+    std::array<float, NumPlanes> m_planeDistances;
+};
+}
+
+#endif  // FRUSTUM_H
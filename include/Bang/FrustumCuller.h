@@ -0,0 +1,80 @@
+#ifndef FRUSTUMCULLER_H
+#define FRUSTUMCULLER_H
+
+#include "BangMath/AABox.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/Frustum.h"
+#include "Bang/RenderPass.h"
+#include "Bang/USet.h"
+
+namespace Bang
+{
+class Camera;
+class Renderer;
+class SceneSpatialIndex;
+
+struct FrustumCullingStats
+{
+    uint numTested = 0;
+    uint numVisible = 0;
+    uint numCulled = 0;
+
+    void Reset();
+    void Accumulate(const FrustumCullingStats &stats);
+};
+
+class FrustumCuller
+{
+public:
+    FrustumCuller();
+    ~FrustumCuller();
+
+    // Computes the set of renderers that are culled for the given frustum.
+    // Results stay valid until Clear() or the next Cull().
+    void Cull(const Frustum &frustum,
+              const Array<Renderer *> &renderers,
+              Camera *cullingCamera = nullptr);
+    void Cull(const Frustum &frustum,
+              SceneSpatialIndex *spatialIndex,
+              Camera *cullingCamera = nullptr);
+    void Clear();
+
+    void SetEnabled(bool enabled);
+
+    bool IsEnabled() const;
+    bool IsCulled(const Renderer *renderer) const;
+    bool HasCullResultsFor(const Camera *camera) const;
+    const Array<Renderer *> &GetVisibleRenderers() const;
+    const FrustumCullingStats &GetStats() const;
+
+    // Stateless helpers, usable without any GL context
+    static bool IsCullable(const Renderer *renderer);
+    static bool IsCullablePass(RenderPass renderPass);
+    static AABox GetRendererAABoxWorld(const Renderer *renderer);
+    static bool IsVisible(const Frustum &frustum,
+                          const AABox &aaBoxWorld,
+                          bool testDepth = true);
+    static FrustumCullingStats CullAABoxes(const Frustum &frustum,
+                                           const Array<AABox> &aaBoxesWorld,
+                                           Array<uint> *visibleIndicesOut,
+                                           bool testDepth = true);
+    static FrustumCullingStats CullRenderers(
+        const Frustum &frustum,
+        const Array<Renderer *> &renderers,
+        Array<Renderer *> *visibleRenderersOut,
+        bool testDepth = true);
+
+private:
+    bool m_enabled = true;
+    bool m_hasCullResults = false;
+    bool m_cullResultsFromSpatialIndex = false;
+    Camera *p_cullingCamera = nullptr;
+    USet<const Renderer *> m_culledRenderers;
+    USet<const Renderer *> m_visibleRenderersSet;
+    Array<Renderer *> m_visibleRenderers;
+    FrustumCullingStats m_stats;
+};
+}
+
+#endif  // FRUSTUMCULLER_H
@@ -12,6 +12,7 @@
 #include "Bang/EventEmitter.tcc"
 #include "Bang/EventListener.h"
 #include "Bang/EventListener.tcc"
+#include "Bang/FrustumCuller.h"
 #include "Bang/IEvents.h"
 #include "Bang/Light.h"
 #include "Bang/Map.tcc"
@@ -19,6 +20,7 @@
 #include "Bang/ObjectGatherer.tcc"
 #include "Bang/ReflectionProbe.h"
 #include "Bang/RenderPass.h"
+#include "Bang/RenderQueue.h"
 #include "Bang/StackAndValue.h"
 #include "Bang/USet.h"
 
@@ -27,6 +29,7 @@ namespace Bang
 template <class>
 class EventEmitter;
 class Camera;
+class Frustum;
 class DebugRenderer;
 class Framebuffer;
 class GBuffer;
@@ -42,6 +45,7 @@ class ShaderProgram;
 class Texture2D;
 class TextureCubeMap;
 class TextureUnitManager;
+class VBO;
 
 enum class BlurType
 {
@@ -84,6 +88,12 @@ public:
     void CopyTexture(Texture2D *source, Texture2D *destiny);
 
     void SetReplacementMaterial(Material *material);
+    void SetFrustumCullingEnabled(bool frustumCullingEnabled);
+    void SetRenderQueueEnabled(bool renderQueueEnabled);
+    Array<Renderer *> CullShadowCasters(
+        const Frustum &shadowFrustum,
+        const Array<Renderer *> &shadowCasters,
+        bool testDepth = false);
 
     void PushActiveRenderingCamera();
     void SetActiveRenderingCamera(Camera *camera);
@@ -103,6 +113,11 @@ public:
     DebugRenderer *GetDebugRenderer() const;
     RenderFactory *GetRenderFactory() const;
     Material *GetReplacementMaterial() const;
+    bool IsFrustumCullingEnabled() const;
+    const FrustumCullingStats &GetCameraCullingStats() const;
+    const FrustumCullingStats &GetShadowCullingStats() const;
+    bool IsRenderQueueEnabled() const;
+    const RenderQueueStats &GetRenderQueueStats() const;
     static Camera *GetActiveRenderingCamera();
     const Array<ReflectionProbe *> &GetReflectionProbesFor(Scene *scene) const;
 
@@ -122,6 +137,20 @@ private:
 
     MultiObjectGatherer<ReflectionProbe, true> m_reflProbesCache;
     MultiObjectGatherer<Light, true> m_lightsCache;
+    MultiObjectGatherer<Renderer, true> m_renderersCache;
+
+    FrustumCuller m_frustumCuller;
+    FrustumCullingStats m_cameraCullingStats;
+    FrustumCullingStats m_shadowCullingStats;
+
+    // Opaque scene pass render queue
+    bool m_renderQueueEnabled = true;
+    bool m_renderQueueRecording = false;
+    RenderQueue m_renderQueue;
+    RenderQueueStats m_renderQueueStats;
+    // Model and normal matrix of each instance, one after the other
+    Array<Matrix4> m_instanceMatrices;
+    VBO *p_instanceMatricesVBO = nullptr;
 
     StackAndValue<Camera *> p_renderingCameras;
     USet<Camera *> m_stackedCamerasThatHaveBeenDestroyed;
@@ -154,6 +183,10 @@ private:
     AH<ShaderProgram> p_renderTextureToViewportGammaSP;
 
     void Render(Renderer *rend);
+    void RenderInstanced(const RenderQueueBatch &batch);
+    void EnqueueRenderer(Renderer *rend, RenderPass renderPass);
+    void SubmitRenderQueue();
+    bool CanBeInstanced(Renderer *rend, ShaderProgram *sp) const;
     void RenderShadowMaps(GameObject *go);
     void RenderTexture_(Texture2D *texture, float gammaCorrection);
     void RenderReflectionProbes(GameObject *go);
@@ -48,6 +48,7 @@ public:
     static const String UniformName_HasNormalMapTexture;
     static const String UniformName_TimeSeconds;
     static const String UniformName_Model;
+    static const String UniformName_UseInstancing;
     static const String UniformName_ModelInv;
     static const String UniformName_Normal;
     static const String UniformName_View;
@@ -1,7 +1,9 @@
 #ifndef GAMEOBJECT_H
 #define GAMEOBJECT_H
 
+#include <atomic>
 #include <functional>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -36,6 +38,7 @@ class GUID;
 class Serializable;
 class RectTransform;
 class Scene;
+class SceneObjectIndex;
 class Transform;
 
 #define GAMEOBJECT_(ClassName) OBJECT(ClassName)
@@ -220,6 +223,11 @@ public:
     GameObject *GetParent() const;
     bool IsChildOf(const GameObject *_parent, bool recursive = true) const;
 
+    // Changes every time a game object is added, removed, moved or renamed in
+    // the subtree of this one (this one included), so that caches built from
+    // a subtree know when to be rebuilt
+    uint GetSubtreeVersion() const;
+
     bool IsVisible() const;
     bool IsVisibleRecursively() const;
     bool IsDontDestroyOnLoad() const;
@@ -229,8 +237,11 @@ public:
     Sphere GetBoundingSphereWorld(bool includeChildren = true) const;
 
     // Helper propagate functions
-    void PropagateToChildren(std::function<void(GameObject *)> func);
-    void PropagateToComponents(std::function<void(Component *)> func);
+    template <class TFunction>
+    void PropagateToChildren(const TFunction &func);
+
+    template <class TFunction>
+    void PropagateToComponents(const TFunction &func);
 
     template <class T, class TReturn, class... Args>
     void PropagateToChildren(TReturn T::*func, const Args &... args);
@@ -264,10 +275,17 @@ protected:
     virtual void OnEnabled(Object *object) override;
     virtual void OnDisabled(Object *object) override;
 
+    // Serializable
+    virtual void OnGUIDChanged(const GUID &previousGUID) override;
+
 private:
     Array<GameObject *> m_children;
     Array<Component *> m_components;
 
+    // Instance class ids of m_components (invalid for removed ones), so that
+    // finding a component of a class is an integer range check per component
+    Array<ClassIdType> m_componentsClassIds;
+
     String m_name = "";
     bool m_dontDestroyOnLoad = false;
 
@@ -276,6 +294,10 @@ private:
     mutable bool m_visibleRecursivelyValid = false;
 
     GameObject *p_parent = nullptr;
+    bool m_updatedInParallel = false;
+
+    // Names can be changed from the parallel update workers
+    std::atomic<uint> m_subtreeVersion{0};
 
     // Convencience cached components
     Transform *p_transform = nullptr;
@@ -308,9 +330,45 @@ private:
     void AddChild(GameObject *child, int index, bool keepWorldTransform);
     void AddChild_(GameObject *child, int index, bool keepWorldTransform);
     void RemoveChild(GameObject *child);
+    void IncreaseSubtreeVersion();
 
     Component *AddComponent_(Component *c, int index);
 
+    // Imports everything but the components and children
+    void ImportMetaProperties(const MetaNode &metaNode);
+
+    // Index of the scene this is in, if any, to resolve the Find functions
+    SceneObjectIndex *GetSceneObjectIndex() const;
+
+    // Linear walks, used when not in a scene
+    Object *GetObjectInDescendantsAndThis_(const GUID &guid) const;
+    GameObject *FindInChildren_(const GUID &guid, bool recursive) const;
+    GameObject *FindInChildren_(const String &name, bool recursive) const;
+    GameObject *FindInChildrenAndThis_(const GUID &guid, bool recursive) const;
+    GameObject *FindInChildrenAndThis_(const String &name,
+                                       bool recursive) const;
+
+    // Classes with their own class id are looked up by class id range, and
+    // the rest (interfaces, classes without class id) with dynamic casts.
+    // Every component is a Component, so that one needs no filtering at all.
+    template <class T>
+    using LookUpByClassId =
+        std::integral_constant<bool,
+                               ClassDB::HasOwnClassId<T>() &&
+                                   std::is_base_of<Component, T>::value &&
+                                   !std::is_same<Component, T>::value>;
+
+    template <class T>
+    T *FindComponent(std::true_type lookUpByClassId) const;
+    template <class T>
+    T *FindComponent(std::false_type lookUpByClassId) const;
+    template <class T>
+    void FindComponents(Array<T *> *componentsOut,
+                        std::true_type lookUpByClassId) const;
+    template <class T>
+    void FindComponents(Array<T *> *componentsOut,
+                        std::false_type lookUpByClassId) const;
+
     // Object
     bool CalculateEnabledRecursively() const override;
     bool CalculateVisibleRecursively() const;
@@ -321,9 +379,11 @@ private:
     friend class Scene;
     friend class Prefab;
     friend class GEngine;
+    friend class PrefabTemplate;
     friend class Component;
     friend class SceneManager;
     friend class RectTransform;
+    friend class SceneParallelUpdater;
 };
 }  // namespace Bang
 
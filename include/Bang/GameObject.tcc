@@ -16,17 +16,7 @@ T *GameObject::AddComponent(int index)
 template <class T>
 T *GameObject::GetComponent() const
 {
-    for (Component *comp : m_components)
-    {
-        if (comp)
-        {
-            if (T *tcomp = DCAST<T *>(comp))
-            {
-                return tcomp;
-            }
-        }
-    }
-    return nullptr;
+    return FindComponent<T>(LookUpByClassId<T>());
 }
 
 template <class T>
@@ -55,11 +45,15 @@ T *GameObject::GetComponentInParentAndThis() const
 template <class T>
 T *GameObject::GetComponentInAncestors() const
 {
-    if (T *comp = GetComponentInParent<T>())
+    for (GameObject *ascendant = GetParent(); ascendant;
+         ascendant = ascendant->GetParent())
     {
-        return comp;
+        if (T *comp = ascendant->GetComponent<T>())
+        {
+            return comp;
+        }
     }
-    return GetParent() ? GetParent()->GetComponentInAncestors<T>() : nullptr;
+    return nullptr;
 }
 
 template <class T>
@@ -132,13 +126,68 @@ Array<T *> GameObject::GetComponents() const
 template <class T>
 void GameObject::GetComponents(Array<T *> *components) const
 {
-    for (Component *comp : GetComponents())
+    FindComponents<T>(components, LookUpByClassId<T>());
+}
+
+template <class T>
+T *GameObject::FindComponent(std::true_type) const
+{
+    const ClassIdType classIdBegin = T::GetClassIdBegin();
+    const ClassIdType classIdEnd = T::GetClassIdEnd();
+    for (uint i = 0; i < m_componentsClassIds.Size(); ++i)
+    {
+        if (ClassDB::IsSubClassByIds(
+                classIdBegin, classIdEnd, m_componentsClassIds[i]))
+        {
+            return SCAST<T *>(m_components[i]);
+        }
+    }
+    return nullptr;
+}
+
+template <class T>
+T *GameObject::FindComponent(std::false_type) const
+{
+    for (Component *comp : m_components)
+    {
+        if (comp)
+        {
+            if (T *tcomp = DCAST<T *>(comp))
+            {
+                return tcomp;
+            }
+        }
+    }
+    return nullptr;
+}
+
+template <class T>
+void GameObject::FindComponents(Array<T *> *componentsOut,
+                                std::true_type) const
+{
+    const ClassIdType classIdBegin = T::GetClassIdBegin();
+    const ClassIdType classIdEnd = T::GetClassIdEnd();
+    for (uint i = 0; i < m_componentsClassIds.Size(); ++i)
+    {
+        if (ClassDB::IsSubClassByIds(
+                classIdBegin, classIdEnd, m_componentsClassIds[i]))
+        {
+            componentsOut->PushBack(SCAST<T *>(m_components[i]));
+        }
+    }
+}
+
+template <class T>
+void GameObject::FindComponents(Array<T *> *componentsOut,
+                                std::false_type) const
+{
+    for (Component *comp : m_components)
     {
         if (comp)
         {
             if (T *tcomp = DCAST<T *>(comp))
             {
-                components->PushBack(tcomp);
+                componentsOut->PushBack(tcomp);
             }
         }
     }
@@ -183,10 +232,10 @@ Array<T *> GameObject::GetComponentsInAncestors() const
 template <class T>
 void GameObject::GetComponentsInAncestors(Array<T *> *componentsOut) const
 {
-    if (GetParent())
+    for (GameObject *ascendant = GetParent(); ascendant;
+         ascendant = ascendant->GetParent())
     {
-        GetParent()->GetComponents<T>(componentsOut);
-        GetParent()->GetComponentsInAncestors<T>(componentsOut);
+        ascendant->GetComponents<T>(componentsOut);
     }
 }
 template <class T>
@@ -384,12 +433,14 @@ Array<T *> GameObject::GetObjectsInParentAndThis() const
 template <class T>
 T *GameObject::GetObjectInDescendants() const
 {
-    const Array<GameObject *> descendants = GetDescendants();
-    for (GameObject *descendant : descendants)
+    for (GameObject *child : GetChildren())
     {
-        if (T *obj = descendant->GetObject<T>())
+        if (child)
         {
-            return obj;
+            if (T *obj = child->GetObjectInDescendantsAndThis<T>())
+            {
+                return obj;
+            }
         }
     }
     return nullptr;
@@ -431,15 +482,12 @@ Array<T *> GameObject::GetObjectsInDescendantsAndThis() const
 template <class T>
 T *GameObject::GetObjectInAscendants() const
 {
-    const Array<GameObject *> ascendants = GetAscendants();
-    for (GameObject *ascendant : ascendants)
+    for (GameObject *ascendant = GetParent(); ascendant;
+         ascendant = ascendant->GetParent())
     {
-        if (ascendant)
+        if (T *obj = ascendant->GetObject<T>())
         {
-            if (T *obj = ascendant->GetObject<T>())
-            {
-                return obj;
-            }
+            return obj;
         }
     }
     return nullptr;
@@ -478,6 +526,50 @@ Array<T *> GameObject::GetObjectsInAscendantsAndThis() const
     return objs;
 }
 
+template <class TFunction>
+void GameObject::PropagateToChildren(const TFunction &func)
+{
+    ++m_childrenIterationDepth;
+
+    const Array<GameObject *> &children = GetChildren();
+    for (GameObject *child : children)
+    {
+        if (child && child->IsEnabledRecursively())
+        {
+            func(child);
+        }
+    }
+
+    if (--m_childrenIterationDepth == 0)
+    {
+        TryToAddQueuedChildren();
+        TryToClearDeletedChildren();
+        DestroyDelayedGameObjects();
+    }
+}
+
+template <class TFunction>
+void GameObject::PropagateToComponents(const TFunction &func)
+{
+    ++m_componentsIterationDepth;
+
+    const Array<Component *> &components = GetComponents();
+    for (Component *comp : components)
+    {
+        if (comp && comp->IsEnabledRecursively())
+        {
+            func(comp);
+        }
+    }
+
+    if (--m_componentsIterationDepth == 0)
+    {
+        TryToAddQueuedComponents();
+        TryToClearDeletedComponents();
+        DestroyDelayedComponents();
+    }
+}
+
 template <class TListener, class TReturn, class... Args>
 void GameObject::PropagateToChildren(TReturn TListener::*func,
                                      const Args &... args)
@@ -3,6 +3,7 @@
 
 #include "Bang/BangDefines.h"
 #include "Bang/GUID.h"
+#include "Bang/ReflectFieldAccessor.h"
 #include "Bang/ReflectMacros.h"
 #include "Bang/ReflectStruct.h"
 #include "Bang/ReflectVariable.h"
@@ -11,14 +12,21 @@
 namespace Bang
 {
 class ReflectStruct;
+class ReflectTable;
 class Asset;
 class GUID;
 
 class IReflectable
 {
 public:
+    // Reflects this instance again on every call, since the names and hints
+    // of some variables depend on its state
     const ReflectStruct &GetReflectStruct() const;
 
+    // Reflected variables of the class of this instance, shared by all of
+    // its instances
+    const ReflectTable &GetReflectTable() const;
+
 protected:
     IReflectable() = default;
     virtual ~IReflectable() = default;
@@ -29,6 +37,14 @@ protected:
                                 std::function<T()> getter,
                                 const String &hintsString = "");
 
+    // Same as above, but the setter and getter receive the instance, so the
+    // variable can be shared through the ReflectTable
+    template <class TClass, class T>
+    ReflectVariable *ReflectVar(const String &varName,
+                                void (*setter)(TClass *, T),
+                                T (*getter)(const TClass *),
+                                const String &hintsString = "");
+
     template <class TClass, class T, class TToCastTo = T>
     ReflectVariable *ReflectVarMember(const String &varName,
                                       void (TClass::*setter)(T),
@@ -58,8 +74,8 @@ protected:
     ReflectStruct *GetReflectStructPtr() const;
 
 private:
-    mutable bool m_alreadyReflected = false;
     mutable ReflectStruct m_reflectStruct;
+    mutable const ReflectTable *p_reflectTable = nullptr;
 
     static Asset *LoadAssetFromGUID(const GUID &guid);
 };
@@ -87,6 +103,27 @@ ReflectVariable *IReflectable::ReflectVar(const String &varName,
     return GetReflectStructPtr()->GetReflectVariablePtr(varName);
 }
 
+template <class TClass, class T>
+ReflectVariable *IReflectable::ReflectVar(const String &varName,
+                                          void (*setter)(TClass *, T),
+                                          T (*getter)(const TClass *),
+                                          const String &hintsString)
+{
+    ASSERT(setter);
+    ASSERT(getter);
+
+    TClass *instance = SCAST<TClass *>(this);
+    ReflectVariable *reflVar = ReflectVar<T>(
+        varName,
+        [instance, setter](T v) { setter(instance, v); },
+        [instance, getter]() -> T { return getter(instance); },
+        hintsString);
+    reflVar->SetAccessor(
+        std::make_shared<ReflectFieldFunctionAccessor<TClass, T>>(setter,
+                                                                  getter));
+    return reflVar;
+}
+
 template <class TClass, class T, class TToCastTo>
 ReflectVariable *IReflectable::ReflectVarMember(
     const String &varName,
@@ -95,13 +132,19 @@ ReflectVariable *IReflectable::ReflectVarMember(
     TClass *instance,
     const String &hintsString)
 {
-    return ReflectVar<TToCastTo>(
+    ReflectVariable *reflVar = ReflectVar<TToCastTo>(
         varName,
         [instance, setter](TToCastTo v) { (instance->*setter)(SCAST<T>(v)); },
         [instance, getter]() -> TToCastTo {
             return SCAST<TToCastTo>((instance->*getter)());
         },
         hintsString);
+    reflVar->SetAccessor(std::make_shared<
+                         ReflectFieldMemberAccessor<TClass,
+                                                    const T &,
+                                                    const T &,
+                                                    TToCastTo>>(setter, getter));
+    return reflVar;
 }
 template <class TClass, class T, class TToCastTo>
 ReflectVariable *IReflectable::ReflectVarMember(const String &varName,
@@ -110,13 +153,17 @@ ReflectVariable *IReflectable::ReflectVarMember(const String &varName,
                                                 TClass *instance,
                                                 const String &hintsString)
 {
-    return ReflectVar<TToCastTo>(
+    ReflectVariable *reflVar = ReflectVar<TToCastTo>(
         varName,
         [instance, setter](TToCastTo v) { (instance->*setter)(SCAST<T>(v)); },
         [instance, getter]() -> TToCastTo {
             return SCAST<TToCastTo>((instance->*getter)());
         },
         hintsString);
+    reflVar->SetAccessor(
+        std::make_shared<ReflectFieldMemberAccessor<TClass, T, T, TToCastTo>>(
+            setter, getter));
+    return reflVar;
 }
 template <class T>
 ReflectVariable *IReflectable::ReflectVarEnum(const String &varName,
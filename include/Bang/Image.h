@@ -93,6 +93,7 @@ public:
 
     // Asset
     void Import(const Path &imageFilepath) override;
+    std::size_t GetResidentBytes() const override;
 
 private:
     Vector2i m_size = Vector2i::Zero();
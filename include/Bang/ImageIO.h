@@ -6,6 +6,7 @@
 namespace Bang
 {
 class Path;
+class String;
 class Image;
 class Texture2D;
 
@@ -22,6 +23,9 @@ public:
     ImageIO() = delete;
 
 private:
+    static bool ImportCooked(const String &cookedKey, Image *img);
+    static void ExportCooked(const String &cookedKey, const Image &img);
+
     static void ExportBMP(const Path &filepath, const Image &img);
     static void ImportBMP(const Path &filepath, Image *img, bool *ok);
 
@@ -0,0 +1,137 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+
+namespace Bang
+{
+class JobSystem;
+class Thread;
+
+// Counts the pending jobs of a group (a single job or all the chunks of a
+// parallel for), and holds the jobs waiting for the group to finish.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    bool IsDone() const;
+
+private:
+    struct Continuation;
+
+    std::atomic<int> m_pendingJobs{0};
+    std::mutex m_mutex;
+    bool m_finished = false;
+    Array<std::shared_ptr<Continuation>> m_continuations;
+
+    friend class JobSystem;
+};
+
+class JobHandle
+{
+public:
+    JobHandle() = default;
+
+    bool IsValid() const;
+    bool IsDone() const;
+
+private:
+    std::shared_ptr<JobCounter> p_counter;
+
+    friend class JobSystem;
+};
+
+// Persistent pool of worker threads (one per hardware thread, minus the main
+// one) with a work stealing deque per worker. Jobs scheduled from a worker go
+// to its own deque, which it consumes in LIFO order, while idle workers steal
+// the oldest jobs of the others. Jobs scheduled from any other thread go to a
+// shared deque. Waiting on a handle runs pending jobs instead of blocking.
+class JobSystem
+{
+public:
+    using JobFunction = std::function<void()>;
+    using ParallelForFunction = std::function<void(uint begin, uint end)>;
+
+    JobSystem();
+    virtual ~JobSystem();
+
+    // 0 workers means as many as hardware threads minus one
+    void Init(uint numWorkers = 0);
+
+    JobHandle Schedule(const JobFunction &jobFunction);
+    JobHandle Schedule(const JobFunction &jobFunction,
+                       const Array<JobHandle> &dependencies);
+
+    // Splits [begin, end) in chunks of at most grainSize indices. A grainSize
+    // of 0 picks one that gives a few chunks per worker.
+    JobHandle ScheduleParallelFor(uint begin,
+                                  uint end,
+                                  uint grainSize,
+                                  const ParallelForFunction &function);
+    JobHandle ScheduleParallelFor(uint begin,
+                                  uint end,
+                                  uint grainSize,
+                                  const ParallelForFunction &function,
+                                  const Array<JobHandle> &dependencies);
+    void ParallelFor(uint begin,
+                     uint end,
+                     uint grainSize,
+                     const ParallelForFunction &function);
+
+    // Runs other pending jobs in the calling thread until the job is done
+    void Wait(const JobHandle &jobHandle);
+    void Wait(const Array<JobHandle> &jobHandles);
+
+    uint GetNumWorkers() const;
+    bool IsWorkerThread() const;
+
+    static JobSystem *GetInstance();
+
+private:
+    struct Job
+    {
+        JobFunction function;
+        std::shared_ptr<JobCounter> counter;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    Array<Thread *> m_workerThreads;
+
+    // One per worker, plus the shared one at the end
+    Array<WorkQueue *> m_workQueues;
+
+    std::atomic<int> m_numQueuedJobs{0};
+    std::atomic<bool> m_exit{false};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+
+    void WorkerLoop(uint workerIndex);
+    bool TryRunOneJob();
+    bool TryPopJob(Job *job);
+    void RunJob(Job *job);
+
+    void Submit(const Array<Job> &jobs);
+    void SubmitAfter(const Array<Job> &jobs,
+                     const Array<JobHandle> &dependencies);
+    void OnJobFinished(JobCounter *counter);
+
+    WorkQueue *GetSharedQueue() const;
+    int GetCurrentWorkerIndex() const;
+};
+}
+
+#endif  // JOBSYSTEM_H
@@ -18,6 +18,7 @@ class Camera;
 class GameObject;
 class Serializable;
 class Renderer;
+class SceneSpatialIndex;
 class ShaderProgram;
 class Texture;
 
@@ -52,6 +53,9 @@ public:
 
     void RenderShadowMaps(GameObject *go);
 
+    // Component
+    ComponentUpdateAccess GetUpdateAccess() const override;
+
     // Serializable
     void Reflect() override;
 
@@ -65,6 +69,9 @@ protected:
     virtual void SetUniformsBeforeApplyingLight(ShaderProgram *sp) const;
     virtual void OnShadowHighBitDepthChanged();
 
+    // For the lights whose bounds change without their transform changing
+    void PropagateBoundsChanged();
+
 private:
     float m_intensity = 1.0f;
     Color m_color = Color::White();
@@ -79,6 +86,7 @@ private:
 
     AH<Material> p_shadowMapMaterial;
     AH<ShaderProgram> p_lightScreenPassShaderProgram;
+    SceneSpatialIndex *p_spatialIndex = nullptr;
 
     void SetShadowLightCommonUniforms(ShaderProgram *sp) const;
     void ApplyLight(Camera *camera, const AARect &renderRect) const;
@@ -86,6 +94,7 @@ private:
     virtual void RenderShadowMaps_(GameObject *go) = 0;
 
     friend class GEngine;
+    friend class SceneSpatialIndex;
 };
 }
 
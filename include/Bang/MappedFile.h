@@ -0,0 +1,38 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+
+#include "Bang/BangDefines.h"
+#include "Bang/Path.h"
+
+namespace Bang
+{
+// Read-only memory mapping of a whole file. The bytes are read lazily by the
+// OS as they are accessed, and stay valid until the file is closed.
+class MappedFile
+{
+public:
+    MappedFile();
+    MappedFile(const Path &filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool Open(const Path &filepath);
+    void Close();
+
+    bool IsOpen() const;
+    const Byte *GetData() const;
+    std::size_t GetSize() const;
+    const Path &GetPath() const;
+
+private:
+    Path m_path;
+    const Byte *p_data = nullptr;
+    std::size_t m_size = 0;
+};
+}
+
+#endif  // MAPPEDFILE_H
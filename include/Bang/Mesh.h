@@ -17,6 +17,7 @@
 #include "BangMath/Sphere.h"
 #include "Bang/String.h"
 #include "Bang/Texture2D.h"
+#include "Bang/TriangleBVH.h"
 #include "BangMath/Transformation.h"
 #include "BangMath/Triangle.h"
 #include "Bang/UMap.h"
@@ -49,6 +50,9 @@ public:
     static constexpr uint DefaultTangentsVBOLocation = 3;
     static constexpr uint DefaultVertexToBonesIdsVBOLocation = 4;
     static constexpr uint DefaultVertexToBonesWeightsVBOLocation = 5;
+    static constexpr uint DefaultInstanceModelMatrixVBOLocation = 6;  // 6..9
+    static constexpr uint DefaultInstanceNormalMatrixVBOLocation =
+        10;  // 10..13
 
     void SetPositionsPool(const Array<Vector3> &positions);
     void SetNormalsPool(const Array<Vector3> &normals);
@@ -64,6 +68,8 @@ public:
     void UpdateVertexNormals();
     void UpdateVAOsAndTables();
 
+    // Builds the LODs of the current geometry. Until then, and after any
+    // change of it, the mesh has no LODs other than itself.
     void CalculateLODs();
     int GetNumLODs() const;
     AH<Mesh> GetLODMesh(int lod) const;
@@ -153,11 +159,17 @@ public:
 
     const AABox &GetAABBox() const;
     const Sphere &GetBoundingSphere() const;
+
+    // Built the first time it is asked for after the triangles change
+    const TriangleBVH &GetTriangleBVH() const;
     const Array<Mesh::VertexId> &GetTrianglesVertexIds() const;
     const Array<Vector3> &GetPositionsPool() const;
     const Array<Vector3> &GetNormalsPool() const;
     const Array<Vector2> &GetUvsPool() const;
     const Array<Vector3> &GetTangentsPool() const;
+    // The 4 most relevant bones of each vertex, as in the VBO
+    const Array<std::array<int, 4>> &GetVertexBonesIdsPool() const;
+    const Array<std::array<float, 4>> &GetVertexBonesWeightsPool() const;
     const Map<String, uint> &GetBonesIds() const;
     const Map<String, Mesh::Bone> &GetBonesPool() const;
     const Path &GetModelFilepath() const;
@@ -170,6 +182,7 @@ public:
 
     // Asset
     void Import(const Path &meshFilepath) override;
+    std::size_t GetResidentBytes() const override;
 
     // Serializable
     virtual void ImportMeta(const MetaNode &metaNode) override;
@@ -188,8 +201,8 @@ private:
     Map<String, Bone> m_bonesPool;
     Map<uint, String> m_idToBone;
     Map<String, uint> m_bonesIds;
-    Map<VertexId, std::array<int, 4>> m_vertexIdToImportantBonesIdsPool;
-    Map<VertexId, std::array<float, 4>> m_vertexIdToImportantBonesWeightsPool;
+    Array<std::array<int, 4>> m_vertexBonesIdsPool;
+    Array<std::array<float, 4>> m_vertexBonesWeightsPool;
 
     // (i, j, k) hold the opposite corners of the corners (0, 1, 2) of the
     // triangle 3*(i/3)
@@ -205,6 +218,9 @@ private:
     AABox m_bBox;
     Sphere m_bSphere;
 
+    mutable bool m_isTriangleBVHValid = false;
+    mutable TriangleBVH m_triangleBVH;
+
     Mesh();
     virtual ~Mesh() override;
 };
@@ -3,6 +3,7 @@
 
 #include "BangMath/AABox.h"
 #include "BangMath/Ray.h"
+#include "Bang/Array.h"
 #include "Bang/AssetHandle.h"
 #include "Bang/BangDefines.h"
 #include "Bang/ComponentMacros.h"
@@ -12,6 +13,7 @@
 
 namespace Bang
 {
+class Camera;
 class Serializable;
 class Mesh;
 class ShaderProgram;
@@ -29,10 +31,30 @@ public:
 
     void SetCurrentLOD(int lod);
     void SetAutoLOD(bool autoLOD);
+    void SetLODScreenSizes(const Array<float> &lodScreenSizes);
+    void SetLODHysteresis(float lodHysteresis);
 
     bool GetAutoLOD() const;
     int GetCurrentLOD() const;
     Mesh *GetCurrentLODActiveMesh() const;
+    const Array<float> &GetLODScreenSizes() const;
+    float GetLODHysteresis() const;
+
+    // Returns the LOD to use for an object covering screenSize (fraction of
+    // the viewport height). lodScreenSizes[i] is the screen size under which
+    // LOD i+1 replaces LOD i, in decreasing order. Missing thresholds keep
+    // halving the last one. To avoid popping back and forth, the thresholds
+    // finer than currentLOD are scaled by (1 + hysteresis), and the rest by
+    // (1 - hysteresis).
+    static int SelectLOD(float screenSize,
+                         int currentLOD,
+                         int numLODs,
+                         const Array<float> &lodScreenSizes,
+                         float hysteresis);
+
+    // Approximate fraction of the viewport height covered by the bounding
+    // sphere of the given world box
+    static float GetScreenSize(const AABox &aaBBoxWorld, const Camera *camera);
 
     void IntersectRay(const Ray &ray,
                       bool *outIntersected = nullptr,
@@ -48,6 +70,9 @@ public:
     virtual void SetUniformsOnBind(ShaderProgram *sp) override;
     virtual AABox GetAABBox() const override;
 
+    // Component
+    virtual ComponentUpdateAccess GetUpdateAccess() const override;
+
     // Serializable
     virtual void Reflect() override;
 
@@ -57,6 +82,8 @@ protected:
 
     bool m_autoLOD = false;
     int m_currentLOD = 0;
+    Array<float> m_lodScreenSizes = {0.5f, 0.25f, 0.125f, 0.0625f};
+    float m_lodHysteresis = 0.1f;
 
     void IntersectRay_(const Ray &ray,
                        Texture2D *textureToFilterBy = nullptr,
@@ -68,6 +95,11 @@ protected:
     MeshRenderer();
     virtual ~MeshRenderer() override;
 
+    void UpdateAutoLOD();
+
+    // Component
+    virtual void OnBeforeRender() override;
+
     // Renderer
     virtual void OnRender() override;
 };
@@ -4,12 +4,14 @@
 #include <functional>
 #include <utility>
 
+#include "Bang/Array.h"
 #include "Bang/BangDefines.h"
 #include "Bang/GUID.h"
 #include "Bang/GUIDManager.h"
 #include "Bang/Map.h"
 #include "Bang/Path.h"
 #include "Bang/String.h"
+#include "Bang/UMap.h"
 
 namespace Bang
 {
@@ -34,6 +36,9 @@ public:
     static Path GetFilepath(const Path &importFilepath);
     static Path GetMetaFilepath(const Path &filepath);
     static Path GetMetaFilepath(const GUID &guid);
+
+    // Inside the directories whose meta files have been loaded, a path not
+    // registered has no meta file, so it is answered without the disk
     static GUID GetGUID(const Path &filepath);
 
     static void OnFilepathRenamed(const Path &oldPath, const Path &newPath);
@@ -41,12 +46,25 @@ public:
 private:
     Map<GUID, Path> m_GUIDToFilepath;
     Map<Path, GUID> m_filepathToGUID;
+    Array<Path> m_indexedDirectories;
 
     GUIDManager m_GUIDManager;
 
+    struct MetaFileEntry;
+
     MetaFilesManager();
     ~MetaFilesManager();
 
+    static void ScanDirectory(const Path &directory, Array<Path> *filepaths);
+    static void LoadMetaFilepathGUIDs(const Path &directory,
+                                      const Array<Path> &filepaths);
+    static void ReadMetaFilesIndex(const Path &directory,
+                                   UMap<Path, MetaFileEntry> *indexEntries);
+    static void WriteMetaFilesIndex(const Path &directory,
+                                    const Array<MetaFileEntry> &entries);
+    static String GetMetaFilesIndexKey(const Path &directory);
+    static bool IsInIndexedDirectory(const Path &filepath);
+
     static GUID GetGUIDReadingMetaFilepath(const Path &metaFilepath);
     static String GetMetaExtension();
     static MetaFilesManager *GetInstance();
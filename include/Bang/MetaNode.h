@@ -21,6 +21,12 @@ namespace Bang
 {
 class Path;
 
+enum class MetaNodeFormat
+{
+    YAML,
+    BINARY
+};
+
 class MetaNode
 {
 public:
@@ -65,6 +71,7 @@ public:
     void SetName(const String name);
     String ToString() const;
     void ToString(YAML::Emitter &out) const;
+    void ToBinary(Array<Byte> *bytes) const;
 
     const String &GetName() const;
     const Map<String, MetaAttribute> &GetAttributes() const;
@@ -76,6 +83,7 @@ public:
     void Import(const MetaNode &metaNode);
     void Import(const String &metaString);
     void Import(const YAML::Node &yamlNode);
+    bool Import(const Byte *data, std::size_t size);
     void Import(const Path &filepath);
 
     bool operator==(const MetaNode &rhs) const;
@@ -0,0 +1,97 @@
+#ifndef METANODEBINARY_H
+#define METANODEBINARY_H
+
+#include <cstddef>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/String.h"
+
+namespace Bang
+{
+class MetaNode;
+
+// Compact binary encoding of a MetaNode tree, equivalent to its YAML one.
+// All the strings (node names, attribute names and values, and children
+// container names) are interned in a table at the beginning, and the nodes
+// refer to them by index. Nodes and children containers are prefixed with
+// their size in bytes, so that they can be skipped without being read.
+// Integers are 32 bit little endian.
+// Attribute values are not typed: they are the same strings MetaAttribute
+// stores, and numbers are still parsed by MetaAttribute::Get. What it saves
+// is the YAML tokenizing and the allocations of the tree walk. Formats are
+// chosen per asset with Serializable::GetMetaFileFormat, and only Model
+// uses this one. Scenes and prefabs are still YAML.
+class MetaNodeBinary
+{
+public:
+    static void Encode(const MetaNode &metaNode, Array<Byte> *bytes);
+    static bool Decode(const Byte *data,
+                       std::size_t size,
+                       MetaNode *metaNode);
+
+    // Only checks the header
+    static bool IsBinary(const Byte *data, std::size_t size);
+
+    MetaNodeBinary() = delete;
+};
+
+// String of a binary MetaNode buffer. It is not null terminated.
+struct MetaNodeBinaryString
+{
+    const char *data = nullptr;
+    uint size = 0;
+
+    String ToString() const;
+    bool operator==(const String &rhs) const;
+    bool operator!=(const String &rhs) const;
+};
+
+// Read-only view of a node of a binary MetaNode buffer, like a MappedFile.
+// It does not allocate, and must not outlive the buffer.
+class MetaNodeBinaryView
+{
+public:
+    MetaNodeBinaryView() = default;
+
+    // View of the root node. The whole buffer is validated here, and the
+    // view is invalid if it is not a well formed binary MetaNode.
+    static MetaNodeBinaryView FromData(const Byte *data, std::size_t size);
+
+    bool IsValid() const;
+    MetaNodeBinaryString GetName() const;
+
+    uint GetNumAttributes() const;
+    MetaNodeBinaryString GetAttributeName(uint i) const;
+    MetaNodeBinaryString GetAttributeValue(uint i) const;
+    bool GetAttributeValue(const String &attributeName,
+                           MetaNodeBinaryString *value) const;
+
+    uint GetNumChildrenContainers() const;
+    MetaNodeBinaryString GetChildrenContainerName(uint containerIndex) const;
+    uint GetNumChildren(uint containerIndex) const;
+
+    // The following children are got with GetNextSibling(), as many times
+    // as GetNumChildren() says
+    MetaNodeBinaryView GetFirstChild(uint containerIndex) const;
+    MetaNodeBinaryView GetNextSibling() const;
+
+    void ToMetaNode(MetaNode *metaNode) const;
+
+private:
+    const Byte *p_stringOffsets = nullptr;
+    const Byte *p_stringData = nullptr;
+    const Byte *p_node = nullptr;
+
+    MetaNodeBinaryView(const Byte *stringOffsets,
+                       const Byte *stringData,
+                       const Byte *node);
+
+    MetaNodeBinaryString GetString(uint stringIndex) const;
+    const Byte *GetAttributesBegin() const;
+    const Byte *GetChildrenContainersBegin() const;
+    const Byte *GetChildrenContainer(uint containerIndex) const;
+};
+}
+
+#endif  // METANODEBINARY_H
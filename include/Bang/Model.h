@@ -5,6 +5,7 @@
 #include "Bang/BangDefines.h"
 #include "Bang/Map.h"
 #include "Bang/Mesh.h"
+#include "Bang/MetaNode.h"
 #include "Bang/ModelIO.h"
 #include "Bang/String.h"
 
@@ -46,6 +47,10 @@ public:
     virtual void ImportMeta(const MetaNode &metaNode) override;
     virtual void ExportMeta(MetaNode *metaNode) const override;
 
+    // The meta of a model holds the ones of all its meshes, materials and
+    // animations, so it is kept binary
+    virtual MetaNodeFormat GetMetaFileFormat() const override;
+
 private:
     ModelIOScene m_modelScene;
 };
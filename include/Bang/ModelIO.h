@@ -33,6 +33,9 @@ class GameObject;
 class Material;
 class Model;
 class Path;
+struct ModelIORawMaterial;
+struct ModelIORawMesh;
+struct ModelIORawScene;
 
 struct ModelIONode
 {
@@ -70,6 +73,12 @@ public:
                             Model *model,
                             ModelIOScene *modelScene);
 
+    // What ImportModel reads before creating any asset, in the cooked
+    // format. It needs no GL context, so cooked and uncooked imports can be
+    // compared with it.
+    static bool ImportModelRaw(const Path &modelFilepath,
+                               Array<Byte> *rawSceneBytes);
+
     static void ImportMeshRaw(aiMesh *aMesh,
                               Array<Mesh::VertexId> *vertexIndices,
                               Array<Vector3> *vertexPositionsPool,
@@ -96,11 +105,20 @@ private:
     static const aiScene *ImportScene(Assimp::Importer *importer,
                                       const Path &modelFilepath);
 
-    static void ImportEmbeddedMesh(aiMesh *aMesh,
+    static bool ImportRawScene(const Path &modelFilepath,
+                               ModelIORawScene *rawScene);
+    static bool ReadRawScene(const Path &modelFilepath,
+                             ModelIORawScene *rawScene);
+    static bool ImportCookedRawScene(const String &cookedKey,
+                                     ModelIORawScene *rawScene);
+    static void ExportCookedRawScene(const String &cookedKey,
+                                     const ModelIORawScene &rawScene);
+
+    static void ImportEmbeddedMesh(const ModelIORawMesh &rawMesh,
                                    Model *model,
                                    AH<Mesh> *outMesh,
                                    String *outMeshName);
-    static void ImportEmbeddedMaterial(aiMaterial *aMaterial,
+    static void ImportEmbeddedMaterial(const ModelIORawMaterial &rawMaterial,
                                        const Path &modelDirectory,
                                        Model *model,
                                        AH<Material> *outMaterial,
@@ -61,6 +61,47 @@ public:
         Vector3 GetGravityForce(const Particle::Parameters &params) const;
     };
 
+    // One array per coordinate
+    struct Vector3Stream
+    {
+        Array<float> x;
+        Array<float> y;
+        Array<float> z;
+
+        void Resize(uint size);
+        Vector3 Get(uint i) const;
+        void Set(uint i, const Vector3 &v);
+    };
+
+    // Same fields as Particle::Data, but with one array per field, so that
+    // all the particles can be stepped with loops the compiler can vectorize
+    struct Streams
+    {
+        Vector3Stream prevPositions;
+        Vector3Stream positions;
+        Vector3Stream velocities;
+        Vector3Stream extraForces;
+        Vector3Stream frictionForces;
+        Array<Color> startColors;
+        Array<Color> endColors;
+        Array<Color> currentColors;
+        Array<float> totalLifeTimes;
+        Array<float> remainingLifeTimes;
+        Array<float> remainingStartTimes;
+        Array<float> prevDeltaTimesSecs;
+        Array<float> sizes;
+        Array<uint> currentFrames;
+
+        // 1 for the particles moved in the last step, 0 for the rest
+        Array<float> activeMasks;
+
+        void Resize(uint size);
+        uint Size() const;
+        bool IsActive(uint i) const;
+        Particle::Data Get(uint i) const;
+        void Set(uint i, const Particle::Data &pData);
+    };
+
     static void ExecuteFixedStepped(
         Time totalDeltaTime,
         Time fixedStepDeltaTime,
@@ -93,9 +134,40 @@ public:
         std::function<bool(uint i)> canUpdateParticleFunc,
         std::function<void(Time dt)> extraFuncToExecuteBeforeEveryStep);
 
+    // Only the dead particles go through initParticleFunc
+    static void FixedStepAll(
+        Particle::Streams *particlesStreams,
+        Time totalDeltaTime,
+        Time fixedStepDeltaTime,
+        const Particle::Parameters &params,
+        std::function<void(uint, const Particle::Parameters &)>
+            initParticleFunc);
+
+    static void FixedStepAll(
+        Particle::Streams *particlesStreams,
+        Time totalDeltaTime,
+        Time fixedStepDeltaTime,
+        const Particle::Parameters &params,
+        std::function<void(uint, const Particle::Parameters &)>
+            initParticleFunc,
+        std::function<void(Time dt)> extraFuncToExecuteBeforeEveryStep);
+
+    static void FixedStepAll(
+        Particle::Streams *particlesStreams,
+        Time totalDeltaTime,
+        Time fixedStepDeltaTime,
+        const Particle::Parameters &params,
+        std::function<void(uint, const Particle::Parameters &)>
+            initParticleFunc,
+        std::function<void(Time dt)> extraFuncToExecuteBeforeEveryStep,
+        std::function<void(Time dt)> extraFuncToExecuteAfterEveryStep);
+
     static void Step(Particle::Data *pData,
                      Time dt,
                      const Particle::Parameters &params);
+    static void Step(Particle::Streams *particlesStreams,
+                     Time dt,
+                     const Particle::Parameters &params);
 
     static void MoveParticle(Particle::Data *pData,
                              Time dt,
@@ -111,6 +183,18 @@ private:
     static void StepPositionAndVelocity(Particle::Data *pData,
                                         float dt,
                                         const Particle::Parameters &params);
+    static void CorrectParticlesCollisions(
+        Particle::Streams *particlesStreams,
+        float dtSecs,
+        const Particle::Parameters &params);
+    static void CollideParticleWithColliders(
+        const Particle::Parameters &params,
+        float dtSecs,
+        const Vector3 &particleGravityForce,
+        Vector3 *prevPosition,
+        Vector3 *position,
+        Vector3 *velocity,
+        Vector3 *frictionForce);
     static bool CollideParticle(Collider *collider,
                                 const Parameters &params,
                                 const Vector3 &prevPositionNoInt,
@@ -18,6 +18,7 @@
 namespace Bang
 {
 class Serializable;
+class Collider;
 class Mesh;
 class ShaderProgram;
 class Texture2D;
@@ -125,12 +126,14 @@ public:
 
 private:
     AABox m_aabox;
+    float m_particlesMaxSpeed = 0.0f;
+    float m_particlesMaxExtraForce = 0.0f;
     bool m_emitOnStart = true;
     bool m_isEmitting = false;
 
     VAO *p_particlesVAO = nullptr;
     VBO *p_particleDataVBO = nullptr;
-    Array<Particle::Data> m_particlesData;
+    Particle::Streams m_particlesStreams;
     Array<ParticleVBOData> m_particlesVBOData;
 
     AH<Mesh> m_particleMesh;
@@ -160,6 +163,11 @@ private:
 
     void InitParticle(uint i, const Particle::Parameters &params);
     bool IsParticleActive(uint i) const;
+    void ComputeParticlesBounds(AABox *aaBox,
+                                float *maxSpeed,
+                                float *maxExtraForce) const;
+    void UpdateParticlesBounds();
+    void CullColliders(const Array<Collider *> &sceneColliders, Time dt);
     void RecreateVAOForMesh();
     void UpdateDataVBO();
 
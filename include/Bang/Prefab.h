@@ -1,6 +1,7 @@
 #ifndef BANGFAB_H
 #define BANGFAB_H
 
+#include "Bang/Array.h"
 #include "Bang/Asset.h"
 #include "Bang/BangDefines.h"
 #include "Bang/MetaNode.h"
@@ -10,6 +11,7 @@ namespace Bang
 {
 class GameObject;
 class Path;
+class PrefabTemplate;
 
 class Prefab : public Asset
 {
@@ -18,6 +20,8 @@ class Prefab : public Asset
 public:
     GameObject *Instantiate() const;
     GameObject *InstantiateRaw() const;
+    Array<GameObject *> InstantiateN(uint numInstances) const;
+    Array<GameObject *> InstantiateRawN(uint numInstances) const;
 
     void SetGameObject(GameObject *go);
 
@@ -33,10 +37,16 @@ public:
 private:
     String m_gameObjectMetaInfoContent = "";
 
+    // Compiled from the meta content when first needed
+    mutable PrefabTemplate *p_template = nullptr;
+
     Prefab();
     Prefab(GameObject *go);
     Prefab(const String &gameObjectMetaInfoContent);
     virtual ~Prefab() override;
+
+    const PrefabTemplate *GetTemplate() const;
+    void SetMetaContent(const String &gameObjectMetaInfoContent);
 };
 }
 
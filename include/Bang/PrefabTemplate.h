@@ -0,0 +1,71 @@
+#ifndef PREFABTEMPLATE_H
+#define PREFABTEMPLATE_H
+
+#include <functional>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/MetaNode.h"
+#include "Bang/ReflectFieldAccessor.h"
+
+namespace Bang
+{
+class Component;
+class GameObject;
+
+// Parsed form of a prefab, compiled once so that it can be instantiated many
+// times without parsing its meta again. The GameObject tree is flattened in
+// pre-order, each GameObject with its parent index and the range of its
+// components, whose classes are resolved up front. The meta of each
+// component is compiled into a flat list of field assignments the first
+// time it is instantiated, when its class can be asked for them.
+class PrefabTemplate
+{
+public:
+    PrefabTemplate(const MetaNode &gameObjectMetaNode);
+    ~PrefabTemplate();
+
+    PrefabTemplate(const PrefabTemplate &) = delete;
+    PrefabTemplate &operator=(const PrefabTemplate &) = delete;
+
+    GameObject *Instantiate() const;
+    void Instantiate(uint numInstances, Array<GameObject *> *gameObjects) const;
+
+    const MetaNode &GetMetaNode() const;
+
+private:
+    struct ComponentOp
+    {
+        const std::function<void *()> *constructor;
+        const MetaNode *metaNode;
+
+        // Range of m_fieldOps. Without the ImportMeta of Component, the
+        // class may import more than its fields, so ImportMeta is called.
+        bool hasComponentImportMeta;
+        uint fieldOpsBegin;
+        uint fieldOpsEnd;
+    };
+
+    struct GameObjectOp
+    {
+        int parentIndex;
+        const MetaNode *metaNode;
+        uint componentsBegin;
+        uint componentsEnd;
+    };
+
+    // The ops point to nodes inside this one
+    MetaNode m_metaNode;
+
+    Array<GameObjectOp> m_gameObjectOps;
+    mutable Array<ComponentOp> m_componentOps;
+    mutable Array<ReflectImportOp> m_fieldOps;
+    mutable bool m_areFieldOpsCompiled = false;
+
+    void Compile(const MetaNode &gameObjectMetaNode, int parentIndex);
+    GameObject *Instantiate(Array<GameObject *> *gameObjectsScratch) const;
+    void ImportMeta(ComponentOp *componentOp, Component *comp) const;
+};
+}
+
+#endif  // PREFABTEMPLATE_H
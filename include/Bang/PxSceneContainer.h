@@ -58,7 +58,7 @@ public:
 
     Scene *GetScene() const;
     physx::PxScene *GetPxScene() const;
-    Array<Collider *> GetColliders() const;
+    const Array<Collider *> &GetColliders() const;
     physx::PxActor *GetPxActorFromGameObject(GameObject *go) const;
     Collider *GetColliderFromPxShape(physx::PxShape *pxShape) const;
     GameObject *GetGameObjectFromPxActor(physx::PxActor *pxActor) const;
@@ -75,6 +75,9 @@ private:
     physx::PxScene *p_pxScene = nullptr;
     ObjectGatherer<PhysicsComponent, true> *m_physicsObjectGatherer = nullptr;
     Map<physx::PxShape *, Collider *> m_pxShapeToCollider;
+
+    // Kept up to date with the gatherer events
+    Array<Collider *> m_colliders;
     mutable Map<GameObject *, physx::PxActor *> m_gameObjectToPxActor;
     mutable Map<physx::PxActor *, GameObject *> m_pxActorToGameObject;
 
@@ -152,6 +152,7 @@ private:
 
     // Transform
     void CalculateLocalToParentMatrix() const override;
+    void CalculateParentToLocalMatrix() const override;
 
     void CalculateRectLocalToWorldMatrix() const;
     void CalculateRectTransformLocalToWorldMatrix() const;
@@ -0,0 +1,188 @@
+#ifndef REFLECTFIELDACCESSOR_H
+#define REFLECTFIELDACCESSOR_H
+
+#include <functional>
+#include <sstream>
+#include <type_traits>
+
+#include "Bang/BangDefines.h"
+#include "Bang/MetaNode.h"
+#include "Bang/String.h"
+
+namespace Bang
+{
+class IReflectable;
+
+// Assignment of a value parsed once from a meta, to any instance of a class
+using ReflectImportOp = std::function<void(IReflectable *)>;
+
+// Typed getter and setter of a reflected variable, not bound to any instance,
+// so that it can be shared by all the instances of a class
+class ReflectFieldAccessor
+{
+public:
+    ReflectFieldAccessor() = default;
+    virtual ~ReflectFieldAccessor() = default;
+
+    virtual void Import(IReflectable *reflectable,
+                        const MetaNode &metaNode,
+                        const String &varName) const = 0;
+    virtual void Export(const IReflectable *reflectable,
+                        MetaNode *metaNode,
+                        const String &varName) const = 0;
+    virtual void Copy(const IReflectable *from, IReflectable *to) const = 0;
+
+    // Empty if the meta does not have the variable
+    virtual ReflectImportOp CompileImport(const MetaNode &metaNode,
+                                          const String &varName) const = 0;
+};
+
+template <class T>
+class ReflectFieldAccessorT : public ReflectFieldAccessor
+{
+public:
+    virtual T Get(const IReflectable *reflectable) const = 0;
+    virtual void Set(IReflectable *reflectable, const T &value) const = 0;
+
+    void Import(IReflectable *reflectable,
+                const MetaNode &metaNode,
+                const String &varName) const override;
+    void Export(const IReflectable *reflectable,
+                MetaNode *metaNode,
+                const String &varName) const override;
+    void Copy(const IReflectable *from, IReflectable *to) const override;
+    ReflectImportOp CompileImport(const MetaNode &metaNode,
+                                  const String &varName) const override;
+};
+
+template <class TClass, class TSetArg, class TGetRet, class T>
+class ReflectFieldMemberAccessor : public ReflectFieldAccessorT<T>
+{
+public:
+    using Setter = void (TClass::*)(TSetArg);
+    using Getter = TGetRet (TClass::*)() const;
+
+    ReflectFieldMemberAccessor(Setter setter, Getter getter);
+
+    T Get(const IReflectable *reflectable) const override;
+    void Set(IReflectable *reflectable, const T &value) const override;
+
+private:
+    Setter m_setter = nullptr;
+    Getter m_getter = nullptr;
+};
+
+template <class TClass, class T>
+class ReflectFieldFunctionAccessor : public ReflectFieldAccessorT<T>
+{
+public:
+    using Setter = void (*)(TClass *, T);
+    using Getter = T (*)(const TClass *);
+
+    ReflectFieldFunctionAccessor(Setter setter, Getter getter);
+
+    T Get(const IReflectable *reflectable) const override;
+    void Set(IReflectable *reflectable, const T &value) const override;
+
+private:
+    Setter m_setter = nullptr;
+    Getter m_getter = nullptr;
+};
+
+template <class T>
+void ReflectFieldAccessorT<T>::Import(IReflectable *reflectable,
+                                      const MetaNode &metaNode,
+                                      const String &varName) const
+{
+    if (MetaAttribute *attr = metaNode.GetAttribute(varName))
+    {
+        Set(reflectable, attr->Get<T>());
+    }
+}
+
+template <class T>
+void ReflectFieldAccessorT<T>::Export(const IReflectable *reflectable,
+                                      MetaNode *metaNode,
+                                      const String &varName) const
+{
+    // Same formatting as exporting the value through a Variant
+    std::ostringstream oss;
+    oss << Get(reflectable);
+    metaNode->Set(varName, String(oss.str()));
+}
+
+template <class T>
+void ReflectFieldAccessorT<T>::Copy(const IReflectable *from,
+                                    IReflectable *to) const
+{
+    Set(to, Get(from));
+}
+
+template <class T>
+ReflectImportOp ReflectFieldAccessorT<T>::CompileImport(
+    const MetaNode &metaNode,
+    const String &varName) const
+{
+    MetaAttribute *attr = metaNode.GetAttribute(varName);
+    if (!attr)
+    {
+        return nullptr;
+    }
+
+    // The accessors live as long as the ReflectTable, until the program exits
+    const ReflectFieldAccessorT<T> *accessor = this;
+    const T value = attr->Get<T>();
+    return [accessor, value](IReflectable *reflectable) {
+        accessor->Set(reflectable, value);
+    };
+}
+
+template <class TClass, class TSetArg, class TGetRet, class T>
+ReflectFieldMemberAccessor<TClass, TSetArg, TGetRet, T>::
+    ReflectFieldMemberAccessor(Setter setter, Getter getter)
+    : m_setter(setter), m_getter(getter)
+{
+}
+
+template <class TClass, class TSetArg, class TGetRet, class T>
+T ReflectFieldMemberAccessor<TClass, TSetArg, TGetRet, T>::Get(
+    const IReflectable *reflectable) const
+{
+    const TClass *instance = SCAST<const TClass *>(reflectable);
+    return SCAST<T>((instance->*m_getter)());
+}
+
+template <class TClass, class TSetArg, class TGetRet, class T>
+void ReflectFieldMemberAccessor<TClass, TSetArg, TGetRet, T>::Set(
+    IReflectable *reflectable,
+    const T &value) const
+{
+    using TSetValue = typename std::decay<TSetArg>::type;
+    TClass *instance = SCAST<TClass *>(reflectable);
+    (instance->*m_setter)(SCAST<TSetValue>(value));
+}
+
+template <class TClass, class T>
+ReflectFieldFunctionAccessor<TClass, T>::ReflectFieldFunctionAccessor(
+    Setter setter,
+    Getter getter)
+    : m_setter(setter), m_getter(getter)
+{
+}
+
+template <class TClass, class T>
+T ReflectFieldFunctionAccessor<TClass, T>::Get(
+    const IReflectable *reflectable) const
+{
+    return m_getter(SCAST<const TClass *>(reflectable));
+}
+
+template <class TClass, class T>
+void ReflectFieldFunctionAccessor<TClass, T>::Set(IReflectable *reflectable,
+                                                  const T &value) const
+{
+    m_setter(SCAST<TClass *>(reflectable), value);
+}
+}
+
+#endif  // REFLECTFIELDACCESSOR_H
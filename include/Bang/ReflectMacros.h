@@ -1,6 +1,8 @@
 #ifndef REFLECTMACROS_H
 #define REFLECTMACROS_H
 
+#include <type_traits>
+
 #define BANG_REFLECT_VAR_HINTED(Name, Setter, Getter, Hints) \
     ReflectVar(Name, Setter, Getter, Hints);
 #define BANG_REFLECT_VAR(Name, Setter, Getter) \
@@ -11,28 +13,40 @@
 #define BANG_REFLECT_VAR_MEMBER(Class, Name, Setter, Getter) \
     BANG_REFLECT_VAR_MEMBER_HINTED(Class, Name, Setter, Getter, "")
 
-#define BANG_REFLECT_VAR_ENUM(Name, Setter, Getter, EnumType)       \
-    ReflectVar<uint32_t>(                                           \
-        Name,                                                       \
-        [this](uint32_t x) { Setter(SCAST<EnumType>(x)); },         \
-        [this]() -> uint32_t { return SCAST<uint32_t>(Getter()); }, \
-        BANG_REFLECT_HINT_ENUM(true));
+// Class of the instance being reflected, for the accessors that receive it
+#define BANG_REFLECT_THIS_CLASS std::remove_pointer<decltype(this)>::type
 
-#define BANG_REFLECT_VAR_ENUM_FLAGS(Name, Setter, Getter)         \
-    ReflectVar<FlagsPrimitiveType>(                               \
+#define BANG_REFLECT_VAR_ENUM(Name, Setter, Getter, EnumType)     \
+    ReflectVar<BANG_REFLECT_THIS_CLASS, uint32_t>(                \
         Name,                                                     \
-        [this](FlagsPrimitiveType x) {                            \
-            Setter(SCAST<FlagsPrimitiveType>(x));                 \
+        [](BANG_REFLECT_THIS_CLASS *self, uint32_t x) {           \
+            self->Setter(SCAST<EnumType>(x));                     \
+        },                                                        \
+        [](const BANG_REFLECT_THIS_CLASS *self) -> uint32_t {     \
+            return SCAST<uint32_t>(self->Getter());               \
         },                                                        \
-        [this]() { return SCAST<FlagsPrimitiveType>(Getter()); }, \
+        BANG_REFLECT_HINT_ENUM(true));
+
+#define BANG_REFLECT_VAR_ENUM_FLAGS(Name, Setter, Getter)                  \
+    ReflectVar<BANG_REFLECT_THIS_CLASS, FlagsPrimitiveType>(               \
+        Name,                                                              \
+        [](BANG_REFLECT_THIS_CLASS *self, FlagsPrimitiveType x) {          \
+            self->Setter(SCAST<FlagsPrimitiveType>(x));                    \
+        },                                                                 \
+        [](const BANG_REFLECT_THIS_CLASS *self) -> FlagsPrimitiveType {    \
+            return SCAST<FlagsPrimitiveType>(self->Getter());              \
+        },                                                                 \
         BANG_REFLECT_HINT_ENUM_FLAGS(true));
 
 #define BANG_REFLECT_VAR_ASSET(Name, Setter, Getter, AssetClass, Hints)   \
-    ReflectVar<GUID>(                                                     \
+    ReflectVar<BANG_REFLECT_THIS_CLASS, GUID>(                            \
         Name,                                                             \
-        [this](GUID v) { Setter(Assets::Load<AssetClass>(v).Get()); },    \
-        [this]() -> GUID {                                                \
-            return Getter() ? Getter()->GetGUID() : GUID::Empty();        \
+        [](BANG_REFLECT_THIS_CLASS *self, GUID v) {                       \
+            self->Setter(Assets::Load<AssetClass>(v).Get());              \
+        },                                                                \
+        [](const BANG_REFLECT_THIS_CLASS *self) -> GUID {                 \
+            return self->Getter() ? self->Getter()->GetGUID()             \
+                                  : GUID::Empty();                        \
         },                                                                \
         BANG_REFLECT_HINT_EXTENSIONS(                                     \
             Extensions::GetExtension(AssetClass::GetClassNameStatic())) + \
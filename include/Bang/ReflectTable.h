@@ -0,0 +1,47 @@
+#ifndef REFLECTTABLE_H
+#define REFLECTTABLE_H
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/ReflectFieldAccessor.h"
+#include "Bang/ReflectVariable.h"
+#include "Bang/TypeMap.h"
+
+namespace Bang
+{
+class IReflectable;
+class MetaNode;
+class ReflectStruct;
+
+// Reflected variables of a class, taken once from the Reflect() of one of its
+// instances and shared by all of them. Importing, exporting and copying go
+// through the typed accessors of the variables, without rebuilding the
+// ReflectStruct nor boxing the values in a Variant. Variables reflected with
+// setters and getters bound to an instance (no accessor) still go through
+// the ReflectStruct of each instance. Buttons are actions, not values, so
+// they are skipped.
+class ReflectTable
+{
+public:
+    ReflectTable(TypeId typeId, const ReflectStruct &reflStruct);
+    ~ReflectTable();
+
+    void ImportMeta(IReflectable *reflectable, const MetaNode &metaNode) const;
+    void ExportMeta(const IReflectable *reflectable, MetaNode *metaNode) const;
+    void CopyValues(const IReflectable *from, IReflectable *to) const;
+
+    // Same as ImportMeta, but parsing the meta only once, into operations
+    // that can be applied to many instances
+    void CompileImportMeta(const MetaNode &metaNode,
+                           Array<ReflectImportOp> *importOps) const;
+
+    TypeId GetTypeId() const;
+    const Array<ReflectVariable> &GetVariables() const;
+
+private:
+    TypeId m_typeId;
+    Array<ReflectVariable> m_variables;
+};
+}
+
+#endif  // REFLECTTABLE_H
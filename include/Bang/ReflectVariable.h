@@ -1,6 +1,8 @@
 #ifndef REFLECTVARIABLE_H
 #define REFLECTVARIABLE_H
 
+#include <memory>
+
 #include "Bang/Array.h"
 #include "Bang/BangDefines.h"
 #include "Bang/ReflectVariableHints.h"
@@ -9,6 +11,8 @@
 
 namespace Bang
 {
+class ReflectFieldAccessor;
+
 class ReflectVariable
 {
 public:
@@ -55,6 +59,10 @@ public:
         }
     }
 
+    // Set when the variable is reflected through instance independent
+    // accessors, which lets ReflectTable share it between instances
+    void SetAccessor(const std::shared_ptr<ReflectFieldAccessor> &accessor);
+
     Variant &GetVariant();
     Variant GetCurrentValue() const;
     ReflectVariableHints *GetHintsPtr();
@@ -63,6 +71,7 @@ public:
     const String &GetCodeName() const;
     SetterFunc GetSetter() const;
     GetterFunc GetGetter() const;
+    const ReflectFieldAccessor *GetAccessor() const;
     const String &GetTypeString() const;
     const Variant &GetInitValue() const;
     const String &GetInitValueString() const;
@@ -82,6 +91,7 @@ private:
 
     SetterFunc m_setter = nullptr;
     GetterFunc m_getter = nullptr;
+    std::shared_ptr<ReflectFieldAccessor> p_accessor;
 };
 }  // namespace Bang
 
@@ -0,0 +1,100 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <cstdint>
+
+#include "BangMath/Matrix4.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/RenderPass.h"
+#include "Bang/UMap.h"
+
+namespace Bang
+{
+class Material;
+class Mesh;
+class Renderer;
+class ShaderProgram;
+
+struct RenderQueueStats
+{
+    uint numItems = 0;
+    uint numDrawCalls = 0;
+    uint numInstancedDrawCalls = 0;
+    uint numInstancedItems = 0;
+    uint numShaderProgramChanges = 0;
+    uint numMaterialChanges = 0;
+    uint numMeshChanges = 0;
+
+    void Reset();
+};
+
+struct RenderQueueItem
+{
+    uint64_t sortKey = 0;
+    Renderer *renderer = nullptr;
+    ShaderProgram *shaderProgram = nullptr;
+    Material *material = nullptr;
+    Mesh *mesh = nullptr;
+    Matrix4 modelMatrix = Matrix4::Identity();
+    bool instanceable = false;
+};
+
+struct RenderQueueBatch
+{
+    uint firstItemIndex = 0;
+    uint numItems = 0;
+    bool instanced = false;
+};
+
+// Collects the draws of a pass, sorts them by state so that consecutive
+// draws share as much state as possible, and groups consecutive draws of
+// the same mesh and material into instanced batches. It does not touch GL,
+// the GEngine is the one submitting the batches.
+class RenderQueue
+{
+public:
+    RenderQueue();
+    ~RenderQueue();
+
+    void Clear();
+    void Add(RenderPass renderPass,
+             Renderer *renderer,
+             ShaderProgram *shaderProgram,
+             Material *material,
+             Mesh *mesh,
+             const Matrix4 &modelMatrix,
+             bool instanceable);
+
+    // Sorts the items by their key and builds the batches
+    void Prepare(uint minInstancesPerBatch = 2);
+
+    const Array<RenderQueueItem> &GetItems() const;
+    const Array<RenderQueueBatch> &GetBatches() const;
+    const RenderQueueStats &GetStats() const;
+
+    // Key layout, from most to least significant bits:
+    // [pass: 8][shader program: 16][material: 20][mesh: 20]
+    static uint64_t BuildSortKey(uint renderPassId,
+                                 uint shaderProgramId,
+                                 uint materialId,
+                                 uint meshId);
+
+    // Stable LSD radix sort of the items by their sort key
+    static void RadixSort(Array<RenderQueueItem> *items);
+
+private:
+    Array<RenderQueueItem> m_items;
+    Array<RenderQueueBatch> m_batches;
+    RenderQueueStats m_stats;
+
+    UMap<const void *, uint> m_shaderProgramIds;
+    UMap<const void *, uint> m_materialIds;
+    UMap<const void *, uint> m_meshIds;
+
+    static uint GetId(UMap<const void *, uint> *ids, const void *ptr);
+    void BuildBatches(uint minInstancesPerBatch);
+};
+}
+
+#endif  // RENDERQUEUE_H
@@ -14,7 +14,13 @@ template <class>
 class EventEmitter;
 class Camera;
 class DebugRenderer;
+class SceneAnimatorsUpdater;
+class SceneObjectIndex;
+class SceneParallelUpdater;
+class SceneSpatialIndex;
 class Serializable;
+class TransformHierarchy;
+class TransparentRenderList;
 class IEventsDestroy;
 
 class Scene : public GameObject, public EventListener<IEventsDestroy>
@@ -31,8 +37,24 @@ public:
 
     void SetCamera(Camera *cam);
 
+    // Updates the subtrees whose components only touch their own subtree in
+    // the JobSystem workers (see SceneParallelUpdater)
+    void SetParallelUpdateEnabled(bool parallelUpdateEnabled);
+    bool IsParallelUpdateEnabled() const;
+    SceneParallelUpdater *GetParallelUpdater() const;
+
+    // Updates all the animators before the rest of the scene, evaluating
+    // their poses in the JobSystem workers (see SceneAnimatorsUpdater)
+    void SetParallelAnimatorsEnabled(bool parallelAnimatorsEnabled);
+    bool IsParallelAnimatorsEnabled() const;
+    SceneAnimatorsUpdater *GetAnimatorsUpdater() const;
+
     Time GetDeltaTime() const;
     Camera *GetCamera() const;
+    SceneObjectIndex *GetObjectIndex() const;
+    SceneSpatialIndex *GetSpatialIndex() const;
+    TransformHierarchy *GetTransformHierarchy() const;
+    TransparentRenderList *GetTransparentRenderList() const;
 
     void InvalidateCanvas();
 
@@ -57,6 +79,14 @@ private:
 
     Camera *p_camera = nullptr;
     DebugRenderer *p_debugRenderer = nullptr;
+    SceneObjectIndex *p_objectIndex = nullptr;
+    mutable SceneSpatialIndex *p_spatialIndex = nullptr;
+    mutable TransparentRenderList *p_transparentRenderList = nullptr;
+    mutable SceneParallelUpdater *p_parallelUpdater = nullptr;
+    mutable SceneAnimatorsUpdater *p_animatorsUpdater = nullptr;
+    mutable TransformHierarchy *p_transformHierarchy = nullptr;
+    bool m_parallelUpdateEnabled = false;
+    bool m_parallelAnimatorsEnabled = false;
 
     friend class Window;
     friend class GEngine;
@@ -0,0 +1,47 @@
+#ifndef SCENEANIMATORSUPDATER_H
+#define SCENEANIMATORSUPDATER_H
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/ObjectGatherer.h"
+#include "Bang/Time.h"
+
+namespace Bang
+{
+class Animator;
+class GameObject;
+
+// Updates all the animators below a root before the update walk of the scene,
+// which then skips them. The state machines are stepped in the main thread,
+// since their nodes are shared between animators. Then the poses, which only
+// touch their own animator, are evaluated in the JobSystem workers. Last, the
+// poses are written into the bones in the main thread, in the same order
+// every frame, so the result is the same as evaluating them one by one.
+class SceneAnimatorsUpdater
+{
+public:
+    SceneAnimatorsUpdater();
+    ~SceneAnimatorsUpdater();
+
+    void SetRoot(GameObject *root);
+
+    // Without parallel evaluation the poses are evaluated one by one in the
+    // main thread, which gives the same poses
+    void SetParallelEvaluation(bool parallelEvaluation);
+
+    // All the animators are stepped with the same time
+    void UpdateAnimators(Time now);
+
+    GameObject *GetRoot() const;
+    bool GetParallelEvaluation() const;
+    const Array<Animator *> &GetLastUpdatedAnimators() const;
+
+private:
+    ObjectGatherer<Animator, true> m_animatorsGatherer;
+    Array<Animator *> m_animatorsToEvaluate;
+    Array<Animator *> m_lastUpdatedAnimators;
+    bool m_parallelEvaluation = true;
+};
+}
+
+#endif  // SCENEANIMATORSUPDATER_H
@@ -0,0 +1,104 @@
+#ifndef SCENEOBJECTINDEX_H
+#define SCENEOBJECTINDEX_H
+
+#include <atomic>
+#include <mutex>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/EventListener.h"
+#include "Bang/GUID.h"
+#include "Bang/IEventsChildren.h"
+#include "Bang/IEventsComponent.h"
+#include "Bang/IEventsName.h"
+#include "Bang/String.h"
+#include "Bang/UMap.h"
+#include "Bang/USet.h"
+
+namespace Bang
+{
+class Component;
+class GameObject;
+class Object;
+
+// Hash tables from GUID to the game objects and components below a root (and
+// the root itself), and from name to game objects, kept up to date through
+// the children, component and name events. The Find functions of GameObject
+// and ObjectPtr resolve through the index of their scene when they have one,
+// returning the same object the depth first walk would.
+class SceneObjectIndex : public EventListener<IEventsChildren>,
+                         public EventListener<IEventsComponent>,
+                         public EventListener<IEventsName>
+{
+public:
+    SceneObjectIndex();
+    virtual ~SceneObjectIndex() override;
+
+    void SetRoot(GameObject *root);
+
+    // Game objects or components whose game object is subtreeRoot or one of
+    // its descendants
+    Object *FindObject(const GUID &guid, const GameObject *subtreeRoot) const;
+    GameObject *FindGameObject(const GUID &guid,
+                               const GameObject *subtreeRoot,
+                               bool includeSubtreeRoot) const;
+    GameObject *FindGameObject(const String &name,
+                               const GameObject *subtreeRoot,
+                               bool includeSubtreeRoot) const;
+
+    // GUIDs are changed without events (for example when importing the meta
+    // of an object already in the scene), so objects report it themselves
+    void OnObjectGUIDChanged(Object *object, const GUID &previousGUID);
+
+    // Walks the hierarchy and checks that the index matches it exactly
+    bool CheckConsistency() const;
+
+    GameObject *GetRoot() const;
+    uint GetNumIndexedObjects() const;
+
+    // Changes every time a game object or a component is added or removed,
+    // or a game object is renamed, so that caches built from the hierarchy
+    // know when to be rebuilt
+    uint GetHierarchyVersion() const;
+
+private:
+    GameObject *p_root = nullptr;
+    UMap<GUID, Array<Object *>> m_guidToObjects;
+    UMap<String, USet<GameObject *>> m_nameToGameObjects;
+    uint m_numIndexedObjects = 0;
+    std::atomic<uint> m_hierarchyVersion{0};
+
+    // Names can be changed from the parallel update workers
+    mutable std::mutex m_mutex;
+
+    bool CheckConsistency_() const;
+
+    void AddGameObject(GameObject *go);
+    void RemoveGameObject(GameObject *go);
+    void AddObject(Object *object, const GUID &guid);
+    void RemoveObject(Object *object, const GUID &guid);
+
+    static GameObject *GetGameObjectOf(Object *object);
+    static bool IsInSubtree(const GameObject *go,
+                            const GameObject *subtreeRoot,
+                            bool includeSubtreeRoot);
+    static bool IsBeforeInHierarchy(const GameObject *lhs,
+                                    const GameObject *rhs);
+
+    // IEventsChildren
+    void OnChildAdded(GameObject *addedChild, GameObject *parent) override;
+    void OnChildRemoved(GameObject *removedChild, GameObject *parent) override;
+
+    // IEventsComponent
+    void OnComponentAdded(Component *addedComponent, int index) override;
+    void OnComponentRemoved(Component *removedComponent,
+                            GameObject *previousGameObject) override;
+
+    // IEventsName
+    void OnNameChanged(GameObject *go,
+                       const String &oldName,
+                       const String &newName) override;
+};
+}
+
+#endif  // SCENEOBJECTINDEX_H
@@ -0,0 +1,71 @@
+#ifndef SCENEPARALLELUPDATER_H
+#define SCENEPARALLELUPDATER_H
+
+#include <functional>
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/UMap.h"
+
+namespace Bang
+{
+class GameObject;
+class Scene;
+
+// Updates in the JobSystem workers the biggest subtrees of a scene whose
+// components only touch their own subtree (ComponentUpdateAccess), before the
+// usual update walk of the main thread, which then skips them. Subtrees are
+// scheduled after the subtrees their declared dependencies belong to. A
+// subtree depending on something updated in the main thread, or in a
+// dependency cycle, is left to the main thread.
+// The subtrees and their schedule are cached, and only collected again when
+// the hierarchy of the scene changes (or when invalidated).
+// Structural changes (adding, removing, reparenting or destroying), and the
+// events for the scene wide listeners (transform hierarchy, spatial index,
+// transparent list), asked for while a subtree is being updated are queued
+// in that subtree job, and applied in the main thread once all of them have
+// finished: first all the events, while everything they refer to is still
+// alive, and then all the structural changes, in schedule order.
+class SceneParallelUpdater
+{
+public:
+    SceneParallelUpdater();
+    ~SceneParallelUpdater();
+
+    void UpdateParallelSubtrees(Scene *scene);
+
+    // Clears the marks of the subtrees updated in the last frame, for when
+    // the main thread walk did not reach them
+    void ResetUpdatedMarks(Scene *scene);
+
+    // For when the update dependencies of a component change
+    void InvalidateSubtrees();
+
+    const Array<GameObject *> &GetLastParallelSubtrees() const;
+
+    // If called from a subtree being updated in parallel, queue the change
+    // or the event in its job and return true
+    static bool DeferIfUpdating(const std::function<void()> &structuralChange);
+    static bool DeferEventIfUpdating(const std::function<void()> &event);
+
+private:
+    Array<GameObject *> m_subtrees;
+    Array<Array<uint>> m_subtreeDependencies;
+    Array<uint> m_scheduleOrder;
+    Array<Array<std::function<void()>>> m_deferredEvents;
+    Array<Array<std::function<void()>>> m_deferredStructuralChanges;
+    Array<GameObject *> m_lastParallelSubtrees;
+    UMap<GameObject *, uint> m_subtreeIndices;
+    uint m_subtreesHierarchyVersion = 0;
+    bool m_subtreesValid = false;
+
+    // Returns whether they were collected again
+    bool CollectSubtreesIfNeeded(Scene *scene);
+    bool CollectSubtrees(GameObject *go);
+    void ScheduleSubtrees();
+    int GetSubtreeIndexOf(GameObject *go) const;
+    void ApplyDeferredChanges();
+};
+}
+
+#endif  // SCENEPARALLELUPDATER_H
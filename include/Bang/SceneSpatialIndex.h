@@ -0,0 +1,139 @@
+#ifndef SCENESPATIALINDEX_H
+#define SCENESPATIALINDEX_H
+
+#include <mutex>
+
+#include "BangMath/AABox.h"
+#include "BangMath/Ray.h"
+#include "BangMath/Sphere.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/DynamicAABBTree.h"
+#include "Bang/EventListener.h"
+#include "Bang/Frustum.h"
+#include "Bang/IEventsObjectGatherer.h"
+#include "Bang/IEventsRendererChanged.h"
+#include "Bang/IEventsTransform.h"
+#include "Bang/ObjectGatherer.h"
+#include "Bang/UMap.h"
+
+namespace Bang
+{
+class Collider;
+class Component;
+class GameObject;
+class Light;
+class Renderer;
+
+// Keeps the renderers, colliders and lights below a root in dynamic AABB
+// trees, so that spatial queries do not need to visit the whole hierarchy.
+// Objects are refitted lazily: transform changes (and renderer changes, and
+// light range changes) only mark them as dirty, and the trees are updated on
+// the next Update() (or query).
+class SceneSpatialIndex : public EventListener<IEventsObjectGatherer<Renderer>>,
+                          public EventListener<IEventsObjectGatherer<Collider>>,
+                          public EventListener<IEventsObjectGatherer<Light>>,
+                          public EventListener<IEventsRendererChanged>
+{
+public:
+    SceneSpatialIndex();
+    virtual ~SceneSpatialIndex() override;
+
+    void SetRoot(GameObject *root);
+    void Update();
+    void MarkDirty(Component *component);
+
+    // Objects without finite bounds (directional lights, renderers without
+    // mesh, etc.) are always reported by the queries
+    void QueryRenderers(const Frustum &frustum,
+                        Array<Renderer *> *renderersOut,
+                        bool testDepth = true);
+    void QueryRenderers(const AABox &aaBox, Array<Renderer *> *renderersOut);
+    void QueryRenderers(const Sphere &sphere, Array<Renderer *> *renderersOut);
+    void QueryRenderers(const Ray &ray,
+                        float maxDistance,
+                        Array<Renderer *> *renderersOut);
+
+    void QueryColliders(const AABox &aaBox, Array<Collider *> *collidersOut);
+    void QueryColliders(const Sphere &sphere, Array<Collider *> *collidersOut);
+    void QueryColliders(const Ray &ray,
+                        float maxDistance,
+                        Array<Collider *> *collidersOut);
+
+    void QueryLights(const Frustum &frustum, Array<Light *> *lightsOut);
+    void QueryLights(const AABox &aaBox, Array<Light *> *lightsOut);
+    void QueryLights(const Sphere &sphere, Array<Light *> *lightsOut);
+
+    GameObject *GetRoot() const;
+    uint GetNumRenderers() const;
+    uint GetNumColliders() const;
+    uint GetNumLights() const;
+
+    static AABox GetAABoxWorld(Component *component);
+
+private:
+    using Tree = DynamicAABBTree<Component *>;
+
+    struct Category
+    {
+        Tree tree;
+        Array<Component *> unboundedComponents;
+    };
+
+    class Entry : public EventListener<IEventsTransform>
+    {
+    public:
+        SceneSpatialIndex *p_index = nullptr;
+        Component *p_component = nullptr;
+        Category *p_category = nullptr;
+        int proxyId = Tree::NullNode;
+        bool dirty = false;
+
+        // IEventsTransform
+        void OnTransformChanged() override;
+        void OnParentTransformChanged() override;
+    };
+
+    GameObject *p_root = nullptr;
+    ObjectGatherer<Renderer, true> m_renderersGatherer;
+    ObjectGatherer<Collider, true> m_collidersGatherer;
+    ObjectGatherer<Light, true> m_lightsGatherer;
+
+    Category m_renderers;
+    Category m_colliders;
+    Category m_lights;
+    UMap<Component *, Entry *> m_entries;
+    Array<Entry *> m_dirtyEntries;
+    Array<Entry *> m_refitEntries;
+
+    // Transforms can be changed from the parallel update workers
+    std::mutex m_dirtyEntriesMutex;
+
+    void AddEntry(Component *component, Category *category);
+    void RemoveEntry(Component *component, Category *category);
+    void MarkDirty(Entry *entry);
+    void Refit(Entry *entry);
+    void Clear();
+
+    template <class T, class QueryFunction>
+    void Query(Category *category,
+               const QueryFunction &queryFunction,
+               Array<T *> *objectsOut);
+
+    // IEventsObjectGatherer
+    void OnObjectGathered(Renderer *renderer) override;
+    void OnObjectGathered(Collider *collider) override;
+    void OnObjectGathered(Light *light) override;
+    void OnObjectUnGathered(GameObject *previousGameObject,
+                            Renderer *renderer) override;
+    void OnObjectUnGathered(GameObject *previousGameObject,
+                            Collider *collider) override;
+    void OnObjectUnGathered(GameObject *previousGameObject,
+                            Light *light) override;
+
+    // IEventsRendererChanged
+    void OnRendererChanged(Renderer *changedRenderer) override;
+};
+}
+
+#endif  // SCENESPATIALINDEX_H
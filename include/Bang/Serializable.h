@@ -23,8 +23,16 @@ public:
     virtual void ImportMeta(const MetaNode &metaNode);
     virtual void ExportMeta(MetaNode *metaNode) const;
 
+    // ImportMeta parsed once into operations that can be applied to many
+    // instances of the class. Classes that import more than their reflected
+    // variables in ImportMeta do not have it all here.
+    virtual void CompileImportMeta(const MetaNode &metaNode,
+                                   Array<ReflectImportOp> *importOps) const;
+
     virtual bool ImportMetaFromFile(const Path &path);
     virtual bool ExportMetaToFile(const Path &path) const;
+    // Format ExportMetaToFile writes. Any of them is read on import.
+    virtual MetaNodeFormat GetMetaFileFormat() const;
 
     virtual String GetClassName() const = 0;
 
@@ -44,6 +52,7 @@ protected:
     Serializable();
 
     void SetGUID(const GUID &guid);
+    virtual void OnGUIDChanged(const GUID &previousGUID);
 
 private:
     GUID m_GUID;
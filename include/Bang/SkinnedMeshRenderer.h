@@ -1,6 +1,7 @@
 #ifndef SKINNEDMESHRENDERER_H
 #define SKINNEDMESHRENDERER_H
 
+#include <array>
 #include <functional>
 #include <vector>
 
@@ -27,6 +28,7 @@ template <class>
 class IEventsObjectGatherer;
 class GameObject;
 class Serializable;
+class Mesh;
 class Model;
 class ShaderProgram;
 template <class ObjectType, bool RECURSIVE>
@@ -44,15 +46,17 @@ public:
 
     // MeshRenderer
     void OnUpdate() override;
+    void OnPostUpdate() override;
     void OnRender() override;
     virtual void Bind() override;
     virtual void SetUniformsOnBind(ShaderProgram *sp) override;
     Matrix4 GetModelMatrixUniform() const override;
+    AABox GetAABBox() const override;
 
     void SetRootBoneGameObjectName(const String &rootBoneGameObjectName);
 
     Model *GetActiveModel() const;
-    Array<GameObject *> GetAllBoneGameObjects() const;
+    const Array<GameObject *> &GetAllBoneGameObjects() const;
     GameObject *GetRootBoneGameObject() const;
     const String &GetRootBoneGameObjectName() const;
     GameObject *GetBoneGameObject(const String &boneName) const;
@@ -71,9 +75,42 @@ public:
     void SetSkinnedMeshRendererCurrentBoneMatrices(
         const Array<Matrix4> &boneMatrices);
 
+    const Array<Matrix4> &GetBoneMatrices() const;
+
     void ResetBoneTransformation(GameObject *boneGo);
     void ResetBoneTransformations();
 
+    // Skins the positions of the active mesh on the CPU with the current bone
+    // matrices, as the vertex shader does. They are in the root bone space.
+    void ComputeSkinnedPositions(Array<Vector3> *skinnedPositions) const;
+    AABox ComputeSkinnedAABBox() const;
+
+    // Linear blend skinning of positions with up to 4 bones each
+    static void SkinPositions(const Array<Vector3> &positions,
+                              const Array<std::array<int, 4>> &bonesIds,
+                              const Array<std::array<float, 4>> &bonesWeights,
+                              const Array<Matrix4> &boneMatrices,
+                              Array<Vector3> *skinnedPositions);
+
+    // Bind space bounds of the vertices of each bone, for the culling bounds
+    struct BoneBounds
+    {
+        Array<AABox> boneBindSpaceBounds;
+        Array<Byte> boneHasVertices;
+        AABox unskinnedBounds;
+        bool hasUnskinnedVertices = false;
+    };
+    static void ComputeBoneBounds(
+        const Array<Vector3> &positions,
+        const Array<std::array<int, 4>> &bonesIds,
+        const Array<std::array<float, 4>> &bonesWeights,
+        BoneBounds *boneBounds);
+
+    // Bounds of the positions skinned with these bone matrices, in the root
+    // bone space, without skinning them. Empty if there are no positions.
+    static AABox SkinBoneBounds(const BoneBounds &boneBounds,
+                                const Array<Matrix4> &boneMatrices);
+
     // ObjectGatherer
     virtual void OnObjectGathered(GameObject *go) override;
     virtual void OnObjectUnGathered(GameObject *previousGameObject,
@@ -86,14 +123,50 @@ protected:
     void OnMeshLoaded(Mesh *mesh) override;
 
 private:
+    // A bone, or a GameObject between a bone and the root bone, with what
+    // its transformation in root space needs, resolved once
+    struct BoneBinding
+    {
+        GameObject *gameObject = nullptr;
+
+        // Binding of the parent, -1 if the parent is the root bone
+        int parentBindingIndex = -1;
+
+        // In the bone matrices, -1 if it is not a bone of the mesh
+        int boneMatrixIndex = -1;
+
+        Transformation parentBoneSpaceToRootSpace;
+        Transformation rootSpaceToBoneSpace;
+    };
+
     Array<Matrix4> m_bonesTransformsMatricesArrayUniform;
 
+    // Palette of the last update, to know when the bounds have changed
+    Array<Matrix4> m_prevBonesTransformsMatrices;
+
     ObjectGatherer<GameObject, true> *m_gameObjectGatherer = nullptr;
 
     String m_rootBoneGameObjectName = "";
     mutable USet<String> m_boneNames;
     mutable DPtr<GameObject> p_rootBoneGameObject = nullptr;
     mutable Map<String, GameObject *> m_boneNameToBoneGameObject;
+
+    // Parents before children
+    mutable bool m_boneBindingsValid = false;
+    mutable const Mesh *p_boneBindingsMesh = nullptr;
+    mutable Array<BoneBinding> m_boneBindings;
+    mutable Array<GameObject *> m_boneGameObjects;
+    Array<Transformation> m_boneTransformsInRootSpace;
+
+    mutable bool m_boneBoundsValid = false;
+    mutable const Mesh *p_boneBoundsMesh = nullptr;
+    mutable BoneBounds m_boneBounds;
+
+    void BindBonesIfNeeded() const;
+    int AddBoneBinding(GameObject *go,
+                       UMap<GameObject *, int> *goToBindingIndex) const;
+    void InvalidateBoneBindings();
+    void UpdateBoneBoundsIfNeeded() const;
 };
 }
 
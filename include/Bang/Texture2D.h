@@ -57,6 +57,7 @@ public:
 
     // Asset
     virtual void Import(const Path &imageFilepath) override;
+    std::size_t GetResidentBytes() const override;
 
 protected:
     Texture2D();
@@ -70,10 +71,16 @@ protected:
     // Texture
     void OnFormatChanged() override;
 
+    // Asset
+    void ImportAsync(const Path &imageFilepath) override;
+    void ImportAsyncFinish(const Path &imageFilepath) override;
+
 private:
     Image m_image;
     float m_alphaCutoff = 0.0f;
     Vector2i m_size = Vector2i::Zero();
+
+    void FillFromImage();
 };
 }  // namespace Bang
 
@@ -22,6 +22,7 @@ namespace Bang
 {
 class GameObject;
 class Serializable;
+class TransformHierarchy;
 
 class IInvalidatableTransformWorld
     : public IInvalidatable<IInvalidatableTransformWorld>
@@ -123,6 +124,9 @@ public:
     void OnParentTransformChanged() override;
     void OnChildrenTransformChanged() override;
 
+    // Component
+    virtual ComponentUpdateAccess GetUpdateAccess() const override;
+
     // Serializable
     virtual void Reflect() override;
 
@@ -134,6 +138,15 @@ protected:
     mutable Matrix4 m_localToWorldMatrix;
     mutable Matrix4 m_worldToLocalMatrix;
 
+    // Inverses are only computed when asked for
+    mutable bool m_parentToLocalMatrixValid = false;
+    mutable bool m_worldToLocalMatrixValid = false;
+
+    // World values, cached along with the local to world matrix
+    mutable Vector3 m_position = Vector3::Zero();
+    mutable Quaternion m_rotation = Quaternion::Identity();
+    mutable Vector3 m_scale = Vector3::One();
+
     Transform();
     virtual ~Transform() override;
 
@@ -145,6 +158,7 @@ protected:
     void RecalculateParentMatricesIfNeeded() const;
     void RecalculateWorldMatricesIfNeeded() const;
     virtual void CalculateLocalToParentMatrix() const;
+    virtual void CalculateParentToLocalMatrix() const;
     virtual void CalculateLocalToWorldMatrix() const;
 
     virtual bool CanBeRepeatedInGameObject() const override;
@@ -154,8 +168,11 @@ private:
     Vector3 m_localEulerAnglesDegreesHint = Vector3::Zero();
 
     mutable bool m_alreadyNotifiedChildrenThatTransformHasChanged = false;
+    TransformHierarchy *p_transformHierarchy = nullptr;
 
     void PropagateParentTransformChangedEventToChildren() const;
+
+    friend class TransformHierarchy;
 };
 }  // namespace Bang
 
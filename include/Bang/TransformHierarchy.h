@@ -0,0 +1,61 @@
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/EventListener.h"
+#include "Bang/IEventsObjectGatherer.h"
+#include "Bang/ObjectGatherer.h"
+
+namespace Bang
+{
+class GameObject;
+class Transform;
+
+// Flat view of the transforms below a root, sorted by depth, with the index
+// of the parent transform of each one (-1 for the top ones). The topology is
+// rebuilt lazily when the hierarchy changes. UpdateWorldMatrices() refreshes
+// the invalid world matrices level by level in a single linear pass, running
+// the big levels in parallel in the JobSystem, so that the later reads of
+// GetPosition(), GetLocalToWorldMatrix(), etc. just return cached values.
+// Rect transforms (and everything below them) are left out, since their
+// matrices depend on the viewport being rendered.
+class TransformHierarchy
+    : public EventListener<IEventsObjectGatherer<Transform>>
+{
+public:
+    TransformHierarchy();
+    virtual ~TransformHierarchy() override;
+
+    void SetRoot(GameObject *root);
+    void InvalidateTopology();
+    void UpdateWorldMatrices();
+
+    GameObject *GetRoot() const;
+    uint GetNumTransforms() const;
+    uint GetNumLevels() const;
+    Transform *GetTransform(uint index) const;
+    int GetParentIndex(uint index) const;
+
+private:
+    ObjectGatherer<Transform, true> m_transformsGatherer;
+
+    Array<Transform *> m_sortedTransforms;
+    Array<int> m_parentIndices;
+
+    // m_sortedTransforms[m_levelBegins[l]..m_levelBegins[l+1]) are in level l
+    Array<uint> m_levelBegins;
+
+    bool m_topologyValid = false;
+
+    void RebuildTopologyIfNeeded();
+    void UpdateWorldMatrices(uint begin, uint end);
+
+    // IEventsObjectGatherer
+    void OnObjectGathered(Transform *transform) override;
+    void OnObjectUnGathered(GameObject *previousGameObject,
+                            Transform *transform) override;
+};
+}
+
+#endif  // TRANSFORMHIERARCHY_H
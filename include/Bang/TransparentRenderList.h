@@ -0,0 +1,65 @@
+#ifndef TRANSPARENTRENDERLIST_H
+#define TRANSPARENTRENDERLIST_H
+
+#include "BangMath/Vector3.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+#include "Bang/EventListener.h"
+#include "Bang/IEventsObjectGatherer.h"
+#include "Bang/IEventsRendererChanged.h"
+#include "Bang/ObjectGatherer.h"
+#include "Bang/UMap.h"
+
+namespace Bang
+{
+class GameObject;
+class Renderer;
+
+// Maintains the renderers below a root whose material is rendered in the
+// transparent pass, so that the transparent pass does not need to visit the
+// whole hierarchy every frame. The back to front order of the previous frame
+// is kept, so sorting is an insertion sort over an almost sorted array.
+class TransparentRenderList
+    : public EventListener<IEventsObjectGatherer<Renderer>>,
+      public EventListener<IEventsRendererChanged>
+{
+public:
+    TransparentRenderList();
+    virtual ~TransparentRenderList() override;
+
+    void SetRoot(GameObject *root);
+    void SortBackToFront(const Vector3 &cameraPosition);
+
+    GameObject *GetRoot() const;
+    const Array<Renderer *> &GetRenderers() const;
+
+    static bool IsTransparent(const Renderer *renderer);
+
+private:
+    struct Entry
+    {
+        Renderer *renderer = nullptr;
+        float distanceSq = 0.0f;
+    };
+
+    GameObject *p_root = nullptr;
+    ObjectGatherer<Renderer, true> m_renderersGatherer;
+    Array<Entry> m_entries;
+    UMap<Renderer *, uint> m_entryIndices;
+    Array<Renderer *> m_sortedRenderers;
+
+    int IndexOf(Renderer *renderer) const;
+    void UpdateMembership(Renderer *renderer);
+    void Remove(Renderer *renderer);
+
+    // IEventsObjectGatherer
+    void OnObjectGathered(Renderer *renderer) override;
+    void OnObjectUnGathered(GameObject *previousGameObject,
+                            Renderer *renderer) override;
+
+    // IEventsRendererChanged
+    void OnRendererChanged(Renderer *changedRenderer) override;
+};
+}
+
+#endif  // TRANSPARENTRENDERLIST_H
@@ -0,0 +1,62 @@
+#ifndef TRIANGLEBVH_H
+#define TRIANGLEBVH_H
+
+#include "BangMath/AABox.h"
+#include "BangMath/Segment.h"
+#include "BangMath/Triangle.h"
+#include "BangMath/Vector3.h"
+#include "Bang/Array.h"
+#include "Bang/BangDefines.h"
+
+namespace Bang
+{
+// Bounding volume hierarchy over a set of triangles, in the space of their
+// positions. Built top-down, splitting each node at the median triangle
+// along its longest axis.
+class TriangleBVH
+{
+public:
+    static constexpr uint MaxLeafTriangles = 4;
+
+    TriangleBVH();
+    ~TriangleBVH();
+
+    // Every 3 vertex ids are a triangle, as in Mesh
+    void Build(const Array<Vector3> &positions,
+               const Array<uint> &trianglesVertexIds);
+    void Clear();
+
+    // Closest triangle crossed by the segment, measured from its origin.
+    // The whole segment is tested, so it can not go through a triangle
+    // between its ends without hitting it.
+    bool IntersectSegment(const Segment &segment,
+                          Vector3 *intersectionPoint,
+                          uint *triangleId) const;
+
+    bool IsEmpty() const;
+    uint GetNumNodes() const;
+    const AABox &GetAABox() const;
+
+private:
+    struct Node
+    {
+        AABox aaBox;
+
+        // Leaves have triangles. The first child of an inner node is the
+        // next node, and the second one is at secondChildIndex.
+        uint trianglesBegin = 0;
+        uint numTriangles = 0;
+        uint secondChildIndex = 0;
+    };
+
+    Array<Node> m_nodes;
+    Array<Triangle> m_triangles;
+
+    // Triangle ids, sorted so that each leaf has a range of them
+    Array<uint> m_triangleIds;
+
+    uint BuildNode(uint begin, uint end, const Array<Vector3> &centroids);
+};
+}
+
+#endif  // TRIANGLEBVH_H
@@ -0,0 +1,245 @@
+#include "Bang/AnimationSampler.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/UMap.tcc"
+#include "BangMath/Math.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Vector3.h"
+
+using namespace Bang;
+
+uint AnimationSkeleton::AddBone(const String &boneName)
+{
+    auto it = m_boneNameToIndex.Find(boneName);
+    if (it != m_boneNameToIndex.End())
+    {
+        return it->second;
+    }
+
+    const uint boneIndex = m_boneNames.Size();
+    m_boneNames.PushBack(boneName);
+    m_boneNameToIndex.Add(boneName, boneIndex);
+    return boneIndex;
+}
+
+void AnimationSkeleton::Clear()
+{
+    m_boneNames.Clear();
+    m_boneNameToIndex.Clear();
+}
+
+int AnimationSkeleton::GetBoneIndex(const String &boneName) const
+{
+    auto it = m_boneNameToIndex.Find(boneName);
+    return (it != m_boneNameToIndex.End()) ? SCAST<int>(it->second) : -1;
+}
+
+const String &AnimationSkeleton::GetBoneName(uint boneIndex) const
+{
+    return m_boneNames[boneIndex];
+}
+
+const Array<String> &AnimationSkeleton::GetBoneNames() const
+{
+    return m_boneNames;
+}
+
+uint AnimationSkeleton::GetNumBones() const
+{
+    return m_boneNames.Size();
+}
+
+void AnimationPose::Reset(uint numBones)
+{
+    boneTransformations.Resize(numBones);
+    animatedBones.Resize(numBones);
+    for (uint i = 0; i < numBones; ++i)
+    {
+        animatedBones[i] = 0;
+    }
+}
+
+void AnimationPose::Grow(uint numBones)
+{
+    const uint prevNumBones = GetNumBones();
+    if (numBones > prevNumBones)
+    {
+        boneTransformations.Resize(numBones);
+        animatedBones.Resize(numBones);
+        for (uint i = prevNumBones; i < numBones; ++i)
+        {
+            animatedBones[i] = 0;
+        }
+    }
+}
+
+void AnimationPose::Combine(const AnimationPose &layerPose,
+                            const Array<float> &boneWeights)
+{
+    const uint numLayerBones = layerPose.GetNumBones();
+    Grow(numLayerBones);
+
+    const bool hasWeights = !boneWeights.IsEmpty();
+    for (uint i = 0; i < numLayerBones; ++i)
+    {
+        const bool masked =
+            hasWeights && (i >= boneWeights.Size() || boneWeights[i] <= 0.0f);
+        if (!layerPose.animatedBones[i] || masked)
+        {
+            continue;
+        }
+
+        const Transformation &layerTransformation =
+            layerPose.boneTransformations[i];
+        if (animatedBones[i])
+        {
+            Transformation &transformation = boneTransformations[i];
+            transformation.Translate(layerTransformation.GetPosition());
+            transformation.Rotate(layerTransformation.GetRotation());
+            transformation.Scale(layerTransformation.GetScale());
+        }
+        else
+        {
+            boneTransformations[i] = layerTransformation;
+            animatedBones[i] = 1;
+        }
+    }
+}
+
+bool AnimationPose::IsBoneAnimated(uint boneIndex) const
+{
+    return (boneIndex < animatedBones.Size()) && animatedBones[boneIndex];
+}
+
+uint AnimationPose::GetNumBones() const
+{
+    return boneTransformations.Size();
+}
+
+void AnimationPose::Interpolate(const AnimationPose &prevPose,
+                                const AnimationPose &nextPose,
+                                float weight,
+                                AnimationPose *outPose)
+{
+    const uint numBones =
+        Math::Max(prevPose.GetNumBones(), nextPose.GetNumBones());
+    outPose->Grow(numBones);
+
+    const Transformation identity;
+    for (uint i = 0; i < numBones; ++i)
+    {
+        const bool prevAnimated = prevPose.IsBoneAnimated(i);
+        const bool nextAnimated = nextPose.IsBoneAnimated(i);
+        if (!prevAnimated && !nextAnimated)
+        {
+            outPose->animatedBones[i] = 0;
+            continue;
+        }
+
+        const Transformation &prevTransformation =
+            prevAnimated ? prevPose.boneTransformations[i] : identity;
+        const Transformation &nextTransformation =
+            nextAnimated ? nextPose.boneTransformations[i] : identity;
+
+        const Vector3 interpPos =
+            Vector3::Lerp(prevTransformation.GetPosition(),
+                          nextTransformation.GetPosition(),
+                          weight);
+        const Quaternion interpRot =
+            Quaternion::SLerp(prevTransformation.GetRotation(),
+                              nextTransformation.GetRotation(),
+                              weight);
+        const Vector3 interpScale =
+            Vector3::Lerp(prevTransformation.GetScale(),
+                          nextTransformation.GetScale(),
+                          weight);
+
+        Transformation &outTransformation = outPose->boneTransformations[i];
+        outTransformation.SetPosition(interpPos);
+        outTransformation.SetRotation(interpRot);
+        outTransformation.SetScale(interpScale);
+        outPose->animatedBones[i] = 1;
+    }
+}
+
+void AnimationSampler::Bind(const Animation *animation,
+                            const AnimationSkeleton *skeleton)
+{
+    p_animation = animation;
+    p_skeleton = skeleton;
+    m_boundSkeletonNumBones = 0;
+    m_boneTrackBoneIndices.Clear();
+    m_boneTrackCursors.Clear();
+    BindIfNeeded();
+}
+
+void AnimationSampler::Sample(Time animationTime, AnimationPose *pose)
+{
+    BindIfNeeded();
+
+    const double timeInFrames =
+        Animation::GetSampleTimeInFrames(GetAnimation(), animationTime);
+    if (timeInFrames < 0.0 || !GetSkeleton())
+    {
+        return;
+    }
+
+    if (pose->GetNumBones() < GetSkeleton()->GetNumBones())
+    {
+        pose->Reset(GetSkeleton()->GetNumBones());
+    }
+
+    const Array<Animation::BoneTrack> &boneTracks =
+        GetAnimation()->GetBoneTracks();
+    for (uint i = 0; i < boneTracks.Size(); ++i)
+    {
+        const int boneIndex = m_boneTrackBoneIndices[i];
+        if (boneIndex >= 0)
+        {
+            pose->boneTransformations[boneIndex] = Animation::SampleBoneTrack(
+                boneTracks[i], timeInFrames, &m_boneTrackCursors[i]);
+            pose->animatedBones[boneIndex] = 1;
+        }
+    }
+}
+
+const Animation *AnimationSampler::GetAnimation() const
+{
+    return p_animation;
+}
+
+const AnimationSkeleton *AnimationSampler::GetSkeleton() const
+{
+    return p_skeleton;
+}
+
+uint AnimationSampler::GetNumBoundBoneTracks() const
+{
+    return m_boneTrackBoneIndices.Size();
+}
+
+void AnimationSampler::BindIfNeeded()
+{
+    // Bone tracks and skeleton bones are only ever added
+    const uint numBoneTracks =
+        GetAnimation() ? GetAnimation()->GetBoneTracks().Size() : 0;
+    const uint numSkeletonBones =
+        GetSkeleton() ? GetSkeleton()->GetNumBones() : 0;
+    if (numBoneTracks == m_boneTrackBoneIndices.Size() &&
+        numSkeletonBones == m_boundSkeletonNumBones)
+    {
+        return;
+    }
+
+    m_boundSkeletonNumBones = numSkeletonBones;
+    m_boneTrackBoneIndices.Resize(numBoneTracks);
+    m_boneTrackCursors.Resize(numBoneTracks);
+    for (uint i = 0; i < numBoneTracks; ++i)
+    {
+        const Animation::BoneTrack &boneTrack =
+            GetAnimation()->GetBoneTracks()[i];
+        m_boneTrackBoneIndices[i] =
+            GetSkeleton() ? GetSkeleton()->GetBoneIndex(boneTrack.boneName)
+                          : -1;
+    }
+}
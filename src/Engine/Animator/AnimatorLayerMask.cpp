@@ -98,6 +98,22 @@ Set<String> AnimatorLayerMask::GetBoneMaskNamesSet(Animator *animator) const
     return boneMaskSet;
 }
 
+Array<float> AnimatorLayerMask::GetBoneMaskWeights(
+    Animator *animator,
+    const AnimationSkeleton &skeleton) const
+{
+    const Set<String> boneMaskSet = GetBoneMaskNamesSet(animator);
+
+    Array<float> boneWeights;
+    boneWeights.Resize(skeleton.GetNumBones());
+    for (uint i = 0; i < skeleton.GetNumBones(); ++i)
+    {
+        boneWeights[i] =
+            boneMaskSet.Contains(skeleton.GetBoneName(i)) ? 1.0f : 0.0f;
+    }
+    return boneWeights;
+}
+
 void AnimatorLayerMask::Import(const Path &assetFilepath)
 {
     BANG_UNUSED(assetFilepath);
@@ -76,6 +76,33 @@ AnimatorStateMachineBlendTreeNode::GetBoneTransformations(
     return blended;
 }
 
+void AnimatorStateMachineBlendTreeNode::SampleBonePose(
+    Time animationTime,
+    Animator *animator,
+    AnimationPose *pose) const
+{
+    float secondWeight = animator->GetVariableFloat(GetBlendVariableName());
+    secondWeight = Math::Clamp(secondWeight, 0.0f, 1.0f);
+
+    animator->SampleAnimation(GetAnimation(), animationTime, pose);
+    float normalizedTime =
+        animationTime.GetSeconds() /
+        Math::Max(GetAnimation()->GetDurationInSeconds(), 0.01f);
+
+    if (GetSecondAnimation())
+    {
+        Time secondAnimationTime = Time::Seconds(
+            normalizedTime * GetSecondAnimation()->GetDurationInSeconds());
+        secondAnimationTime *= GetSecondAnimationSpeed();
+
+        // Blended in place, the second pose is reused by every blend tree
+        AnimationPose *secondPose = animator->GetBlendPose();
+        animator->SampleAnimation(
+            GetSecondAnimation(), secondAnimationTime, secondPose);
+        AnimationPose::Interpolate(*pose, *secondPose, secondWeight, pose);
+    }
+}
+
 Animation *AnimatorStateMachineBlendTreeNode::GetSecondAnimation() const
 {
     return p_secondAnimation.Get();
@@ -90,6 +90,13 @@ Map<String, Transformation> AnimatorStateMachineNode::GetBoneTransformations(
     return bonesTransformations;
 }
 
+void AnimatorStateMachineNode::SampleBonePose(Time animationTime,
+                                              Animator *animator,
+                                              AnimationPose *pose) const
+{
+    animator->SampleAnimation(GetAnimation(), animationTime, pose);
+}
+
 void AnimatorStateMachineNode::SetSpeed(float speed)
 {
     m_speed = speed;
@@ -39,6 +39,8 @@ void Animation::AddPositionKeyFrame(
     if (!GetBoneNameToPositionKeyFrames().ContainsKey(boneName))
     {
         m_boneNameToPositionKeyFrames.Add(boneName, {{}});
+        GetOrAddBoneTrack(boneName)->positionKeyFrames =
+            &m_boneNameToPositionKeyFrames.Get(boneName);
     }
     m_boneNameToPositionKeyFrames.Get(boneName).PushBack(keyFrame);
     PropagateAssetChanged();
@@ -51,6 +53,8 @@ void Animation::AddRotationKeyFrame(
     if (!GetBoneNameToRotationKeyFrames().ContainsKey(boneName))
     {
         m_boneNameToRotationKeyFrames.Add(boneName, {{}});
+        GetOrAddBoneTrack(boneName)->rotationKeyFrames =
+            &m_boneNameToRotationKeyFrames.Get(boneName);
     }
     m_boneNameToRotationKeyFrames.Get(boneName).PushBack(keyFrame);
     PropagateAssetChanged();
@@ -62,6 +66,8 @@ void Animation::AddScaleKeyFrame(const String &boneName,
     if (!GetBoneNameToScaleKeyFrames().ContainsKey(boneName))
     {
         m_boneNameToScaleKeyFrames.Add(boneName, {{}});
+        GetOrAddBoneTrack(boneName)->scaleKeyFrames =
+            &m_boneNameToScaleKeyFrames.Get(boneName);
     }
     m_boneNameToScaleKeyFrames.Get(boneName).PushBack(keyFrame);
     PropagateAssetChanged();
@@ -128,23 +134,63 @@ AnimationWrapMode Animation::GetWrapMode() const
     return m_wrapMode;
 }
 
+// Index of the first keyframe whose next one is at or after the given time,
+// as long as it is at or before it. The keyframes are sorted by time.
 template <class T>
-Array<Animation::KeyFrame<T>> GetConsecutiveKeyFrames(
-    const Array<Animation::KeyFrame<T>> &keyFrames,
-    float timeInFrames)
+bool FindConsecutiveKeyFrames(const Array<Animation::KeyFrame<T>> &keyFrames,
+                              float timeInFrames,
+                              uint *cursor)
 {
     const uint numKF = keyFrames.Size();
-    for (uint i = 0; i < numKF - 1; ++i)
+    if (numKF < 2)
     {
-        const Animation::KeyFrame<T> &prevKF = keyFrames[i];
-        const Animation::KeyFrame<T> &nextKF = keyFrames[i + 1];
-        if (timeInFrames >= prevKF.timeInFrames &&
-            timeInFrames <= nextKF.timeInFrames)
+        return false;
+    }
+
+    // The cursor can only be moved forward if no previous keyframe matches
+    uint i = *cursor;
+    if (i >= numKF - 1 || (i > 0 && keyFrames[i].timeInFrames >= timeInFrames))
+    {
+        uint begin = 0, end = numKF - 1;
+        while (begin < end)
         {
-            return {{prevKF, nextKF}};
+            const uint mid = (begin + end) / 2;
+            if (keyFrames[mid + 1].timeInFrames < timeInFrames)
+            {
+                begin = mid + 1;
+            }
+            else
+            {
+                end = mid;
+            }
         }
+        i = begin;
+    }
+
+    while (i < numKF - 1 && keyFrames[i + 1].timeInFrames < timeInFrames)
+    {
+        ++i;
+    }
+
+    if (i < numKF - 1 && keyFrames[i].timeInFrames <= timeInFrames)
+    {
+        *cursor = i;
+        return true;
     }
-    return {{}};
+    return false;
+}
+
+template <class T>
+float GetKeyFramesInterpFactor(const Animation::KeyFrame<T> &prevKF,
+                               const Animation::KeyFrame<T> &nextKF,
+                               double timeInFrames)
+{
+    float timeBetweenPrevNext = (nextKF.timeInFrames - prevKF.timeInFrames);
+    timeBetweenPrevNext = Math::Max(timeBetweenPrevNext, 0.0001f);
+
+    float timePassedSincePrev = (timeInFrames - prevKF.timeInFrames);
+    float interpFactor = (timePassedSincePrev / timeBetweenPrevNext);
+    return Math::Clamp(interpFactor, 0.0f, 1.0f);
 }
 
 float Animation::WrapTime(float time,
@@ -224,6 +270,25 @@ const Map<String, Array<Animation::KeyFrame<Vector3>>>
     return m_boneNameToScaleKeyFrames;
 }
 
+const Array<Animation::BoneTrack> &Animation::GetBoneTracks() const
+{
+    return m_boneTracks;
+}
+
+Animation::BoneTrack *Animation::GetOrAddBoneTrack(const String &boneName)
+{
+    auto it = m_boneNameToBoneTrackIndex.Find(boneName);
+    if (it != m_boneNameToBoneTrackIndex.End())
+    {
+        return &m_boneTracks[it->second];
+    }
+
+    m_boneNameToBoneTrackIndex.Add(boneName, m_boneTracks.Size());
+    m_boneTracks.PushBack(BoneTrack());
+    m_boneTracks.Back().boneName = boneName;
+    return &m_boneTracks.Back();
+}
+
 void Animation::Import(const Path &animationFilepath)
 {
     BANG_UNUSED(animationFilepath);
@@ -272,107 +337,91 @@ Map<String, Transformation> Animation::GetBoneAnimationTransformations(
     Time animationTime)
 {
     Map<String, Transformation> boneTransformations;
-    if (!anim)
+    const double timeInFrames = GetSampleTimeInFrames(anim, animationTime);
+    if (timeInFrames < 0.0)
     {
         return boneTransformations;
     }
 
-    if (anim->GetDurationInFrames() <= 0.0f)
+    for (const BoneTrack &boneTrack : anim->GetBoneTracks())
     {
-        return boneTransformations;
+        BoneTrackCursor cursor;
+        boneTransformations.Add(
+            boneTrack.boneName,
+            SampleBoneTrack(boneTrack, timeInFrames, &cursor));
+    }
+    return boneTransformations;
+}
+
+double Animation::GetSampleTimeInFrames(const Animation *anim,
+                                        Time animationTime)
+{
+    if (!anim || anim->GetDurationInFrames() <= 0.0f)
+    {
+        return -1.0;
     }
 
     double timeInFrames =
         (animationTime.GetSeconds() * anim->GetFramesPerSecond());
     timeInFrames = WrapTime(
         timeInFrames, anim->GetDurationInFrames(), anim->GetWrapMode());
-    timeInFrames = Math::Max(timeInFrames, 0.00001);
+    return Math::Max(timeInFrames, 0.00001);
+}
 
-    for (const auto &it : anim->GetBoneNameToPositionKeyFrames())
+Transformation Animation::SampleBoneTrack(const BoneTrack &boneTrack,
+                                          double timeInFrames,
+                                          BoneTrackCursor *cursor)
+{
+    // Channels without keyframes around the time take their default value
+    Transformation boneTransformation;
+    if (const auto *posKeyFrames = boneTrack.positionKeyFrames)
     {
-        const String &boneName = it.first;
-        const auto &posKeyFrames = it.second;
-
         Vector3 bonePosition = Vector3::Zero();
-
-        Array<KeyFrame<Vector3>> positionInterpKeyFrames =
-            GetConsecutiveKeyFrames(posKeyFrames, timeInFrames);
-
-        if (positionInterpKeyFrames.Size() == 2)
+        uint &i = cursor->positionKeyFrame;
+        if (FindConsecutiveKeyFrames(*posKeyFrames, timeInFrames, &i))
         {
-            const KeyFrame<Vector3> &prevPosKF = positionInterpKeyFrames[0];
-            const KeyFrame<Vector3> &nextPosKF = positionInterpKeyFrames[1];
-            float timeBetweenPrevNext =
-                (nextPosKF.timeInFrames - prevPosKF.timeInFrames);
-            timeBetweenPrevNext = Math::Max(timeBetweenPrevNext, 0.0001f);
-
-            float timePassedSincePrev = (timeInFrames - prevPosKF.timeInFrames);
-            float interpFactor = (timePassedSincePrev / timeBetweenPrevNext);
-            interpFactor = Math::Clamp(interpFactor, 0.0f, 1.0f);
-
-            bonePosition =
-                Vector3::Lerp(prevPosKF.value, nextPosKF.value, interpFactor);
+            const KeyFrame<Vector3> &prevPosKF = (*posKeyFrames)[i];
+            const KeyFrame<Vector3> &nextPosKF = (*posKeyFrames)[i + 1];
+            bonePosition = Vector3::Lerp(
+                prevPosKF.value,
+                nextPosKF.value,
+                GetKeyFramesInterpFactor(prevPosKF, nextPosKF, timeInFrames));
         }
-        boneTransformations[boneName].SetPosition(bonePosition);
+        boneTransformation.SetPosition(bonePosition);
     }
 
-    for (const auto &it : anim->GetBoneNameToRotationKeyFrames())
+    if (const auto *rotKeyFrames = boneTrack.rotationKeyFrames)
     {
-        const String &boneName = it.first;
-        const auto &rotKeyFrames = it.second;
-
         Quaternion boneRotation = Quaternion::Identity();
-
-        Array<KeyFrame<Quaternion>> rotationInterpKeyFrames =
-            GetConsecutiveKeyFrames(rotKeyFrames, timeInFrames);
-
-        if (rotationInterpKeyFrames.Size() == 2)
+        uint &i = cursor->rotationKeyFrame;
+        if (FindConsecutiveKeyFrames(*rotKeyFrames, timeInFrames, &i))
         {
-            const KeyFrame<Quaternion> &prevRotKF = rotationInterpKeyFrames[0];
-            const KeyFrame<Quaternion> &nextRotKF = rotationInterpKeyFrames[1];
-            float timeBetweenPrevNext =
-                (nextRotKF.timeInFrames - prevRotKF.timeInFrames);
-            timeBetweenPrevNext = Math::Max(timeBetweenPrevNext, 0.0001f);
-
-            float timePassedSincePrev = (timeInFrames - prevRotKF.timeInFrames);
-            float interpFactor = (timePassedSincePrev / timeBetweenPrevNext);
-            interpFactor = Math::Clamp(interpFactor, 0.0f, 1.0f);
-
+            const KeyFrame<Quaternion> &prevRotKF = (*rotKeyFrames)[i];
+            const KeyFrame<Quaternion> &nextRotKF = (*rotKeyFrames)[i + 1];
             boneRotation = Quaternion::SLerp(
-                prevRotKF.value, nextRotKF.value, interpFactor);
+                prevRotKF.value,
+                nextRotKF.value,
+                GetKeyFramesInterpFactor(prevRotKF, nextRotKF, timeInFrames));
         }
-        boneTransformations[boneName].SetRotation(boneRotation);
+        boneTransformation.SetRotation(boneRotation);
     }
 
-    for (const auto &it : anim->GetBoneNameToScaleKeyFrames())
+    if (const auto *scaleKeyFrames = boneTrack.scaleKeyFrames)
     {
-        const String &boneName = it.first;
-        const auto &scaleKeyFrames = it.second;
-
         Vector3 boneScale = Vector3::One();
-        Array<KeyFrame<Vector3>> scaleInterpKeyFrames =
-            GetConsecutiveKeyFrames(scaleKeyFrames, timeInFrames);
-
-        if (scaleInterpKeyFrames.Size() == 2)
+        uint &i = cursor->scaleKeyFrame;
+        if (FindConsecutiveKeyFrames(*scaleKeyFrames, timeInFrames, &i))
         {
-            const KeyFrame<Vector3> &prevScaleKF = scaleInterpKeyFrames[0];
-            const KeyFrame<Vector3> &nextScaleKF = scaleInterpKeyFrames[1];
-            float timeBetweenPrevNext =
-                (nextScaleKF.timeInFrames - prevScaleKF.timeInFrames);
-            timeBetweenPrevNext = Math::Max(timeBetweenPrevNext, 0.0001f);
-
-            float timePassedSincePrev =
-                (timeInFrames - prevScaleKF.timeInFrames);
-            float interpFactor = (timePassedSincePrev / timeBetweenPrevNext);
-            interpFactor = Math::Clamp(interpFactor, 0.0f, 1.0f);
-
-            boneScale = Vector3::Lerp(
-                prevScaleKF.value, nextScaleKF.value, interpFactor);
+            const KeyFrame<Vector3> &prevScaleKF = (*scaleKeyFrames)[i];
+            const KeyFrame<Vector3> &nextScaleKF = (*scaleKeyFrames)[i + 1];
+            boneScale = Vector3::Lerp(prevScaleKF.value,
+                                      nextScaleKF.value,
+                                      GetKeyFramesInterpFactor(
+                                          prevScaleKF, nextScaleKF, timeInFrames));
         }
-        boneTransformations[boneName].SetScale(boneScale);
+        boneTransformation.SetScale(boneScale);
     }
-
-    return boneTransformations;
+    return boneTransformation;
 }
 
 Map<String, Transformation> Animation::GetInterpolatedBoneTransformations(
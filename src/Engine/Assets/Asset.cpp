@@ -153,6 +153,20 @@ String Asset::GetEmbeddedAssetName(GUID::GUIDType embeddedResGUID) const
     return "";
 }
 
+std::size_t Asset::GetResidentBytes() const
+{
+    // Embedded assets live as long as their parent does
+    std::size_t residentBytes = sizeof(Asset);
+    for (const AH<Asset> &embeddedAssetAH : GetEmbeddedAssets())
+    {
+        if (embeddedAssetAH)
+        {
+            residentBytes += embeddedAssetAH.Get()->GetResidentBytes();
+        }
+    }
+    return residentBytes;
+}
+
 void Asset::ImportMeta(const MetaNode &metaNode)
 {
     Serializable::ImportMeta(metaNode);
@@ -202,6 +216,29 @@ void Asset::Import_(const Path &assetFilepath)
                                                      this);
 }
 
+void Asset::ImportAsync(const Path &assetFilepath)
+{
+    BANG_UNUSED(assetFilepath);
+}
+
+void Asset::ImportAsyncFinish(const Path &assetFilepath)
+{
+    Import(assetFilepath);
+}
+
+void Asset::ImportAsyncFinish_(const Path &assetFilepath,
+                               const MetaNode *metaNode)
+{
+    ImportAsyncFinish(assetFilepath);
+    if (metaNode)
+    {
+        ImportMeta(*metaNode);
+    }
+
+    EventEmitter<IEventsAsset>::PropagateToListeners(&IEventsAsset::OnImported,
+                                                     this);
+}
+
 void Asset::ClearEmbeddedAssets()
 {
     while (!m_embeddedAssets.IsEmpty())
@@ -18,6 +18,8 @@
 #include "Bang/File.h"
 #include "Bang/GUID.h"
 #include "Bang/IEventsDestroy.h"
+#include "Bang/JobSystem.h"
+#include "Bang/List.tcc"
 #include "Bang/MaterialFactory.h"
 #include "Bang/MeshFactory.h"
 #include "Bang/MetaFilesManager.h"
@@ -88,9 +90,16 @@ void Assets::CreateAssetMetaAndImportFile(const Asset *asset,
 
 AH<Asset> Assets::Load_(std::function<Asset *()> creator, const Path &filepath)
 {
+    // The GUID lookup is only worth it if something is being loaded async
+    if (!m_asyncLoads.IsEmpty())
+    {
+        FinishAsyncLoad(MetaFilesManager::GetGUID(filepath));
+    }
+
     AH<Asset> assetAH;
     if (Asset *asset = GetCached_(filepath))
     {
+        ++m_cacheHits;
         assetAH.Set(asset);
         return assetAH;
     }
@@ -124,6 +133,7 @@ AH<Asset> Assets::Load_(std::function<Asset *()> creator, const Path &filepath)
 
             MetaFilesManager::RegisterFilepathGUID(filepath, assetGUID);
             Assets::Import(asset);  // Actually import the asset
+            ++m_cacheMisses;
         }
         assetAH.Set(asset);
     }
@@ -148,8 +158,17 @@ AH<Asset> Assets::Load_(std::function<Asset *()> creator, const GUID &guid)
         return AH<Asset>(nullptr);
     }
 
+    if (!m_asyncLoads.IsEmpty())
+    {
+        FinishAsyncLoad(guid);
+    }
+
     AH<Asset> assetAH(GetCached_(guid));
-    if (!assetAH)
+    if (assetAH)
+    {
+        ++m_cacheHits;
+    }
+    else
     {
         if (!Assets::IsEmbeddedAsset(guid))
         {
@@ -176,6 +195,136 @@ AH<Asset> Assets::Load_(std::function<Asset *()> creator, const GUID &guid)
     return assetAH;
 }
 
+std::shared_ptr<AsyncAssetLoad> Assets::LoadAsync_(
+    std::function<Asset *()> creator,
+    const Path &filepath)
+{
+    const GUID guid = MetaFilesManager::GetGUID(filepath);
+    auto it = m_asyncLoads.Find(guid);
+    if (it != m_asyncLoads.End())
+    {
+        return it->second;
+    }
+
+    std::shared_ptr<AsyncAssetLoad> load = std::make_shared<AsyncAssetLoad>();
+    load->m_path = filepath;
+
+    // Cached, embedded and missing assets have nothing to be read
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    if (!jobSystem || m_beingDestroyed || filepath.IsEmpty() ||
+        GetCached_(filepath) || Assets::IsEmbeddedAsset(filepath) ||
+        !filepath.IsFile())
+    {
+        load->m_assetAH = Load_(creator, filepath);
+        load->m_finished = true;
+        return load;
+    }
+
+    Asset *asset = creator();
+    GUID assetGUID = guid;
+    if (assetGUID.IsEmpty())
+    {
+        assetGUID = GUIDManager::GetNewGUID();
+    }
+    asset->SetGUID(assetGUID);
+    MetaFilesManager::RegisterFilepathGUID(filepath, assetGUID);
+
+    load->m_guid = assetGUID;
+    load->p_asset = asset;
+    m_asyncLoads.Add(assetGUID, load);
+
+    load->m_jobHandle = jobSystem->Schedule([load]() {
+        load->p_asset->ImportAsync(load->m_path);
+
+        const Path metaFilepath =
+            MetaFilesManager::GetMetaFilepath(load->m_path);
+        if (metaFilepath.IsFile())
+        {
+            load->m_metaNode.Import(metaFilepath);
+            load->m_hasMetaNode = true;
+        }
+    });
+    return load;
+}
+
+std::shared_ptr<AsyncAssetLoad> Assets::LoadAsync_(
+    std::function<Asset *()> creator,
+    const GUID &guid)
+{
+    if (!guid.IsEmpty() && !Assets::IsEmbeddedAsset(guid) &&
+        !GetCached_(guid))
+    {
+        const Path assetPath = MetaFilesManager::GetFilepath(guid);
+        if (assetPath.IsFile())
+        {
+            return LoadAsync_(creator, assetPath);
+        }
+    }
+
+    std::shared_ptr<AsyncAssetLoad> load = std::make_shared<AsyncAssetLoad>();
+    load->m_assetAH = Load_(creator, guid);
+    load->m_finished = true;
+    return load;
+}
+
+void Assets::FinishAsyncLoads()
+{
+    Assets *assets = Assets::GetInstance();
+    if (!assets || assets->m_asyncLoads.IsEmpty())
+    {
+        return;
+    }
+
+    Array<std::shared_ptr<AsyncAssetLoad>> doneLoads;
+    for (const auto &pair : assets->m_asyncLoads)
+    {
+        if (pair.second->m_jobHandle.IsDone())
+        {
+            doneLoads.PushBack(pair.second);
+        }
+    }
+
+    for (const std::shared_ptr<AsyncAssetLoad> &load : doneLoads)
+    {
+        assets->FinishAsyncLoad(load.get());
+    }
+}
+
+void Assets::FinishAsyncLoad(const GUID &guid)
+{
+    auto it = m_asyncLoads.Find(guid);
+    if (it != m_asyncLoads.End())
+    {
+        std::shared_ptr<AsyncAssetLoad> load = it->second;
+        FinishAsyncLoad(load.get());
+    }
+}
+
+void Assets::FinishAsyncLoad(AsyncAssetLoad *load)
+{
+    if (load->m_finished)
+    {
+        return;
+    }
+
+    if (JobSystem *jobSystem = JobSystem::GetInstance())
+    {
+        jobSystem->Wait(load->m_jobHandle);
+    }
+
+    Asset *asset = load->p_asset;
+    load->p_asset = nullptr;
+    m_asyncLoads.Remove(load->m_guid);
+
+    asset->ImportAsyncFinish_(load->m_path,
+                              load->m_hasMetaNode ? &load->m_metaNode
+                                                  : nullptr);
+    load->m_metaNode = MetaNode();
+    load->m_assetAH.Set(asset);
+    load->m_finished = true;
+    ++m_cacheMisses;
+}
+
 Asset *Assets::GetCached_(const GUID &guid) const
 {
     if (m_assetsCache.ContainsKey(guid))
@@ -243,9 +392,13 @@ void Assets::Remove(const GUID &guid)
     auto it = assets->m_assetsCache.Find(guid);
     ASSERT(it != assets->m_assetsCache.End());
 
-    const AssetEntry &assetEntry = it->second;
+    AssetEntry &assetEntry = it->second;
     ASSERT(assetEntry.asset != nullptr);
     ASSERT(assetEntry.usageCount == 0);
+    if (assetEntry.unused)
+    {
+        assets->RemoveUnusedAsset(&assetEntry);
+    }
 
     Asset *asset = assetEntry.asset;
     if (asset)
@@ -281,7 +434,13 @@ void Assets::RegisterAssetUsage(Asset *asset)
     {
         Assets::Add(asset);
     }
-    ++assets->m_assetsCache.Get(guid).usageCount;
+
+    AssetEntry &assetEntry = assets->m_assetsCache.Get(guid);
+    if (assetEntry.unused)
+    {
+        assets->RemoveUnusedAsset(&assetEntry);
+    }
+    ++assetEntry.usageCount;
 }
 
 void Assets::UnRegisterAssetUsage(Asset *asset)
@@ -292,17 +451,106 @@ void Assets::UnRegisterAssetUsage(Asset *asset)
         ASSERT(!guid.IsEmpty());
 
         ASSERT(assets->GetCached_(guid));
-        uint *assetsUsage = &(assets->m_assetsCache.Get(guid).usageCount);
-        ASSERT(*assetsUsage >= 1);
-        --(*assetsUsage);
+        AssetEntry &assetEntry = assets->m_assetsCache.Get(guid);
+        ASSERT(assetEntry.usageCount >= 1);
+        --assetEntry.usageCount;
 
-        if (*assetsUsage == 0)
+        if (assetEntry.usageCount == 0)
         {
-            Assets::Remove(guid);
+            if (assets->CanKeepUnused(asset))
+            {
+                assets->AddUnusedAsset(guid, &assetEntry);
+                assets->DeleteUnusedAssets(assets->m_unusedAssetsBudget);
+            }
+            else
+            {
+                Assets::Remove(guid);
+            }
         }
     }
 }
 
+void Assets::SetUnusedAssetsBudget(std::size_t budgetBytes)
+{
+    Assets *assets = Assets::GetInstance();
+    assets->m_unusedAssetsBudget = budgetBytes;
+    assets->DeleteUnusedAssets(budgetBytes);
+}
+
+std::size_t Assets::GetUnusedAssetsBudget()
+{
+    return Assets::GetInstance()->m_unusedAssetsBudget;
+}
+
+Assets::CacheStats Assets::GetCacheStats()
+{
+    Assets *assets = Assets::GetInstance();
+
+    CacheStats cacheStats;
+    cacheStats.hits = assets->m_cacheHits;
+    cacheStats.misses = assets->m_cacheMisses;
+    cacheStats.numAssets = assets->m_assetsCache.Size();
+    cacheStats.numUnusedAssets = assets->m_unusedAssets.Size();
+    cacheStats.unusedBytes = assets->m_unusedAssetsBytes;
+    for (const auto &pair : assets->m_assetsCache)
+    {
+        const AssetEntry &assetEntry = pair.second;
+
+        // Embedded assets are counted in their parent
+        if (!assetEntry.asset->GetParentAsset())
+        {
+            cacheStats.residentBytes += assetEntry.asset->GetResidentBytes();
+        }
+    }
+    return cacheStats;
+}
+
+void Assets::ResetCacheStats()
+{
+    Assets *assets = Assets::GetInstance();
+    assets->m_cacheHits = 0;
+    assets->m_cacheMisses = 0;
+}
+
+bool Assets::CanKeepUnused(const Asset *asset) const
+{
+    // Only assets that can be loaded again from their file, since nobody
+    // would find the rest
+    const GUID &guid = asset->GetGUID();
+    return !m_beingDestroyed && m_unusedAssetsBudget > 0 &&
+           !asset->GetParentAsset() && !Assets::IsEmbeddedAsset(guid) &&
+           MetaFilesManager::GetFilepath(guid).IsFile();
+}
+
+void Assets::AddUnusedAsset(const GUID &guid, AssetEntry *assetEntry)
+{
+    ASSERT(!assetEntry->unused);
+    m_unusedAssets.PushBack(guid);
+    assetEntry->unused = true;
+    assetEntry->unusedIt = std::prev(m_unusedAssets.End());
+    assetEntry->unusedBytes = assetEntry->asset->GetResidentBytes();
+    m_unusedAssetsBytes += assetEntry->unusedBytes;
+}
+
+void Assets::RemoveUnusedAsset(AssetEntry *assetEntry)
+{
+    ASSERT(assetEntry->unused);
+    m_unusedAssets.Remove(assetEntry->unusedIt);
+    m_unusedAssetsBytes -= assetEntry->unusedBytes;
+    assetEntry->unused = false;
+    assetEntry->unusedBytes = 0;
+}
+
+void Assets::DeleteUnusedAssets(std::size_t budgetBytes)
+{
+    // Deleting an asset can leave other ones unused, so the list is looked at
+    // again after each one
+    while (m_unusedAssetsBytes > budgetBytes && !m_unusedAssets.IsEmpty())
+    {
+        Assets::Remove(m_unusedAssets.Front());
+    }
+}
+
 Path Assets::GetAssetPath(const Asset *asset)
 {
     Path assetPath;
@@ -342,6 +590,24 @@ void Assets::Destroy()
 {
     m_beingDestroyed = true;
 
+    for (const auto &pair : m_asyncLoads)
+    {
+        AsyncAssetLoad *load = pair.second.get();
+        if (JobSystem *jobSystem = JobSystem::GetInstance())
+        {
+            jobSystem->Wait(load->m_jobHandle);
+        }
+        delete load->p_asset;
+        load->p_asset = nullptr;
+        load->m_finished = true;
+    }
+    m_asyncLoads.Clear();
+
+    while (!m_unusedAssets.IsEmpty())
+    {
+        Assets::Remove(m_unusedAssets.Front());
+    }
+
 #define B_DESTROY_AND_NULL(p) \
     if (p)                    \
     {                         \
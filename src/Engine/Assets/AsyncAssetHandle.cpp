@@ -0,0 +1,31 @@
+#include "Bang/AsyncAssetHandle.h"
+
+#include "Bang/Assets.h"
+
+using namespace Bang;
+
+bool AsyncAssetHandleBase::IsValid() const
+{
+    return (p_load != nullptr);
+}
+
+bool AsyncAssetHandleBase::IsDone() const
+{
+    return IsValid() && p_load->m_finished;
+}
+
+void AsyncAssetHandleBase::Wait() const
+{
+    if (IsValid() && !IsDone())
+    {
+        if (Assets *assets = Assets::GetInstance())
+        {
+            assets->FinishAsyncLoad(p_load.get());
+        }
+    }
+}
+
+Asset *AsyncAssetHandleBase::GetAsset() const
+{
+    return IsDone() ? p_load->m_assetAH.Get() : nullptr;
+}
@@ -63,6 +63,7 @@ Mesh::~Mesh()
 void Mesh::SetTrianglesVertexIds(const Array<Mesh::VertexId> &trisVerticesIds)
 {
     m_areCornerTablesValid = false;
+    m_isTriangleBVHValid = false;
 
     m_triangleVertexIds = trisVerticesIds;
 
@@ -94,6 +95,7 @@ void Mesh::SetBonesIds(const Map<String, uint> &bonesIds)
 void Mesh::SetPosition(Mesh::VertexId vId, const Vector3 &pos)
 {
     m_positionsPool[vId] = pos;
+    m_isTriangleBVHValid = false;
 }
 
 void Mesh::UpdateVAOs(bool createIndicesIfNeeded)
@@ -120,10 +122,17 @@ void Mesh::UpdateVAOs(bool createIndicesIfNeeded)
         SetTrianglesVertexIds(triVertexIds);
     }
 
+    m_vertexBonesIdsPool.Clear();
+    m_vertexBonesWeightsPool.Clear();
     if (hasBones)
     {
         // Pick 4 most relevant bones per vertex
-        for (VertexId vid = 0; vid < GetTrianglesVertexIds().Size(); ++vid)
+        const uint numVertexIds = GetTrianglesVertexIds().Size();
+        m_vertexBonesIdsPool.Resize(numVertexIds,
+                                    std::array<int, 4>({{0, 0, 0, 0}}));
+        m_vertexBonesWeightsPool.Resize(
+            numVertexIds, std::array<float, 4>({{0, 0, 0, 0}}));
+        for (VertexId vid = 0; vid < numVertexIds; ++vid)
         {
             struct BoneExt : public IToString
             {
@@ -152,13 +161,6 @@ void Mesh::UpdateVAOs(bool createIndicesIfNeeded)
                 }
             }
 
-            m_vertexIdToImportantBonesIdsPool.Add(
-                vid, std::array<int, 4>({{0, 0, 0, 0}}));
-            m_vertexIdToImportantBonesWeightsPool.Add(
-                vid,
-                // std::array<float, 4>({{0,0,0,0}}));
-                std::array<float, 4>({{0, 0, 0, 0}}));
-
             if (!vertexBonesExt.IsEmpty())
             {
                 Containers::Sort(
@@ -178,16 +180,10 @@ void Mesh::UpdateVAOs(bool createIndicesIfNeeded)
 
                 for (uint i = 0; i < numImportantBones; ++i)
                 {
-                    m_vertexIdToImportantBonesIdsPool.Get(vid)[i] =
-                        vertexBonesExt[i].id;
-                    m_vertexIdToImportantBonesWeightsPool.Get(vid)[i] =
+                    m_vertexBonesIdsPool[vid][i] = vertexBonesExt[i].id;
+                    m_vertexBonesWeightsPool[vid][i] =
                         vertexBonesExt[i].weight / weightSum;
                 }
-
-                // std::cerr << "id: " <<
-                // m_vertexIdToImportantBonesIdsPool.Get(vid) << std::endl;
-                // std::cerr << "wei: " <<
-                // m_vertexIdToImportantBonesWeightsPool.Get(vid) << std::endl;
             }
         }
     }
@@ -226,20 +222,19 @@ void Mesh::UpdateVAOs(bool createIndicesIfNeeded)
             interleavedAttributes.PushBack(tangent.z);
         }
 
-        if (i < m_vertexIdToImportantBonesIdsPool.Size())
+        if (i < m_vertexBonesIdsPool.Size())
         {
-            const auto &vertexIdToImportantBonesIds =
-                m_vertexIdToImportantBonesIdsPool.Get(i);
+            const auto &vertexIdToImportantBonesIds = m_vertexBonesIdsPool[i];
             interleavedAttributes.PushBack(vertexIdToImportantBonesIds[0]);
             interleavedAttributes.PushBack(vertexIdToImportantBonesIds[1]);
             interleavedAttributes.PushBack(vertexIdToImportantBonesIds[2]);
             interleavedAttributes.PushBack(vertexIdToImportantBonesIds[3]);
         }
 
-        if (i < m_vertexIdToImportantBonesWeightsPool.Size())
+        if (i < m_vertexBonesWeightsPool.Size())
         {
             const auto &vertexIdToImportantBonesWeights =
-                m_vertexIdToImportantBonesWeightsPool.Get(i);
+                m_vertexBonesWeightsPool[i];
             interleavedAttributes.PushBack(vertexIdToImportantBonesWeights[0]);
             interleavedAttributes.PushBack(vertexIdToImportantBonesWeights[1]);
             interleavedAttributes.PushBack(vertexIdToImportantBonesWeights[2]);
@@ -328,6 +323,7 @@ void Mesh::SetPositionsPool(const Array<Vector3> &positions)
     }
 
     m_positionsPool = positions;
+    m_isTriangleBVHValid = false;
     m_bBox.CreateFromPositions(m_positionsPool.GetVector());
     m_bSphere.FillFromBox(m_bBox);
     m_areLodsValid = false;
@@ -550,7 +546,8 @@ AH<Mesh> Mesh::GetLODMesh(int lod) const
 
 const Array<AH<Mesh>> Mesh::GetLODMeshes() const
 {
-    return m_lodMeshes;
+    // The LODs of the geometry before the last change are not used
+    return m_areLodsValid ? m_lodMeshes : Array<AH<Mesh>>();
 }
 
 uint Mesh::GetNumTriangles() const
@@ -1200,6 +1197,17 @@ const Sphere &Mesh::GetBoundingSphere() const
 {
     return m_bSphere;
 }
+
+const TriangleBVH &Mesh::GetTriangleBVH() const
+{
+    if (!m_isTriangleBVHValid)
+    {
+        m_triangleBVH.Build(GetPositionsPool(), GetTrianglesVertexIds());
+        m_isTriangleBVHValid = true;
+    }
+    return m_triangleBVH;
+}
+
 const Map<String, Mesh::Bone> &Mesh::GetBonesPool() const
 {
     return m_bonesPool;
@@ -1224,6 +1232,16 @@ const Array<Vector3> &Mesh::GetTangentsPool() const
 {
     return m_tangentsPool;
 }
+const Array<std::array<int, 4>> &Mesh::GetVertexBonesIdsPool() const
+{
+    return m_vertexBonesIdsPool;
+}
+
+const Array<std::array<float, 4>> &Mesh::GetVertexBonesWeightsPool() const
+{
+    return m_vertexBonesWeightsPool;
+}
+
 const Map<String, uint> &Mesh::GetBonesIds() const
 {
     return m_bonesIds;
@@ -1272,6 +1290,10 @@ void Mesh::CloneInto(Serializable *clone, bool cloneGUID) const
     mClone->SetTrianglesVertexIds(GetTrianglesVertexIds());
     mClone->SetBonesIds(GetBonesIds());
     mClone->UpdateVAOs();
+
+    // Same geometry, so the LODs can be shared instead of built again
+    mClone->m_lodMeshes = m_lodMeshes;
+    mClone->m_areLodsValid = m_areLodsValid;
 }
 
 void Mesh::Import(const Path &meshFilepath)
@@ -1282,6 +1304,15 @@ void Mesh::Import(const Path &meshFilepath)
     BANG_UNUSED(meshFilepath);
 }
 
+std::size_t Mesh::GetResidentBytes() const
+{
+    // The vertex data is both in the pools and in the VBO and IBO
+    const std::size_t dataBytes =
+        GetVBOStride() * GetNumVertices() +
+        GetTrianglesVertexIds().Size() * sizeof(Mesh::VertexId);
+    return Asset::GetResidentBytes() + 2 * dataBytes;
+}
+
 void Mesh::ImportMeta(const MetaNode &metaNode)
 {
     Asset::ImportMeta(metaNode);
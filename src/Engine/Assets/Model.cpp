@@ -178,3 +178,8 @@ void Model::ExportMeta(MetaNode *metaNode) const
 {
     Asset::ExportMeta(metaNode);
 }
+
+MetaNodeFormat Model::GetMetaFileFormat() const
+{
+    return MetaNodeFormat::BINARY;
+}
@@ -4,6 +4,7 @@
 #include "Bang/GameObjectFactory.h"
 #include "Bang/MetaFilesManager.h"
 #include "Bang/MetaNode.h"
+#include "Bang/PrefabTemplate.h"
 #include "Bang/Scene.h"
 #include "Bang/SceneManager.h"
 
@@ -25,11 +26,12 @@ Prefab::Prefab(GameObject *go)
 
 Prefab::Prefab(const String &gameObjectMetaInfoContent)
 {
-    m_gameObjectMetaInfoContent = gameObjectMetaInfoContent;
+    SetMetaContent(gameObjectMetaInfoContent);
 }
 
 Prefab::~Prefab()
 {
+    delete p_template;
 }
 
 GameObject *Prefab::Instantiate() const
@@ -41,27 +43,45 @@ GameObject *Prefab::Instantiate() const
 
 GameObject *Prefab::InstantiateRaw() const
 {
-    GameObject *go = GameObjectFactory::CreateGameObject(false);
+    if (const PrefabTemplate *prefabTemplate = GetTemplate())
+    {
+        return prefabTemplate->Instantiate();
+    }
+    return GameObjectFactory::CreateGameObject(false);
+}
 
-    if (!GetMetaContent().IsEmpty())
+Array<GameObject *> Prefab::InstantiateN(uint numInstances) const
+{
+    Array<GameObject *> gos = InstantiateRawN(numInstances);
+    Scene *activeScene = SceneManager::GetActiveScene();
+    for (GameObject *go : gos)
     {
-        MetaNode metaNode;
-        metaNode.Import(GetMetaContent());
-        go->ImportMeta(metaNode);
+        go->SetParent(activeScene);
     }
-    return go;
+    return gos;
 }
 
-void Prefab::SetGameObject(GameObject *go)
+Array<GameObject *> Prefab::InstantiateRawN(uint numInstances) const
 {
-    if (go)
+    Array<GameObject *> gos;
+    if (const PrefabTemplate *prefabTemplate = GetTemplate())
     {
-        m_gameObjectMetaInfoContent = go->GetSerializedString();
+        prefabTemplate->Instantiate(numInstances, &gos);
     }
     else
     {
-        m_gameObjectMetaInfoContent = "";
+        gos.Reserve(numInstances);
+        for (uint i = 0; i < numInstances; ++i)
+        {
+            gos.PushBack(GameObjectFactory::CreateGameObject(false));
+        }
     }
+    return gos;
+}
+
+void Prefab::SetGameObject(GameObject *go)
+{
+    SetMetaContent(go ? go->GetSerializedString() : "");
 }
 
 const String &Prefab::GetMetaContent() const
@@ -69,6 +89,25 @@ const String &Prefab::GetMetaContent() const
     return m_gameObjectMetaInfoContent;
 }
 
+const PrefabTemplate *Prefab::GetTemplate() const
+{
+    if (!p_template && !GetMetaContent().IsEmpty())
+    {
+        MetaNode metaNode;
+        metaNode.Import(GetMetaContent());
+        p_template = new PrefabTemplate(metaNode);
+    }
+    return p_template;
+}
+
+void Prefab::SetMetaContent(const String &gameObjectMetaInfoContent)
+{
+    m_gameObjectMetaInfoContent = gameObjectMetaInfoContent;
+
+    delete p_template;
+    p_template = nullptr;
+}
+
 void Prefab::Import(const Path &prefabFilepath)
 {
     ImportMetaFromFile(MetaFilesManager::GetMetaFilepath(prefabFilepath));
@@ -81,7 +120,7 @@ void Prefab::ImportMeta(const MetaNode &metaNode)
     String newMetaInfo = metaNode.ToString();
     if (newMetaInfo != GetMetaContent())
     {
-        m_gameObjectMetaInfoContent = newMetaInfo;
+        SetMetaContent(newMetaInfo);
     }
 }
 
@@ -89,8 +128,12 @@ void Prefab::ExportMeta(MetaNode *metaNode) const
 {
     Asset::ExportMeta(metaNode);
 
-    MetaNode prefabMetaNode;
-    prefabMetaNode.Import(GetMetaContent());
-
-    *metaNode = prefabMetaNode;
+    if (const PrefabTemplate *prefabTemplate = GetTemplate())
+    {
+        *metaNode = prefabTemplate->GetMetaNode();
+    }
+    else
+    {
+        *metaNode = MetaNode();
+    }
 }
@@ -0,0 +1,154 @@
+#include "Bang/PrefabTemplate.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/ClassDB.h"
+#include "Bang/Component.h"
+#include "Bang/Debug.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObjectFactory.h"
+
+using namespace Bang;
+
+PrefabTemplate::PrefabTemplate(const MetaNode &gameObjectMetaNode)
+    : m_metaNode(gameObjectMetaNode)
+{
+    Compile(m_metaNode, -1);
+}
+
+PrefabTemplate::~PrefabTemplate()
+{
+}
+
+GameObject *PrefabTemplate::Instantiate() const
+{
+    Array<GameObject *> gameObjectsScratch;
+    return Instantiate(&gameObjectsScratch);
+}
+
+void PrefabTemplate::Instantiate(uint numInstances,
+                                 Array<GameObject *> *gameObjects) const
+{
+    gameObjects->Reserve(gameObjects->Size() + numInstances);
+
+    Array<GameObject *> gameObjectsScratch;
+    gameObjectsScratch.Reserve(m_gameObjectOps.Size());
+    for (uint i = 0; i < numInstances; ++i)
+    {
+        gameObjects->PushBack(Instantiate(&gameObjectsScratch));
+    }
+}
+
+const MetaNode &PrefabTemplate::GetMetaNode() const
+{
+    return m_metaNode;
+}
+
+void PrefabTemplate::Compile(const MetaNode &gameObjectMetaNode,
+                             int parentIndex)
+{
+    GameObjectOp gameObjectOp;
+    gameObjectOp.parentIndex = parentIndex;
+    gameObjectOp.metaNode = &gameObjectMetaNode;
+    gameObjectOp.componentsBegin = m_componentOps.Size();
+
+    // GetChildren adds the container if it is not there, and the node must
+    // be kept as it was to be exported
+    const Array<MetaNode> noChildren;
+    const Array<MetaNode> &componentsMetaNodes =
+        gameObjectMetaNode.ContainsChildren("Components")
+            ? gameObjectMetaNode.GetChildren("Components")
+            : noChildren;
+    const Array<MetaNode> &childrenMetaNodes =
+        gameObjectMetaNode.ContainsChildren("GameObjectChildren")
+            ? gameObjectMetaNode.GetChildren("GameObjectChildren")
+            : noChildren;
+
+    for (const MetaNode &componentMetaNode : componentsMetaNodes)
+    {
+        const String &className = componentMetaNode.GetName();
+        ComponentOp componentOp;
+        componentOp.constructor = ClassDB::GetConstructor(className);
+        componentOp.metaNode = &componentMetaNode;
+        componentOp.hasComponentImportMeta =
+            ClassDB::HasComponentImportMeta(className);
+        componentOp.fieldOpsBegin = componentOp.fieldOpsEnd = 0;
+        if (componentOp.constructor)
+        {
+            m_componentOps.PushBack(componentOp);
+        }
+        else
+        {
+            Debug_Error("Trying to create an object of class '"
+                        << className
+                        << "' "
+                           "which is not registered.");
+        }
+    }
+    gameObjectOp.componentsEnd = m_componentOps.Size();
+
+    const int gameObjectIndex = SCAST<int>(m_gameObjectOps.Size());
+    m_gameObjectOps.PushBack(gameObjectOp);
+
+    for (const MetaNode &childMetaNode : childrenMetaNodes)
+    {
+        ASSERT(childMetaNode.GetName() == GameObject::GetClassNameStatic());
+        Compile(childMetaNode, gameObjectIndex);
+    }
+}
+
+GameObject *PrefabTemplate::Instantiate(
+    Array<GameObject *> *gameObjectsScratch) const
+{
+    // Same steps as GameObject::ImportMeta on new GameObjects, without
+    // looking for existing components and children to reuse
+    gameObjectsScratch->Clear();
+    for (const GameObjectOp &gameObjectOp : m_gameObjectOps)
+    {
+        GameObject *go = GameObjectFactory::CreateGameObject(false);
+        if (gameObjectOp.parentIndex >= 0)
+        {
+            go->SetParent(gameObjectsScratch->At(gameObjectOp.parentIndex));
+        }
+        go->ImportMetaProperties(*gameObjectOp.metaNode);
+
+        for (uint i = gameObjectOp.componentsBegin;
+             i < gameObjectOp.componentsEnd;
+             ++i)
+        {
+            ComponentOp *componentOp = &m_componentOps[i];
+            Component *comp =
+                SCAST<Component *>((*componentOp->constructor)());
+            go->AddComponent(comp);
+            ImportMeta(componentOp, comp);
+        }
+
+        gameObjectsScratch->PushBack(go);
+    }
+
+    // The first instance has created all the components, and compiled them
+    m_areFieldOpsCompiled = true;
+    return gameObjectsScratch->At(0);
+}
+
+void PrefabTemplate::ImportMeta(ComponentOp *componentOp,
+                                Component *comp) const
+{
+    if (!componentOp->hasComponentImportMeta)
+    {
+        comp->ImportMeta(*componentOp->metaNode);
+        return;
+    }
+
+    if (!m_areFieldOpsCompiled)
+    {
+        componentOp->fieldOpsBegin = m_fieldOps.Size();
+        comp->CompileImportMeta(*componentOp->metaNode, &m_fieldOps);
+        componentOp->fieldOpsEnd = m_fieldOps.Size();
+    }
+
+    for (uint i = componentOp->fieldOpsBegin; i < componentOp->fieldOpsEnd;
+         ++i)
+    {
+        m_fieldOps[i](comp);
+    }
+}
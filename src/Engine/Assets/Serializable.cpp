@@ -1,6 +1,5 @@
 #include "Bang/Serializable.h"
 
-#include "BangMath/Color.h"
 #include "Bang/File.h"
 #include "Bang/GUID.h"
 #include "Bang/GUIDManager.h"
@@ -8,11 +7,8 @@
 #include "Bang/MetaNode.tcc"
 #include "Bang/ObjectPtr.h"
 #include "Bang/Path.h"
-#include "BangMath/Quaternion.h"
+#include "Bang/ReflectTable.h"
 #include "Bang/String.h"
-#include "BangMath/Vector2.h"
-#include "BangMath/Vector3.h"
-#include "BangMath/Vector4.h"
 
 using namespace Bang;
 
@@ -58,115 +54,39 @@ void Serializable::ImportMeta(const MetaNode &metaNode)
         SetGUID(metaNode.Get<GUID>("GUID"));
     }
 
-    // Import reflected variables
-    const ReflectStruct &reflStruct = GetReflectStruct();
-    for (const ReflectVariable &reflVar : reflStruct.GetVariables())
+    GetReflectTable().ImportMeta(this, metaNode);
+}
+
+void Serializable::CompileImportMeta(const MetaNode &metaNode,
+                                     Array<ReflectImportOp> *importOps) const
+{
+    if (metaNode.Contains("GUID"))
     {
-        const String &varName = reflVar.GetName();
-        if (metaNode.Contains(varName))
-        {
-            if (auto reflVarSetter = reflVar.GetSetter())
-            {
-                switch (reflVar.GetVariant().GetType())
-                {
-                    case Variant::Type::FLOAT:
-                        reflVarSetter(
-                            Variant::FromFloat(metaNode.Get<float>(varName)));
-                        break;
-                    case Variant::Type::DOUBLE:
-                        reflVarSetter(
-                            Variant::FromDouble(metaNode.Get<double>(varName)));
-                        break;
-                    case Variant::Type::INT:
-                        reflVarSetter(
-                            Variant::FromInt(metaNode.Get<int>(varName)));
-                        break;
-                    case Variant::Type::UINT:
-                        reflVarSetter(
-                            Variant::FromUint(metaNode.Get<uint>(varName)));
-                        break;
-                    case Variant::Type::BOOL:
-                        if (!reflVar.GetHints().GetIsButton())
-                        {
-                            reflVarSetter(
-                                Variant::FromBool(metaNode.Get<bool>(varName)));
-                        }
-                        break;
-                    case Variant::Type::PATH:
-                        reflVarSetter(
-                            Variant::FromPath(metaNode.Get<Path>(varName)));
-                        break;
-                    case Variant::Type::STRING:
-                        reflVarSetter(
-                            Variant::FromString(metaNode.Get<String>(varName)));
-                        break;
-                    case Variant::Type::GUID:
-                        reflVarSetter(
-                            Variant::FromGUID(metaNode.Get<GUID>(varName)));
-                        break;
-                    case Variant::Type::COLOR:
-                        reflVarSetter(
-                            Variant::FromColor(metaNode.Get<Color>(varName)));
-                        break;
-                    case Variant::Type::VECTOR2:
-                        reflVarSetter(Variant::FromVector2(
-                            metaNode.Get<Vector2>(varName)));
-                        break;
-                    case Variant::Type::VECTOR3:
-                        reflVarSetter(Variant::FromVector3(
-                            metaNode.Get<Vector3>(varName)));
-                        break;
-                    case Variant::Type::VECTOR4:
-                        reflVarSetter(Variant::FromVector4(
-                            metaNode.Get<Vector4>(varName)));
-                        break;
-                    case Variant::Type::VECTOR2i:
-                        reflVarSetter(Variant::FromVector2i(
-                            metaNode.Get<Vector2i>(varName)));
-                        break;
-                    case Variant::Type::VECTOR3i:
-                        reflVarSetter(Variant::FromVector3i(
-                            metaNode.Get<Vector3i>(varName)));
-                        break;
-                    case Variant::Type::VECTOR4i:
-                        reflVarSetter(Variant::FromVector4i(
-                            metaNode.Get<Vector4i>(varName)));
-                        break;
-                    case Variant::Type::QUATERNION:
-                        reflVarSetter(Variant::FromQuaternion(
-                            metaNode.Get<Quaternion>(varName)));
-                        break;
-                    case Variant::Type::OBJECT_PTR:
-                        reflVarSetter(Variant::FromObjectPtr(
-                            metaNode.Get<ObjectPtr>(varName)));
-                        break;
-                    case Variant::Type::NONE: break;
-
-                    default: ASSERT(false); break;
-                }
-            }
-        }
+        const GUID guid = metaNode.Get<GUID>("GUID");
+        importOps->PushBack([guid](IReflectable *reflectable) {
+            SCAST<Serializable *>(reflectable)->SetGUID(guid);
+        });
     }
+
+    GetReflectTable().CompileImportMeta(metaNode, importOps);
 }
 
 void Serializable::ExportMeta(MetaNode *metaNode) const
 {
     metaNode->Set<GUID>("GUID", GetGUID());
 
-    // Export reflected variables
-    const ReflectStruct &reflStruct = GetReflectStruct();
-    MetaNode reflMeta = reflStruct.GetMeta();
-    metaNode->Import(reflMeta);
+    GetReflectTable().ExportMeta(this, metaNode);
 
-    metaNode->SetName(GetClassName());  // Set name after, to avoid overwrites
+    metaNode->SetName(GetClassName());
 }
 
 bool Serializable::ImportMetaFromFile(const Path &path)
 {
     if (path.Exists())
     {
-        String fileContents = File::GetContents(path);
-        ImportMeta(fileContents);
+        MetaNode metaNode;
+        metaNode.Import(path);
+        ImportMeta(metaNode);
         return true;
     }
     return false;
@@ -174,10 +94,24 @@ bool Serializable::ImportMetaFromFile(const Path &path)
 
 bool Serializable::ExportMetaToFile(const Path &path) const
 {
-    File::Write(path, GetSerializedString());
+    if (GetMetaFileFormat() == MetaNodeFormat::BINARY)
+    {
+        Array<Byte> bytes;
+        GetMeta().ToBinary(&bytes);
+        File::Write(path, bytes.Data(), bytes.Size());
+    }
+    else
+    {
+        File::Write(path, GetSerializedString());
+    }
     return true;
 }
 
+MetaNodeFormat Serializable::GetMetaFileFormat() const
+{
+    return MetaNodeFormat::YAML;
+}
+
 HideFlags &Serializable::GetHideFlags()
 {
     return m_hideFlags;
@@ -190,8 +124,17 @@ const HideFlags &Serializable::GetHideFlags() const
 
 void Serializable::SetGUID(const GUID &guid)
 {
+    const GUID previousGUID = GetGUID();
     m_GUID = guid;
     GUIDManager::RemoveGUID(GetGUID());
+    if (GetGUID() != previousGUID)
+    {
+        OnGUIDChanged(previousGUID);
+    }
+}
+
+void Serializable::OnGUIDChanged(const GUID &)
+{
 }
 
 const GUID &Serializable::GetGUID() const
@@ -208,21 +151,9 @@ void Serializable::CloneInto(Serializable *cloneable, bool cloneGUID) const
 {
     Serializable *clone = SCAST<Serializable *>(cloneable);
 
-    // Clone reflected variables
-    ReflectStruct thisReflStruct = GetReflectStruct();
-    ReflectStruct cloneReflStruct = clone->GetReflectStruct();
-    for (uint i = 0; i < thisReflStruct.GetVariables().Size(); ++i)
-    {
-        const ReflectVariable &thisReflVar = thisReflStruct.GetVariables()[i];
-        const ReflectVariable &cloneReflVar = cloneReflStruct.GetVariables()[i];
-        if (auto thisGetter = thisReflVar.GetGetter())
-        {
-            if (auto cloneSetter = cloneReflVar.GetSetter())
-            {
-                cloneSetter(thisGetter());
-            }
-        }
-    }
+    const ReflectTable &reflTable = GetReflectTable();
+    ASSERT(&clone->GetReflectTable() == &reflTable);
+    reflTable.CopyValues(this, clone);
 
     if (cloneGUID)
     {
@@ -1,19 +1,69 @@
 #include "Bang/IReflectable.h"
 
+#include <mutex>
+
 #include "Bang/Assets.h"
 #include "Bang/ReflectStruct.h"
+#include "Bang/ReflectTable.h"
+#include "Bang/TypeMap.h"
+#include "Bang/UMap.tcc"
 
 using namespace Bang;
 
+namespace
+{
+// One table per class, alive until the program exits
+std::mutex s_reflectTablesMutex;
+UMap<TypeId, const ReflectTable *> s_reflectTables;
+}
+
 const ReflectStruct &IReflectable::GetReflectStruct() const
 {
-    // if (!m_alreadyReflected)
+    m_reflectStruct.Clear();
+    const_cast<IReflectable *>(this)->Reflect();
+    return m_reflectStruct;
+}
+
+const ReflectTable &IReflectable::GetReflectTable() const
+{
+    // The type is checked too, in case the table was got while this object
+    // was being constructed or destroyed
+    const TypeId typeId = GetTypeId(this);
+    if (p_reflectTable && p_reflectTable->GetTypeId() == typeId)
     {
-        m_reflectStruct.Clear();
-        const_cast<IReflectable *>(this)->Reflect();
-        m_alreadyReflected = true;
+        return *p_reflectTable;
     }
-    return m_reflectStruct;
+
+    {
+        std::lock_guard<std::mutex> lock(s_reflectTablesMutex);
+        auto it = s_reflectTables.Find(typeId);
+        if (it != s_reflectTables.End())
+        {
+            p_reflectTable = it->second;
+            return *p_reflectTable;
+        }
+    }
+
+    // Reflect() is user code, so it is not run with the lock taken. If
+    // another thread builds the table meanwhile, its table is the one kept.
+    const ReflectTable *reflectTable =
+        new ReflectTable(typeId, GetReflectStruct());
+    {
+        std::lock_guard<std::mutex> lock(s_reflectTablesMutex);
+        auto it = s_reflectTables.Find(typeId);
+        if (it == s_reflectTables.End())
+        {
+            s_reflectTables.Add(typeId, reflectTable);
+        }
+        else
+        {
+            delete reflectTable;
+            reflectTable = it->second;
+        }
+    }
+
+    p_reflectTable = reflectTable;
+    return *p_reflectTable;
 }
 
 void IReflectable::Reflect()
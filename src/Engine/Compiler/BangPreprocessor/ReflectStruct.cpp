@@ -167,11 +167,15 @@ String ReflectStruct::GetReflectVarCode() const
         }
 
         String varReflectionCode = R"VERBATIM(
-               ReflectVar<VAR_TYPE>(
-                           "VAR_REFL_NAME",
-                           [this](VAR_TYPE x) { VAR_NAME = MAYBE_CAST(VAR_X); },
-                           [this]() { return MAYBE_CONSTRUCTOR(VAR_NAME); },
-                                   HINTS);
+               ReflectVar<BANG_REFLECT_THIS_CLASS, VAR_TYPE>(
+                   "VAR_REFL_NAME",
+                   [](BANG_REFLECT_THIS_CLASS *self, VAR_TYPE x) {
+                       self->VAR_NAME = MAYBE_CAST(VAR_X);
+                   },
+                   [](const BANG_REFLECT_THIS_CLASS *self) -> VAR_TYPE {
+                       return MAYBE_CONSTRUCTOR(self->VAR_NAME);
+                   },
+                   HINTS);
             )VERBATIM";
 
         if (varType == Variant::Type::OBJECT_PTR)
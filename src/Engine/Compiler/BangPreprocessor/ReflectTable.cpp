@@ -0,0 +1,259 @@
+#include "Bang/ReflectTable.h"
+
+#include <utility>
+
+#include "BangMath/Color.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Vector2.h"
+#include "BangMath/Vector3.h"
+#include "BangMath/Vector4.h"
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+#include "Bang/GUID.h"
+#include "Bang/IReflectable.h"
+#include "Bang/MetaNode.h"
+#include "Bang/MetaNode.tcc"
+#include "Bang/ObjectPtr.h"
+#include "Bang/Path.h"
+#include "Bang/ReflectFieldAccessor.h"
+#include "Bang/ReflectStruct.h"
+#include "Bang/String.h"
+#include "Bang/Variant.h"
+
+using namespace Bang;
+
+namespace
+{
+Variant GetMetaValueAsVariant(const MetaNode &metaNode,
+                              const String &varName,
+                              Variant::Type type)
+{
+    switch (type)
+    {
+        case Variant::Type::FLOAT:
+            return Variant::FromFloat(metaNode.Get<float>(varName));
+        case Variant::Type::DOUBLE:
+            return Variant::FromDouble(metaNode.Get<double>(varName));
+        case Variant::Type::INT:
+            return Variant::FromInt(metaNode.Get<int>(varName));
+        case Variant::Type::UINT:
+            return Variant::FromUint(metaNode.Get<uint>(varName));
+        case Variant::Type::BOOL:
+            return Variant::FromBool(metaNode.Get<bool>(varName));
+        case Variant::Type::PATH:
+            return Variant::FromPath(metaNode.Get<Path>(varName));
+        case Variant::Type::STRING:
+            return Variant::FromString(metaNode.Get<String>(varName));
+        case Variant::Type::GUID:
+            return Variant::FromGUID(metaNode.Get<GUID>(varName));
+        case Variant::Type::COLOR:
+            return Variant::FromColor(metaNode.Get<Color>(varName));
+        case Variant::Type::VECTOR2:
+            return Variant::FromVector2(metaNode.Get<Vector2>(varName));
+        case Variant::Type::VECTOR3:
+            return Variant::FromVector3(metaNode.Get<Vector3>(varName));
+        case Variant::Type::VECTOR4:
+            return Variant::FromVector4(metaNode.Get<Vector4>(varName));
+        case Variant::Type::VECTOR2i:
+            return Variant::FromVector2i(metaNode.Get<Vector2i>(varName));
+        case Variant::Type::VECTOR3i:
+            return Variant::FromVector3i(metaNode.Get<Vector3i>(varName));
+        case Variant::Type::VECTOR4i:
+            return Variant::FromVector4i(metaNode.Get<Vector4i>(varName));
+        case Variant::Type::QUATERNION:
+            return Variant::FromQuaternion(metaNode.Get<Quaternion>(varName));
+        case Variant::Type::OBJECT_PTR:
+            return Variant::FromObjectPtr(metaNode.Get<ObjectPtr>(varName));
+        case Variant::Type::NONE: break;
+
+        default: ASSERT(false); break;
+    }
+    return Variant();
+}
+
+const ReflectVariable *GetInstanceReflectVariable(
+    const IReflectable *reflectable,
+    const ReflectStruct **instanceReflStruct,
+    uint i)
+{
+    if (!*instanceReflStruct)
+    {
+        *instanceReflStruct = &reflectable->GetReflectStruct();
+    }
+
+    const Array<ReflectVariable> &instanceVars =
+        (*instanceReflStruct)->GetVariables();
+    ASSERT(i < instanceVars.Size());
+    return (i < instanceVars.Size()) ? &instanceVars[i] : nullptr;
+}
+}
+
+ReflectTable::ReflectTable(TypeId typeId, const ReflectStruct &reflStruct)
+    : m_typeId(typeId), m_variables(reflStruct.GetVariables())
+{
+    // Those are bound to the instance the table was taken from
+    for (ReflectVariable &reflVar : m_variables)
+    {
+        reflVar.SetSetter(nullptr);
+        reflVar.SetGetter(nullptr);
+    }
+}
+
+ReflectTable::~ReflectTable()
+{
+}
+
+void ReflectTable::ImportMeta(IReflectable *reflectable,
+                              const MetaNode &metaNode) const
+{
+    const ReflectStruct *instanceReflStruct = nullptr;
+    for (uint i = 0; i < m_variables.Size(); ++i)
+    {
+        const ReflectVariable &reflVar = m_variables[i];
+        if (reflVar.GetHints().GetIsButton())
+        {
+            continue;
+        }
+
+        const String &varName = reflVar.GetName();
+        if (const ReflectFieldAccessor *accessor = reflVar.GetAccessor())
+        {
+            accessor->Import(reflectable, metaNode, varName);
+        }
+        else if (metaNode.Contains(varName))
+        {
+            const ReflectVariable *instanceReflVar =
+                GetInstanceReflectVariable(
+                    reflectable, &instanceReflStruct, i);
+            if (instanceReflVar && instanceReflVar->GetSetter())
+            {
+                instanceReflVar->GetSetter()(GetMetaValueAsVariant(
+                    metaNode, varName, reflVar.GetVariant().GetType()));
+            }
+        }
+    }
+}
+
+void ReflectTable::ExportMeta(const IReflectable *reflectable,
+                              MetaNode *metaNode) const
+{
+    const ReflectStruct *instanceReflStruct = nullptr;
+    for (uint i = 0; i < m_variables.Size(); ++i)
+    {
+        const ReflectVariable &reflVar = m_variables[i];
+        if (reflVar.GetHints().GetIsButton())
+        {
+            continue;
+        }
+
+        const String &varName = reflVar.GetName();
+        if (const ReflectFieldAccessor *accessor = reflVar.GetAccessor())
+        {
+            accessor->Export(reflectable, metaNode, varName);
+        }
+        else if (const ReflectVariable *instanceReflVar =
+                     GetInstanceReflectVariable(
+                         reflectable, &instanceReflStruct, i))
+        {
+            metaNode->Set(varName, instanceReflVar->GetCurrentValue());
+        }
+    }
+}
+
+void ReflectTable::CopyValues(const IReflectable *from, IReflectable *to) const
+{
+    const ReflectStruct *fromReflStruct = nullptr;
+    const ReflectStruct *toReflStruct = nullptr;
+    for (uint i = 0; i < m_variables.Size(); ++i)
+    {
+        const ReflectVariable &reflVar = m_variables[i];
+        if (reflVar.GetHints().GetIsButton())
+        {
+            continue;
+        }
+
+        if (const ReflectFieldAccessor *accessor = reflVar.GetAccessor())
+        {
+            accessor->Copy(from, to);
+        }
+        else
+        {
+            const ReflectVariable *fromReflVar =
+                GetInstanceReflectVariable(from, &fromReflStruct, i);
+            const ReflectVariable *toReflVar =
+                GetInstanceReflectVariable(to, &toReflStruct, i);
+            if (fromReflVar && toReflVar && fromReflVar->GetGetter() &&
+                toReflVar->GetSetter())
+            {
+                toReflVar->GetSetter()(fromReflVar->GetGetter()());
+            }
+        }
+    }
+}
+
+void ReflectTable::CompileImportMeta(const MetaNode &metaNode,
+                                     Array<ReflectImportOp> *importOps) const
+{
+    // The variables bound to the instance are set through its ReflectStruct,
+    // reflected once for each run of them
+    Array<std::pair<uint, Variant>> instanceValues;
+    auto FlushInstanceValues = [&instanceValues, importOps]() {
+        if (instanceValues.IsEmpty())
+        {
+            return;
+        }
+
+        importOps->PushBack([instanceValues](IReflectable *reflectable) {
+            const Array<ReflectVariable> &instanceVars =
+                reflectable->GetReflectStruct().GetVariables();
+            for (const auto &pair : instanceValues)
+            {
+                ASSERT(pair.first < instanceVars.Size());
+                if (pair.first < instanceVars.Size() &&
+                    instanceVars[pair.first].GetSetter())
+                {
+                    instanceVars[pair.first].GetSetter()(pair.second);
+                }
+            }
+        });
+        instanceValues.Clear();
+    };
+
+    for (uint i = 0; i < m_variables.Size(); ++i)
+    {
+        const ReflectVariable &reflVar = m_variables[i];
+        if (reflVar.GetHints().GetIsButton())
+        {
+            continue;
+        }
+
+        const String &varName = reflVar.GetName();
+        if (const ReflectFieldAccessor *accessor = reflVar.GetAccessor())
+        {
+            if (ReflectImportOp importOp =
+                    accessor->CompileImport(metaNode, varName))
+            {
+                FlushInstanceValues();
+                importOps->PushBack(importOp);
+            }
+        }
+        else if (metaNode.Contains(varName))
+        {
+            instanceValues.PushBack(std::make_pair(
+                i,
+                GetMetaValueAsVariant(
+                    metaNode, varName, reflVar.GetVariant().GetType())));
+        }
+    }
+    FlushInstanceValues();
+}
+
+TypeId ReflectTable::GetTypeId() const
+{
+    return m_typeId;
+}
+
+const Array<ReflectVariable> &ReflectTable::GetVariables() const
+{
+    return m_variables;
+}
@@ -139,6 +139,12 @@ void ReflectVariable::SetGetter(std::function<Variant()> getter)
     m_getter = getter;
 }
 
+void ReflectVariable::SetAccessor(
+    const std::shared_ptr<ReflectFieldAccessor> &accessor)
+{
+    p_accessor = accessor;
+}
+
 Variant &ReflectVariable::GetVariant()
 {
     return m_variant;
@@ -183,6 +189,11 @@ ReflectVariable::GetterFunc ReflectVariable::GetGetter() const
     return m_getter;
 }
 
+const ReflectFieldAccessor *ReflectVariable::GetAccessor() const
+{
+    return p_accessor.get();
+}
+
 const String &ReflectVariable::GetTypeString() const
 {
     return m_typeString;
@@ -25,6 +25,7 @@
 #include "Bang/MetaNode.tcc"
 #include "Bang/SkinnedMeshRenderer.h"
 #include "Bang/Transform.h"
+#include "Bang/UMap.tcc"
 
 namespace Bang
 {
@@ -60,109 +61,101 @@ void Animator::OnUpdate()
 {
     Component::OnUpdate();
 
-    Time now = Time::GetNow();
+    if (m_updatedByScene)
+    {
+        // Already updated this frame by the SceneAnimatorsUpdater
+        m_updatedByScene = false;
+        return;
+    }
+
+    if (StepPlayers(Time::GetNow()))
+    {
+        EvaluatePose();
+        ApplyPose();
+    }
+}
+
+bool Animator::StepPlayers(Time now)
+{
     Time passedTime = (now - m_prevFrameTime);
     m_prevFrameTime = now;
 
     AnimatorStateMachine *sm = GetStateMachine();
-    if (sm && IsPlaying())
+    if (!sm || !IsPlaying())
     {
-        Map<String, Transformation> combinedLayersBonesTransformations;
-        for (AnimatorStateMachinePlayer *player : GetPlayers())
-        {
-            player->Step(this, passedTime);
+        return false;
+    }
 
-            if (player->GetCurrentAnimation())
-            {
-                const Time currentAnimTime = player->GetCurrentNodeTime();
+    for (AnimatorStateMachinePlayer *player : GetPlayers())
+    {
+        player->Step(this, passedTime);
+    }
+    return true;
+}
+
+void Animator::EvaluatePose()
+{
+    m_combinedPose.Reset(GetSkeleton().GetNumBones());
+    for (AnimatorStateMachinePlayer *player : GetPlayers())
+    {
+        if (player->GetCurrentAnimation())
+        {
+            const Time currentAnimTime = player->GetCurrentNodeTime();
 
-                AnimatorStateMachineLayer *layer =
-                    player->GetStateMachineLayer();
-                ASSERT(layer);
+            AnimatorStateMachineLayer *layer = player->GetStateMachineLayer();
+            ASSERT(layer);
 
-                if (layer->GetEnabled())
+            if (layer->GetEnabled())
+            {
+                if (AnimatorStateMachineNode *nextNode = player->GetNextNode())
                 {
-                    bool hasLayerMask = (layer->GetLayerMask() != nullptr);
-                    Set<String> layerMask;
-                    if (hasLayerMask)
-                    {
-                        layerMask =
-                            layer->GetLayerMask()->GetBoneMaskNamesSet(this);
-                    }
-
-                    Map<String, Transformation> layerBoneNameToBoneTransform;
-                    if (AnimatorStateMachineNode *nextNode =
-                            player->GetNextNode())
-                    {
-                        // Cross fading
-                        Map<String, Transformation> prevBoneTransformations =
-                            player->GetCurrentNode()->GetBoneTransformations(
-                                player->GetCurrentNodeTime(), this);
-
-                        Map<String, Transformation> nextBoneTransformations =
-                            nextNode->GetBoneTransformations(
-                                player->GetCurrentTransitionTime(), this);
-
-                        double totalCrossFadeSeconds = Math::Max(
-                            player->GetCurrentTransitionDuration().GetSeconds(),
-                            0.01);
-                        float nextWeight =
-                            (player->GetCurrentTransitionTime().GetSeconds() /
-                             totalCrossFadeSeconds);
-
-                        ASSERT(player->GetCurrentTransition());
-
-                        layerBoneNameToBoneTransform =
-                            Animation::GetInterpolatedBoneTransformations(
-                                prevBoneTransformations,
-                                nextBoneTransformations,
-                                nextWeight);
-                    }
-                    else
-                    {
-                        // Simple animation
-                        layerBoneNameToBoneTransform =
-                            player->GetCurrentNode()->GetBoneTransformations(
-                                currentAnimTime, this);
-                    }
-
-                    for (const auto &pair : layerBoneNameToBoneTransform)
-                    {
-                        const String &layerBoneName = pair.first;
-                        const Transformation &layerBoneTransform = pair.second;
-
-                        bool considerThisBone =
-                            (!hasLayerMask ||
-                             layerMask.Contains(layerBoneName));
-                        if (considerThisBone)
-                        {
-                            auto it = combinedLayersBonesTransformations.Find(
-                                layerBoneName);
-                            if (it != combinedLayersBonesTransformations.End())
-                            {
-                                Transformation
-                                    &combinedLayerBoneTransformation =
-                                        it->second;
-                                combinedLayerBoneTransformation.Translate(
-                                    layerBoneTransform.GetPosition());
-                                combinedLayerBoneTransformation.Rotate(
-                                    layerBoneTransform.GetRotation());
-                                combinedLayerBoneTransformation.Scale(
-                                    layerBoneTransform.GetScale());
-                            }
-                            else
-                            {
-                                combinedLayersBonesTransformations.Add(
-                                    layerBoneName, layerBoneTransform);
-                            }
-                        }
-                    }
+                    // Cross fading
+                    player->GetCurrentNode()->SampleBonePose(
+                        player->GetCurrentNodeTime(), this, &m_layerPose);
+                    nextNode->SampleBonePose(player->GetCurrentTransitionTime(),
+                                             this,
+                                             &m_crossFadePose);
+
+                    double totalCrossFadeSeconds = Math::Max(
+                        player->GetCurrentTransitionDuration().GetSeconds(),
+                        0.01);
+                    float nextWeight =
+                        (player->GetCurrentTransitionTime().GetSeconds() /
+                         totalCrossFadeSeconds);
+
+                    ASSERT(player->GetCurrentTransition());
+
+                    AnimationPose::Interpolate(m_layerPose,
+                                               m_crossFadePose,
+                                               nextWeight,
+                                               &m_layerPose);
                 }
+                else
+                {
+                    // Simple animation
+                    player->GetCurrentNode()->SampleBonePose(
+                        currentAnimTime, this, &m_layerPose);
+                }
+
+                m_combinedPose.Combine(m_layerPose, GetLayerMaskWeights(layer));
             }
         }
+    }
+}
 
-        SetSkinnedMeshRendererBoneTransformations(
-            combinedLayersBonesTransformations);
+void Animator::ApplyPose()
+{
+    SetSkinnedMeshRendererBoneTransformations(m_combinedPose);
+
+    // Samplers can be bound from the workers, so the animations are watched
+    // from here, to drop their samplers when they are destroyed
+    for (const auto &guidAndSampler : m_animationSamplers)
+    {
+        if (const Animation *animation = guidAndSampler.second.GetAnimation())
+        {
+            const_cast<Animation *>(animation)
+                ->EventEmitter<IEventsDestroy>::RegisterListener(this);
+        }
     }
 }
 
@@ -212,36 +205,143 @@ void Animator::SetVariableTrigger(const String &varName, bool value)
     SetVariableBool(varName, value);
 }
 
+void Animator::SampleAnimation(const Animation *animation,
+                               Time animationTime,
+                               AnimationPose *pose)
+{
+    pose->Reset(GetSkeleton().GetNumBones());
+    if (!animation)
+    {
+        return;
+    }
+
+    AnimationSampler &sampler = m_animationSamplers[animation->GetGUID()];
+    const Array<Animation::BoneTrack> &boneTracks = animation->GetBoneTracks();
+    if (sampler.GetAnimation() != animation ||
+        sampler.GetNumBoundBoneTracks() != boneTracks.Size())
+    {
+        for (const Animation::BoneTrack &boneTrack : boneTracks)
+        {
+            m_skeleton.AddBone(boneTrack.boneName);
+        }
+        sampler.Bind(animation, &m_skeleton);
+    }
+    sampler.Sample(animationTime, pose);
+}
+
+const AnimationSkeleton &Animator::GetSkeleton() const
+{
+    return m_skeleton;
+}
+
+const AnimationPose &Animator::GetPose() const
+{
+    return m_combinedPose;
+}
+
+AnimationPose *Animator::GetBlendPose()
+{
+    return &m_blendPose;
+}
+
+const Array<float> &Animator::GetLayerMaskWeights(
+    const AnimatorStateMachineLayer *layer)
+{
+    LayerMaskWeights &layerMaskWeights = m_layerMaskWeights[layer];
+
+    // The mask bones are found by name below the animator parent, so the
+    // weights are rebuilt whenever that subtree changes
+    const AnimatorLayerMask *layerMask = layer->GetLayerMask();
+    GameObject *animatorParent = GetGameObject()->GetParent();
+    const uint animatorParentSubtreeVersion =
+        animatorParent ? animatorParent->GetSubtreeVersion() : 0;
+    if (!layerMask)
+    {
+        layerMaskWeights.layerMask = nullptr;
+        layerMaskWeights.boneWeights.Clear();
+    }
+    else if (layerMask != layerMaskWeights.layerMask ||
+             layerMask->GetBoneEntries() != layerMaskWeights.boneEntries ||
+             animatorParent != layerMaskWeights.animatorParent ||
+             animatorParentSubtreeVersion !=
+                 layerMaskWeights.animatorParentSubtreeVersion ||
+             GetSkeleton().GetNumBones() != layerMaskWeights.numBones)
+    {
+        layerMaskWeights.layerMask = layerMask;
+        layerMaskWeights.boneEntries = layerMask->GetBoneEntries();
+        layerMaskWeights.animatorParent = animatorParent;
+        layerMaskWeights.animatorParentSubtreeVersion =
+            animatorParentSubtreeVersion;
+        layerMaskWeights.numBones = GetSkeleton().GetNumBones();
+        layerMaskWeights.boneWeights =
+            layerMask->GetBoneMaskWeights(this, GetSkeleton());
+    }
+    return layerMaskWeights.boneWeights;
+}
+
 void Animator::SetSkinnedMeshRendererBoneTransformations(
-    const Map<String, Transformation> &boneAnimMatrices)
+    const AnimationPose &pose)
 {
     Array<SkinnedMeshRenderer *> smrs =
         GetGameObject()->GetComponents<SkinnedMeshRenderer>();
     for (SkinnedMeshRenderer *smr : smrs)
     {
-        Array<GameObject *> allBoneGos = smr->GetAllBoneGameObjects();
-        for (GameObject *boneGo : allBoneGos)
+        const SkinnedMeshRendererBones &smrBones =
+            GetSkinnedMeshRendererBones(smr);
+        for (uint i = 0; i < smrBones.boneGameObjects.Size(); ++i)
         {
-            const String &boneName = boneGo->GetName();
-            auto it = boneAnimMatrices.Find(boneGo->GetName());
-            if (it != boneAnimMatrices.End())
+            const int boneIndex = smrBones.boneIndices[i];
+            if (boneIndex >= 0 && pose.IsBoneAnimated(boneIndex))
             {
-                const Transformation &boneAnimTransformation = it->second;
-                if (GameObject *boneGo = smr->GetBoneGameObject(boneName))
+                if (GameObject *boneGo = smrBones.namedBoneGameObjects[i])
                 {
                     boneGo->GetTransform()->FillFromTransformation(
-                        boneAnimTransformation);
+                        pose.boneTransformations[boneIndex]);
                 }
             }
             else
             {
-                smr->ResetBoneTransformation(boneGo);
+                smr->ResetBoneTransformation(smrBones.boneGameObjects[i]);
             }
         }
-        smr->UpdateBonesMatricesFromTransformMatrices();
     }
 }
 
+const Animator::SkinnedMeshRendererBones &
+Animator::GetSkinnedMeshRendererBones(SkinnedMeshRenderer *smr)
+{
+    SkinnedMeshRendererBones &smrBones = m_skinnedMeshRendererBones[smr];
+
+    // The bones are found by name below the root bone, so they are resolved
+    // again whenever that subtree changes
+    const Array<GameObject *> &boneGos = smr->GetAllBoneGameObjects();
+    GameObject *rootBoneGo = smr->GetRootBoneGameObject();
+    const uint rootBoneSubtreeVersion =
+        rootBoneGo ? rootBoneGo->GetSubtreeVersion() : 0;
+    if (boneGos == smrBones.boneGameObjects &&
+        rootBoneGo == smrBones.rootBoneGameObject &&
+        rootBoneSubtreeVersion == smrBones.rootBoneSubtreeVersion &&
+        GetSkeleton().GetNumBones() == smrBones.numBones)
+    {
+        return smrBones;
+    }
+
+    smrBones.boneGameObjects = boneGos;
+    smrBones.rootBoneGameObject = rootBoneGo;
+    smrBones.rootBoneSubtreeVersion = rootBoneSubtreeVersion;
+    smrBones.numBones = GetSkeleton().GetNumBones();
+    smrBones.boneIndices.Clear();
+    smrBones.namedBoneGameObjects.Clear();
+    for (GameObject *boneGo : boneGos)
+    {
+        const String &boneName = boneGo->GetName();
+        smrBones.boneIndices.PushBack(GetSkeleton().GetBoneIndex(boneName));
+        smrBones.namedBoneGameObjects.PushBack(
+            smr->GetBoneGameObject(boneName));
+    }
+    return smrBones;
+}
+
 void Animator::OnLayerAdded(AnimatorStateMachine *stateMachine,
                             AnimatorStateMachineLayer *stateMachineLayer)
 {
@@ -268,12 +368,21 @@ void Animator::OnLayerRemoved(AnimatorStateMachine *stateMachine,
     {
         if (player->GetStateMachineLayer() == stateMachineLayer)
         {
+            m_layerMaskWeights.Remove(stateMachineLayer);
             m_animatorStateMachinePlayers.Remove(player);
             break;
         }
     }
 }
 
+void Animator::OnDestroyed(EventEmitter<IEventsDestroy> *object)
+{
+    // Only animations are listened to. Their address can be reused by the
+    // next asset loaded, so their samplers go away with them.
+    Asset *animation = SCAST<Asset *>(object);
+    m_animationSamplers.Remove(animation->GetGUID());
+}
+
 void Animator::Play()
 {
     m_playing = true;
@@ -108,24 +108,31 @@ void AudioSource::Reflect()
 {
     Component::Reflect();
 
-    ReflectVar<float>("Volume",
-                      [this](float v) { SetVolume(v); },
-                      [this]() -> float { return GetVolume(); },
-                      BANG_REFLECT_HINT_SLIDER(0.0f, 1.0f));
-    ReflectVar<float>("Pitch",
-                      [this](float p) { SetPitch(p); },
-                      [this]() -> float { return GetPitch(); },
-                      BANG_REFLECT_HINT_MIN_VALUE(0.01f));
-    ReflectVar<float>("Range",
-                      [this](float r) { SetRange(r); },
-                      [this]() -> float { return GetRange(); },
-                      BANG_REFLECT_HINT_MIN_VALUE(0.01f));
-    ReflectVar<bool>("Looping",
-                     [this](bool looping) { SetLooping(looping); },
-                     [this]() -> bool { return GetLooping(); });
-    ReflectVar<bool>("PlayOnStart",
-                     [this](bool playOnStart) { SetPlayOnStart(playOnStart); },
-                     [this]() -> bool { return GetPlayOnStart(); });
+    ReflectVar<AudioSource, float>(
+        "Volume",
+        [](AudioSource *as, float v) { as->SetVolume(v); },
+        [](const AudioSource *as) -> float { return as->GetVolume(); },
+        BANG_REFLECT_HINT_SLIDER(0.0f, 1.0f));
+    ReflectVar<AudioSource, float>(
+        "Pitch",
+        [](AudioSource *as, float p) { as->SetPitch(p); },
+        [](const AudioSource *as) -> float { return as->GetPitch(); },
+        BANG_REFLECT_HINT_MIN_VALUE(0.01f));
+    ReflectVar<AudioSource, float>(
+        "Range",
+        [](AudioSource *as, float r) { as->SetRange(r); },
+        [](const AudioSource *as) -> float { return as->GetRange(); },
+        BANG_REFLECT_HINT_MIN_VALUE(0.01f));
+    ReflectVar<AudioSource, bool>(
+        "Looping",
+        [](AudioSource *as, bool looping) { as->SetLooping(looping); },
+        [](const AudioSource *as) -> bool { return as->GetLooping(); });
+    ReflectVar<AudioSource, bool>(
+        "PlayOnStart",
+        [](AudioSource *as, bool playOnStart) {
+            as->SetPlayOnStart(playOnStart);
+        },
+        [](const AudioSource *as) -> bool { return as->GetPlayOnStart(); });
 
     BANG_REFLECT_BUTTON_HINTED(
         AudioSource,
@@ -436,6 +436,11 @@ Quad Camera::GetFrustumBotQuad() const
     return Quad(p0, p1, p2, p3);
 }
 
+Frustum Camera::GetFrustum() const
+{
+    return Frustum(GetProjectionMatrix() * GetViewMatrix());
+}
+
 Camera *Camera::GetActive()
 {
     Camera *cam = GEngine::GetActiveRenderingCamera();
@@ -108,6 +108,7 @@ void Cloth::SetPoint(uint i, const Vector3 &pos)
         m_points[i] = pos;
         m_particlesData[i].position = pos;
         m_particlesData[i].prevPosition = m_particlesData[i].position;
+        PropagateRendererChanged();
     }
 }
 
@@ -273,6 +274,7 @@ void Cloth::OnUpdate()
     UpdateMeshPoints();
 
     m_validMeshPoints = false;
+    PropagateRendererChanged();
 }
 
 void Cloth::Bind()
@@ -367,13 +369,15 @@ void Cloth::Reflect()
     //     ->GetHintsPtr()
     //     ->Update(BANG_REFLECT_HINT_SHOWN(false));
 
-    ReflectVar<bool>(
+    ReflectVar<Cloth, bool>(
         "Wireframe",
-        [this](bool w) {
-            GetMaterial()->GetShaderProgramProperties().SetWireframe(w);
+        [](Cloth *cloth, bool w) {
+            cloth->GetMaterial()->GetShaderProgramProperties().SetWireframe(w);
         },
-        [this]() -> bool {
-            return GetMaterial()->GetShaderProgramProperties().GetWireframe();
+        [](const Cloth *cloth) -> bool {
+            return cloth->GetMaterial()
+                ->GetShaderProgramProperties()
+                .GetWireframe();
         });
 
     BANG_REFLECT_VAR_MEMBER_HINTED(Cloth,
@@ -429,24 +433,35 @@ void Cloth::Reflect()
                             SetComputeCollisions,
                             GetComputeCollisions);
 
-    ReflectVar<bool>("Top Left Fixed",
-                     [this](bool f) { SetFixedPoint(0, f); },
-                     [this]() { return IsPointFixed(0); });
-    ReflectVar<bool>(
+    ReflectVar<Cloth, bool>(
+        "Top Left Fixed",
+        [](Cloth *cloth, bool f) { cloth->SetFixedPoint(0, f); },
+        [](const Cloth *cloth) { return cloth->IsPointFixed(0); });
+    ReflectVar<Cloth, bool>(
         "Top Right Fixed",
-        [this](bool f) { SetFixedPoint(GetSubdivisions() - 1, f); },
-        [this]() { return IsPointFixed(GetSubdivisions() - 1); });
-    ReflectVar<bool>(
+        [](Cloth *cloth, bool f) {
+            cloth->SetFixedPoint(cloth->GetSubdivisions() - 1, f);
+        },
+        [](const Cloth *cloth) {
+            return cloth->IsPointFixed(cloth->GetSubdivisions() - 1);
+        });
+    ReflectVar<Cloth, bool>(
         "Bot Left Fixed",
-        [this](bool f) { SetFixedPoint(GetTotalNumPoints() - 1, f); },
-        [this]() { return IsPointFixed(GetTotalNumPoints() - 1); });
-    ReflectVar<bool>(
+        [](Cloth *cloth, bool f) {
+            cloth->SetFixedPoint(cloth->GetTotalNumPoints() - 1, f);
+        },
+        [](const Cloth *cloth) {
+            return cloth->IsPointFixed(cloth->GetTotalNumPoints() - 1);
+        });
+    ReflectVar<Cloth, bool>(
         "Bot Right Fixed",
-        [this](bool f) {
-            SetFixedPoint(GetTotalNumPoints() - GetSubdivisions(), f);
+        [](Cloth *cloth, bool f) {
+            cloth->SetFixedPoint(
+                cloth->GetTotalNumPoints() - cloth->GetSubdivisions(), f);
         },
-        [this]() {
-            return IsPointFixed(GetTotalNumPoints() - GetSubdivisions());
+        [](const Cloth *cloth) {
+            return cloth->IsPointFixed(cloth->GetTotalNumPoints() -
+                                       cloth->GetSubdivisions());
         });
 }
 
@@ -632,6 +647,7 @@ void Cloth::RecreateMesh()
     GetMesh()->SetTrianglesVertexIds(triangleVertexIndices);
 
     UpdateMeshPoints();
+    PropagateRendererChanged();
 }
 
 uint Cloth::GetTotalNumPoints() const
@@ -15,7 +15,9 @@
 #include "Bang/Transform.h"
 #include "PxRigidDynamic.h"
 #include "PxShape.h"
+#include "geometry/PxGeometryQuery.h"
 #include "extensions/PxRigidBodyExt.h"
+#include "foundation/PxBounds3.h"
 #include "foundation/PxQuat.h"
 #include "foundation/PxTransform.h"
 #include "foundation/PxVec3.h"
@@ -142,6 +144,19 @@ PhysicsMaterial *Collider::GetPhysicsMaterial() const
     return p_physicsMaterial.Get();
 }
 
+AABox Collider::GetAABBoxWorld() const
+{
+    if (physx::PxShape *pxShape = GetPxShape())
+    {
+        const physx::PxBounds3 pxBounds =
+            physx::PxGeometryQuery::getWorldBounds(
+                pxShape->getGeometry().any(), GetWorldPxTransform());
+        return AABox(Physics::GetVector3FromPxVec3(pxBounds.minimum),
+                     Physics::GetVector3FromPxVec3(pxBounds.maximum));
+    }
+    return AABox::Empty();
+}
+
 bool Collider::CanComputeInertia() const
 {
     return true;
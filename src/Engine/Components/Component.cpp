@@ -9,12 +9,16 @@
 #include "Bang/IEventsComponentChangeGameObject.h"
 #include "Bang/MetaNode.h"
 #include "Bang/MetaNode.tcc"
+#include "Bang/Scene.h"
+#include "Bang/SceneObjectIndex.h"
+#include "Bang/SceneParallelUpdater.h"
 #include "Bang/String.h"
 
 using namespace Bang;
 
 Component::Component()
 {
+    SET_INSTANCE_CLASS_ID(Component);
 }
 
 Component::~Component()
@@ -27,6 +31,14 @@ Component::~Component()
 
 void Component::DestroyImmediate(Component *component)
 {
+    if (component->GetGameObject() &&
+        component->GetGameObject()->GetParent() &&
+        SceneParallelUpdater::DeferIfUpdating(
+            [component]() { Component::DestroyImmediate(component); }))
+    {
+        return;
+    }
+
     if (!component->IsBeingDestroyed())
     {
         component->SetWaitingToBeDestroyed();
@@ -39,6 +51,14 @@ void Component::DestroyImmediate(Component *component)
 
 void Component::Destroy(Component *component)
 {
+    if (component->GetGameObject() &&
+        component->GetGameObject()->GetParent() &&
+        SceneParallelUpdater::DeferIfUpdating(
+            [component]() { Component::Destroy(component); }))
+    {
+        return;
+    }
+
     if (!component->IsWaitingToBeDestroyed())
     {
         component->SetWaitingToBeDestroyed();
@@ -106,6 +126,16 @@ GameObject *Component::GetGameObject() const
     return p_gameObject;
 }
 
+ComponentUpdateAccess Component::GetUpdateAccess() const
+{
+    return ComponentUpdateAccess::MAIN_THREAD;
+}
+
+void Component::GetUpdateDependencies(Array<GameObject *> *dependencies) const
+{
+    BANG_UNUSED(dependencies);
+}
+
 void Component::OnPreStart()
 {
 }
@@ -201,6 +231,17 @@ bool Component::CalculateEnabledRecursively() const
            (GetGameObject() ? GetGameObject()->IsEnabledRecursively() : true);
 }
 
+void Component::OnGUIDChanged(const GUID &previousGUID)
+{
+    Object::OnGUIDChanged(previousGUID);
+
+    Scene *scene = (GetGameObject() ? GetGameObject()->GetScene() : nullptr);
+    if (scene)
+    {
+        scene->GetObjectIndex()->OnObjectGUIDChanged(this, previousGUID);
+    }
+}
+
 void Component::CloneInto(Serializable *clone, bool cloneGUID) const
 {
     Object::CloneInto(clone, cloneGUID);
@@ -224,6 +265,19 @@ void Component::ImportMeta(const MetaNode &metaNode)
     }
 }
 
+void Component::CompileImportMeta(const MetaNode &metaNode,
+                                  Array<ReflectImportOp> *importOps) const
+{
+    Serializable::CompileImportMeta(metaNode, importOps);
+    if (metaNode.Contains("Enabled"))
+    {
+        const bool enabled = metaNode.Get<bool>("Enabled", true);
+        importOps->PushBack([enabled](IReflectable *reflectable) {
+            SCAST<Component *>(reflectable)->SetEnabled(enabled);
+        });
+    }
+}
+
 void Component::ExportMeta(MetaNode *metaNode) const
 {
     Serializable::ExportMeta(metaNode);
@@ -16,6 +16,7 @@
 #include "Bang/ClassDB.h"
 #include "Bang/Framebuffer.h"
 #include "BangMath/Polygon2D.h"
+#include "Bang/Frustum.h"
 #include "Bang/GEngine.h"
 #include "Bang/GL.h"
 #include "Bang/GLUniforms.h"
@@ -142,6 +143,13 @@ void DirectionalLight::RenderShadowMaps_(GameObject *go)
     GLUniforms::SetProjectionMatrix(shadowMapProjMatrix);
     m_lastUsedShadowMapViewProj = shadowMapProjMatrix * shadowMapViewMatrix;
 
+    // Only render the casters that fall inside the shadow map ortho box.
+    // Depth is not tested, so that casters behind it still cast shadows.
+    const Array<Renderer *> visibleShadowCastersRenderers =
+        ge->CullShadowCasters(Frustum(m_lastUsedShadowMapViewProj),
+                              shadowCastersRenderers,
+                              false);
+
     // Render shadow map into framebuffer
     GL::SetDepthMask(true);
     GL::ClearDepthBuffer(1.0f);
@@ -149,7 +157,7 @@ void DirectionalLight::RenderShadowMaps_(GameObject *go)
     float limit = Math::Exp(GetShadowExponentConstant());
     GL::ClearColorBuffer(Color(limit));
 
-    for (Renderer *rend : shadowCastersRenderers)
+    for (Renderer *rend : visibleShadowCastersRenderers)
     {
         rend->OnRender(RenderPass::SCENE_OPAQUE);
     }
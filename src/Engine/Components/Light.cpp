@@ -15,6 +15,7 @@
 #include "Bang/MetaNode.tcc"
 #include "Bang/RenderPass.h"
 #include "Bang/Renderer.h"
+#include "Bang/SceneSpatialIndex.h"
 #include "Bang/ShaderProgram.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/Texture2D.h"
@@ -210,6 +211,14 @@ void Light::OnShadowHighBitDepthChanged()
 {
 }
 
+void Light::PropagateBoundsChanged()
+{
+    if (p_spatialIndex)
+    {
+        p_spatialIndex->MarkDirty(this);
+    }
+}
+
 void Light::SetShadowLightCommonUniforms(ShaderProgram *sp) const
 {
     Transform *tr = GetGameObject()->GetTransform();
@@ -276,6 +285,11 @@ AARect Light::GetRenderRect(Camera *camera) const
     return AARect::NDCRect();
 }
 
+ComponentUpdateAccess Light::GetUpdateAccess() const
+{
+    return ComponentUpdateAccess::GAMEOBJECT_SUBTREE;
+}
+
 void Light::Reflect()
 {
     Serializable::Reflect();
@@ -287,10 +301,11 @@ void Light::Reflect()
                                    BANG_REFLECT_HINT_MIN_VALUE(0.0f));
     BANG_REFLECT_VAR_MEMBER(Light, "Color", SetColor, GetColor);
 
-    ReflectVar<float>("Exp ctt",
-                      [this](float f) { SetShadowExponentConstant(f); },
-                      [this]() { return GetShadowExponentConstant(); },
-                      BANG_REFLECT_HINT_MINMAX_VALUE(0.0f, 1000.0f));
+    ReflectVar<Light, float>(
+        "Exp ctt",
+        [](Light *l, float f) { l->SetShadowExponentConstant(f); },
+        [](const Light *l) { return l->GetShadowExponentConstant(); },
+        BANG_REFLECT_HINT_MINMAX_VALUE(0.0f, 1000.0f));
 
     BANG_REFLECT_VAR_MEMBER_HINTED(Light,
                                    "Softness",
@@ -318,8 +333,9 @@ void Light::Reflect()
                             SetShadowHighBitDepth,
                             GetShadowHighBitDepth);
 
-    ReflectVar<uint>("Shadow Map Size",
-                     [this](uint size) { SetShadowMapSize(Vector2i(size)); },
-                     [this]() -> uint { return GetShadowMapSize().x; },
-                     BANG_REFLECT_HINT_MIN_VALUE(1));
+    ReflectVar<Light, uint>(
+        "Shadow Map Size",
+        [](Light *l, uint size) { l->SetShadowMapSize(Vector2i(size)); },
+        [](const Light *l) -> uint { return l->GetShadowMapSize().x; },
+        BANG_REFLECT_HINT_MIN_VALUE(1));
 }
@@ -69,6 +69,7 @@ void LineRenderer::SetPoints(const Array<Vector3> &points)
     p_mesh.Get()->SetTrianglesVertexIds({});
     p_mesh.Get()->SetPositionsPool(GetPoints());
     p_mesh.Get()->UpdateVAOs();
+    PropagateRendererChanged();
 }
 
 const Array<Vector3> &LineRenderer::GetPoints() const
@@ -2,6 +2,7 @@
 
 #include "Bang/Assets.h"
 #include "Bang/Assets.tcc"
+#include "Bang/Camera.h"
 #include "Bang/ClassDB.h"
 #include "Bang/Extensions.h"
 #include "Bang/GL.h"
@@ -42,6 +43,7 @@ void MeshRenderer::SetMesh(Mesh *m)
         p_sharedMesh.Set(m);
         OnMeshLoaded(m);
         p_mesh.Set(nullptr);
+        PropagateRendererChanged();
     }
 }
 
@@ -86,6 +88,16 @@ void MeshRenderer::SetAutoLOD(bool autoLOD)
     m_autoLOD = autoLOD;
 }
 
+void MeshRenderer::SetLODScreenSizes(const Array<float> &lodScreenSizes)
+{
+    m_lodScreenSizes = lodScreenSizes;
+}
+
+void MeshRenderer::SetLODHysteresis(float lodHysteresis)
+{
+    m_lodHysteresis = Math::Clamp(lodHysteresis, 0.0f, 1.0f);
+}
+
 bool MeshRenderer::GetAutoLOD() const
 {
     return m_autoLOD;
@@ -102,6 +114,94 @@ Mesh *MeshRenderer::GetCurrentLODActiveMesh() const
                            : nullptr;
 }
 
+const Array<float> &MeshRenderer::GetLODScreenSizes() const
+{
+    return m_lodScreenSizes;
+}
+
+float MeshRenderer::GetLODHysteresis() const
+{
+    return m_lodHysteresis;
+}
+
+int MeshRenderer::SelectLOD(float screenSize,
+                            int currentLOD,
+                            int numLODs,
+                            const Array<float> &lodScreenSizes,
+                            float hysteresis)
+{
+    int lod = 0;
+    float threshold = 1.0f;
+    for (int i = 0; i < numLODs - 1; ++i)
+    {
+        threshold = (i < SCAST<int>(lodScreenSizes.Size()))
+                        ? lodScreenSizes[i]
+                        : (threshold * 0.5f);
+
+        const float bias =
+            (i < currentLOD) ? (1.0f + hysteresis) : (1.0f - hysteresis);
+        if (screenSize >= threshold * bias)
+        {
+            break;
+        }
+        lod = i + 1;
+    }
+    return lod;
+}
+
+float MeshRenderer::GetScreenSize(const AABox &aaBBoxWorld,
+                                  const Camera *camera)
+{
+    const Vector3 &min = aaBBoxWorld.GetMin();
+    const Vector3 &max = aaBBoxWorld.GetMax();
+    const Vector3 center = (min + max) * 0.5f;
+    const float radius = (max - min).Length() * 0.5f;
+
+    if (camera->GetProjectionMode() == CameraProjectionMode::ORTHOGRAPHIC)
+    {
+        const float orthoHeight = camera->GetOrthoHeight();
+        return (orthoHeight > 0.0f) ? (radius / orthoHeight) : 1.0f;
+    }
+
+    const Transform *camTr = camera->GetGameObject()->GetTransform();
+    const Vector3 camPos = camTr->GetLocalToWorldMatrix().GetTranslation();
+    const float dist = (center - camPos).Length();
+    const float tanHalfFov =
+        Math::Tan(Math::DegToRad(camera->GetFovDegrees()) * 0.5f);
+    if (dist <= radius || tanHalfFov <= 0.0f)
+    {
+        return 1.0f;
+    }
+    return radius / (dist * tanHalfFov);
+}
+
+void MeshRenderer::UpdateAutoLOD()
+{
+    Mesh *mesh = GetActiveMesh();
+    Camera *camera = Camera::GetActive();
+    if (!mesh || !camera)
+    {
+        return;
+    }
+
+    // LODs are built when the model is imported. Meshes without them, or
+    // whose geometry changed since, are always drawn at full detail.
+    const int numLODs = mesh->GetNumLODs();
+    if (numLODs <= 1)
+    {
+        m_currentLOD = 0;
+        return;
+    }
+
+    const float screenSize =
+        GetScreenSize(GetGameObject()->GetAABBoxWorld(), camera);
+    m_currentLOD = SelectLOD(screenSize,
+                             GetCurrentLOD(),
+                             numLODs,
+                             GetLODScreenSizes(),
+                             GetLODHysteresis());
+}
+
 void MeshRenderer::IntersectRay(const Ray &ray,
                                 bool *outIntersected,
                                 Vector3 *outIntersectionPoint,
@@ -253,6 +353,16 @@ AABox MeshRenderer::GetAABBox() const
     return GetActiveMesh() ? GetActiveMesh()->GetAABBox() : AABox::Empty();
 }
 
+void MeshRenderer::OnBeforeRender()
+{
+    Renderer::OnBeforeRender();
+
+    if (GetAutoLOD())
+    {
+        UpdateAutoLOD();
+    }
+}
+
 void MeshRenderer::OnRender()
 {
     Renderer::OnRender();
@@ -276,6 +386,11 @@ Mesh *MeshRenderer::GetActiveMesh() const
     return GetSharedMesh();
 }
 
+ComponentUpdateAccess MeshRenderer::GetUpdateAccess() const
+{
+    return ComponentUpdateAccess::GAMEOBJECT_SUBTREE;
+}
+
 void MeshRenderer::Reflect()
 {
     Renderer::Reflect();
@@ -287,4 +402,10 @@ void MeshRenderer::Reflect()
         Mesh,
         BANG_REFLECT_HINT_EXTENSIONS(Extensions::GetMeshExtension()) +
             BANG_REFLECT_HINT_ZOOMABLE_PREVIEW(true));
+
+    BANG_REFLECT_VAR_MEMBER(MeshRenderer, "Auto LOD", SetAutoLOD, GetAutoLOD);
+    BANG_REFLECT_VAR_MEMBER(MeshRenderer,
+                            "LOD Hysteresis",
+                            SetLODHysteresis,
+                            GetLODHysteresis);
 }
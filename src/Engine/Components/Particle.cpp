@@ -22,6 +22,197 @@
 
 using namespace Bang;
 
+namespace
+{
+void StepLifeTimes(Particle::Streams *streams, float dtSecs)
+{
+    float *remainingStartTimes = streams->remainingStartTimes.Data();
+    float *remainingLifeTimes = streams->remainingLifeTimes.Data();
+    float *activeMasks = streams->activeMasks.Data();
+    for (uint i = 0; i < streams->Size(); ++i)
+    {
+        // Life time only starts to pass the step after the start time ran out
+        const float started = (remainingStartTimes[i] <= 0.0f) ? 1.0f : 0.0f;
+        remainingStartTimes[i] -= dtSecs * (1.0f - started);
+        remainingLifeTimes[i] -= dtSecs * started;
+        activeMasks[i] = (remainingLifeTimes[i] > 0.0f) ? started : 0.0f;
+    }
+}
+
+void StepRenderData(Particle::Streams *streams,
+                    const Particle::Parameters &params)
+{
+    const float *totalLifeTimes = streams->totalLifeTimes.Data();
+    const float *remainingLifeTimes = streams->remainingLifeTimes.Data();
+    const float *activeMasks = streams->activeMasks.Data();
+    const Color *startColors = streams->startColors.Data();
+    const Color *endColors = streams->endColors.Data();
+    Color *currentColors = streams->currentColors.Data();
+    for (uint i = 0; i < streams->Size(); ++i)
+    {
+        const float lifeTimePercent =
+            1.0f - (remainingLifeTimes[i] / totalLifeTimes[i]);
+        const Color color =
+            Color::Lerp(startColors[i], endColors[i], lifeTimePercent);
+        currentColors[i] = (activeMasks[i] > 0.0f) ? color : currentColors[i];
+    }
+
+    const Vector2i &sheetSize = params.animationSheetSize;
+    const uint numFrames = SCAST<uint>(sheetSize.x * sheetSize.y);
+    uint *currentFrames = streams->currentFrames.Data();
+    for (uint i = 0; i < streams->Size(); ++i)
+    {
+        if (activeMasks[i] > 0.0f)
+        {
+            const float passedLifeTime =
+                (totalLifeTimes[i] - remainingLifeTimes[i]);
+            const uint animationFrame =
+                SCAST<uint>(passedLifeTime * params.animationSpeed);
+            currentFrames[i] = animationFrame % numFrames;
+        }
+    }
+}
+
+template <Particle::PhysicsStepMode StepMode>
+void IntegrateAxis(uint numParticles,
+                   float dt,
+                   float damping,
+                   float gravityForce,
+                   const float *activeMasks,
+                   const float *prevDeltaTimesSecs,
+                   const float *extraForces,
+                   const float *frictionForces,
+                   float *prevPositions,
+                   float *positions,
+                   float *velocities)
+{
+    for (uint i = 0; i < numParticles; ++i)
+    {
+        // Unit mass, so the acceleration is the net force
+        const float acc = gravityForce + frictionForces[i] + extraForces[i];
+        const float prevPos = positions[i];
+        const float prevVelocity = velocities[i];
+
+        // StepMode is a constant, so the switch is resolved at compile time
+        float newPos = prevPos;
+        float newVelocity = prevVelocity;
+        switch (StepMode)
+        {
+            case Particle::PhysicsStepMode::EULER:
+                newPos = prevPos + (prevVelocity * dt);
+                newVelocity = (prevVelocity + (acc * dt)) * damping;
+                break;
+
+            case Particle::PhysicsStepMode::EULER_SEMI:
+                newVelocity = (prevVelocity + (acc * dt)) * damping;
+                newPos = prevPos + (newVelocity * dt);
+                break;
+
+            case Particle::PhysicsStepMode::VERLET:
+            {
+                const float timeStepRatio = (dt / prevDeltaTimesSecs[i]);
+                const float disp =
+                    timeStepRatio * (prevPos - prevPositions[i]) +
+                    (acc * (dt * dt));
+                newPos = prevPos + disp * damping;
+                newVelocity = (newPos - prevPos) / dt;
+            }
+            break;
+        }
+
+        const bool active = (activeMasks[i] > 0.0f);
+        positions[i] = active ? newPos : prevPos;
+        velocities[i] = active ? newVelocity : prevVelocity;
+        prevPositions[i] = active ? prevPos : prevPositions[i];
+    }
+}
+
+template <Particle::PhysicsStepMode StepMode>
+void IntegrateParticles(Particle::Streams *streams,
+                        float dt,
+                        const Particle::Parameters &params)
+{
+    const uint numParticles = streams->Size();
+    const float *activeMasks = streams->activeMasks.Data();
+    const Vector3 gravityForce = Particle::Data().GetGravityForce(params);
+    float *prevDeltaTimesSecs = streams->prevDeltaTimesSecs.Data();
+    IntegrateAxis<StepMode>(numParticles,
+                            dt,
+                            params.damping,
+                            gravityForce.x,
+                            activeMasks,
+                            prevDeltaTimesSecs,
+                            streams->extraForces.x.Data(),
+                            streams->frictionForces.x.Data(),
+                            streams->prevPositions.x.Data(),
+                            streams->positions.x.Data(),
+                            streams->velocities.x.Data());
+    IntegrateAxis<StepMode>(numParticles,
+                            dt,
+                            params.damping,
+                            gravityForce.y,
+                            activeMasks,
+                            prevDeltaTimesSecs,
+                            streams->extraForces.y.Data(),
+                            streams->frictionForces.y.Data(),
+                            streams->prevPositions.y.Data(),
+                            streams->positions.y.Data(),
+                            streams->velocities.y.Data());
+    IntegrateAxis<StepMode>(numParticles,
+                            dt,
+                            params.damping,
+                            gravityForce.z,
+                            activeMasks,
+                            prevDeltaTimesSecs,
+                            streams->extraForces.z.Data(),
+                            streams->frictionForces.z.Data(),
+                            streams->prevPositions.z.Data(),
+                            streams->positions.z.Data(),
+                            streams->velocities.z.Data());
+
+    // Collisions are solved after this, and they start from no friction
+    float *frictionForcesX = streams->frictionForces.x.Data();
+    float *frictionForcesY = streams->frictionForces.y.Data();
+    float *frictionForcesZ = streams->frictionForces.z.Data();
+    for (uint i = 0; i < numParticles; ++i)
+    {
+        const bool active = (activeMasks[i] > 0.0f);
+        prevDeltaTimesSecs[i] = active ? dt : prevDeltaTimesSecs[i];
+        frictionForcesX[i] = active ? 0.0f : frictionForcesX[i];
+        frictionForcesY[i] = active ? 0.0f : frictionForcesY[i];
+        frictionForcesZ[i] = active ? 0.0f : frictionForcesZ[i];
+    }
+}
+}
+
+void Particle::Step(Particle::Streams *particlesStreams,
+                    Time dt,
+                    const Particle::Parameters &params)
+{
+    const float dtSecs = SCAST<float>(dt.GetSeconds());
+
+    StepLifeTimes(particlesStreams, dtSecs);
+    StepRenderData(particlesStreams, params);
+    switch (params.physicsStepMode)
+    {
+        case Particle::PhysicsStepMode::EULER:
+            IntegrateParticles<Particle::PhysicsStepMode::EULER>(
+                particlesStreams, dtSecs, params);
+            break;
+
+        case Particle::PhysicsStepMode::EULER_SEMI:
+            IntegrateParticles<Particle::PhysicsStepMode::EULER_SEMI>(
+                particlesStreams, dtSecs, params);
+            break;
+
+        case Particle::PhysicsStepMode::VERLET:
+            IntegrateParticles<Particle::PhysicsStepMode::VERLET>(
+                particlesStreams, dtSecs, params);
+            break;
+    }
+    Particle::CorrectParticlesCollisions(particlesStreams, dtSecs, params);
+}
+
 void Particle::Step(Particle::Data *pData_, Time dt, const Parameters &params)
 {
     float dtSecs = SCAST<float>(dt.GetSeconds());
@@ -76,36 +267,86 @@ void Particle::CorrectParticleCollisions(Particle::Data *pData,
     pData->frictionForce = Vector3::Zero();
     if (params.computeCollisions && params.colliders.Size() >= 1)
     {
-        Vector3 pPrevPos = pData->prevPosition;
-        for (Collider *collider : params.colliders)
+        CollideParticleWithColliders(params,
+                                     dtSecs,
+                                     pData->GetGravityForce(params),
+                                     &pData->prevPosition,
+                                     &pData->position,
+                                     &pData->velocity,
+                                     &pData->frictionForce);
+    }
+}
+
+void Particle::CorrectParticlesCollisions(Particle::Streams *particlesStreams,
+                                          float dtSecs,
+                                          const Particle::Parameters &params)
+{
+    if (!params.computeCollisions || params.colliders.Size() == 0)
+    {
+        return;
+    }
+
+    Particle::Streams &streams = *particlesStreams;
+    const Vector3 gravityForce = Particle::Data().GetGravityForce(params);
+    for (uint i = 0; i < streams.Size(); ++i)
+    {
+        if (streams.activeMasks[i] > 0.0f)
         {
-            if (collider->IsEnabledRecursively())
+            Vector3 prevPosition = streams.prevPositions.Get(i);
+            Vector3 position = streams.positions.Get(i);
+            Vector3 velocity = streams.velocities.Get(i);
+            Vector3 frictionForce = streams.frictionForces.Get(i);
+            CollideParticleWithColliders(params,
+                                         dtSecs,
+                                         gravityForce,
+                                         &prevPosition,
+                                         &position,
+                                         &velocity,
+                                         &frictionForce);
+            streams.prevPositions.Set(i, prevPosition);
+            streams.positions.Set(i, position);
+            streams.velocities.Set(i, velocity);
+            streams.frictionForces.Set(i, frictionForce);
+        }
+    }
+}
+
+void Particle::CollideParticleWithColliders(const Particle::Parameters &params,
+                                            float dtSecs,
+                                            const Vector3 &particleGravityForce,
+                                            Vector3 *prevPosition,
+                                            Vector3 *position,
+                                            Vector3 *velocity,
+                                            Vector3 *frictionForce)
+{
+    Vector3 pPrevPos = *prevPosition;
+    for (Collider *collider : params.colliders)
+    {
+        if (collider->IsEnabledRecursively())
+        {
+            const Vector3 pPositionWithoutCollide = *position;
+            const Vector3 pVelocityWithoutCollide = *velocity;
+
+            Vector3 posAfterCollision;
+            Vector3 velocityAfterCollision;
+            Vector3 collisionFrictionForce;
+            const bool collided = CollideParticle(collider,
+                                                  params,
+                                                  pPrevPos,
+                                                  pPositionWithoutCollide,
+                                                  pVelocityWithoutCollide,
+                                                  particleGravityForce,
+                                                  &posAfterCollision,
+                                                  &velocityAfterCollision,
+                                                  &collisionFrictionForce);
+            if (collided)
             {
-                const Vector3 pPositionWithoutCollide = pData->position;
-                const Vector3 pVelocityWithoutCollide = pData->velocity;
-
-                Vector3 posAfterCollision;
-                Vector3 velocityAfterCollision;
-                Vector3 frictionForce;
-                const bool collided =
-                    CollideParticle(collider,
-                                    params,
-                                    pPrevPos,
-                                    pPositionWithoutCollide,
-                                    pVelocityWithoutCollide,
-                                    pData->GetGravityForce(params),
-                                    &posAfterCollision,
-                                    &velocityAfterCollision,
-                                    &frictionForce);
-                if (collided)
-                {
-                    pPrevPos = pData->position;
-                    pData->prevPosition =
-                        posAfterCollision - (velocityAfterCollision * dtSecs);
-                    pData->position = posAfterCollision;
-                    pData->velocity = velocityAfterCollision;
-                    pData->frictionForce += frictionForce;
-                }
+                pPrevPos = *position;
+                *prevPosition =
+                    posAfterCollision - (velocityAfterCollision * dtSecs);
+                *position = posAfterCollision;
+                *velocity = velocityAfterCollision;
+                *frictionForce += collisionFrictionForce;
             }
         }
     }
@@ -188,6 +429,65 @@ void Particle::FixedStepAll(
         });
 }
 
+void Particle::FixedStepAll(
+    Particle::Streams *particlesStreams,
+    Time totalDeltaTime,
+    Time fixedStepDeltaTime,
+    const Particle::Parameters &params,
+    std::function<void(uint, const Particle::Parameters &)> initParticleFunc)
+{
+    Particle::FixedStepAll(particlesStreams,
+                           totalDeltaTime,
+                           fixedStepDeltaTime,
+                           params,
+                           initParticleFunc,
+                           [](Time) {});
+}
+
+void Particle::FixedStepAll(
+    Particle::Streams *particlesStreams,
+    Time totalDeltaTime,
+    Time fixedStepDeltaTime,
+    const Particle::Parameters &params,
+    std::function<void(uint, const Particle::Parameters &)> initParticleFunc,
+    std::function<void(Time dt)> extraFuncToExecuteBeforeEveryStep)
+{
+    Particle::FixedStepAll(particlesStreams,
+                           totalDeltaTime,
+                           fixedStepDeltaTime,
+                           params,
+                           initParticleFunc,
+                           extraFuncToExecuteBeforeEveryStep,
+                           [](Time) {});
+}
+
+void Particle::FixedStepAll(
+    Particle::Streams *particlesStreams,
+    Time totalDeltaTime,
+    Time fixedStepDeltaTime,
+    const Particle::Parameters &params,
+    std::function<void(uint, const Particle::Parameters &)> initParticleFunc,
+    std::function<void(Time dt)> extraFuncToExecuteBeforeEveryStep,
+    std::function<void(Time dt)> extraFuncToExecuteAfterEveryStep)
+{
+    Particle::ExecuteFixedStepped(
+        totalDeltaTime, fixedStepDeltaTime, [&](Time dt) {
+            extraFuncToExecuteBeforeEveryStep(dt);
+            Particle::Step(particlesStreams, dt, params);
+
+            const Particle::Streams &streams = *particlesStreams;
+            for (uint i = 0; i < streams.Size(); ++i)
+            {
+                if (streams.remainingStartTimes[i] <= 0.0f &&
+                    streams.remainingLifeTimes[i] <= 0.0f)
+                {
+                    initParticleFunc(i, params);
+                }
+            }
+            extraFuncToExecuteAfterEveryStep(dt);
+        });
+}
+
 void Particle::StepPositionAndVelocity(Particle::Data *pData,
                                        float dt,
                                        const Parameters &params)
@@ -285,19 +585,23 @@ bool Particle::CollideParticle(Collider *collider,
             MeshCollider *meshCol = SCAST<MeshCollider *>(collider);
             if (Mesh *mesh = meshCol->GetMesh())
             {
-                for (uint triIdx = 0; triIdx < mesh->GetNumTriangles();
-                     ++triIdx)
+                // The mesh BVH is in the collider local space
+                Transform *tr = collider->GetGameObject()->GetTransform();
+                const Segment localDispSegment(
+                    tr->FromWorldToLocalPoint(dispSegment.GetOrigin()),
+                    tr->FromWorldToLocalPoint(dispSegment.GetDestiny()));
+
+                Vector3 localCollisionPoint;
+                Mesh::TriangleId triId;
+                collided = mesh->GetTriangleBVH().IntersectSegment(
+                    localDispSegment, &localCollisionPoint, &triId);
+                if (collided)
                 {
-                    Triangle tri = mesh->GetTriangle(triIdx);
-                    Transform *tr = collider->GetGameObject()->GetTransform();
-                    tri = tr->GetLocalToWorldMatrix() * tri;
-
-                    Geometry::IntersectSegmentTriangle(
-                        dispSegment, tri, &collided, &collisionPoint);
-                    if (collided)
-                    {
-                        collisionNormal = tri.GetNormal();
-                    }
+                    const Triangle tri = tr->GetLocalToWorldMatrix() *
+                                         mesh->GetTriangle(triId);
+                    collisionPoint =
+                        tr->FromLocalToWorldPoint(localCollisionPoint);
+                    collisionNormal = tri.GetNormal();
                 }
             }
         }
@@ -352,3 +656,90 @@ Vector3 Particle::Data::GetGravityForce(
     Physics *ph = Physics::GetInstance();
     return ph->GetGravity() * params.gravityMultiplier;
 }
+
+void Particle::Vector3Stream::Resize(uint size)
+{
+    x.Resize(size);
+    y.Resize(size);
+    z.Resize(size);
+}
+
+Vector3 Particle::Vector3Stream::Get(uint i) const
+{
+    return Vector3(x[i], y[i], z[i]);
+}
+
+void Particle::Vector3Stream::Set(uint i, const Vector3 &v)
+{
+    x[i] = v.x;
+    y[i] = v.y;
+    z[i] = v.z;
+}
+
+void Particle::Streams::Resize(uint size)
+{
+    prevPositions.Resize(size);
+    positions.Resize(size);
+    velocities.Resize(size);
+    extraForces.Resize(size);
+    frictionForces.Resize(size);
+    startColors.Resize(size);
+    endColors.Resize(size);
+    currentColors.Resize(size);
+    totalLifeTimes.Resize(size);
+    remainingLifeTimes.Resize(size);
+    remainingStartTimes.Resize(size);
+    prevDeltaTimesSecs.Resize(size);
+    sizes.Resize(size);
+    currentFrames.Resize(size);
+    activeMasks.Resize(size);
+}
+
+uint Particle::Streams::Size() const
+{
+    return positions.x.Size();
+}
+
+bool Particle::Streams::IsActive(uint i) const
+{
+    return (remainingLifeTimes[i] > 0.0f && remainingStartTimes[i] <= 0.0f);
+}
+
+Particle::Data Particle::Streams::Get(uint i) const
+{
+    Particle::Data pData;
+    pData.prevPosition = prevPositions.Get(i);
+    pData.position = positions.Get(i);
+    pData.velocity = velocities.Get(i);
+    pData.extraForce = extraForces.Get(i);
+    pData.frictionForce = frictionForces.Get(i);
+    pData.startColor = startColors[i];
+    pData.endColor = endColors[i];
+    pData.currentColor = currentColors[i];
+    pData.totalLifeTime = totalLifeTimes[i];
+    pData.remainingLifeTime = remainingLifeTimes[i];
+    pData.remainingStartTime = remainingStartTimes[i];
+    pData.prevDeltaTimeSecs = prevDeltaTimesSecs[i];
+    pData.size = sizes[i];
+    pData.currentFrame = currentFrames[i];
+    return pData;
+}
+
+void Particle::Streams::Set(uint i, const Particle::Data &pData)
+{
+    prevPositions.Set(i, pData.prevPosition);
+    positions.Set(i, pData.position);
+    velocities.Set(i, pData.velocity);
+    extraForces.Set(i, pData.extraForce);
+    frictionForces.Set(i, pData.frictionForce);
+    startColors[i] = pData.startColor;
+    endColors[i] = pData.endColor;
+    currentColors[i] = pData.currentColor;
+    totalLifeTimes[i] = pData.totalLifeTime;
+    remainingLifeTimes[i] = pData.remainingLifeTime;
+    remainingStartTimes[i] = pData.remainingStartTime;
+    prevDeltaTimesSecs[i] = pData.prevDeltaTimeSecs;
+    sizes[i] = pData.size;
+    currentFrames[i] = pData.currentFrame;
+    activeMasks[i] = 0.0f;
+}
@@ -9,6 +9,7 @@
 #include "Bang/Assets.tcc"
 #include "Bang/Camera.h"
 #include "Bang/ClassDB.h"
+#include "Bang/Collider.h"
 #include "Bang/Component.h"
 #include "Bang/Flags.h"
 #include "Bang/GL.h"
@@ -41,6 +42,12 @@ class Serializable;
 
 using namespace Bang;
 
+namespace
+{
+// Covers the push out of the colliders, see Particle::CollideParticle
+constexpr float CollidersCullingMargin = 0.5f;
+}
+
 ParticleSystem::ParticleSystem()
 {
     SET_INSTANCE_CLASS_ID(ParticleSystem);
@@ -81,6 +88,7 @@ void ParticleSystem::OnStart()
     {
         m_isEmitting = false;
     }
+    PropagateRendererChanged();
 }
 
 void ParticleSystem::OnUpdate()
@@ -90,32 +98,32 @@ void ParticleSystem::OnUpdate()
     if (m_isEmitting)
     {
         Physics *ph = Physics::GetInstance();
-        m_particlesParameters.colliders =
+        const Array<Collider *> &sceneColliders =
             ph->GetPxSceneContainerFromScene(GetGameObject()->GetScene())
                 ->GetColliders();
 
+        const AABox prevAABox = m_aabox;
         Time fixedDeltaTime =
             Time::Seconds(1.0f / Math::Max(m_stepsPerSecond, 1u));
         Particle::FixedStepAll(
-            &m_particlesData,
+            &m_particlesStreams,
             Time::GetDeltaTime(),
             fixedDeltaTime,
             m_particlesParameters,
             [this](uint i, const Particle::Parameters &params) {
                 InitParticle(i, params);
-            });
+            },
+            [this, &sceneColliders](Time dt) {
+                CullColliders(sceneColliders, dt);
+            },
+            [this](Time) { UpdateParticlesBounds(); });
+
+        UpdateDataVBO();
 
-        // AABBox
+        if (m_aabox != prevAABox)
         {
-            Array<Vector3> particlePositions;
-            for (uint i = 0; i < GetNumParticles(); ++i)
-            {
-                particlePositions.PushBack(m_particlesData[i].position);
-            }
-            m_aabox.CreateFromPositions(particlePositions.GetVector());
+            PropagateRendererChanged();
         }
-
-        UpdateDataVBO();
     }
 }
 
@@ -126,6 +134,9 @@ void ParticleSystem::Reset()
         InitParticle(i, GetParticlesParameters());
     }
     UpdateDataVBO();
+
+    UpdateParticlesBounds();
+    PropagateRendererChanged();
 }
 
 void ParticleSystem::SetMesh(Mesh *mesh)
@@ -295,13 +306,15 @@ void ParticleSystem::SetNumParticles(uint numParticles)
 
         // Resize arrays
         m_particlesVBOData.Resize(GetNumParticles());
-        m_particlesData.Resize(GetNumParticles());
+        m_particlesStreams.Resize(GetNumParticles());
 
         // Initialize values
         for (uint i = prevNumParticles; i < GetNumParticles(); ++i)
         {
             InitParticle(i, GetParticlesParameters());
         }
+        UpdateParticlesBounds();
+        PropagateRendererChanged();
 
         // Initialize VBOs
         p_particleDataVBO->CreateAndFill(
@@ -539,7 +552,7 @@ void ParticleSystem::InitParticle(uint i, const Particle::Parameters &params)
     ASSERT(i >= 0);
     ASSERT(i < GetNumParticles());
 
-    Particle::Data &particleData = m_particlesData[i];
+    Particle::Data particleData;
     particleData.position = GetParticleInitialPosition();
     particleData.velocity = GetParticleInitialVelocity();
     particleData.prevPosition = particleData.position - particleData.velocity;
@@ -553,12 +566,97 @@ void ParticleSystem::InitParticle(uint i, const Particle::Parameters &params)
 
     particleData.currentColor = particleData.startColor;
     particleData.currentFrame = 0;
+
+    m_particlesStreams.Set(i, particleData);
 }
 
 bool ParticleSystem::IsParticleActive(uint i) const
 {
-    return (m_particlesData[i].remainingLifeTime > 0 &&
-            m_particlesData[i].remainingStartTime <= 0);
+    return m_particlesStreams.IsActive(i);
+}
+
+void ParticleSystem::ComputeParticlesBounds(AABox *aaBox,
+                                            float *maxSpeed,
+                                            float *maxExtraForce) const
+{
+    if (GetNumParticles() == 0)
+    {
+        *aaBox = AABox::Empty();
+        *maxSpeed = 0.0f;
+        *maxExtraForce = 0.0f;
+        return;
+    }
+
+    const Particle::Vector3Stream &positions = m_particlesStreams.positions;
+    const Particle::Vector3Stream &velocities = m_particlesStreams.velocities;
+    const Particle::Vector3Stream &extraForces =
+        m_particlesStreams.extraForces;
+    Vector3 minPosition = positions.Get(0);
+    Vector3 maxPosition = minPosition;
+    float maxSqSpeed = 0.0f;
+    float maxSqExtraForce = 0.0f;
+    for (uint i = 0; i < GetNumParticles(); ++i)
+    {
+        minPosition.x = Math::Min(minPosition.x, positions.x[i]);
+        minPosition.y = Math::Min(minPosition.y, positions.y[i]);
+        minPosition.z = Math::Min(minPosition.z, positions.z[i]);
+        maxPosition.x = Math::Max(maxPosition.x, positions.x[i]);
+        maxPosition.y = Math::Max(maxPosition.y, positions.y[i]);
+        maxPosition.z = Math::Max(maxPosition.z, positions.z[i]);
+
+        const float sqSpeed = (velocities.x[i] * velocities.x[i]) +
+                              (velocities.y[i] * velocities.y[i]) +
+                              (velocities.z[i] * velocities.z[i]);
+        maxSqSpeed = Math::Max(maxSqSpeed, sqSpeed);
+
+        const float sqExtraForce = (extraForces.x[i] * extraForces.x[i]) +
+                                   (extraForces.y[i] * extraForces.y[i]) +
+                                   (extraForces.z[i] * extraForces.z[i]);
+        maxSqExtraForce = Math::Max(maxSqExtraForce, sqExtraForce);
+    }
+
+    *aaBox = AABox(minPosition, maxPosition);
+    *maxSpeed = Math::Sqrt(maxSqSpeed);
+    *maxExtraForce = Math::Sqrt(maxSqExtraForce);
+}
+
+void ParticleSystem::UpdateParticlesBounds()
+{
+    ComputeParticlesBounds(
+        &m_aabox, &m_particlesMaxSpeed, &m_particlesMaxExtraForce);
+}
+
+void ParticleSystem::CullColliders(const Array<Collider *> &sceneColliders,
+                                   Time dt)
+{
+    Array<Collider *> &colliders = m_particlesParameters.colliders;
+    colliders.Clear();
+    if (!GetComputeCollisions() || sceneColliders.IsEmpty())
+    {
+        return;
+    }
+
+    // Grow the bounds left by the previous step by as much as a particle
+    // can move in this one
+    const float dtSecs = SCAST<float>(dt.GetSeconds());
+    const Particle::Data defaultParticleData;
+    const float gravityForceLength =
+        defaultParticleData.GetGravityForce(GetParticlesParameters()).Length();
+    const float maxForce = gravityForceLength + m_particlesMaxExtraForce;
+    const Vector3 displacement(m_particlesMaxSpeed * dtSecs +
+                               maxForce * dtSecs * dtSecs +
+                               CollidersCullingMargin);
+    const AABox stepAABox(m_aabox.GetMin() - displacement,
+                          m_aabox.GetMax() + displacement);
+
+    for (Collider *collider : sceneColliders)
+    {
+        if (collider->IsEnabledRecursively() &&
+            collider->GetAABBoxWorld().CheckCollision(stepAABox))
+        {
+            colliders.PushBack(collider);
+        }
+    }
 }
 
 void ParticleSystem::RecreateVAOForMesh()
@@ -720,14 +818,14 @@ void ParticleSystem::UpdateDataVBO()
 {
     for (uint i = 0; i < GetNumParticles(); ++i)
     {
-        const Particle::Data &pData = m_particlesData[i];
         if (IsParticleActive(i))
         {
-            m_particlesVBOData[i].position = pData.position;
-            m_particlesVBOData[i].size = pData.size;
-            m_particlesVBOData[i].color = pData.currentColor;
+            const Particle::Streams &streams = m_particlesStreams;
+            m_particlesVBOData[i].position = streams.positions.Get(i);
+            m_particlesVBOData[i].size = streams.sizes[i];
+            m_particlesVBOData[i].color = streams.currentColors[i];
             m_particlesVBOData[i].animationFrame =
-                SCAST<float>(pData.currentFrame);
+                SCAST<float>(streams.currentFrames[i]);
         }
         else
         {
@@ -79,7 +79,11 @@ AARect PointLight::GetRenderRect(Camera *cam) const
 
 void PointLight::SetRange(float range)
 {
-    m_range = range;
+    if (range != GetRange())
+    {
+        m_range = range;
+        PropagateBoundsChanged();
+    }
 }
 
 void PointLight::SetShadowNearPlane(float nearPlane)
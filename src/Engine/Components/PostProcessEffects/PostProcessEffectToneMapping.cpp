@@ -9,6 +9,8 @@ using namespace Bang;
 
 PostProcessEffectToneMapping::PostProcessEffectToneMapping()
 {
+    SET_INSTANCE_CLASS_ID(PostProcessEffectToneMapping);
+
     m_toneMappingShaderProgram.Set(ShaderProgramFactory::Get(
         ShaderProgramFactory::GetScreenPassVertexShaderPath(),
         ShaderProgramFactory::GetEngineShadersDir().Append(
@@ -529,6 +529,10 @@ void RectTransform::CalculateLocalToParentMatrix() const
                             Matrix4::RotateMatrix(GetLocalRotation()) *
                             Matrix4::ScaleMatrix(GetLocalScale()) *
                             translateToPivot;
+}
+
+void RectTransform::CalculateParentToLocalMatrix() const
+{
     m_parentToLocalMatrix = m_localToParentMatrix.Inversed();
 }
 
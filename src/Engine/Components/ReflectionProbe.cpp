@@ -386,10 +386,15 @@ void ReflectionProbe::Reflect()
                                    BANG_REFLECT_HINT_MIN_VALUE(Vector2i(0)));
     BANG_REFLECT_VAR_MEMBER(
         ReflectionProbe, "Filter for IBL", SetFilterForIBL, GetFilterForIBL);
-    ReflectVar<float>("Rest time",
-                      [this](float seconds) { SetRestTimeSeconds(seconds); },
-                      [this]() { return GetRestTime().GetSeconds(); },
-                      BANG_REFLECT_HINT_MIN_VALUE(0.0f));
+    ReflectVar<ReflectionProbe, float>(
+        "Rest time",
+        [](ReflectionProbe *rp, float seconds) {
+            rp->SetRestTimeSeconds(seconds);
+        },
+        [](const ReflectionProbe *rp) -> float {
+            return rp->GetRestTime().GetSeconds();
+        },
+        BANG_REFLECT_HINT_MIN_VALUE(0.0f));
 
     BANG_REFLECT_VAR_MEMBER(
         ReflectionProbe, "Is Boxed", SetIsBoxed, GetIsBoxed);
@@ -398,10 +403,14 @@ void ReflectionProbe::Reflect()
     BANG_REFLECT_VAR_MEMBER(
         ReflectionProbe, "ZFar", SetCamerasZFar, GetCamerasZFar);
 
-    ReflectVar<uint>(
+    ReflectVar<ReflectionProbe, uint>(
         "Clear mode",
-        [this](uint x) { SetCamerasClearMode(SCAST<CameraClearMode>(x)); },
-        [this]() { return SCAST<uint>(GetCamerasClearMode()); });
+        [](ReflectionProbe *rp, uint x) {
+            rp->SetCamerasClearMode(SCAST<CameraClearMode>(x));
+        },
+        [](const ReflectionProbe *rp) {
+            return SCAST<uint>(rp->GetCamerasClearMode());
+        });
 
     BANG_REFLECT_HINT_ENUM_FIELD_VALUE(
         "Clear mode", "Color", CameraClearMode::COLOR);
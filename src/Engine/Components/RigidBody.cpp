@@ -283,10 +283,12 @@ void RigidBody::Reflect()
     // BANG_REFLECT_VAR_MEMBER_ENUM_FLAGS(
     //     RigidBody, "Constraints", SetConstraints, GetConstraints);
 
-    ReflectVarEnum<FlagsPrimitiveType>(
+    ReflectVar<RigidBody, FlagsPrimitiveType>(
         "Constraints",
-        [this](const FlagsPrimitiveType &x) { SetConstraints(x); },
-        [this]() { return SCAST<FlagsPrimitiveType>(GetConstraints()); },
+        [](RigidBody *rb, FlagsPrimitiveType x) { rb->SetConstraints(x); },
+        [](const RigidBody *rb) {
+            return SCAST<FlagsPrimitiveType>(rb->GetConstraints());
+        },
         BANG_REFLECT_HINT_ENUM_FLAGS(true));
 
     BANG_REFLECT_HINT_ENUM_FIELD_VALUE(
@@ -96,6 +96,7 @@ void Rope::OnUpdate()
     }
 
     m_validLineRendererPoints = false;
+    PropagateRendererChanged();
 }
 
 void Rope::Bind()
@@ -204,6 +205,7 @@ void Rope::SetNumPoints(uint numPoints_)
         m_validLineRendererPoints = false;
 
         Reset();
+        PropagateRendererChanged();
     }
 }
 
@@ -222,6 +224,7 @@ void Rope::SetPoints(const Array<Vector3> &points)
     m_points = points;
     m_validLineRendererPoints = false;
     SetNumPoints(points.Size());
+    PropagateRendererChanged();
 }
 
 void Rope::SetSeeDebugPoints(bool seeDebugPoints)
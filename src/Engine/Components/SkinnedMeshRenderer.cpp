@@ -12,6 +12,7 @@
 #include "Bang/GameObject.h"
 #include "Bang/IEventsName.h"
 #include "Bang/IEventsObjectGatherer.h"
+#include "Bang/JobSystem.h"
 #include "Bang/Map.tcc"
 #include "BangMath/Matrix4.h"
 #include "Bang/Mesh.h"
@@ -33,6 +34,13 @@ class Asset;
 
 using namespace Bang;
 
+namespace
+{
+// Below this, skinning is cheaper than splitting it in jobs
+constexpr uint ParallelSkinningMinSize = 4096;
+constexpr uint ParallelSkinningGrainSize = 1024;
+}
+
 SkinnedMeshRenderer::SkinnedMeshRenderer()
 {
     SET_INSTANCE_CLASS_ID(SkinnedMeshRenderer);
@@ -51,6 +59,15 @@ void SkinnedMeshRenderer::OnUpdate()
     Component::OnUpdate();
 }
 
+void SkinnedMeshRenderer::OnPostUpdate()
+{
+    Component::OnPostUpdate();
+
+    // After the animators and the physics have moved the bones, so that the
+    // render only has to upload the palette
+    UpdateBonesMatricesFromTransformMatrices();
+}
+
 Transformation SkinnedMeshRenderer::GetBoneTransformationFor(
     GameObject *boneGameObject,
     const Transformation &transformInBoneSpace,
@@ -122,21 +139,54 @@ void SkinnedMeshRenderer::SetBoneUniforms(ShaderProgram *sp)
 
 void SkinnedMeshRenderer::UpdateBonesMatricesFromTransformMatrices()
 {
-    Map<String, Matrix4> bonesMatrices;
-    UMap<GameObject *, Transformation> bonesTransformsCache;
-    Array<GameObject *> allBones = GetAllBoneGameObjects();
-    for (GameObject *boneGo : allBones)
+    if (!GetActiveMesh())
     {
-        const String &boneName = boneGo->GetName();
-        GameObject *boneGameObject = boneGo;
+        return;
+    }
+
+    BindBonesIfNeeded();
+
+    // Same as GetBoneTransformationFor on every bone, in one pass, since the
+    // parents are before their children
+    Array<Matrix4> &boneMatrices = m_bonesTransformsMatricesArrayUniform;
+    m_prevBonesTransformsMatrices = boneMatrices;
+    boneMatrices.Resize(Animator::MaxNumBones);
+    for (Matrix4 &boneMatrix : boneMatrices)
+    {
+        boneMatrix = Matrix4::Identity();
+    }
+
+    const Transformation identity = Transformation::Identity();
+    m_boneTransformsInRootSpace.Resize(m_boneBindings.Size());
+    for (uint i = 0; i < m_boneBindings.Size(); ++i)
+    {
+        const BoneBinding &binding = m_boneBindings[i];
         const Transformation &localToParent =
-            boneGameObject->GetTransform()->GetLocalTransformation();
-        Transformation boneTransformMatrix = GetBoneTransformationFor(
-            boneGameObject, localToParent, &bonesTransformsCache);
+            binding.gameObject->GetTransform()->GetLocalTransformation();
+        const Transformation &parentBoneTransformInRootSpace =
+            (binding.parentBindingIndex >= 0)
+                ? m_boneTransformsInRootSpace[binding.parentBindingIndex]
+                : identity;
+
+        Transformation &boneTransformInRootSpace =
+            m_boneTransformsInRootSpace[i];
+        boneTransformInRootSpace = parentBoneTransformInRootSpace *
+                                   binding.parentBoneSpaceToRootSpace *
+                                   localToParent *
+                                   binding.rootSpaceToBoneSpace;
+
+        if (binding.boneMatrixIndex >= 0)
+        {
+            boneMatrices[binding.boneMatrixIndex] =
+                boneTransformInRootSpace.GetMatrix();
+        }
+    }
 
-        bonesMatrices.Add(boneName, boneTransformMatrix.GetMatrix());
+    // The bounds follow the bones, so the spatial index has to refit them
+    if (boneMatrices != m_prevBonesTransformsMatrices)
+    {
+        PropagateRendererChanged();
     }
-    SetSkinnedMeshRendererCurrentBoneMatrices(bonesMatrices);
 }
 
 void SkinnedMeshRenderer::OnRender()
@@ -152,7 +202,6 @@ void SkinnedMeshRenderer::Bind()
 void SkinnedMeshRenderer::SetUniformsOnBind(ShaderProgram *sp)
 {
     MeshRenderer::SetUniformsOnBind(sp);
-    UpdateBonesMatricesFromTransformMatrices();
     SetBoneUniforms(sp);
 }
 
@@ -164,6 +213,7 @@ void SkinnedMeshRenderer::SetRootBoneGameObjectName(
         p_rootBoneGameObject = nullptr;  // Reset cached root bone gameObject
         m_rootBoneGameObjectName = rootBoneGameObjectName;
         m_gameObjectGatherer->SetRoot(GetRootBoneGameObject());
+        InvalidateBoneBindings();
         UpdateBonesMatricesFromTransformMatrices();
     }
 }
@@ -180,22 +230,10 @@ Model *SkinnedMeshRenderer::GetActiveModel() const
     return nullptr;
 }
 
-Array<GameObject *> SkinnedMeshRenderer::GetAllBoneGameObjects() const
+const Array<GameObject *> &SkinnedMeshRenderer::GetAllBoneGameObjects() const
 {
-    Array<GameObject *> allBones;
-    if (GetRootBoneGameObject())
-    {
-        Array<GameObject *> allRootGoChildren =
-            GetRootBoneGameObject()->GetDescendants();
-        for (GameObject *rootBoneChild : allRootGoChildren)
-        {
-            if (m_boneNames.Contains(rootBoneChild->GetName()))
-            {
-                allBones.PushBack(rootBoneChild);
-            }
-        }
-    }
-    return allBones;
+    BindBonesIfNeeded();
+    return m_boneGameObjects;
 }
 
 GameObject *SkinnedMeshRenderer::GetRootBoneGameObject() const
@@ -277,6 +315,11 @@ void SkinnedMeshRenderer::SetSkinnedMeshRendererCurrentBoneMatrices(
     m_bonesTransformsMatricesArrayUniform = boneMatrices;
 }
 
+const Array<Matrix4> &SkinnedMeshRenderer::GetBoneMatrices() const
+{
+    return m_bonesTransformsMatricesArrayUniform;
+}
+
 void SkinnedMeshRenderer::ResetBoneTransformation(GameObject *boneGo)
 {
     if (Model *model = GetActiveModel())
@@ -319,8 +362,91 @@ void SkinnedMeshRenderer::ResetBoneTransformations()
     }
 }
 
+void SkinnedMeshRenderer::ComputeSkinnedPositions(
+    Array<Vector3> *skinnedPositions) const
+{
+    skinnedPositions->Clear();
+    if (Mesh *mesh = GetActiveMesh())
+    {
+        SkinPositions(mesh->GetPositionsPool(),
+                      mesh->GetVertexBonesIdsPool(),
+                      mesh->GetVertexBonesWeightsPool(),
+                      GetBoneMatrices(),
+                      skinnedPositions);
+    }
+}
+
+AABox SkinnedMeshRenderer::ComputeSkinnedAABBox() const
+{
+    Array<Vector3> skinnedPositions;
+    ComputeSkinnedPositions(&skinnedPositions);
+    if (skinnedPositions.IsEmpty())
+    {
+        return AABox::Empty();
+    }
+
+    AABox skinnedAABox;
+    skinnedAABox.CreateFromPositions(skinnedPositions);
+    return skinnedAABox;
+}
+
+void SkinnedMeshRenderer::SkinPositions(
+    const Array<Vector3> &positions,
+    const Array<std::array<int, 4>> &bonesIds,
+    const Array<std::array<float, 4>> &bonesWeights,
+    const Array<Matrix4> &boneMatrices,
+    Array<Vector3> *skinnedPositions)
+{
+    const uint numPositions = positions.Size();
+    const uint numSkinnedPositions = Math::Min(
+        numPositions, Math::Min(bonesIds.Size(), bonesWeights.Size()));
+    const int numBoneMatrices = SCAST<int>(boneMatrices.Size());
+    skinnedPositions->Resize(numPositions);
+
+    // Positions without bones are left as they are
+    for (uint i = numSkinnedPositions; i < numPositions; ++i)
+    {
+        (*skinnedPositions)[i] = positions[i];
+    }
+
+    auto SkinRange = [&](uint begin, uint end) {
+        for (uint i = begin; i < end; ++i)
+        {
+            const Vector4 position(positions[i], 1.0f);
+            const std::array<int, 4> &ids = bonesIds[i];
+            const std::array<float, 4> &weights = bonesWeights[i];
+
+            Vector4 skinnedPosition = Vector4::Zero();
+            for (uint j = 0; j < 4; ++j)
+            {
+                const int boneId = ids[j];
+                if (weights[j] != 0.0f && boneId >= 0 &&
+                    boneId < numBoneMatrices)
+                {
+                    skinnedPosition +=
+                        (boneMatrices[boneId] * position) * weights[j];
+                }
+            }
+            (*skinnedPositions)[i] = skinnedPosition.xyz();
+        }
+    };
+
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    const bool canRunInParallel = (jobSystem && jobSystem->GetNumWorkers() > 0);
+    if (canRunInParallel && numSkinnedPositions >= ParallelSkinningMinSize)
+    {
+        jobSystem->ParallelFor(
+            0, numSkinnedPositions, ParallelSkinningGrainSize, SkinRange);
+    }
+    else
+    {
+        SkinRange(0, numSkinnedPositions);
+    }
+}
+
 void SkinnedMeshRenderer::OnObjectGathered(GameObject *)
 {
+    InvalidateBoneBindings();
 }
 
 void SkinnedMeshRenderer::OnObjectUnGathered(GameObject *, GameObject *go)
@@ -330,6 +456,7 @@ void SkinnedMeshRenderer::OnObjectUnGathered(GameObject *, GameObject *go)
         p_rootBoneGameObject = nullptr;
     }
     m_boneNameToBoneGameObject.Remove(go->GetName());
+    InvalidateBoneBindings();
 }
 
 void SkinnedMeshRenderer::Reflect()
@@ -358,6 +485,8 @@ void SkinnedMeshRenderer::OnMeshLoaded(Mesh *)
             m_boneNames.Add(boneName);
         }
     }
+    InvalidateBoneBindings();
+    m_boneBoundsValid = false;
     UpdateBonesMatricesFromTransformMatrices();
 }
 
@@ -369,3 +498,225 @@ Matrix4 SkinnedMeshRenderer::GetModelMatrixUniform() const
                      ->GetLocalToWorldMatrix()
                : MeshRenderer::GetModelMatrixUniform();
 }
+
+AABox SkinnedMeshRenderer::GetAABBox() const
+{
+    Mesh *mesh = GetActiveMesh();
+    GameObject *rootBoneGo = GetRootBoneGameObject();
+    const Array<Matrix4> &boneMatrices = GetBoneMatrices();
+    if (!mesh || !rootBoneGo || !GetGameObject() || boneMatrices.IsEmpty() ||
+        mesh->GetVertexBonesIdsPool().IsEmpty())
+    {
+        return MeshRenderer::GetAABBox();
+    }
+
+    UpdateBoneBoundsIfNeeded();
+    const AABox skinnedAABoxInRootSpace =
+        SkinBoneBounds(m_boneBounds, boneMatrices);
+    if (skinnedAABoxInRootSpace == AABox::Empty())
+    {
+        return AABox::Empty();
+    }
+
+    // Rendered with the model matrix of the root bone, but the bounds are in
+    // the space of this GameObject
+    const Matrix4 rootBoneToLocal =
+        GetGameObject()->GetTransform()->GetWorldToLocalMatrix() *
+        rootBoneGo->GetTransform()->GetLocalToWorldMatrix();
+    return rootBoneToLocal * skinnedAABoxInRootSpace;
+}
+
+void SkinnedMeshRenderer::BindBonesIfNeeded() const
+{
+    if (m_boneBindingsValid && p_boneBindingsMesh == GetActiveMesh())
+    {
+        return;
+    }
+
+    // The bindings are invalidated with the changes the gatherer sees, so it
+    // must gather from the current root bone
+    GameObject *rootBoneGo = GetRootBoneGameObject();
+    if (m_gameObjectGatherer->GetRoot() != rootBoneGo)
+    {
+        m_gameObjectGatherer->SetRoot(rootBoneGo);
+    }
+
+    m_boneBindings.Clear();
+    m_boneGameObjects.Clear();
+    if (rootBoneGo)
+    {
+        Mesh *mesh = GetActiveMesh();
+        UMap<GameObject *, int> goToBindingIndex;
+        Array<GameObject *> rootBoneDescendants = rootBoneGo->GetDescendants();
+        for (GameObject *descendant : rootBoneDescendants)
+        {
+            const String &boneName = descendant->GetName();
+            if (!m_boneNames.Contains(boneName))
+            {
+                continue;
+            }
+
+            m_boneGameObjects.PushBack(descendant);
+
+            const int bindingIndex =
+                AddBoneBinding(descendant, &goToBindingIndex);
+            if (mesh)
+            {
+                auto it = mesh->GetBonesIds().Find(boneName);
+                if (it != mesh->GetBonesIds().End() &&
+                    it->second < SCAST<uint>(Animator::MaxNumBones))
+                {
+                    m_boneBindings[bindingIndex].boneMatrixIndex =
+                        SCAST<int>(it->second);
+                }
+            }
+        }
+    }
+
+    p_boneBindingsMesh = GetActiveMesh();
+    m_boneBindingsValid = true;
+}
+
+int SkinnedMeshRenderer::AddBoneBinding(
+    GameObject *go,
+    UMap<GameObject *, int> *goToBindingIndex) const
+{
+    auto it = goToBindingIndex->Find(go);
+    if (it != goToBindingIndex->End())
+    {
+        return it->second;
+    }
+
+    BoneBinding binding;
+    binding.gameObject = go;
+
+    // Same cases as in GetBoneTransformationFor. If the GameObject is not
+    // found by its name, its local transformation is used as it is.
+    const String &boneName = go->GetName();
+    if (GetBoneGameObject(boneName))
+    {
+        GameObject *parentGo = go->GetParent();
+        ASSERT(parentGo);
+        const String &parentName = parentGo->GetName();
+        if (GetBoneGameObject(parentName))
+        {
+            binding.parentBoneSpaceToRootSpace =
+                GetRootSpaceToBoneSpaceTransformation(parentName).Inversed();
+        }
+        binding.rootSpaceToBoneSpace =
+            GetRootSpaceToBoneSpaceTransformation(boneName);
+
+        if (parentGo != GetRootBoneGameObject())
+        {
+            binding.parentBindingIndex =
+                AddBoneBinding(parentGo, goToBindingIndex);
+        }
+    }
+
+    const int bindingIndex = SCAST<int>(m_boneBindings.Size());
+    m_boneBindings.PushBack(binding);
+    goToBindingIndex->Add(go, bindingIndex);
+    return bindingIndex;
+}
+
+void SkinnedMeshRenderer::InvalidateBoneBindings()
+{
+    m_boneBindingsValid = false;
+}
+
+void SkinnedMeshRenderer::UpdateBoneBoundsIfNeeded() const
+{
+    Mesh *mesh = GetActiveMesh();
+    if (m_boneBoundsValid && p_boneBoundsMesh == mesh)
+    {
+        return;
+    }
+
+    if (mesh)
+    {
+        ComputeBoneBounds(mesh->GetPositionsPool(),
+                          mesh->GetVertexBonesIdsPool(),
+                          mesh->GetVertexBonesWeightsPool(),
+                          &m_boneBounds);
+    }
+    else
+    {
+        ComputeBoneBounds({}, {}, {}, &m_boneBounds);
+    }
+
+    p_boneBoundsMesh = mesh;
+    m_boneBoundsValid = true;
+}
+
+void SkinnedMeshRenderer::ComputeBoneBounds(
+    const Array<Vector3> &positions,
+    const Array<std::array<int, 4>> &bonesIds,
+    const Array<std::array<float, 4>> &bonesWeights,
+    BoneBounds *boneBounds)
+{
+    boneBounds->boneBindSpaceBounds.Clear();
+    boneBounds->boneBindSpaceBounds.Resize(Animator::MaxNumBones);
+    boneBounds->boneHasVertices.Clear();
+    boneBounds->boneHasVertices.Resize(Animator::MaxNumBones, 0);
+    boneBounds->unskinnedBounds = AABox();
+    boneBounds->hasUnskinnedVertices = false;
+    for (uint i = 0; i < positions.Size(); ++i)
+    {
+        if (i >= bonesIds.Size() || i >= bonesWeights.Size())
+        {
+            // Left as it is by the skinning
+            boneBounds->unskinnedBounds.AddPoint(positions[i]);
+            boneBounds->hasUnskinnedVertices = true;
+            continue;
+        }
+
+        bool hasBones = false;
+        for (uint j = 0; j < 4; ++j)
+        {
+            const int boneId = bonesIds[i][j];
+            if (bonesWeights[i][j] != 0.0f && boneId >= 0 &&
+                boneId < Animator::MaxNumBones)
+            {
+                boneBounds->boneBindSpaceBounds[boneId].AddPoint(positions[i]);
+                boneBounds->boneHasVertices[boneId] = 1;
+                hasBones = true;
+            }
+        }
+
+        if (!hasBones)
+        {
+            // Skinned to the origin, as no bone adds to it
+            boneBounds->unskinnedBounds.AddPoint(Vector3::Zero());
+            boneBounds->hasUnskinnedVertices = true;
+        }
+    }
+}
+
+AABox SkinnedMeshRenderer::SkinBoneBounds(const BoneBounds &boneBounds,
+                                          const Array<Matrix4> &boneMatrices)
+{
+    // A skinned vertex is a weighted average of the vertex transformed by
+    // each of its bones, so it is inside the transformed bounds of its bones
+    bool hasPoints = false;
+    AABox skinnedAABox;
+    const uint numBones =
+        Math::Min(boneBounds.boneBindSpaceBounds.Size(), boneMatrices.Size());
+    for (uint i = 0; i < numBones; ++i)
+    {
+        if (boneBounds.boneHasVertices[i])
+        {
+            const AABox boneAABox =
+                boneMatrices[i] * boneBounds.boneBindSpaceBounds[i];
+            skinnedAABox.AddPoint(boneAABox.GetMin());
+            skinnedAABox.AddPoint(boneAABox.GetMax());
+            hasPoints = true;
+        }
+    }
+    if (boneBounds.hasUnskinnedVertices)
+    {
+        skinnedAABox.AddPoint(boneBounds.unskinnedBounds.GetMin());
+        skinnedAABox.AddPoint(boneBounds.unskinnedBounds.GetMax());
+        hasPoints = true;
+    }
+    return hasPoints ? skinnedAABox : AABox::Empty();
+}
@@ -10,8 +10,10 @@
 #include "BangMath/Matrix4.h"
 #include "Bang/MetaNode.h"
 #include "Bang/MetaNode.tcc"
+#include "Bang/RectTransform.h"
 #include "BangMath/Quaternion.h"
 #include "Bang/StreamOperators.h"
+#include "Bang/TransformHierarchy.h"
 #include "BangMath/Vector3.h"
 #include "BangMath/Vector4.h"
 
@@ -188,6 +190,7 @@ void Transform::RecalculateParentMatricesIfNeeded() const
     if (IInvalidatableTransformLocal::IsInvalid())
     {
         CalculateLocalToParentMatrix();
+        m_parentToLocalMatrixValid = false;
         IInvalidatableTransformLocal::Validate();
     }
 }
@@ -197,6 +200,7 @@ void Transform::RecalculateWorldMatricesIfNeeded() const
     if (IInvalidatableTransformWorld::IsInvalid())
     {
         CalculateLocalToWorldMatrix();
+        m_worldToLocalMatrixValid = false;
         IInvalidatableTransformWorld::Validate();
     }
 }
@@ -204,20 +208,31 @@ void Transform::RecalculateWorldMatricesIfNeeded() const
 void Transform::CalculateLocalToParentMatrix() const
 {
     m_localToParentMatrix = GetLocalTransformation().GetMatrix();
+}
+
+void Transform::CalculateParentToLocalMatrix() const
+{
     m_parentToLocalMatrix = GetLocalTransformation().GetMatrixInverse();
 }
 
 void Transform::CalculateLocalToWorldMatrix() const
 {
+    // The parent values are cached, so this does not recurse up to the root
+    // unless the ancestors are invalid too
     m_localToWorldMatrix = GetLocalToParentMatrix();
+    m_position = GetLocalPosition();
+    m_rotation = GetLocalRotation();
+    m_scale = GetLocalScale();
+
     GameObject *parent = GetGameObject()->GetParent();
-    if (parent && parent->GetTransform())
+    if (Transform *parentTr = (parent ? parent->GetTransform() : nullptr))
     {
-        const Matrix4 &mp =
-            parent->GetTransform()->Transform::GetLocalToWorldMatrix();
+        const Matrix4 &mp = parentTr->Transform::GetLocalToWorldMatrix();
         m_localToWorldMatrix = mp * m_localToWorldMatrix;
+        m_position = mp.TransformedPoint(m_position);
+        m_rotation = parentTr->m_rotation * m_rotation;
+        m_scale = parentTr->m_scale * m_scale;
     }
-    m_worldToLocalMatrix = m_localToWorldMatrix.Inversed();
 }
 
 const Matrix4 &Transform::GetLocalToParentMatrix() const
@@ -229,6 +244,11 @@ const Matrix4 &Transform::GetLocalToParentMatrix() const
 const Matrix4 &Transform::GetParentToLocalMatrix() const
 {
     RecalculateParentMatricesIfNeeded();
+    if (!m_parentToLocalMatrixValid)
+    {
+        CalculateParentToLocalMatrix();
+        m_parentToLocalMatrixValid = true;
+    }
     return m_parentToLocalMatrix;
 }
 
@@ -241,6 +261,11 @@ const Matrix4 &Transform::GetLocalToWorldMatrix() const
 const Matrix4 &Transform::GetWorldToLocalMatrix() const
 {
     RecalculateWorldMatricesIfNeeded();
+    if (!m_worldToLocalMatrixValid)
+    {
+        m_worldToLocalMatrix = m_localToWorldMatrix.Inversed();
+        m_worldToLocalMatrixValid = true;
+    }
     return m_worldToLocalMatrix;
 }
 
@@ -286,14 +311,17 @@ const Vector3 &Transform::GetLocalPosition() const
 
 Vector3 Transform::GetPosition() const
 {
-    if (GameObject *parent = GetGameObject()->GetParent())
+    // The matrices of rect transforms depend on the viewport, so positions
+    // relative to them can not be cached
+    GameObject *parent = GetGameObject()->GetParent();
+    RectTransform *parentRT = (parent ? parent->GetRectTransform() : nullptr);
+    if (parentRT)
     {
-        if (Transform *tr = parent->GetTransform())
-        {
-            return tr->FromLocalToWorldPoint(GetLocalPosition());
-        }
+        return parentRT->FromLocalToWorldPoint(GetLocalPosition());
     }
-    return GetLocalPosition();
+
+    RecalculateWorldMatricesIfNeeded();
+    return m_position;
 }
 
 const Quaternion &Transform::GetLocalRotation() const
@@ -303,14 +331,8 @@ const Quaternion &Transform::GetLocalRotation() const
 
 Quaternion Transform::GetRotation() const
 {
-    if (GameObject *parent = GetGameObject()->GetParent())
-    {
-        if (Transform *tr = parent->GetTransform())
-        {
-            return tr->GetRotation() * GetLocalRotation();
-        }
-    }
-    return GetLocalRotation();
+    RecalculateWorldMatricesIfNeeded();
+    return m_rotation;
 }
 
 const Vector3 &Transform::GetLocalEuler() const
@@ -330,10 +352,8 @@ const Vector3 &Transform::GetLocalScale() const
 
 Vector3 Transform::GetScale() const
 {
-    GameObject *parent = GetGameObject()->GetParent();
-    Transform *parentTr = (parent ? parent->GetTransform() : nullptr);
-    Vector3 parentScale = parentTr ? parentTr->GetScale() : Vector3::One();
-    return parentScale * GetLocalScale();
+    RecalculateWorldMatricesIfNeeded();
+    return m_scale;
 }
 
 const Transformation &Transform::GetLocalTransformation() const
@@ -388,6 +408,10 @@ void Transform::OnTransformInvalidated()
 }
 void Transform::OnParentChanged(GameObject *, GameObject *)
 {
+    if (p_transformHierarchy)
+    {
+        p_transformHierarchy->InvalidateTopology();
+    }
     OnParentTransformChanged();
 }
 void Transform::OnTransformChanged()
@@ -437,6 +461,11 @@ void Transform::OnChildrenTransformChanged()
 {
 }
 
+ComponentUpdateAccess Transform::GetUpdateAccess() const
+{
+    return ComponentUpdateAccess::GAMEOBJECT_SUBTREE;
+}
+
 void Transform::Reflect()
 {
     Component::Reflect();
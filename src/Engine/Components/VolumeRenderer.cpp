@@ -197,11 +197,16 @@ void VolumeRenderer::OnBeforeRender()
 {
     Renderer::OnBeforeRender();
 
-    if (GetActiveMaterial())
+    if (Material *mat = GetActiveMaterial())
     {
-        GetActiveMaterial()->GetShaderProgramProperties().SetRenderPass(
-            GetUseTransferFunction() ? RenderPass::SCENE_TRANSPARENT
-                                     : RenderPass::SCENE_OPAQUE);
+        const RenderPass renderPass = GetUseTransferFunction()
+                                          ? RenderPass::SCENE_TRANSPARENT
+                                          : RenderPass::SCENE_OPAQUE;
+        if (renderPass != mat->GetShaderProgramProperties().GetRenderPass())
+        {
+            mat->GetShaderProgramProperties().SetRenderPass(renderPass);
+            PropagateRendererChanged();
+        }
     }
 
     GetVolumeRenderMaterial()->SetShaderProgram(
@@ -27,6 +27,8 @@
 #include "Bang/Renderer.h"
 #include "Bang/Scene.h"
 #include "Bang/SceneManager.h"
+#include "Bang/SceneObjectIndex.h"
+#include "Bang/SceneParallelUpdater.h"
 #include "BangMath/Sphere.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/Transform.h"
@@ -72,6 +74,13 @@ void GameObject::Start()
 
 void GameObject::Update()
 {
+    if (m_updatedInParallel)
+    {
+        // Already updated this frame by the SceneParallelUpdater
+        m_updatedInParallel = false;
+        return;
+    }
+
     if (IsActiveRecursively())
     {
         PropagateToComponents(&Component::Update);
@@ -131,6 +140,14 @@ void GameObject::BeforeChildrenRender(RenderPass renderPass)
 
 Component *GameObject::AddComponent(Component *component, int index)
 {
+    if (GetParent() && SceneParallelUpdater::DeferIfUpdating(
+                           [this, component, index]() {
+                               AddComponent(component, index);
+                           }))
+    {
+        return component;
+    }
+
     m_componentsToAdd.PushBack(std::make_pair(component, index));
     TryToAddQueuedComponents();
     return component;
@@ -178,6 +195,7 @@ void GameObject::AddChild_(GameObject *childToAdd,
 
         index = Math::Clamp(index, 0, m_children.Size());
         m_children.Insert(childToAdd, index);
+        IncreaseSubtreeVersion();
 
         EventEmitter<IEventsChildren>::PropagateToListenersAndArray(
             GetObjects<EventListener<IEventsChildren>>(),
@@ -203,6 +221,7 @@ void GameObject::AddChild_(GameObject *childToAdd,
 
             newIndex = Math::Clamp(newIndex, 0, m_children.Size());
             m_children.Insert(childToAdd, newIndex);
+            IncreaseSubtreeVersion();
 
             EventEmitter<IEventsChildren>::PropagateToListenersAndArray(
                 GetObjects<EventListener<IEventsChildren>>(),
@@ -222,6 +241,7 @@ void GameObject::RemoveChild(GameObject *childToRemove)
     {
         m_children[i] = nullptr;
         TryToClearDeletedChildren();
+        IncreaseSubtreeVersion();
 
         EventEmitter<IEventsChildren>::PropagateToListenersAndArray(
             GetObjects<EventListener<IEventsChildren>>(),
@@ -255,6 +275,7 @@ Component *GameObject::AddComponent_(Component *component, int index_)
 
         const int index = (index_ != -1 ? index_ : GetComponents().Size());
         m_components.Insert(component, index);
+        m_componentsClassIds.Insert(component->GetInstanceClassId(), index);
 
         if (transformComp)
         {
@@ -324,6 +345,7 @@ void GameObject::RemoveComponent(Component *component)
     if (i >= 0)
     {
         m_components[i] = nullptr;
+        m_componentsClassIds[i] = ClassDB::GetInvalidClassId();
 
         EventEmitter<IEventsComponent>::PropagateToListeners(
             &IEventsComponent::OnComponentRemoved, component, this);
@@ -357,6 +379,15 @@ void GameObject::OnDisabled(Object *object)
         object);
 }
 
+void GameObject::OnGUIDChanged(const GUID &previousGUID)
+{
+    Object::OnGUIDChanged(previousGUID);
+    if (SceneObjectIndex *objectIndex = GetSceneObjectIndex())
+    {
+        objectIndex->OnObjectGUIDChanged(this, previousGUID);
+    }
+}
+
 void GameObject::TryToAddQueuedChildren()
 {
     if (m_childrenIterationDepth == 0)
@@ -402,19 +433,28 @@ void GameObject::TryToClearDeletedChildren()
 void GameObject::TryToClearDeletedComponents()
 {
     Array<Component *> newComponents;
-    for (Component *comp : m_components)
+    Array<ClassIdType> newComponentsClassIds;
+    for (uint i = 0; i < m_components.Size(); ++i)
     {
-        if (comp)
+        if (Component *comp = m_components[i])
         {
             newComponents.PushBack(comp);
+            newComponentsClassIds.PushBack(m_componentsClassIds[i]);
         }
     }
     m_components = newComponents;
+    m_componentsClassIds = newComponentsClassIds;
 }
 
 void GameObject::DestroyImmediate(GameObject *gameObject)
 {
     ASSERT(gameObject);
+    if (gameObject->GetParent() &&
+        SceneParallelUpdater::DeferIfUpdating(
+            [gameObject]() { GameObject::DestroyImmediate(gameObject); }))
+    {
+        return;
+    }
 
     if (!gameObject->IsBeingDestroyed())
     {
@@ -446,6 +486,7 @@ void GameObject::DestroyImmediate(GameObject *gameObject)
             else
             {
                 gameObject->m_components.PopBack();
+                gameObject->m_componentsClassIds.PopBack();
             }
         }
 
@@ -456,6 +497,13 @@ void GameObject::DestroyImmediate(GameObject *gameObject)
 
 void GameObject::Destroy(GameObject *gameObject)
 {
+    if (gameObject->GetParent() &&
+        SceneParallelUpdater::DeferIfUpdating(
+            [gameObject]() { GameObject::Destroy(gameObject); }))
+    {
+        return;
+    }
+
     if (!gameObject->IsWaitingToBeDestroyed())
     {
         gameObject->SetWaitingToBeDestroyed();
@@ -504,6 +552,12 @@ Scene *GameObject::GetScene() const
     return parent ? parent->GetScene() : nullptr;
 }
 
+SceneObjectIndex *GameObject::GetSceneObjectIndex() const
+{
+    Scene *scene = GetScene();
+    return scene ? scene->GetObjectIndex() : nullptr;
+}
+
 Transform *GameObject::GetTransform() const
 {
     return p_transform;
@@ -519,6 +573,7 @@ void GameObject::SetName(const String &name)
     {
         String oldName = GetName();
         m_name = name;
+        IncreaseSubtreeVersion();
         EventEmitter<IEventsName>::PropagateToListeners(
             &IEventsName::OnNameChanged, this, oldName, GetName());
     }
@@ -542,6 +597,65 @@ Object *GameObject::GetObjectInDescendantsAndThis(const GUID &guid) const
         return nullptr;
     }
 
+    if (SceneObjectIndex *objectIndex = GetSceneObjectIndex())
+    {
+        return objectIndex->FindObject(guid, this);
+    }
+    return GetObjectInDescendantsAndThis_(guid);
+}
+
+GameObject *GameObject::FindInChildren(const GUID &guid, bool recursive) const
+{
+    if (recursive)
+    {
+        if (SceneObjectIndex *objectIndex = GetSceneObjectIndex())
+        {
+            return objectIndex->FindGameObject(guid, this, false);
+        }
+    }
+    return FindInChildren_(guid, recursive);
+}
+
+GameObject *GameObject::FindInChildren(const String &name, bool recursive) const
+{
+    if (recursive)
+    {
+        if (SceneObjectIndex *objectIndex = GetSceneObjectIndex())
+        {
+            return objectIndex->FindGameObject(name, this, false);
+        }
+    }
+    return FindInChildren_(name, recursive);
+}
+
+GameObject *GameObject::FindInChildrenAndThis(const GUID &guid,
+                                              bool recursive) const
+{
+    if (recursive)
+    {
+        if (SceneObjectIndex *objectIndex = GetSceneObjectIndex())
+        {
+            return objectIndex->FindGameObject(guid, this, true);
+        }
+    }
+    return FindInChildrenAndThis_(guid, recursive);
+}
+
+GameObject *GameObject::FindInChildrenAndThis(const String &name,
+                                              bool recursive) const
+{
+    if (recursive)
+    {
+        if (SceneObjectIndex *objectIndex = GetSceneObjectIndex())
+        {
+            return objectIndex->FindGameObject(name, this, true);
+        }
+    }
+    return FindInChildrenAndThis_(name, recursive);
+}
+
+Object *GameObject::GetObjectInDescendantsAndThis_(const GUID &guid) const
+{
     if (GetGUID() == guid)
     {
         return const_cast<GameObject *>(this);
@@ -561,7 +675,7 @@ Object *GameObject::GetObjectInDescendantsAndThis(const GUID &guid) const
     {
         if (child)
         {
-            if (Object *obj = child->GetObjectInDescendantsAndThis(guid))
+            if (Object *obj = child->GetObjectInDescendantsAndThis_(guid))
             {
                 return obj;
             }
@@ -570,14 +684,14 @@ Object *GameObject::GetObjectInDescendantsAndThis(const GUID &guid) const
     return nullptr;
 }
 
-GameObject *GameObject::FindInChildren(const GUID &guid, bool recursive) const
+GameObject *GameObject::FindInChildren_(const GUID &guid, bool recursive) const
 {
     for (GameObject *child : GetChildren())
     {
         if (child)
         {
             if (GameObject *found =
-                    child->FindInChildrenAndThis(guid, recursive))
+                    child->FindInChildrenAndThis_(guid, recursive))
             {
                 return found;
             }
@@ -586,14 +700,15 @@ GameObject *GameObject::FindInChildren(const GUID &guid, bool recursive) const
     return nullptr;
 }
 
-GameObject *GameObject::FindInChildren(const String &name, bool recursive) const
+GameObject *GameObject::FindInChildren_(const String &name,
+                                        bool recursive) const
 {
     for (GameObject *child : GetChildren())
     {
         if (child)
         {
             if (GameObject *found =
-                    child->FindInChildrenAndThis(name, recursive))
+                    child->FindInChildrenAndThis_(name, recursive))
             {
                 return found;
             }
@@ -602,8 +717,8 @@ GameObject *GameObject::FindInChildren(const String &name, bool recursive) const
     return nullptr;
 }
 
-GameObject *GameObject::FindInChildrenAndThis(const GUID &guid,
-                                              bool recursive) const
+GameObject *GameObject::FindInChildrenAndThis_(const GUID &guid,
+                                               bool recursive) const
 {
     if (GetGUID() == guid)
     {
@@ -618,7 +733,7 @@ GameObject *GameObject::FindInChildrenAndThis(const GUID &guid,
         }
         else if (recursive)
         {
-            if (GameObject *found = child->FindInChildren(guid, true))
+            if (GameObject *found = child->FindInChildren_(guid, true))
             {
                 return found;
             }
@@ -627,8 +742,8 @@ GameObject *GameObject::FindInChildrenAndThis(const GUID &guid,
     return nullptr;
 }
 
-GameObject *GameObject::FindInChildrenAndThis(const String &name,
-                                              bool recursive) const
+GameObject *GameObject::FindInChildrenAndThis_(const String &name,
+                                               bool recursive) const
 {
     if (GetName() == name)
     {
@@ -643,7 +758,7 @@ GameObject *GameObject::FindInChildrenAndThis(const String &name,
         }
         else if (recursive)
         {
-            if (GameObject *found = child->FindInChildren(name, true))
+            if (GameObject *found = child->FindInChildren_(name, true))
             {
                 return found;
             }
@@ -839,8 +954,18 @@ void GameObject::SetParent(GameObject *newParent,
                            int index,
                            bool keepWorldTransform)
 {
+    if ((GetParent() || newParent) &&
+        SceneParallelUpdater::DeferIfUpdating(
+            [this, newParent, index, keepWorldTransform]() {
+                SetParent(newParent, index, keepWorldTransform);
+            }))
+    {
+        return;
+    }
+
     if (newParent != GetParent())  // Parent change
     {
+        m_updatedInParallel = false;
         if (GetParent())
         {
             GetParent()->RemoveChild(this);
@@ -870,6 +995,19 @@ GameObject *GameObject::GetParent() const
     return p_parent;
 }
 
+uint GameObject::GetSubtreeVersion() const
+{
+    return m_subtreeVersion;
+}
+
+void GameObject::IncreaseSubtreeVersion()
+{
+    for (GameObject *go = this; go; go = go->GetParent())
+    {
+        ++go->m_subtreeVersion;
+    }
+}
+
 void GameObject::SetDontDestroyOnLoad(bool dontDestroyOnLoad)
 {
     m_dontDestroyOnLoad = dontDestroyOnLoad;
@@ -947,48 +1085,6 @@ Sphere GameObject::GetBoundingSphereWorld(bool includeChildren) const
     return bSphereWorld;
 }
 
-void GameObject::PropagateToChildren(std::function<void(GameObject *)> func)
-{
-    ++m_childrenIterationDepth;
-
-    const Array<GameObject *> &children = GetChildren();
-    for (GameObject *child : children)
-    {
-        if (child && child->IsEnabledRecursively())
-        {
-            func(child);
-        }
-    }
-
-    if (--m_childrenIterationDepth == 0)
-    {
-        TryToAddQueuedChildren();
-        TryToClearDeletedChildren();
-        DestroyDelayedGameObjects();
-    }
-}
-
-void GameObject::PropagateToComponents(std::function<void(Component *)> func)
-{
-    ++m_componentsIterationDepth;
-
-    const Array<Component *> &components = GetComponents();
-    for (Component *comp : components)
-    {
-        if (comp && comp->IsEnabledRecursively())
-        {
-            func(comp);
-        }
-    }
-
-    if (--m_componentsIterationDepth == 0)
-    {
-        TryToAddQueuedComponents();
-        TryToClearDeletedComponents();
-        DestroyDelayedComponents();
-    }
-}
-
 GameObject *GameObject::Instantiate()
 {
     GameObject *go = GameObjectFactory::CreateGameObject(true);
@@ -1093,27 +1189,7 @@ String GameObject::ToString() const
 
 void GameObject::ImportMeta(const MetaNode &metaNode)
 {
-    Serializable::ImportMeta(metaNode);
-
-    if (metaNode.Contains("Enabled"))
-    {
-        SetEnabled(metaNode.Get<bool>("Enabled"));
-    }
-
-    if (metaNode.Contains("Visible"))
-    {
-        SetVisible(metaNode.Get<bool>("Visible"));
-    }
-
-    if (metaNode.Contains("Name"))
-    {
-        SetName(metaNode.Get<String>("Name"));
-    }
-
-    if (metaNode.Contains("DontDestroyOnLoad"))
-    {
-        SetDontDestroyOnLoad(metaNode.Get<bool>("DontDestroyOnLoad"));
-    }
+    ImportMetaProperties(metaNode);
 
     // Read components
     {
@@ -1216,6 +1292,31 @@ void GameObject::ImportMeta(const MetaNode &metaNode)
     }
 }
 
+void GameObject::ImportMetaProperties(const MetaNode &metaNode)
+{
+    Serializable::ImportMeta(metaNode);
+
+    if (metaNode.Contains("Enabled"))
+    {
+        SetEnabled(metaNode.Get<bool>("Enabled"));
+    }
+
+    if (metaNode.Contains("Visible"))
+    {
+        SetVisible(metaNode.Get<bool>("Visible"));
+    }
+
+    if (metaNode.Contains("Name"))
+    {
+        SetName(metaNode.Get<String>("Name"));
+    }
+
+    if (metaNode.Contains("DontDestroyOnLoad"))
+    {
+        SetDontDestroyOnLoad(metaNode.Get<bool>("DontDestroyOnLoad"));
+    }
+}
+
 void GameObject::ExportMeta(MetaNode *metaNode) const
 {
     Serializable::ExportMeta(metaNode);
@@ -17,6 +17,12 @@
 #include "Bang/MetaNode.h"
 #include "Bang/MetaNode.tcc"
 #include "Bang/Physics.h"
+#include "Bang/SceneAnimatorsUpdater.h"
+#include "Bang/SceneObjectIndex.h"
+#include "Bang/SceneParallelUpdater.h"
+#include "Bang/SceneSpatialIndex.h"
+#include "Bang/TransformHierarchy.h"
+#include "Bang/TransparentRenderList.h"
 #include "Bang/UICanvas.h"
 
 namespace Bang
@@ -31,12 +37,37 @@ Scene::Scene() : GameObject("Scene")
 {
     p_debugRenderer = new DebugRenderer();
     Physics::GetInstance()->RegisterScene(this);
+
+    // Not lazy, since it can be queried from the parallel update workers
+    p_objectIndex = new SceneObjectIndex();
+    p_objectIndex->SetRoot(this);
 }
 
 Scene::~Scene()
 {
     Physics::GetInstance()->UnRegisterScene(this);
     GameObject::DestroyImmediate(GetDebugRenderer());
+    delete p_objectIndex;
+    if (p_spatialIndex)
+    {
+        delete p_spatialIndex;
+    }
+    if (p_transparentRenderList)
+    {
+        delete p_transparentRenderList;
+    }
+    if (p_parallelUpdater)
+    {
+        delete p_parallelUpdater;
+    }
+    if (p_animatorsUpdater)
+    {
+        delete p_animatorsUpdater;
+    }
+    if (p_transformHierarchy)
+    {
+        delete p_transformHierarchy;
+    }
 }
 
 void Scene::Start()
@@ -52,6 +83,16 @@ void Scene::Update()
 {
     m_deltaTime = Time::GetPassedTimeSince(m_lastUpdateTime);
     m_lastUpdateTime = Time::GetNow();
+
+    if (IsParallelAnimatorsEnabled())
+    {
+        // Same time for all of them, so that the order does not matter
+        GetAnimatorsUpdater()->UpdateAnimators(Time::GetNow());
+    }
+    if (IsParallelUpdateEnabled())
+    {
+        GetParallelUpdater()->UpdateParallelSubtrees(this);
+    }
     GameObject::Update();
 }
 
@@ -94,6 +135,49 @@ void Scene::SetCamera(Camera *cam)
     }
 }
 
+void Scene::SetParallelUpdateEnabled(bool parallelUpdateEnabled)
+{
+    m_parallelUpdateEnabled = parallelUpdateEnabled;
+    if (!IsParallelUpdateEnabled() && p_parallelUpdater)
+    {
+        p_parallelUpdater->ResetUpdatedMarks(this);
+    }
+}
+
+bool Scene::IsParallelUpdateEnabled() const
+{
+    return m_parallelUpdateEnabled;
+}
+
+SceneParallelUpdater *Scene::GetParallelUpdater() const
+{
+    if (!p_parallelUpdater)
+    {
+        p_parallelUpdater = new SceneParallelUpdater();
+    }
+    return p_parallelUpdater;
+}
+
+void Scene::SetParallelAnimatorsEnabled(bool parallelAnimatorsEnabled)
+{
+    m_parallelAnimatorsEnabled = parallelAnimatorsEnabled;
+}
+
+bool Scene::IsParallelAnimatorsEnabled() const
+{
+    return m_parallelAnimatorsEnabled;
+}
+
+SceneAnimatorsUpdater *Scene::GetAnimatorsUpdater() const
+{
+    if (!p_animatorsUpdater)
+    {
+        p_animatorsUpdater = new SceneAnimatorsUpdater();
+        p_animatorsUpdater->SetRoot(const_cast<Scene *>(this));
+    }
+    return p_animatorsUpdater;
+}
+
 Time Scene::GetDeltaTime() const
 {
     return m_deltaTime;
@@ -144,6 +228,41 @@ Camera *Scene::GetCamera() const
     return p_camera;
 }
 
+SceneObjectIndex *Scene::GetObjectIndex() const
+{
+    return p_objectIndex;
+}
+
+SceneSpatialIndex *Scene::GetSpatialIndex() const
+{
+    if (!p_spatialIndex)
+    {
+        p_spatialIndex = new SceneSpatialIndex();
+        p_spatialIndex->SetRoot(const_cast<Scene *>(this));
+    }
+    return p_spatialIndex;
+}
+
+TransformHierarchy *Scene::GetTransformHierarchy() const
+{
+    if (!p_transformHierarchy)
+    {
+        p_transformHierarchy = new TransformHierarchy();
+        p_transformHierarchy->SetRoot(const_cast<Scene *>(this));
+    }
+    return p_transformHierarchy;
+}
+
+TransparentRenderList *Scene::GetTransparentRenderList() const
+{
+    if (!p_transparentRenderList)
+    {
+        p_transparentRenderList = new TransparentRenderList();
+        p_transparentRenderList->SetRoot(const_cast<Scene *>(this));
+    }
+    return p_transparentRenderList;
+}
+
 void Scene::ImportMeta(const MetaNode &metaNode)
 {
     GameObject::ImportMeta(metaNode);
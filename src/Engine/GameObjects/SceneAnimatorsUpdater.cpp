@@ -0,0 +1,99 @@
+#include "Bang/SceneAnimatorsUpdater.h"
+
+#include "Bang/Animator.h"
+#include "Bang/Array.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/JobSystem.h"
+
+using namespace Bang;
+
+namespace
+{
+// Below this, the poses are cheaper to evaluate than to split in jobs
+constexpr uint ParallelAnimatorsMinSize = 4;
+}
+
+SceneAnimatorsUpdater::SceneAnimatorsUpdater()
+{
+}
+
+SceneAnimatorsUpdater::~SceneAnimatorsUpdater()
+{
+    SetRoot(nullptr);
+}
+
+void SceneAnimatorsUpdater::SetRoot(GameObject *root)
+{
+    if (root != GetRoot())
+    {
+        m_animatorsGatherer.SetRoot(root);
+        m_animatorsToEvaluate.Clear();
+        m_lastUpdatedAnimators.Clear();
+    }
+}
+
+void SceneAnimatorsUpdater::SetParallelEvaluation(bool parallelEvaluation)
+{
+    m_parallelEvaluation = parallelEvaluation;
+}
+
+void SceneAnimatorsUpdater::UpdateAnimators(Time now)
+{
+    m_animatorsToEvaluate.Clear();
+    m_lastUpdatedAnimators.Clear();
+    for (Animator *animator : m_animatorsGatherer.GetGatheredObjects())
+    {
+        if (animator && animator->IsStarted() &&
+            animator->IsActiveRecursively())
+        {
+            animator->m_updatedByScene = true;
+            m_lastUpdatedAnimators.PushBack(animator);
+            if (animator->StepPlayers(now))
+            {
+                m_animatorsToEvaluate.PushBack(animator);
+            }
+        }
+    }
+
+    const uint numAnimators = m_animatorsToEvaluate.Size();
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    const bool canRunInParallel = (GetParallelEvaluation() && jobSystem &&
+                                   jobSystem->GetNumWorkers() > 0);
+    if (canRunInParallel && numAnimators >= ParallelAnimatorsMinSize)
+    {
+        jobSystem->ParallelFor(0, numAnimators, 0, [this](uint b, uint e) {
+            for (uint i = b; i < e; ++i)
+            {
+                m_animatorsToEvaluate[i]->EvaluatePose();
+            }
+        });
+    }
+    else
+    {
+        for (Animator *animator : m_animatorsToEvaluate)
+        {
+            animator->EvaluatePose();
+        }
+    }
+
+    for (Animator *animator : m_animatorsToEvaluate)
+    {
+        animator->ApplyPose();
+    }
+}
+
+GameObject *SceneAnimatorsUpdater::GetRoot() const
+{
+    return m_animatorsGatherer.GetRoot();
+}
+
+bool SceneAnimatorsUpdater::GetParallelEvaluation() const
+{
+    return m_parallelEvaluation;
+}
+
+const Array<Animator *> &SceneAnimatorsUpdater::GetLastUpdatedAnimators()
+    const
+{
+    return m_lastUpdatedAnimators;
+}
@@ -0,0 +1,459 @@
+#include "Bang/SceneObjectIndex.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+#include "Bang/Component.h"
+#include "Bang/Debug.h"
+#include "Bang/EventEmitter.tcc"
+#include "Bang/EventListener.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/UMap.tcc"
+#include "Bang/USet.tcc"
+
+using namespace Bang;
+
+SceneObjectIndex::SceneObjectIndex()
+{
+}
+
+SceneObjectIndex::~SceneObjectIndex()
+{
+    SetRoot(nullptr);
+}
+
+void SceneObjectIndex::SetRoot(GameObject *root)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (root != p_root)
+    {
+        if (p_root)
+        {
+            RemoveGameObject(p_root);
+        }
+        ASSERT(m_numIndexedObjects == 0);
+        m_guidToObjects.Clear();
+        m_nameToGameObjects.Clear();
+
+        p_root = root;
+        if (p_root)
+        {
+            AddGameObject(p_root);
+        }
+        ++m_hierarchyVersion;
+    }
+}
+
+Object *SceneObjectIndex::FindObject(const GUID &guid,
+                                     const GameObject *subtreeRoot) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_guidToObjects.Find(guid);
+    if (it == m_guidToObjects.End())
+    {
+        return nullptr;
+    }
+
+    // GUIDs are almost always unique. When they are not, return the first
+    // one in the depth first walk (game object first, then its components)
+    Object *foundObject = nullptr;
+    GameObject *foundGo = nullptr;
+    for (Object *object : it->second)
+    {
+        GameObject *go = GetGameObjectOf(object);
+        if (!IsInSubtree(go, subtreeRoot, true))
+        {
+            continue;
+        }
+
+        bool isBefore = !foundObject || IsBeforeInHierarchy(go, foundGo);
+        if (foundObject && go == foundGo)
+        {
+            const Array<Component *> &comps = go->GetComponents();
+            isBefore = (object == go) ||
+                       (foundObject != go &&
+                        comps.IndexOf(SCAST<Component *>(object)) <
+                            comps.IndexOf(SCAST<Component *>(foundObject)));
+        }
+
+        if (isBefore)
+        {
+            foundObject = object;
+            foundGo = go;
+        }
+    }
+    return foundObject;
+}
+
+GameObject *SceneObjectIndex::FindGameObject(const GUID &guid,
+                                             const GameObject *subtreeRoot,
+                                             bool includeSubtreeRoot) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_guidToObjects.Find(guid);
+    if (it == m_guidToObjects.End())
+    {
+        return nullptr;
+    }
+
+    GameObject *foundGo = nullptr;
+    for (Object *object : it->second)
+    {
+        GameObject *go = DCAST<GameObject *>(object);
+        if (go && IsInSubtree(go, subtreeRoot, includeSubtreeRoot) &&
+            (!foundGo || IsBeforeInHierarchy(go, foundGo)))
+        {
+            foundGo = go;
+        }
+    }
+    return foundGo;
+}
+
+GameObject *SceneObjectIndex::FindGameObject(const String &name,
+                                             const GameObject *subtreeRoot,
+                                             bool includeSubtreeRoot) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_nameToGameObjects.Find(name);
+    if (it == m_nameToGameObjects.End())
+    {
+        return nullptr;
+    }
+
+    GameObject *foundGo = nullptr;
+    for (GameObject *go : it->second)
+    {
+        if (IsInSubtree(go, subtreeRoot, includeSubtreeRoot) &&
+            (!foundGo || IsBeforeInHierarchy(go, foundGo)))
+        {
+            foundGo = go;
+        }
+    }
+    return foundGo;
+}
+
+void SceneObjectIndex::OnObjectGUIDChanged(Object *object,
+                                           const GUID &previousGUID)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_guidToObjects.Find(previousGUID);
+    if (it != m_guidToObjects.End() && it->second.Contains(object))
+    {
+        RemoveObject(object, previousGUID);
+        AddObject(object, object->GetGUID());
+    }
+}
+
+bool SceneObjectIndex::CheckConsistency() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return CheckConsistency_();
+}
+
+bool SceneObjectIndex::CheckConsistency_() const
+{
+    bool consistent = true;
+    uint numObjects = 0;
+    uint numGameObjects = 0;
+    auto CheckObject = [&](Object *object) {
+        ++numObjects;
+        auto it = m_guidToObjects.Find(object->GetGUID());
+        if (it == m_guidToObjects.End() || !it->second.Contains(object))
+        {
+            Debug_Error("SceneObjectIndex: object with GUID "
+                        << object->GetGUID() << " is not indexed");
+            consistent = false;
+        }
+    };
+
+    Array<GameObject *> gosToCheck;
+    if (p_root)
+    {
+        gosToCheck.PushBack(p_root);
+    }
+    while (!gosToCheck.IsEmpty())
+    {
+        GameObject *go = gosToCheck.Back();
+        gosToCheck.PopBack();
+
+        ++numGameObjects;
+        CheckObject(go);
+        auto it = m_nameToGameObjects.Find(go->GetName());
+        if (it == m_nameToGameObjects.End() || !it->second.Contains(go))
+        {
+            Debug_Error("SceneObjectIndex: game object '"
+                        << go->GetName() << "' is not indexed by its name");
+            consistent = false;
+        }
+
+        for (Component *comp : go->GetComponents())
+        {
+            if (comp)
+            {
+                CheckObject(comp);
+            }
+        }
+        for (GameObject *child : go->GetChildren())
+        {
+            if (child)
+            {
+                gosToCheck.PushBack(child);
+            }
+        }
+    }
+
+    // Everything in the hierarchy is indexed, so equal sizes mean that
+    // nothing else is
+    uint numIndexedByGUID = 0;
+    for (const auto &guidAndObjects : m_guidToObjects)
+    {
+        numIndexedByGUID += guidAndObjects.second.Size();
+    }
+    uint numIndexedByName = 0;
+    for (const auto &nameAndGos : m_nameToGameObjects)
+    {
+        numIndexedByName += nameAndGos.second.Size();
+    }
+
+    if (numIndexedByGUID != numObjects || m_numIndexedObjects != numObjects)
+    {
+        Debug_Error("SceneObjectIndex: " << numIndexedByGUID
+                                         << " objects indexed, but "
+                                         << numObjects << " in the hierarchy");
+        consistent = false;
+    }
+    if (numIndexedByName != numGameObjects)
+    {
+        Debug_Error("SceneObjectIndex: " << numIndexedByName
+                                         << " game objects indexed by name, "
+                                         << "but " << numGameObjects
+                                         << " in the hierarchy");
+        consistent = false;
+    }
+    return consistent;
+}
+
+GameObject *SceneObjectIndex::GetRoot() const
+{
+    return p_root;
+}
+
+uint SceneObjectIndex::GetNumIndexedObjects() const
+{
+    return m_numIndexedObjects;
+}
+
+uint SceneObjectIndex::GetHierarchyVersion() const
+{
+    return m_hierarchyVersion;
+}
+
+void SceneObjectIndex::AddGameObject(GameObject *go)
+{
+    go->EventEmitter<IEventsChildren>::RegisterListener(this);
+    go->EventEmitter<IEventsComponent>::RegisterListener(this);
+    go->EventEmitter<IEventsName>::RegisterListener(this);
+
+    AddObject(go, go->GetGUID());
+    m_nameToGameObjects[go->GetName()].Add(go);
+    for (Component *comp : go->GetComponents())
+    {
+        if (comp)
+        {
+            AddObject(comp, comp->GetGUID());
+        }
+    }
+
+    for (GameObject *child : go->GetChildren())
+    {
+        if (child)
+        {
+            AddGameObject(child);
+        }
+    }
+}
+
+void SceneObjectIndex::RemoveGameObject(GameObject *go)
+{
+    go->EventEmitter<IEventsChildren>::UnRegisterListener(this);
+    go->EventEmitter<IEventsComponent>::UnRegisterListener(this);
+    go->EventEmitter<IEventsName>::UnRegisterListener(this);
+
+    RemoveObject(go, go->GetGUID());
+    auto it = m_nameToGameObjects.Find(go->GetName());
+    if (it != m_nameToGameObjects.End())
+    {
+        it->second.Remove(go);
+        if (it->second.IsEmpty())
+        {
+            m_nameToGameObjects.Remove(it);
+        }
+    }
+    for (Component *comp : go->GetComponents())
+    {
+        if (comp)
+        {
+            RemoveObject(comp, comp->GetGUID());
+        }
+    }
+
+    for (GameObject *child : go->GetChildren())
+    {
+        if (child)
+        {
+            RemoveGameObject(child);
+        }
+    }
+}
+
+void SceneObjectIndex::AddObject(Object *object, const GUID &guid)
+{
+    m_guidToObjects[guid].PushBack(object);
+    ++m_numIndexedObjects;
+}
+
+void SceneObjectIndex::RemoveObject(Object *object, const GUID &guid)
+{
+    auto it = m_guidToObjects.Find(guid);
+    if (it != m_guidToObjects.End())
+    {
+        Array<Object *> &objects = it->second;
+        const int i = objects.IndexOf(object);
+        if (i >= 0)
+        {
+            objects.RemoveByIndex(i);
+            --m_numIndexedObjects;
+            if (objects.IsEmpty())
+            {
+                m_guidToObjects.Remove(it);
+            }
+        }
+    }
+}
+
+GameObject *SceneObjectIndex::GetGameObjectOf(Object *object)
+{
+    if (Component *comp = DCAST<Component *>(object))
+    {
+        return comp->GetGameObject();
+    }
+    return SCAST<GameObject *>(object);
+}
+
+bool SceneObjectIndex::IsInSubtree(const GameObject *go,
+                                   const GameObject *subtreeRoot,
+                                   bool includeSubtreeRoot)
+{
+    if (!subtreeRoot)
+    {
+        return true;
+    }
+    return (includeSubtreeRoot && go == subtreeRoot) ||
+           go->IsChildOf(subtreeRoot, true);
+}
+
+bool SceneObjectIndex::IsBeforeInHierarchy(const GameObject *lhs,
+                                           const GameObject *rhs)
+{
+    // Whether lhs comes before rhs in a depth first, preorder walk
+    if (lhs == rhs)
+    {
+        return false;
+    }
+
+    uint lhsDepth = 0, rhsDepth = 0;
+    for (const GameObject *go = lhs; go->GetParent(); go = go->GetParent())
+    {
+        ++lhsDepth;
+    }
+    for (const GameObject *go = rhs; go->GetParent(); go = go->GetParent())
+    {
+        ++rhsDepth;
+    }
+
+    const GameObject *lhsAncestor = lhs;
+    const GameObject *rhsAncestor = rhs;
+    for (; lhsDepth > rhsDepth; --lhsDepth)
+    {
+        lhsAncestor = lhsAncestor->GetParent();
+    }
+    for (; rhsDepth > lhsDepth; --rhsDepth)
+    {
+        rhsAncestor = rhsAncestor->GetParent();
+    }
+
+    // One of them is an ancestor of the other
+    if (lhsAncestor == rhsAncestor)
+    {
+        return (lhsAncestor == lhs);
+    }
+
+    while (lhsAncestor->GetParent() != rhsAncestor->GetParent())
+    {
+        lhsAncestor = lhsAncestor->GetParent();
+        rhsAncestor = rhsAncestor->GetParent();
+    }
+
+    const GameObject *commonParent = lhsAncestor->GetParent();
+    if (!commonParent)
+    {
+        return false;
+    }
+    const Array<GameObject *> &siblings = commonParent->GetChildren();
+    return siblings.IndexOf(const_cast<GameObject *>(lhsAncestor)) <
+           siblings.IndexOf(const_cast<GameObject *>(rhsAncestor));
+}
+
+void SceneObjectIndex::OnChildAdded(GameObject *addedChild, GameObject *)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AddGameObject(addedChild);
+    ++m_hierarchyVersion;
+}
+
+void SceneObjectIndex::OnChildRemoved(GameObject *removedChild, GameObject *)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RemoveGameObject(removedChild);
+    ++m_hierarchyVersion;
+}
+
+void SceneObjectIndex::OnComponentAdded(Component *addedComponent, int)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AddObject(addedComponent, addedComponent->GetGUID());
+    ++m_hierarchyVersion;
+}
+
+void SceneObjectIndex::OnComponentRemoved(Component *removedComponent,
+                                          GameObject *)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RemoveObject(removedComponent, removedComponent->GetGUID());
+    ++m_hierarchyVersion;
+}
+
+void SceneObjectIndex::OnNameChanged(GameObject *go,
+                                     const String &oldName,
+                                     const String &newName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_nameToGameObjects.Find(oldName);
+    if (it != m_nameToGameObjects.End())
+    {
+        it->second.Remove(go);
+        if (it->second.IsEmpty())
+        {
+            m_nameToGameObjects.Remove(it);
+        }
+    }
+    m_nameToGameObjects[newName].Add(go);
+    ++m_hierarchyVersion;
+
+    // Not checked here: other workers may have renamed their game objects
+    // already, and be waiting for the mutex to report it
+}
@@ -0,0 +1,343 @@
+#include "Bang/SceneParallelUpdater.h"
+
+#include <utility>
+
+#include "Bang/Array.tcc"
+#include "Bang/Component.h"
+#include "Bang/ComponentUpdateAccess.h"
+#include "Bang/GameObject.h"
+#include "Bang/GameObject.tcc"
+#include "Bang/JobSystem.h"
+#include "Bang/Scene.h"
+#include "Bang/SceneObjectIndex.h"
+#include "Bang/UMap.tcc"
+
+using namespace Bang;
+
+namespace
+{
+// Queues of the subtree job running in this thread, if any
+thread_local Array<std::function<void()>> *t_deferredEvents = nullptr;
+thread_local Array<std::function<void()>> *t_deferredStructuralChanges =
+    nullptr;
+
+bool IsUpdatable(const GameObject *go)
+{
+    return go && go->IsEnabledRecursively() && go->IsActiveRecursively();
+}
+}
+
+SceneParallelUpdater::SceneParallelUpdater()
+{
+}
+
+SceneParallelUpdater::~SceneParallelUpdater()
+{
+}
+
+void SceneParallelUpdater::UpdateParallelSubtrees(Scene *scene)
+{
+    ResetUpdatedMarks(scene);
+
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    if (!scene || !jobSystem || jobSystem->GetNumWorkers() == 0)
+    {
+        return;
+    }
+
+    Array<JobHandle> jobHandles(m_subtrees.Size());
+    Array<JobHandle> dependencyHandles;
+    Array<uint> scheduledSubtrees;
+    for (uint i : m_scheduleOrder)
+    {
+        // Cached regardless of their state, so that enabling or disabling
+        // them does not need to collect them again
+        GameObject *subtree = m_subtrees[i];
+        if (!IsUpdatable(subtree))
+        {
+            continue;
+        }
+
+        dependencyHandles.Clear();
+        for (uint depIndex : m_subtreeDependencies[i])
+        {
+            dependencyHandles.PushBack(jobHandles[depIndex]);
+        }
+
+        Array<std::function<void()>> *deferredEvents = &m_deferredEvents[i];
+        Array<std::function<void()>> *deferredStructuralChanges =
+            &m_deferredStructuralChanges[i];
+        jobHandles[i] = jobSystem->Schedule(
+            [subtree, deferredEvents, deferredStructuralChanges]() {
+                // Waiting inside the update can run another subtree job here
+                Array<std::function<void()>> *prevDeferredEvents =
+                    t_deferredEvents;
+                Array<std::function<void()>> *prevDeferredStructuralChanges =
+                    t_deferredStructuralChanges;
+                t_deferredEvents = deferredEvents;
+                t_deferredStructuralChanges = deferredStructuralChanges;
+                subtree->Update();
+                t_deferredEvents = prevDeferredEvents;
+                t_deferredStructuralChanges = prevDeferredStructuralChanges;
+            },
+            dependencyHandles);
+        scheduledSubtrees.PushBack(i);
+    }
+    jobSystem->Wait(jobHandles);
+
+    // Mark them before applying the deferred changes, since reparenting a
+    // subtree clears its mark
+    for (uint i : scheduledSubtrees)
+    {
+        m_subtrees[i]->m_updatedInParallel = true;
+        m_lastParallelSubtrees.PushBack(m_subtrees[i]);
+    }
+
+    ApplyDeferredChanges();
+}
+
+void SceneParallelUpdater::ResetUpdatedMarks(Scene *scene)
+{
+    // If the hierarchy did not change, the subtrees of the last frame are
+    // still alive. Otherwise, collecting them again clears all the marks.
+    if (!CollectSubtreesIfNeeded(scene))
+    {
+        for (GameObject *subtree : m_lastParallelSubtrees)
+        {
+            subtree->m_updatedInParallel = false;
+        }
+    }
+    m_lastParallelSubtrees.Clear();
+}
+
+void SceneParallelUpdater::InvalidateSubtrees()
+{
+    m_subtreesValid = false;
+}
+
+const Array<GameObject *> &SceneParallelUpdater::GetLastParallelSubtrees()
+    const
+{
+    return m_lastParallelSubtrees;
+}
+
+bool SceneParallelUpdater::DeferIfUpdating(
+    const std::function<void()> &structuralChange)
+{
+    if (!t_deferredStructuralChanges)
+    {
+        return false;
+    }
+
+    t_deferredStructuralChanges->PushBack(structuralChange);
+    return true;
+}
+
+bool SceneParallelUpdater::DeferEventIfUpdating(
+    const std::function<void()> &event)
+{
+    if (!t_deferredEvents)
+    {
+        return false;
+    }
+
+    t_deferredEvents->PushBack(event);
+    return true;
+}
+
+bool SceneParallelUpdater::CollectSubtreesIfNeeded(Scene *scene)
+{
+    SceneObjectIndex *objectIndex = (scene ? scene->GetObjectIndex() : nullptr);
+    const uint hierarchyVersion =
+        (objectIndex ? objectIndex->GetHierarchyVersion() : 0);
+    if (m_subtreesValid && hierarchyVersion == m_subtreesHierarchyVersion)
+    {
+        return false;
+    }
+
+    m_subtrees.Clear();
+    m_subtreeIndices.Clear();
+    m_subtreesHierarchyVersion = hierarchyVersion;
+    m_subtreesValid = true;
+    if (scene)
+    {
+        for (GameObject *child : scene->GetChildren())
+        {
+            if (CollectSubtrees(child))
+            {
+                m_subtrees.PushBack(child);
+            }
+        }
+    }
+
+    const uint numSubtrees = m_subtrees.Size();
+    for (uint i = 0; i < numSubtrees; ++i)
+    {
+        m_subtreeIndices.Add(m_subtrees[i], i);
+    }
+    m_deferredEvents.Clear();
+    m_deferredEvents.Resize(numSubtrees);
+    m_deferredStructuralChanges.Clear();
+    m_deferredStructuralChanges.Resize(numSubtrees);
+
+    ScheduleSubtrees();
+    return true;
+}
+
+bool SceneParallelUpdater::CollectSubtrees(GameObject *go)
+{
+    // Returns whether the whole subtree of go can be updated in parallel. If
+    // it can not, the biggest subtrees below it that can are collected.
+    // Stale marks of the objects that the main thread walk did not reach
+    // are cleared on the way.
+    go->m_updatedInParallel = false;
+
+    bool subtreeIsLocal = true;
+    for (Component *comp : go->GetComponents())
+    {
+        if (comp && comp->GetUpdateAccess() !=
+                        ComponentUpdateAccess::GAMEOBJECT_SUBTREE)
+        {
+            subtreeIsLocal = false;
+        }
+    }
+
+    const uint firstChildSubtree = m_subtrees.Size();
+    for (GameObject *child : go->GetChildren())
+    {
+        if (!child)
+        {
+            continue;
+        }
+
+        if (CollectSubtrees(child))
+        {
+            m_subtrees.PushBack(child);
+        }
+        else
+        {
+            subtreeIsLocal = false;
+        }
+    }
+
+    // The caller collects go itself instead of its children subtrees
+    if (subtreeIsLocal)
+    {
+        m_subtrees.Resize(firstChildSubtree);
+    }
+    return subtreeIsLocal;
+}
+
+void SceneParallelUpdater::ScheduleSubtrees()
+{
+    // Resolve the declared dependencies into dependencies between subtrees
+    const uint numSubtrees = m_subtrees.Size();
+    Array<Array<uint>> dependents(numSubtrees);
+    Array<uint> numPendingDependencies(numSubtrees, 0u);
+    Array<bool> canBeParallel(numSubtrees, true);
+    Array<Component *> subtreeComponents;
+    Array<GameObject *> componentDependencies;
+    m_subtreeDependencies.Clear();
+    m_subtreeDependencies.Resize(numSubtrees);
+    for (uint i = 0; i < numSubtrees; ++i)
+    {
+        GameObject *subtree = m_subtrees[i];
+
+        subtreeComponents.Clear();
+        componentDependencies.Clear();
+        subtree->GetComponentsInDescendantsAndThis<Component>(
+            &subtreeComponents);
+        for (Component *comp : subtreeComponents)
+        {
+            comp->GetUpdateDependencies(&componentDependencies);
+        }
+
+        for (GameObject *dependency : componentDependencies)
+        {
+            if (!dependency || dependency == subtree ||
+                dependency->IsChildOf(subtree))
+            {
+                continue;
+            }
+
+            const int depIndex = GetSubtreeIndexOf(dependency);
+            if (depIndex < 0)
+            {
+                canBeParallel[i] = false;
+            }
+            else if (!m_subtreeDependencies[i].Contains(SCAST<uint>(depIndex)))
+            {
+                m_subtreeDependencies[i].PushBack(SCAST<uint>(depIndex));
+                dependents[depIndex].PushBack(i);
+                ++numPendingDependencies[i];
+            }
+        }
+    }
+
+    // Topological order. Subtrees depending on one that can not be parallel
+    // or in a cycle never get their dependencies satisfied, and are left out
+    m_scheduleOrder.Clear();
+    for (uint i = 0; i < numSubtrees; ++i)
+    {
+        if (canBeParallel[i] && numPendingDependencies[i] == 0)
+        {
+            m_scheduleOrder.PushBack(i);
+        }
+    }
+    for (uint k = 0; k < m_scheduleOrder.Size(); ++k)
+    {
+        for (uint dependent : dependents[m_scheduleOrder[k]])
+        {
+            if (--numPendingDependencies[dependent] == 0 &&
+                canBeParallel[dependent])
+            {
+                m_scheduleOrder.PushBack(dependent);
+            }
+        }
+    }
+}
+
+int SceneParallelUpdater::GetSubtreeIndexOf(GameObject *go) const
+{
+    while (go)
+    {
+        auto it = m_subtreeIndices.Find(go);
+        if (it != m_subtreeIndices.End())
+        {
+            return SCAST<int>(it->second);
+        }
+        go = go->GetParent();
+    }
+    return -1;
+}
+
+void SceneParallelUpdater::ApplyDeferredChanges()
+{
+    // The structural changes may change the hierarchy (and the cached
+    // subtrees with it), so take them all out first
+    Array<std::function<void()>> events;
+    Array<std::function<void()>> structuralChanges;
+    for (uint i : m_scheduleOrder)
+    {
+        for (std::function<void()> &event : m_deferredEvents[i])
+        {
+            events.PushBack(std::move(event));
+        }
+        for (std::function<void()> &structuralChange :
+             m_deferredStructuralChanges[i])
+        {
+            structuralChanges.PushBack(std::move(structuralChange));
+        }
+        m_deferredEvents[i].Clear();
+        m_deferredStructuralChanges[i].Clear();
+    }
+
+    for (const std::function<void()> &event : events)
+    {
+        event();
+    }
+    for (const std::function<void()> &structuralChange : structuralChanges)
+    {
+        structuralChange();
+    }
+}
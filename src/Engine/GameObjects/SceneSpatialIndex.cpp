@@ -0,0 +1,433 @@
+#include "Bang/SceneSpatialIndex.h"
+
+#include <utility>
+
+#include "Bang/Array.tcc"
+#include "Bang/Collider.h"
+#include "Bang/EventEmitter.tcc"
+#include "Bang/EventListener.tcc"
+#include "Bang/FrustumCuller.h"
+#include "Bang/GameObject.h"
+#include "Bang/Light.h"
+#include "Bang/PointLight.h"
+#include "Bang/Renderer.h"
+#include "Bang/SceneParallelUpdater.h"
+#include "Bang/Transform.h"
+#include "Bang/UMap.tcc"
+
+using namespace Bang;
+
+SceneSpatialIndex::SceneSpatialIndex()
+{
+    m_renderersGatherer.EventEmitter<IEventsObjectGatherer<Renderer>>::
+        RegisterListener(this);
+    m_collidersGatherer.EventEmitter<IEventsObjectGatherer<Collider>>::
+        RegisterListener(this);
+    m_lightsGatherer.EventEmitter<IEventsObjectGatherer<Light>>::
+        RegisterListener(this);
+}
+
+SceneSpatialIndex::~SceneSpatialIndex()
+{
+    SetRoot(nullptr);
+}
+
+void SceneSpatialIndex::SetRoot(GameObject *root)
+{
+    if (root != GetRoot())
+    {
+        p_root = root;
+        m_renderersGatherer.SetRoot(nullptr);
+        m_collidersGatherer.SetRoot(nullptr);
+        m_lightsGatherer.SetRoot(nullptr);
+        Clear();
+
+        m_renderersGatherer.SetRoot(root);
+        m_collidersGatherer.SetRoot(root);
+        m_lightsGatherer.SetRoot(root);
+    }
+}
+
+void SceneSpatialIndex::Update()
+{
+    // Taken out under the lock, so that they can be marked again meanwhile
+    {
+        std::lock_guard<std::mutex> lock(m_dirtyEntriesMutex);
+        std::swap(m_dirtyEntries, m_refitEntries);
+        for (Entry *entry : m_refitEntries)
+        {
+            entry->dirty = false;
+        }
+    }
+
+    for (Entry *entry : m_refitEntries)
+    {
+        Refit(entry);
+    }
+    m_refitEntries.Clear();
+}
+
+void SceneSpatialIndex::MarkDirty(Component *component)
+{
+    auto it = m_entries.Find(component);
+    if (it != m_entries.End())
+    {
+        MarkDirty(it->second);
+    }
+}
+
+template <class T, class QueryFunction>
+void SceneSpatialIndex::Query(Category *category,
+                              const QueryFunction &queryFunction,
+                              Array<T *> *objectsOut)
+{
+    Update();
+
+    queryFunction(category->tree,
+                  [objectsOut](int, Component *const &component) {
+                      objectsOut->PushBack(SCAST<T *>(component));
+                      return true;
+                  });
+
+    for (Component *component : category->unboundedComponents)
+    {
+        objectsOut->PushBack(SCAST<T *>(component));
+    }
+}
+
+void SceneSpatialIndex::QueryRenderers(const Frustum &frustum,
+                                       Array<Renderer *> *renderersOut,
+                                       bool testDepth)
+{
+    Query(&m_renderers,
+          [&frustum, testDepth](const Tree &tree,
+                                const Tree::QueryCallback &callback) {
+              tree.QueryFrustum(frustum, callback, testDepth);
+          },
+          renderersOut);
+}
+
+void SceneSpatialIndex::QueryRenderers(const AABox &aaBox,
+                                       Array<Renderer *> *renderersOut)
+{
+    Query(&m_renderers,
+          [&aaBox](const Tree &tree, const Tree::QueryCallback &callback) {
+              tree.QueryAABox(aaBox, callback);
+          },
+          renderersOut);
+}
+
+void SceneSpatialIndex::QueryRenderers(const Sphere &sphere,
+                                       Array<Renderer *> *renderersOut)
+{
+    Query(&m_renderers,
+          [&sphere](const Tree &tree, const Tree::QueryCallback &callback) {
+              tree.QuerySphere(sphere, callback);
+          },
+          renderersOut);
+}
+
+void SceneSpatialIndex::QueryRenderers(const Ray &ray,
+                                       float maxDistance,
+                                       Array<Renderer *> *renderersOut)
+{
+    Query(&m_renderers,
+          [&ray, maxDistance](const Tree &tree,
+                              const Tree::QueryCallback &callback) {
+              tree.QueryRay(ray, maxDistance, callback);
+          },
+          renderersOut);
+}
+
+void SceneSpatialIndex::QueryColliders(const AABox &aaBox,
+                                       Array<Collider *> *collidersOut)
+{
+    Query(&m_colliders,
+          [&aaBox](const Tree &tree, const Tree::QueryCallback &callback) {
+              tree.QueryAABox(aaBox, callback);
+          },
+          collidersOut);
+}
+
+void SceneSpatialIndex::QueryColliders(const Sphere &sphere,
+                                       Array<Collider *> *collidersOut)
+{
+    Query(&m_colliders,
+          [&sphere](const Tree &tree, const Tree::QueryCallback &callback) {
+              tree.QuerySphere(sphere, callback);
+          },
+          collidersOut);
+}
+
+void SceneSpatialIndex::QueryColliders(const Ray &ray,
+                                       float maxDistance,
+                                       Array<Collider *> *collidersOut)
+{
+    Query(&m_colliders,
+          [&ray, maxDistance](const Tree &tree,
+                              const Tree::QueryCallback &callback) {
+              tree.QueryRay(ray, maxDistance, callback);
+          },
+          collidersOut);
+}
+
+void SceneSpatialIndex::QueryLights(const Frustum &frustum,
+                                    Array<Light *> *lightsOut)
+{
+    Query(&m_lights,
+          [&frustum](const Tree &tree, const Tree::QueryCallback &callback) {
+              tree.QueryFrustum(frustum, callback);
+          },
+          lightsOut);
+}
+
+void SceneSpatialIndex::QueryLights(const AABox &aaBox,
+                                    Array<Light *> *lightsOut)
+{
+    Query(&m_lights,
+          [&aaBox](const Tree &tree, const Tree::QueryCallback &callback) {
+              tree.QueryAABox(aaBox, callback);
+          },
+          lightsOut);
+}
+
+void SceneSpatialIndex::QueryLights(const Sphere &sphere,
+                                    Array<Light *> *lightsOut)
+{
+    Query(&m_lights,
+          [&sphere](const Tree &tree, const Tree::QueryCallback &callback) {
+              tree.QuerySphere(sphere, callback);
+          },
+          lightsOut);
+}
+
+GameObject *SceneSpatialIndex::GetRoot() const
+{
+    return p_root;
+}
+
+uint SceneSpatialIndex::GetNumRenderers() const
+{
+    return m_renderersGatherer.GetGatheredObjects().Size();
+}
+
+uint SceneSpatialIndex::GetNumColliders() const
+{
+    return m_collidersGatherer.GetGatheredObjects().Size();
+}
+
+uint SceneSpatialIndex::GetNumLights() const
+{
+    return m_lightsGatherer.GetGatheredObjects().Size();
+}
+
+AABox SceneSpatialIndex::GetAABoxWorld(Component *component)
+{
+    GameObject *go = component->GetGameObject();
+    if (!go || !go->GetTransform())
+    {
+        return AABox::Empty();
+    }
+
+    if (Renderer *rend = DCAST<Renderer *>(component))
+    {
+        if (rend->GetAABBox() == AABox::Empty())
+        {
+            return AABox::Empty();
+        }
+        return FrustumCuller::GetRendererAABoxWorld(rend);
+    }
+
+    if (Collider *collider = DCAST<Collider *>(component))
+    {
+        return collider->GetAABBoxWorld();
+    }
+
+    if (PointLight *pointLight = DCAST<PointLight *>(component))
+    {
+        const Vector3 center = go->GetTransform()->GetPosition();
+        const Vector3 range = Vector3(pointLight->GetRange());
+        return AABox(center - range, center + range);
+    }
+
+    // Directional lights and unknown components affect the whole scene
+    return AABox::Empty();
+}
+
+void SceneSpatialIndex::AddEntry(Component *component, Category *category)
+{
+    ASSERT(!m_entries.ContainsKey(component));
+
+    Entry *entry = new Entry();
+    entry->p_index = this;
+    entry->p_component = component;
+    entry->p_category = category;
+    m_entries.Add(component, entry);
+
+    if (Transform *tr = component->GetGameObject()->GetTransform())
+    {
+        tr->EventEmitter<IEventsTransform>::RegisterListener(entry);
+    }
+
+    if (Renderer *rend = DCAST<Renderer *>(component))
+    {
+        rend->EventEmitter<IEventsRendererChanged>::RegisterListener(this);
+    }
+
+    MarkDirty(entry);
+}
+
+void SceneSpatialIndex::RemoveEntry(Component *component, Category *category)
+{
+    auto it = m_entries.Find(component);
+    if (it == m_entries.End())
+    {
+        return;
+    }
+
+    Entry *entry = it->second;
+    if (entry->proxyId != Tree::NullNode)
+    {
+        category->tree.DestroyProxy(entry->proxyId);
+    }
+    else
+    {
+        category->unboundedComponents.Remove(component);
+    }
+
+    if (Renderer *rend = DCAST<Renderer *>(component))
+    {
+        rend->EventEmitter<IEventsRendererChanged>::UnRegisterListener(this);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_dirtyEntriesMutex);
+        if (entry->dirty)
+        {
+            m_dirtyEntries.Remove(entry);
+        }
+    }
+    m_entries.Remove(it);
+    delete entry;
+}
+
+void SceneSpatialIndex::MarkDirty(Entry *entry)
+{
+    std::lock_guard<std::mutex> lock(m_dirtyEntriesMutex);
+    if (!entry->dirty)
+    {
+        entry->dirty = true;
+        m_dirtyEntries.PushBack(entry);
+    }
+}
+
+void SceneSpatialIndex::Refit(Entry *entry)
+{
+    Category *category = entry->p_category;
+    const AABox aaBoxWorld = GetAABoxWorld(entry->p_component);
+    const bool isBounded = (aaBoxWorld != AABox::Empty());
+    const bool wasBounded = (entry->proxyId != Tree::NullNode);
+    if (isBounded)
+    {
+        if (wasBounded)
+        {
+            category->tree.MoveProxy(entry->proxyId, aaBoxWorld);
+        }
+        else
+        {
+            category->unboundedComponents.Remove(entry->p_component);
+            entry->proxyId =
+                category->tree.CreateProxy(aaBoxWorld, entry->p_component);
+        }
+    }
+    else if (wasBounded || !category->unboundedComponents.Contains(
+                               entry->p_component))
+    {
+        if (wasBounded)
+        {
+            category->tree.DestroyProxy(entry->proxyId);
+            entry->proxyId = Tree::NullNode;
+        }
+        category->unboundedComponents.PushBack(entry->p_component);
+    }
+}
+
+void SceneSpatialIndex::Clear()
+{
+    for (const auto &pair : m_entries)
+    {
+        delete pair.second;
+    }
+    m_entries.Clear();
+    m_dirtyEntries.Clear();
+    m_refitEntries.Clear();
+
+    for (Category *category : {&m_renderers, &m_colliders, &m_lights})
+    {
+        category->tree.Clear();
+        category->unboundedComponents.Clear();
+    }
+}
+
+void SceneSpatialIndex::OnObjectGathered(Renderer *renderer)
+{
+    AddEntry(renderer, &m_renderers);
+}
+
+void SceneSpatialIndex::OnObjectGathered(Collider *collider)
+{
+    AddEntry(collider, &m_colliders);
+}
+
+void SceneSpatialIndex::OnObjectGathered(Light *light)
+{
+    light->p_spatialIndex = this;
+    AddEntry(light, &m_lights);
+}
+
+void SceneSpatialIndex::OnObjectUnGathered(GameObject *, Renderer *renderer)
+{
+    RemoveEntry(renderer, &m_renderers);
+}
+
+void SceneSpatialIndex::OnObjectUnGathered(GameObject *, Collider *collider)
+{
+    RemoveEntry(collider, &m_colliders);
+}
+
+void SceneSpatialIndex::OnObjectUnGathered(GameObject *, Light *light)
+{
+    if (light->p_spatialIndex == this)
+    {
+        light->p_spatialIndex = nullptr;
+    }
+    RemoveEntry(light, &m_lights);
+}
+
+void SceneSpatialIndex::OnRendererChanged(Renderer *changedRenderer)
+{
+    if (SceneParallelUpdater::DeferEventIfUpdating([this, changedRenderer]() {
+            OnRendererChanged(changedRenderer);
+        }))
+    {
+        return;
+    }
+
+    MarkDirty(changedRenderer);
+}
+
+void SceneSpatialIndex::Entry::OnTransformChanged()
+{
+    if (SceneParallelUpdater::DeferEventIfUpdating(
+            [this]() { OnTransformChanged(); }))
+    {
+        return;
+    }
+
+    p_index->MarkDirty(this);
+}
+
+void SceneSpatialIndex::Entry::OnParentTransformChanged()
+{
+    OnTransformChanged();
+}
@@ -0,0 +1,188 @@
+#include "Bang/TransformHierarchy.h"
+
+#include <utility>
+
+#include "Bang/Array.tcc"
+#include "Bang/EventEmitter.tcc"
+#include "Bang/EventListener.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/JobSystem.h"
+#include "Bang/RectTransform.h"
+#include "Bang/SceneParallelUpdater.h"
+#include "Bang/Transform.h"
+
+using namespace Bang;
+
+namespace
+{
+// Below this, a level is cheaper to update than to split in jobs
+constexpr uint ParallelLevelMinSize = 256;
+constexpr uint ParallelLevelGrainSize = 64;
+}
+
+TransformHierarchy::TransformHierarchy()
+{
+    m_transformsGatherer.EventEmitter<IEventsObjectGatherer<Transform>>::
+        RegisterListener(this);
+}
+
+TransformHierarchy::~TransformHierarchy()
+{
+    SetRoot(nullptr);
+}
+
+void TransformHierarchy::SetRoot(GameObject *root)
+{
+    if (root != GetRoot())
+    {
+        m_transformsGatherer.SetRoot(root);
+        InvalidateTopology();
+    }
+}
+
+void TransformHierarchy::InvalidateTopology()
+{
+    if (SceneParallelUpdater::DeferEventIfUpdating(
+            [this]() { InvalidateTopology(); }))
+    {
+        return;
+    }
+
+    m_topologyValid = false;
+}
+
+void TransformHierarchy::UpdateWorldMatrices()
+{
+    RebuildTopologyIfNeeded();
+
+    // The parents of a level are all in the previous ones, so every level
+    // can be updated in parallel once the previous one is done
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    const bool canRunInParallel = (jobSystem && jobSystem->GetNumWorkers() > 0);
+    for (uint l = 0; l < GetNumLevels(); ++l)
+    {
+        const uint begin = m_levelBegins[l];
+        const uint end = m_levelBegins[l + 1];
+        if (canRunInParallel && (end - begin) >= ParallelLevelMinSize)
+        {
+            jobSystem->ParallelFor(
+                begin, end, ParallelLevelGrainSize, [this](uint b, uint e) {
+                    UpdateWorldMatrices(b, e);
+                });
+        }
+        else
+        {
+            UpdateWorldMatrices(begin, end);
+        }
+    }
+}
+
+GameObject *TransformHierarchy::GetRoot() const
+{
+    return m_transformsGatherer.GetRoot();
+}
+
+uint TransformHierarchy::GetNumTransforms() const
+{
+    return m_sortedTransforms.Size();
+}
+
+uint TransformHierarchy::GetNumLevels() const
+{
+    return (m_levelBegins.Size() > 0 ? m_levelBegins.Size() - 1 : 0);
+}
+
+Transform *TransformHierarchy::GetTransform(uint index) const
+{
+    return m_sortedTransforms[index];
+}
+
+int TransformHierarchy::GetParentIndex(uint index) const
+{
+    return m_parentIndices[index];
+}
+
+void TransformHierarchy::RebuildTopologyIfNeeded()
+{
+    if (m_topologyValid)
+    {
+        return;
+    }
+
+    m_sortedTransforms.Clear();
+    m_parentIndices.Clear();
+    m_levelBegins.Clear();
+    m_topologyValid = true;
+
+    GameObject *root = GetRoot();
+    if (!root)
+    {
+        return;
+    }
+
+    // Breadth first, one level of game objects at a time. The children of a
+    // game object without transform are relative to the world.
+    Array<GameObject *> levelGos = {root};
+    Array<int> levelGosParentIndices = {-1};
+    Array<GameObject *> nextLevelGos;
+    Array<int> nextLevelGosParentIndices;
+    while (!levelGos.IsEmpty())
+    {
+        const uint levelBegin = m_sortedTransforms.Size();
+        nextLevelGos.Clear();
+        nextLevelGosParentIndices.Clear();
+        for (uint i = 0; i < levelGos.Size(); ++i)
+        {
+            GameObject *go = levelGos[i];
+            if (go->GetRectTransform())
+            {
+                continue;
+            }
+
+            int childrenParentIndex = -1;
+            if (Transform *tr = go->GetTransform())
+            {
+                childrenParentIndex = SCAST<int>(m_sortedTransforms.Size());
+                m_sortedTransforms.PushBack(tr);
+                m_parentIndices.PushBack(levelGosParentIndices[i]);
+            }
+
+            for (GameObject *child : go->GetChildren())
+            {
+                nextLevelGos.PushBack(child);
+                nextLevelGosParentIndices.PushBack(childrenParentIndex);
+            }
+        }
+
+        if (m_sortedTransforms.Size() > levelBegin)
+        {
+            m_levelBegins.PushBack(levelBegin);
+        }
+        std::swap(levelGos, nextLevelGos);
+        std::swap(levelGosParentIndices, nextLevelGosParentIndices);
+    }
+    m_levelBegins.PushBack(m_sortedTransforms.Size());
+}
+
+void TransformHierarchy::UpdateWorldMatrices(uint begin, uint end)
+{
+    for (uint i = begin; i < end; ++i)
+    {
+        m_sortedTransforms[i]->RecalculateWorldMatricesIfNeeded();
+    }
+}
+
+void TransformHierarchy::OnObjectGathered(Transform *transform)
+{
+    transform->p_transformHierarchy = this;
+    InvalidateTopology();
+}
+
+void TransformHierarchy::OnObjectUnGathered(GameObject *, Transform *transform)
+{
+    if (transform->p_transformHierarchy == this)
+    {
+        transform->p_transformHierarchy = nullptr;
+    }
+    InvalidateTopology();
+}
@@ -7,8 +7,10 @@
 #include "Bang/Assets.h"
 #include "Bang/AudioManager.h"
 #include "Bang/ClassDB.h"
+#include "Bang/CookedCache.h"
 #include "Bang/Debug.h"
 #include "Bang/GEngine.h"
+#include "Bang/JobSystem.h"
 #include "Bang/MetaFilesManager.h"
 #include "Bang/Paths.h"
 #include "Bang/Physics.h"
@@ -51,8 +53,13 @@ void Application::Init_(const Path &engineRootPath)
     m_systemUtils = new SystemUtils();
     m_debug = CreateDebug();
 
+    m_jobSystem = new JobSystem();
+    m_jobSystem->Init();
+
     m_paths = CreatePaths();
     m_paths->InitPaths(engineRootPath);
+
+    m_metaFilesManager = new MetaFilesManager();
 }
 
 void Application::InitAfterPathsInit_()
@@ -75,9 +82,9 @@ void Application::InitAfterPathsInit_()
 
     m_time->SetInitTime(Time::GetNow() - Time::Millis(SDL_GetTicks()));
 
-    m_metaFilesManager = new MetaFilesManager();
     MetaFilesManager::CreateMissingMetaFiles(Paths::GetEngineAssetsDir());
     MetaFilesManager::LoadMetaFilepathGUIDs(Paths::GetEngineAssetsDir());
+    CookedCache::CollectGarbage();
 
     m_assets = CreateAssets();
     m_assets->Init();
@@ -90,6 +97,9 @@ void Application::InitAfterPathsInit_()
 
 Application::~Application()
 {
+    delete m_jobSystem;
+    m_jobSystem = nullptr;
+
     delete m_classDB;
     delete m_time;
     delete m_debug;
@@ -100,9 +110,12 @@ Application::~Application()
     delete m_physics;
     m_physics = nullptr;
 
-    m_assets->Destroy();
-    delete m_assets;
-    m_assets = nullptr;
+    if (m_assets)
+    {
+        m_assets->Destroy();
+        delete m_assets;
+        m_assets = nullptr;
+    }
 
     delete m_settings;
     delete m_audioManager;
@@ -194,6 +207,11 @@ GEngine *Application::GetGEngine() const
     return m_gEngine;
 }
 
+JobSystem *Application::GetJobSystem() const
+{
+    return m_jobSystem;
+}
+
 Physics *Application::GetPhysics() const
 {
     return m_physics;
@@ -1,5 +1,7 @@
 #include "Bang/ClassDB.h"
 
+#include <type_traits>
+
 #include "Bang/Application.h"
 
 #include "Bang/Animator.h"
@@ -34,6 +36,7 @@
 #include "Bang/ReflectionProbe.h"
 #include "Bang/Renderer.h"
 #include "Bang/RigidBody.h"
+#include "Bang/Set.tcc"
 #include "Bang/SkinnedMeshRenderer.h"
 #include "Bang/SphereCollider.h"
 #include "Bang/Transform.h"
@@ -78,6 +81,14 @@
 
 using namespace Bang;
 
+namespace
+{
+// &T::ImportMeta is a member of Component only if T does not override it
+std::true_type IsComponentImportMeta(void (Component::*)(const MetaNode &));
+template <class T>
+std::false_type IsComponentImportMeta(void (T::*)(const MetaNode &));
+}
+
 ClassDB::ClassDB()
 {
 }
@@ -122,16 +133,38 @@ void *ClassDB::Create(const String &className)
     return createdObj;
 }
 
+bool ClassDB::HasComponentImportMeta(const String &className)
+{
+    ClassDB *cdb = ClassDB::GetInstance();
+    return cdb->m_classNamesWithComponentImportMeta.Contains(className);
+}
+
+const std::function<void *()> *ClassDB::GetConstructor(
+    const String &className)
+{
+    ClassDB *cdb = ClassDB::GetInstance();
+    auto it = cdb->m_classNameToConstructor.Find(className);
+    if (it != cdb->m_classNameToConstructor.End())
+    {
+        return &(it->second);
+    }
+    return nullptr;
+}
+
 void ClassDB::RegisterClasses()
 {
 #define REGISTER_ABSTRACT_CLASS(CLASSNAME)                                   \
     m_classNameToClassIdBegin.Add(#CLASSNAME, CLASSNAME::GetClassIdBegin()); \
     m_classNameToClassIdEnd.Add(#CLASSNAME, CLASSNAME::GetClassIdEnd());
 
-#define REGISTER_CLASS(CLASSNAME)      \
-    REGISTER_ABSTRACT_CLASS(CLASSNAME) \
-    m_classNameToConstructor.Add(      \
-        #CLASSNAME, []() { return SCAST<void *>(new CLASSNAME()); });
+#define REGISTER_CLASS(CLASSNAME)                                        \
+    REGISTER_ABSTRACT_CLASS(CLASSNAME)                                   \
+    m_classNameToConstructor.Add(                                        \
+        #CLASSNAME, []() { return SCAST<void *>(new CLASSNAME()); });    \
+    if (decltype(IsComponentImportMeta(&CLASSNAME::ImportMeta))::value) \
+    {                                                                    \
+        m_classNamesWithComponentImportMeta.Add(#CLASSNAME);             \
+    }
 
     REGISTER_ABSTRACT_CLASS(Object);
     REGISTER_ABSTRACT_CLASS(Component);
@@ -1,13 +1,21 @@
 #include "Bang/FileTracker.h"
 
+#ifdef __linux__
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 #include <unordered_map>
 #include <utility>
 
 #include "Bang/Assert.h"
+#include "Bang/Debug.h"
 #include "Bang/EventEmitter.tcc"
 #include "Bang/Extensions.h"
 #include "Bang/IEventsFileTracker.h"
 #include "Bang/Path.h"
+#include "Bang/StreamOperators.h"
 #include "Bang/Time.h"
 #include "Bang/UMap.h"
 #include "Bang/UMap.tcc"
@@ -22,10 +30,12 @@ using namespace Bang;
 
 FileTracker::FileTracker()
 {
+    StartWatching();
 }
 
 FileTracker::~FileTracker()
 {
+    StopWatching();
 }
 
 void FileTracker::TrackPath(const Path &path)
@@ -48,6 +58,7 @@ void FileTracker::TrackPath(const Path &path)
         m_trackedPaths.Add(path);
         if (!wasBeingTracked)
         {
+            AddWatch(path);
             m_pathsJustRecentlyTracked.Add(path);
             EventEmitter<IEventsFileTracker>::PropagateToListeners(
                 &IEventsFileTracker::OnPathAdded, path);
@@ -65,6 +76,7 @@ void FileTracker::UnTrackPath(const Path &path)
             UnTrackPath(subpath);
         }
     }
+    RemoveWatch(path);
     m_trackedPaths.Remove(path);
     m_pathsJustRecentlyTracked.Remove(path);
     m_pathsToTrackToModificationTime.Remove(path);
@@ -75,9 +87,52 @@ void FileTracker::Clear()
     m_trackedPaths.Clear();
     m_pathsJustRecentlyTracked.Clear();
     m_pathsToTrackToModificationTime.Clear();
+
+    if (IsWatching())
+    {
+        StopWatching();
+        StartWatching();
+    }
 }
 
 void FileTracker::CheckFiles()
+{
+    if (IsWatching())
+    {
+        USet<Path> changedPaths;
+        if (ReadWatchEvents(&changedPaths))
+        {
+            CheckPaths(changedPaths);
+            return;
+        }
+
+        // Some events were lost, check everything this time
+    }
+    CheckFilesPolling();
+}
+
+void FileTracker::SetForcePolling(bool forcePolling)
+{
+    if (forcePolling != m_forcePolling)
+    {
+        m_forcePolling = forcePolling;
+        if (m_forcePolling)
+        {
+            StopWatching();
+        }
+        else
+        {
+            StartWatching();
+        }
+    }
+}
+
+bool FileTracker::IsPolling() const
+{
+    return !IsWatching();
+}
+
+void FileTracker::CheckFilesPolling()
 {
     const UMap<Path, Time> previousPathsToTrack =
         m_pathsToTrackToModificationTime;
@@ -125,6 +180,216 @@ void FileTracker::CheckFiles()
     }
 }
 
+void FileTracker::CheckPaths(const USet<Path> &paths)
+{
+    // Same checks as CheckFilesPolling, but only on the given paths. Many
+    // events on the same path end up in a single check.
+
+    // Check for removed paths. Moved directories do not send events for
+    // their contents, so their tracked sub paths are removed here too.
+    const String dirSeparator = Path::GetSeparatorString();
+    for (const Path &path : paths)
+    {
+        if (m_trackedPaths.Contains(path) && !path.Exists())
+        {
+            Array<Path> removedPaths;
+            const String pathPrefix = path.GetAbsolute() + dirSeparator;
+            for (const Path &trackedPath : m_trackedPaths)
+            {
+                if (trackedPath.BeginsWith(pathPrefix))
+                {
+                    removedPaths.PushBack(trackedPath);
+                }
+            }
+            removedPaths.PushBack(path);
+
+            for (const Path &removedPath : removedPaths)
+            {
+                EventEmitter<IEventsFileTracker>::PropagateToListeners(
+                    &IEventsFileTracker::OnPathRemoved, removedPath);
+                UnTrackPath(removedPath);
+            }
+        }
+    }
+
+    m_pathsJustRecentlyTracked.Clear();
+
+    // Check for new paths inside tracked directories
+    for (const Path &path : paths)
+    {
+        if (!m_trackedPaths.Contains(path) &&
+            m_trackedPaths.Contains(path.GetDirectory()) && path.Exists())
+        {
+            TrackPath(path);
+        }
+    }
+
+    // Check for modified paths
+    for (const Path &path : paths)
+    {
+        if (m_trackedPaths.Contains(path) &&
+            !m_pathsJustRecentlyTracked.Contains(path))
+        {
+            const Time prevModTime = GetModificationTime(path);
+            const Time newModTime = path.GetModificationTime();
+            if (newModTime != prevModTime)
+            {
+                m_pathsToTrackToModificationTime.Add(path, newModTime);
+
+                EventEmitter<IEventsFileTracker>::PropagateToListeners(
+                    &IEventsFileTracker::OnPathModified, path);
+            }
+        }
+    }
+}
+
+bool FileTracker::StartWatching()
+{
+#ifdef __linux__
+    if (!IsWatching() && !m_forcePolling)
+    {
+        m_watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_watchFd < 0)
+        {
+            Debug_Warn("Could not watch files, polling them instead: "
+                       << errno);
+            return false;
+        }
+
+        for (const Path &trackedPath : m_trackedPaths)
+        {
+            AddWatch(trackedPath);
+        }
+    }
+#endif
+    return IsWatching();
+}
+
+void FileTracker::StopWatching()
+{
+#ifdef __linux__
+    if (IsWatching())
+    {
+        close(m_watchFd);
+        m_watchFd = -1;
+    }
+#endif
+    m_watchIdToPath.Clear();
+    m_pathToWatchId.Clear();
+}
+
+bool FileTracker::IsWatching() const
+{
+    return (m_watchFd >= 0);
+}
+
+void FileTracker::AddWatch(const Path &path)
+{
+#ifdef __linux__
+    if (!IsWatching())
+    {
+        return;
+    }
+
+    // Directories are watched, files through their directory
+    const Path dir = path.IsDir() ? path : path.GetDirectory();
+    if (m_pathToWatchId.ContainsKey(dir))
+    {
+        return;
+    }
+
+    const uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE |
+                          IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO |
+                          IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+    const int watchId =
+        inotify_add_watch(m_watchFd, dir.GetAbsolute().ToCString(), mask);
+    if (watchId >= 0)
+    {
+        m_watchIdToPath.Add(watchId, dir);
+        m_pathToWatchId.Add(dir, watchId);
+    }
+    else if (errno == ENOSPC || errno == ENOMEM)
+    {
+        // Out of watches (see fs.inotify.max_user_watches)
+        Debug_Warn("Could not watch '" << dir
+                                       << "', polling files instead.");
+        StopWatching();
+    }
+#else
+    BANG_UNUSED(path);
+#endif
+}
+
+void FileTracker::RemoveWatch(const Path &path)
+{
+#ifdef __linux__
+    auto it = m_pathToWatchId.Find(path);
+    if (it != m_pathToWatchId.End())
+    {
+        const int watchId = it->second;
+        inotify_rm_watch(m_watchFd, watchId);
+        m_watchIdToPath.Remove(watchId);
+        m_pathToWatchId.Remove(path);
+    }
+#else
+    BANG_UNUSED(path);
+#endif
+}
+
+bool FileTracker::ReadWatchEvents(USet<Path> *changedPaths)
+{
+#ifdef __linux__
+    alignas(struct inotify_event) char buffer[4096];
+    bool eventsLost = false;
+    while (IsWatching())
+    {
+        const ssize_t readSize = read(m_watchFd, buffer, sizeof(buffer));
+        if (readSize <= 0)
+        {
+            break;
+        }
+
+        for (ssize_t i = 0; i < readSize;)
+        {
+            const struct inotify_event *event =
+                RCAST<const struct inotify_event *>(buffer + i);
+            i += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // Keep draining, but the events can not be trusted
+                eventsLost = true;
+                continue;
+            }
+
+            auto it = m_watchIdToPath.Find(event->wd);
+            if (it == m_watchIdToPath.End())
+            {
+                continue;
+            }
+
+            const Path dir = it->second;
+            if (event->mask & IN_IGNORED)
+            {
+                // The directory is gone, or the watch was removed
+                m_watchIdToPath.Remove(event->wd);
+                m_pathToWatchId.Remove(dir);
+            }
+
+            changedPaths->Add(dir);
+            if (event->len > 0)
+            {
+                changedPaths->Add(dir.Append(String(event->name)));
+            }
+        }
+    }
+    return !eventsLost;
+#else
+    BANG_UNUSED(changedPaths);
+    return false;
+#endif
+}
+
 Time FileTracker::GetModificationTime(const Path &path) const
 {
     auto it = m_pathsToTrackToModificationTime.Find(path);
@@ -3,6 +3,7 @@
 #include <ostream>
 
 #include "Bang/Application.h"
+#include "Bang/CookedCache.h"
 #include "Bang/Debug.h"
 #include "Bang/Extensions.h"
 #include "Bang/File.h"
@@ -37,6 +38,7 @@ Project *ProjectManager::OpenProject(const Path &projectFilepath)
         Path assetsDir = currentProject->GetProjectAssetsFilepath();
         MetaFilesManager::CreateMissingMetaFiles(assetsDir);
         MetaFilesManager::LoadMetaFilepathGUIDs(assetsDir);
+        CookedCache::CollectGarbage();
 
         currentProject->Init();
         currentProject->ImportMetaFromFile(projectFilepath);
@@ -21,6 +21,7 @@
 #include "Bang/Physics.h"
 #include "Bang/Scene.h"
 #include "Bang/StreamOperators.h"
+#include "Bang/TransformHierarchy.h"
 #include "Bang/Window.h"
 
 using namespace Bang;
@@ -74,6 +75,9 @@ void SceneManager::OnNewFrame(Scene *scene)
 
         scene->DestroyDelayedGameObjects();
         scene->DestroyDelayedComponents();
+
+        // Leave all the world matrices ready for the render
+        scene->GetTransformHierarchy()->UpdateWorldMatrices();
     }
 }
 
@@ -0,0 +1,252 @@
+#include "Bang/FrustumCuller.h"
+
+#include "Bang/GL.h"
+#include "Bang/GameObject.h"
+#include "Bang/Material.h"
+#include "Bang/Renderer.h"
+#include "Bang/SceneSpatialIndex.h"
+#include "Bang/ShaderProgramProperties.h"
+#include "Bang/Transform.h"
+#include "Bang/USet.tcc"
+
+using namespace Bang;
+
+void FrustumCullingStats::Reset()
+{
+    numTested = numVisible = numCulled = 0;
+}
+
+void FrustumCullingStats::Accumulate(const FrustumCullingStats &stats)
+{
+    numTested += stats.numTested;
+    numVisible += stats.numVisible;
+    numCulled += stats.numCulled;
+}
+
+FrustumCuller::FrustumCuller()
+{
+}
+
+FrustumCuller::~FrustumCuller()
+{
+}
+
+void FrustumCuller::Cull(const Frustum &frustum,
+                         const Array<Renderer *> &renderers,
+                         Camera *cullingCamera)
+{
+    Clear();
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    m_hasCullResults = true;
+    p_cullingCamera = cullingCamera;
+    m_visibleRenderers.Reserve(renderers.Size());
+    for (Renderer *rend : renderers)
+    {
+        if (!rend)
+        {
+            continue;
+        }
+
+        ++m_stats.numTested;
+        if (!IsCullable(rend) ||
+            IsVisible(frustum, GetRendererAABoxWorld(rend)))
+        {
+            ++m_stats.numVisible;
+            m_visibleRenderers.PushBack(rend);
+        }
+        else
+        {
+            ++m_stats.numCulled;
+            m_culledRenderers.Add(rend);
+        }
+    }
+}
+
+void FrustumCuller::Cull(const Frustum &frustum,
+                         SceneSpatialIndex *spatialIndex,
+                         Camera *cullingCamera)
+{
+    Clear();
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    // The index only visits the tree nodes that touch the frustum, so here
+    // we only know the visible renderers. The culled ones are the rest.
+    m_hasCullResults = true;
+    m_cullResultsFromSpatialIndex = true;
+    p_cullingCamera = cullingCamera;
+    spatialIndex->QueryRenderers(frustum, &m_visibleRenderers);
+    for (Renderer *rend : m_visibleRenderers)
+    {
+        m_visibleRenderersSet.Add(rend);
+    }
+
+    m_stats.numTested = spatialIndex->GetNumRenderers();
+    m_stats.numVisible = m_visibleRenderers.Size();
+    m_stats.numCulled = (m_stats.numTested - m_stats.numVisible);
+}
+
+void FrustumCuller::Clear()
+{
+    m_hasCullResults = false;
+    m_cullResultsFromSpatialIndex = false;
+    p_cullingCamera = nullptr;
+    m_culledRenderers.Clear();
+    m_visibleRenderersSet.Clear();
+    m_visibleRenderers.Clear();
+    m_stats.Reset();
+}
+
+void FrustumCuller::SetEnabled(bool enabled)
+{
+    if (enabled != IsEnabled())
+    {
+        m_enabled = enabled;
+        Clear();
+    }
+}
+
+bool FrustumCuller::IsEnabled() const
+{
+    return m_enabled;
+}
+
+bool FrustumCuller::IsCulled(const Renderer *renderer) const
+{
+    if (!m_hasCullResults)
+    {
+        return false;
+    }
+
+    if (m_cullResultsFromSpatialIndex)
+    {
+        return IsCullable(renderer) &&
+               !m_visibleRenderersSet.Contains(renderer);
+    }
+    return m_culledRenderers.Contains(renderer);
+}
+
+bool FrustumCuller::HasCullResultsFor(const Camera *camera) const
+{
+    return m_hasCullResults && (p_cullingCamera == camera);
+}
+
+const Array<Renderer *> &FrustumCuller::GetVisibleRenderers() const
+{
+    return m_visibleRenderers;
+}
+
+const FrustumCullingStats &FrustumCuller::GetStats() const
+{
+    return m_stats;
+}
+
+bool FrustumCuller::IsCullable(const Renderer *renderer)
+{
+    if (!renderer || renderer->GetViewProjMode() != GL::ViewProjMode::WORLD)
+    {
+        return false;
+    }
+
+    GameObject *go = renderer->GetGameObject();
+    if (!go || !go->GetTransform())
+    {
+        return false;
+    }
+
+    const Material *mat = renderer->GetActiveMaterial();
+    if (!mat ||
+        !IsCullablePass(mat->GetShaderProgramProperties().GetRenderPass()))
+    {
+        return false;
+    }
+
+    // Renderers without bounds (empty box) can not be culled safely
+    return (renderer->GetAABBox() != AABox::Empty());
+}
+
+bool FrustumCuller::IsCullablePass(RenderPass renderPass)
+{
+    switch (renderPass)
+    {
+        case RenderPass::SCENE_OPAQUE:
+        case RenderPass::SCENE_DECALS:
+        case RenderPass::SCENE_TRANSPARENT:
+        case RenderPass::SCENE_BEFORE_ADDING_LIGHTS:
+        case RenderPass::SCENE_AFTER_ADDING_LIGHTS: return true;
+
+        default: break;
+    }
+    return false;
+}
+
+AABox FrustumCuller::GetRendererAABoxWorld(const Renderer *renderer)
+{
+    const Transform *tr = renderer->GetGameObject()->GetTransform();
+    return tr->GetLocalToWorldMatrix() * renderer->GetAABBox();
+}
+
+bool FrustumCuller::IsVisible(const Frustum &frustum,
+                              const AABox &aaBoxWorld,
+                              bool testDepth)
+{
+    return frustum.Intersects(aaBoxWorld, testDepth);
+}
+
+FrustumCullingStats FrustumCuller::CullAABoxes(const Frustum &frustum,
+                                               const Array<AABox> &aaBoxesWorld,
+                                               Array<uint> *visibleIndicesOut,
+                                               bool testDepth)
+{
+    FrustumCullingStats stats;
+    for (uint i = 0; i < aaBoxesWorld.Size(); ++i)
+    {
+        ++stats.numTested;
+        if (IsVisible(frustum, aaBoxesWorld[i], testDepth))
+        {
+            ++stats.numVisible;
+            if (visibleIndicesOut)
+            {
+                visibleIndicesOut->PushBack(i);
+            }
+        }
+        else
+        {
+            ++stats.numCulled;
+        }
+    }
+    return stats;
+}
+
+FrustumCullingStats FrustumCuller::CullRenderers(
+    const Frustum &frustum,
+    const Array<Renderer *> &renderers,
+    Array<Renderer *> *visibleRenderersOut,
+    bool testDepth)
+{
+    FrustumCullingStats stats;
+    for (Renderer *rend : renderers)
+    {
+        ++stats.numTested;
+        if (!IsCullable(rend) ||
+            IsVisible(frustum, GetRendererAABoxWorld(rend), testDepth))
+        {
+            ++stats.numVisible;
+            if (visibleRenderersOut)
+            {
+                visibleRenderersOut->PushBack(rend);
+            }
+        }
+        else
+        {
+            ++stats.numCulled;
+        }
+    }
+    return stats;
+}
@@ -1,5 +1,6 @@
 ﻿#include "Bang/GEngine.h"
 
+#include <array>
 #include <stack>
 
 #include "Bang/Application.h"
@@ -9,6 +10,7 @@
 #include "Bang/DebugRenderer.h"
 #include "Bang/EventEmitter.h"
 #include "Bang/Framebuffer.h"
+#include "Bang/Frustum.h"
 #include "Bang/GBuffer.h"
 #include "Bang/GL.h"
 #include "Bang/GLUniforms.h"
@@ -19,6 +21,7 @@
 #include "Bang/Material.h"
 #include "Bang/Mesh.h"
 #include "Bang/MeshFactory.h"
+#include "Bang/MeshRenderer.h"
 #include "Bang/MultiObjectGatherer.tcc"
 #include "Bang/Path.h"
 #include "Bang/Paths.h"
@@ -33,7 +36,10 @@
 #include "Bang/TextureCubeMap.h"
 #include "Bang/TextureUnitManager.h"
 #include "Bang/Transform.h"
+#include "Bang/TransparentRenderList.h"
 #include "Bang/USet.tcc"
+#include "Bang/VAO.h"
+#include "Bang/VBO.h"
 
 namespace Bang
 {
@@ -76,6 +82,11 @@ GEngine::~GEngine()
     {
         delete m_fillCubeMapFromTexturesFB;
     }
+
+    if (p_instanceMatricesVBO)
+    {
+        delete p_instanceMatricesVBO;
+    }
 }
 
 void GEngine::Init()
@@ -262,6 +273,58 @@ Material *GEngine::GetReplacementMaterial() const
     return m_replacementMaterial.Get();
 }
 
+void GEngine::SetFrustumCullingEnabled(bool frustumCullingEnabled)
+{
+    m_frustumCuller.SetEnabled(frustumCullingEnabled);
+}
+
+bool GEngine::IsFrustumCullingEnabled() const
+{
+    return m_frustumCuller.IsEnabled();
+}
+
+const FrustumCullingStats &GEngine::GetCameraCullingStats() const
+{
+    return m_cameraCullingStats;
+}
+
+const FrustumCullingStats &GEngine::GetShadowCullingStats() const
+{
+    return m_shadowCullingStats;
+}
+
+void GEngine::SetRenderQueueEnabled(bool renderQueueEnabled)
+{
+    m_renderQueueEnabled = renderQueueEnabled;
+}
+
+bool GEngine::IsRenderQueueEnabled() const
+{
+    return m_renderQueueEnabled;
+}
+
+const RenderQueueStats &GEngine::GetRenderQueueStats() const
+{
+    return m_renderQueueStats;
+}
+
+Array<Renderer *> GEngine::CullShadowCasters(
+    const Frustum &shadowFrustum,
+    const Array<Renderer *> &shadowCasters,
+    bool testDepth)
+{
+    if (!IsFrustumCullingEnabled())
+    {
+        return shadowCasters;
+    }
+
+    Array<Renderer *> visibleShadowCasters;
+    visibleShadowCasters.Reserve(shadowCasters.Size());
+    m_shadowCullingStats.Accumulate(FrustumCuller::CullRenderers(
+        shadowFrustum, shadowCasters, &visibleShadowCasters, testDepth));
+    return visibleShadowCasters;
+}
+
 Camera *GEngine::GetActiveRenderingCamera()
 {
     GEngine *ge = GEngine::GetInstance();
@@ -399,6 +462,21 @@ void GEngine::RenderToGBuffer(GameObject *go, Camera *camera)
     if (camera->MustRenderPass(RenderPass::SCENE_OPAQUE) ||
         camera->MustRenderPass(RenderPass::SCENE_TRANSPARENT))
     {
+        // Cull the scene renderers against the camera frustum once, so that
+        // all the scene passes below skip the ones that are not visible
+        if (Scene *scene = DCAST<Scene *>(go))
+        {
+            m_frustumCuller.Cull(
+                camera->GetFrustum(), scene->GetSpatialIndex(), camera);
+        }
+        else
+        {
+            m_frustumCuller.Cull(camera->GetFrustum(),
+                                 m_renderersCache.GetGatheredArray(go),
+                                 camera);
+        }
+        m_cameraCullingStats = m_frustumCuller.GetStats();
+
         gbuffer->SetSceneDepthStencil();
         ClearDepthStencilIfNeeded(renderFlags);
 
@@ -465,6 +543,8 @@ void GEngine::RenderToGBuffer(GameObject *go, Camera *camera)
             gbuffer->SetColorDrawBuffer();
             RenderWithPass(go, RenderPass::SCENE_AFTER_ADDING_LIGHTS);
         }
+
+        m_frustumCuller.Clear();
     }
 
     // Enable blend for transparent stuff from now on
@@ -540,8 +620,24 @@ void GEngine::RenderWithPassAndMarkStencilForLights(GameObject *go,
     GL::SetStencilValue(1);
     GL::SetStencilOp(GL::StencilOperation::REPLACE);
 
+    // Record the renderers instead of drawing them during the traversal, so
+    // that they can be sorted by state and instanced when submitted
+    const bool useRenderQueue =
+        (IsRenderQueueEnabled() && renderPass == RenderPass::SCENE_OPAQUE);
+    if (useRenderQueue)
+    {
+        m_renderQueue.Clear();
+        m_renderQueueRecording = true;
+    }
+
     RenderWithPass(go, renderPass);
 
+    if (useRenderQueue)
+    {
+        m_renderQueueRecording = false;
+        SubmitRenderQueue();
+    }
+
     GL::Pop(GL::Pushable::STENCIL_STATES);
 }
 
@@ -776,6 +872,13 @@ void GEngine::CopyTexture(Texture2D *source, Texture2D *destiny)
 
 bool GEngine::CanRenderNow(Renderer *rend, RenderPass renderPass) const
 {
+    if (FrustumCuller::IsCullablePass(renderPass) &&
+        m_frustumCuller.HasCullResultsFor(GetActiveRenderingCamera()) &&
+        m_frustumCuller.IsCulled(rend))
+    {
+        return false;
+    }
+
     if (rend->GetGameObject()->IsVisibleRecursively() && rend->IsVisible())
     {
         Material *mat = GetReplacementMaterial() ? GetReplacementMaterial()
@@ -861,31 +964,56 @@ void GEngine::RenderTransparentPass(GameObject *go)
 
     const Vector3 camPos = cam->GetGameObject()->GetTransform()->GetPosition();
 
-    // Sort back to front
-    Array<GameObject *> goChildren = go->GetDescendants();
-    goChildren.Sort(
-        [camPos](const GameObject *lhs, const GameObject *rhs) -> bool {
-            const Transform *lhsTrans = lhs->GetTransform();
-            const Transform *rhsTrans = rhs->GetTransform();
-            if (lhsTrans && rhsTrans)
+    // A replacement material decides the pass of all the renderers, not only
+    // of the ones in the transparent list
+    Scene *scene = DCAST<Scene *>(go);
+    if (scene && !GetReplacementMaterial())
+    {
+        // Only visit the transparent renderers, in back to front order
+        TransparentRenderList *transparentList =
+            scene->GetTransparentRenderList();
+        transparentList->SortBackToFront(camPos);
+        const Array<Renderer *> transparentRenderers =
+            transparentList->GetRenderers();
+        for (Renderer *rend : transparentRenderers)
+        {
+            GameObject *rendGo = rend->GetGameObject();
+            if (rendGo->IsActiveRecursively() &&
+                rendGo->IsVisibleRecursively() &&
+                rend->IsEnabledRecursively())
             {
-                const Vector3 lhsPos = lhsTrans->GetPosition();
-                const Vector3 rhsPos = rhsTrans->GetPosition();
-                const Vector3 lhsCamPosDiff = (lhsPos - camPos);
-                const Vector3 rhsCamPosDiff = (rhsPos - camPos);
-                const float lhsDistToCamSq =
-                    Vector3::Dot(lhsCamPosDiff, lhsCamPosDiff);
-                const float rhsDistToCamSq =
-                    Vector3::Dot(rhsCamPosDiff, rhsCamPosDiff);
-                return lhsDistToCamSq > rhsDistToCamSq;
+                rend->OnRender(RenderPass::SCENE_TRANSPARENT);
             }
-            return false;
-        });
-
-    // Render back to front
-    for (GameObject *go : goChildren)
+        }
+    }
+    else
     {
-        go->Render(RenderPass::SCENE_TRANSPARENT, false);
+        // Sort back to front
+        Array<GameObject *> goChildren = go->GetDescendants();
+        goChildren.Sort(
+            [camPos](const GameObject *lhs, const GameObject *rhs) -> bool {
+                const Transform *lhsTrans = lhs->GetTransform();
+                const Transform *rhsTrans = rhs->GetTransform();
+                if (lhsTrans && rhsTrans)
+                {
+                    const Vector3 lhsPos = lhsTrans->GetPosition();
+                    const Vector3 rhsPos = rhsTrans->GetPosition();
+                    const Vector3 lhsCamPosDiff = (lhsPos - camPos);
+                    const Vector3 rhsCamPosDiff = (rhsPos - camPos);
+                    const float lhsDistToCamSq =
+                        Vector3::Dot(lhsCamPosDiff, lhsCamPosDiff);
+                    const float rhsDistToCamSq =
+                        Vector3::Dot(rhsCamPosDiff, rhsCamPosDiff);
+                    return lhsDistToCamSq > rhsDistToCamSq;
+                }
+                return false;
+            });
+
+        // Render back to front
+        for (GameObject *go : goChildren)
+        {
+            go->Render(RenderPass::SCENE_TRANSPARENT, false);
+        }
     }
 
     m_currentlyForwardRendering = false;
@@ -924,6 +1052,8 @@ GEngine *GEngine::GetInstance()
 
 void GEngine::RenderShadowMaps(GameObject *go)
 {
+    m_shadowCullingStats.Reset();
+
     const Array<Light *> &lights = m_lightsCache.GetGatheredArray(go);
     for (Light *light : lights)
     {
@@ -1048,6 +1178,12 @@ void GEngine::Render(Renderer *rend)
         return;
     }
 
+    if (m_renderQueueRecording)
+    {
+        EnqueueRenderer(rend, RenderPass::SCENE_OPAQUE);
+        return;
+    }
+
     // If we have a replacement shader currently, change the renderer sp
     AH<Material> previousRendSharedMat, previousRendCopiedMat;
     previousRendSharedMat.Set(rend->GetSharedMaterial());
@@ -1081,6 +1217,149 @@ void GEngine::Render(Renderer *rend)
     }
 }
 
+void GEngine::RenderInstanced(const RenderQueueBatch &batch)
+{
+    const Array<RenderQueueItem> &items = m_renderQueue.GetItems();
+    const RenderQueueItem &firstItem = items[batch.firstItemIndex];
+    Renderer *rend = firstItem.renderer;
+    Mesh *mesh = firstItem.mesh;
+    ShaderProgram *sp = firstItem.shaderProgram;
+
+    // The normal matrices are computed here once per instance, instead of
+    // once per vertex in the shader
+    m_instanceMatrices.Clear();
+    m_instanceMatrices.Reserve(batch.numItems * 2);
+    for (uint i = 0; i < batch.numItems; ++i)
+    {
+        const Matrix4 &modelMatrix =
+            items[batch.firstItemIndex + i].modelMatrix;
+        m_instanceMatrices.PushBack(modelMatrix);
+        m_instanceMatrices.PushBack(
+            GLUniforms::CalculateNormalMatrix(modelMatrix));
+    }
+
+    if (!p_instanceMatricesVBO)
+    {
+        p_instanceMatricesVBO = new VBO();
+    }
+    p_instanceMatricesVBO->CreateAndFill(
+        m_instanceMatrices.Data(),
+        m_instanceMatrices.Size() * sizeof(Matrix4),
+        GL::UsageHint::STREAM_DRAW);
+
+    AH<Material> previousRendSharedMat, previousRendCopiedMat;
+    previousRendSharedMat.Set(rend->GetSharedMaterial());
+    previousRendCopiedMat.Set(rend->GetCopiedMaterial());
+    if (GetReplacementMaterial())
+    {
+        rend->EventEmitter<IEventsRendererChanged>::SetEmitEvents(false);
+        rend->SetMaterial(GetReplacementMaterial(), nullptr);
+        rend->EventEmitter<IEventsRendererChanged>::SetEmitEvents(true);
+    }
+
+    rend->Bind();
+    sp->SetBool(GLUniforms::UniformName_UseInstancing, true);
+
+    // A mat4 attribute takes four consecutive locations, one per column
+    VAO *vao = mesh->GetVAO();
+    const std::array<uint, 2> matLocations = {
+        {Mesh::DefaultInstanceModelMatrixVBOLocation,
+         Mesh::DefaultInstanceNormalMatrixVBOLocation}};
+    for (uint m = 0; m < matLocations.size(); ++m)
+    {
+        for (uint col = 0; col < 4; ++col)
+        {
+            vao->SetVBO(p_instanceMatricesVBO,
+                        matLocations[m] + col,
+                        4,
+                        GL::VertexAttribDataType::FLOAT,
+                        false,
+                        2 * sizeof(Matrix4),
+                        m * sizeof(Matrix4) + col * sizeof(Vector4));
+            vao->SetVertexAttribDivisor(matLocations[m] + col, 1);
+        }
+    }
+
+    GL::RenderInstanced(vao,
+                        rend->GetRenderPrimitive(),
+                        mesh->GetNumVerticesIds(),
+                        batch.numItems);
+
+    for (uint matLocation : matLocations)
+    {
+        for (uint col = 0; col < 4; ++col)
+        {
+            vao->SetVertexAttribDivisor(matLocation + col, 0);
+            vao->RemoveVBO(matLocation + col);
+        }
+    }
+
+    sp->SetBool(GLUniforms::UniformName_UseInstancing, false);
+    rend->UnBind();
+
+    if (GetReplacementMaterial())
+    {
+        rend->EventEmitter<IEventsRendererChanged>::SetEmitEvents(false);
+        rend->SetMaterial(previousRendSharedMat.Get(),
+                          previousRendCopiedMat.Get());
+        rend->EventEmitter<IEventsRendererChanged>::SetEmitEvents(true);
+    }
+}
+
+void GEngine::EnqueueRenderer(Renderer *rend, RenderPass renderPass)
+{
+    Material *mat = GetReplacementMaterial() ? GetReplacementMaterial()
+                                             : rend->GetActiveMaterial();
+    ShaderProgram *sp = mat->GetShaderProgram();
+
+    Mesh *mesh = nullptr;
+    if (MeshRenderer *mr = DCAST<MeshRenderer *>(rend))
+    {
+        mesh = mr->GetCurrentLODActiveMesh();
+    }
+
+    m_renderQueue.Add(renderPass,
+                      rend,
+                      sp,
+                      mat,
+                      mesh,
+                      rend->GetModelMatrixUniform(),
+                      (mesh && CanBeInstanced(rend, sp)));
+}
+
+void GEngine::SubmitRenderQueue()
+{
+    m_renderQueue.Prepare();
+
+    const Array<RenderQueueItem> &items = m_renderQueue.GetItems();
+    for (const RenderQueueBatch &batch : m_renderQueue.GetBatches())
+    {
+        if (batch.instanced)
+        {
+            RenderInstanced(batch);
+        }
+        else
+        {
+            Render(items[batch.firstItemIndex].renderer);
+        }
+    }
+
+    m_renderQueueStats = m_renderQueue.GetStats();
+    m_renderQueue.Clear();
+}
+
+bool GEngine::CanBeInstanced(Renderer *rend, ShaderProgram *sp) const
+{
+    // Only plain mesh renderers whose uniforms do not depend on the
+    // renderer itself (apart from the model matrix) can be instanced
+    return rend->GetInstanceClassId() == MeshRenderer::GetClassIdBegin() &&
+           rend->GetViewProjMode() == GL::ViewProjMode::WORLD &&
+           rend->GetRenderPrimitive() == GL::Primitive::TRIANGLES &&
+           rend->GetDepthMask() && rend->GetReceivesShadows() &&
+           !rend->GetUseReflectionProbes() && !m_currentlyForwardRendering &&
+           sp->GetUniformLocation(GLUniforms::UniformName_UseInstancing) >= 0;
+}
+
 GL *GEngine::GetGL() const
 {
     return m_gl;
@@ -0,0 +1,237 @@
+#include "Bang/RenderQueue.h"
+
+#include <array>
+#include <utility>
+
+#include "BangMath/Math.h"
+#include "Bang/Array.tcc"
+#include "Bang/UMap.tcc"
+
+using namespace Bang;
+
+void RenderQueueStats::Reset()
+{
+    *this = RenderQueueStats();
+}
+
+RenderQueue::RenderQueue()
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+}
+
+void RenderQueue::Clear()
+{
+    m_items.Clear();
+    m_batches.Clear();
+    m_stats.Reset();
+    m_shaderProgramIds.Clear();
+    m_materialIds.Clear();
+    m_meshIds.Clear();
+}
+
+void RenderQueue::Add(RenderPass renderPass,
+                      Renderer *renderer,
+                      ShaderProgram *shaderProgram,
+                      Material *material,
+                      Mesh *mesh,
+                      const Matrix4 &modelMatrix,
+                      bool instanceable)
+{
+    // Ids are given in order of appearance, so that they are compact and
+    // fit in the key bits
+    RenderQueueItem item;
+    item.renderer = renderer;
+    item.shaderProgram = shaderProgram;
+    item.material = material;
+    item.mesh = mesh;
+    item.modelMatrix = modelMatrix;
+    item.instanceable = instanceable;
+    item.sortKey = BuildSortKey(SCAST<uint>(renderPass),
+                                GetId(&m_shaderProgramIds, shaderProgram),
+                                GetId(&m_materialIds, material),
+                                GetId(&m_meshIds, mesh));
+    m_items.PushBack(item);
+}
+
+void RenderQueue::Prepare(uint minInstancesPerBatch)
+{
+    RadixSort(&m_items);
+    BuildBatches(minInstancesPerBatch);
+}
+
+const Array<RenderQueueItem> &RenderQueue::GetItems() const
+{
+    return m_items;
+}
+
+const Array<RenderQueueBatch> &RenderQueue::GetBatches() const
+{
+    return m_batches;
+}
+
+const RenderQueueStats &RenderQueue::GetStats() const
+{
+    return m_stats;
+}
+
+uint64_t RenderQueue::BuildSortKey(uint renderPassId,
+                                   uint shaderProgramId,
+                                   uint materialId,
+                                   uint meshId)
+{
+    return ((SCAST<uint64_t>(renderPassId) & 0xFFull) << 56) |
+           ((SCAST<uint64_t>(shaderProgramId) & 0xFFFFull) << 40) |
+           ((SCAST<uint64_t>(materialId) & 0xFFFFFull) << 20) |
+           ((SCAST<uint64_t>(meshId) & 0xFFFFFull));
+}
+
+void RenderQueue::RadixSort(Array<RenderQueueItem> *items)
+{
+    constexpr uint NumDigits = sizeof(uint64_t);
+    constexpr uint NumBuckets = 256;
+
+    const uint n = items->Size();
+    if (n <= 1)
+    {
+        return;
+    }
+
+    // Sort (key, index) pairs instead of the whole items, and compute the
+    // histograms of all the digits in a single pass
+    using KeyIndex = std::pair<uint64_t, uint>;
+    Array<KeyIndex> keys(n), auxKeys(n);
+    std::array<std::array<uint, NumBuckets>, NumDigits> histograms = {};
+    for (uint i = 0; i < n; ++i)
+    {
+        const uint64_t key = (*items)[i].sortKey;
+        keys[i] = std::make_pair(key, i);
+        for (uint d = 0; d < NumDigits; ++d)
+        {
+            ++histograms[d][(key >> (d * 8)) & 0xFF];
+        }
+    }
+
+    for (uint d = 0; d < NumDigits; ++d)
+    {
+        std::array<uint, NumBuckets> &histogram = histograms[d];
+
+        // All the keys have the same digit, nothing to do
+        if (histogram[(keys[0].first >> (d * 8)) & 0xFF] == n)
+        {
+            continue;
+        }
+
+        uint offset = 0;
+        for (uint b = 0; b < NumBuckets; ++b)
+        {
+            const uint count = histogram[b];
+            histogram[b] = offset;
+            offset += count;
+        }
+
+        for (uint i = 0; i < n; ++i)
+        {
+            const uint bucket = (keys[i].first >> (d * 8)) & 0xFF;
+            auxKeys[histogram[bucket]++] = keys[i];
+        }
+        std::swap(keys, auxKeys);
+    }
+
+    Array<RenderQueueItem> sortedItems;
+    sortedItems.Reserve(n);
+    for (const KeyIndex &keyIndex : keys)
+    {
+        sortedItems.PushBack((*items)[keyIndex.second]);
+    }
+    *items = sortedItems;
+}
+
+uint RenderQueue::GetId(UMap<const void *, uint> *ids, const void *ptr)
+{
+    auto it = ids->Find(ptr);
+    if (it != ids->End())
+    {
+        return it->second;
+    }
+
+    const uint newId = SCAST<uint>(ids->Size());
+    ids->Add(ptr, newId);
+    return newId;
+}
+
+void RenderQueue::BuildBatches(uint minInstancesPerBatch)
+{
+    m_batches.Clear();
+    m_stats.Reset();
+    m_stats.numItems = m_items.Size();
+
+    auto CanBeInstancedTogether = [](const RenderQueueItem &lhs,
+                                     const RenderQueueItem &rhs) {
+        return lhs.instanceable && rhs.instanceable &&
+               lhs.sortKey == rhs.sortKey && lhs.mesh == rhs.mesh &&
+               lhs.material == rhs.material &&
+               lhs.shaderProgram == rhs.shaderProgram;
+    };
+
+    auto AddBatch = [this](uint firstItemIndex,
+                           uint numItems,
+                           bool instanced) {
+        RenderQueueBatch batch;
+        batch.firstItemIndex = firstItemIndex;
+        batch.numItems = numItems;
+        batch.instanced = instanced;
+        m_batches.PushBack(batch);
+
+        ++m_stats.numDrawCalls;
+        if (instanced)
+        {
+            ++m_stats.numInstancedDrawCalls;
+            m_stats.numInstancedItems += numItems;
+        }
+    };
+
+    const RenderQueueItem *prevItem = nullptr;
+    uint i = 0;
+    while (i < m_items.Size())
+    {
+        uint runEnd = i + 1;
+        while (runEnd < m_items.Size() &&
+               CanBeInstancedTogether(m_items[i], m_items[runEnd]))
+        {
+            ++runEnd;
+        }
+
+        const RenderQueueItem &item = m_items[i];
+        if (!prevItem || prevItem->shaderProgram != item.shaderProgram)
+        {
+            ++m_stats.numShaderProgramChanges;
+        }
+        if (!prevItem || prevItem->material != item.material)
+        {
+            ++m_stats.numMaterialChanges;
+        }
+        if (!prevItem || prevItem->mesh != item.mesh)
+        {
+            ++m_stats.numMeshChanges;
+        }
+
+        const uint runLength = (runEnd - i);
+        if (runLength >= Math::Max(minInstancesPerBatch, 2u))
+        {
+            AddBatch(i, runLength, true);
+        }
+        else
+        {
+            for (uint j = i; j < runEnd; ++j)
+            {
+                AddBatch(j, 1, false);
+            }
+        }
+
+        prevItem = &m_items[runEnd - 1];
+        i = runEnd;
+    }
+}
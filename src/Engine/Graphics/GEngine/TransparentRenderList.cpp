@@ -0,0 +1,160 @@
+#include "Bang/TransparentRenderList.h"
+
+#include "Bang/Array.tcc"
+#include "Bang/EventEmitter.tcc"
+#include "Bang/EventListener.tcc"
+#include "Bang/GameObject.h"
+#include "Bang/Material.h"
+#include "Bang/Renderer.h"
+#include "Bang/SceneParallelUpdater.h"
+#include "Bang/ShaderProgramProperties.h"
+#include "Bang/Transform.h"
+#include "Bang/UMap.tcc"
+
+using namespace Bang;
+
+TransparentRenderList::TransparentRenderList()
+{
+    m_renderersGatherer.EventEmitter<IEventsObjectGatherer<Renderer>>::
+        RegisterListener(this);
+}
+
+TransparentRenderList::~TransparentRenderList()
+{
+    SetRoot(nullptr);
+}
+
+void TransparentRenderList::SetRoot(GameObject *root)
+{
+    if (root != GetRoot())
+    {
+        p_root = root;
+        m_renderersGatherer.SetRoot(nullptr);
+        m_entries.Clear();
+        m_entryIndices.Clear();
+        m_sortedRenderers.Clear();
+
+        m_renderersGatherer.SetRoot(root);
+    }
+}
+
+void TransparentRenderList::SortBackToFront(const Vector3 &cameraPosition)
+{
+    // World positions come from the cached local to world matrices, so this
+    // does not walk the parent chain for the clean transforms
+    for (Entry &entry : m_entries)
+    {
+        const Transform *tr = entry.renderer->GetGameObject()->GetTransform();
+        const Vector3 pos =
+            tr ? tr->GetLocalToWorldMatrix().GetTranslation() : Vector3::Zero();
+        const Vector3 camToPos = (pos - cameraPosition);
+        entry.distanceSq = Vector3::Dot(camToPos, camToPos);
+    }
+
+    // Frame coherent insertion sort (furthest first). The order of the
+    // previous frame is kept, so it is close to linear most of the times.
+    for (uint i = 1; i < m_entries.Size(); ++i)
+    {
+        const Entry entry = m_entries[i];
+        int j = SCAST<int>(i) - 1;
+        while (j >= 0 && m_entries[j].distanceSq < entry.distanceSq)
+        {
+            m_entries[j + 1] = m_entries[j];
+            --j;
+        }
+        m_entries[j + 1] = entry;
+    }
+
+    m_sortedRenderers.Clear();
+    m_sortedRenderers.Reserve(m_entries.Size());
+    for (uint i = 0; i < m_entries.Size(); ++i)
+    {
+        m_sortedRenderers.PushBack(m_entries[i].renderer);
+        m_entryIndices[m_entries[i].renderer] = i;
+    }
+}
+
+GameObject *TransparentRenderList::GetRoot() const
+{
+    return p_root;
+}
+
+const Array<Renderer *> &TransparentRenderList::GetRenderers() const
+{
+    return m_sortedRenderers;
+}
+
+bool TransparentRenderList::IsTransparent(const Renderer *renderer)
+{
+    const Material *mat = renderer->GetActiveMaterial();
+    return mat && (mat->GetShaderProgramProperties().GetRenderPass() ==
+                   RenderPass::SCENE_TRANSPARENT);
+}
+
+int TransparentRenderList::IndexOf(Renderer *renderer) const
+{
+    auto it = m_entryIndices.Find(renderer);
+    return (it != m_entryIndices.End()) ? SCAST<int>(it->second) : -1;
+}
+
+void TransparentRenderList::UpdateMembership(Renderer *renderer)
+{
+    const bool isInList = (IndexOf(renderer) >= 0);
+    if (IsTransparent(renderer))
+    {
+        if (!isInList)
+        {
+            Entry entry;
+            entry.renderer = renderer;
+            m_entryIndices.Add(renderer, m_entries.Size());
+            m_entries.PushBack(entry);
+        }
+    }
+    else if (isInList)
+    {
+        Remove(renderer);
+    }
+}
+
+void TransparentRenderList::Remove(Renderer *renderer)
+{
+    const int index = IndexOf(renderer);
+    if (index < 0)
+    {
+        return;
+    }
+
+    // The last one takes its place. The next sort puts it back in order.
+    const Entry &lastEntry = m_entries.Back();
+    m_entries[index] = lastEntry;
+    m_entryIndices[lastEntry.renderer] = SCAST<uint>(index);
+    m_entries.PopBack();
+    m_entryIndices.Remove(renderer);
+    m_sortedRenderers.Remove(renderer);
+}
+
+void TransparentRenderList::OnObjectGathered(Renderer *renderer)
+{
+    renderer->EventEmitter<IEventsRendererChanged>::RegisterListener(this);
+    UpdateMembership(renderer);
+}
+
+void TransparentRenderList::OnObjectUnGathered(GameObject *,
+                                               Renderer *renderer)
+{
+    renderer->EventEmitter<IEventsRendererChanged>::UnRegisterListener(this);
+    Remove(renderer);
+}
+
+void TransparentRenderList::OnRendererChanged(Renderer *changedRenderer)
+{
+    if (!changedRenderer || SceneParallelUpdater::DeferEventIfUpdating(
+                                [this, changedRenderer]() {
+                                    OnRendererChanged(changedRenderer);
+                                }))
+    {
+        return;
+    }
+
+    UpdateMembership(changedRenderer);
+}
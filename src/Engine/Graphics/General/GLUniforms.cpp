@@ -40,6 +40,7 @@ const String GLUniforms::UniformName_HasNormalMapTexture =
     "B_HasNormalMapTexture";
 const String GLUniforms::UniformName_TimeSeconds = "B_TimeSeconds";
 const String GLUniforms::UniformName_Model = "B_Model";
+const String GLUniforms::UniformName_UseInstancing = "B_UseInstancing";
 const String GLUniforms::UniformName_ModelInv = "B_ModelInv";
 const String GLUniforms::UniformName_Normal = "B_Normal";
 const String GLUniforms::UniformName_View = "B_View";
@@ -370,6 +370,11 @@ void Image::Import(const Path &imageFilepath)
     ImageIO::Import(imageFilepath, this, &ok);
 }
 
+std::size_t Image::GetResidentBytes() const
+{
+    return Asset::GetResidentBytes() + m_pixels.Size();
+}
+
 void Image::Export(const Path &filepath) const
 {
     ImageIO::Export(filepath, *this);
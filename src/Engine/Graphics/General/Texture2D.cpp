@@ -286,16 +286,47 @@ void Texture2D::Import(const Image &image)
     if (image.GetData())
     {
         m_image = image;
+        FillFromImage();
+    }
+}
+
+std::size_t Texture2D::GetResidentBytes() const
+{
+    return Asset::GetResidentBytes() + GetBytesSize() +
+           m_image.GetResidentBytes();
+}
 
-        SetWidth(image.GetWidth());
-        SetHeight(image.GetHeight());
+void Texture2D::ImportAsync(const Path &imageFilepath)
+{
+    // Only decoding here, the upload needs GL
+    if (!imageFilepath.HasExtension("dds"))
+    {
+        ImageIO::Import(imageFilepath, &m_image);
+    }
+}
 
-        Fill(image.GetData(),
-             GetWidth(),
-             GetHeight(),
-             GL::ColorComp::RGBA,
-             GL::DataType::UNSIGNED_BYTE);
+void Texture2D::ImportAsyncFinish(const Path &imageFilepath)
+{
+    if (imageFilepath.HasExtension("dds"))
+    {
+        Import(imageFilepath);
     }
+    else if (m_image.GetData())
+    {
+        FillFromImage();
+    }
+}
+
+void Texture2D::FillFromImage()
+{
+    SetWidth(m_image.GetWidth());
+    SetHeight(m_image.GetHeight());
+
+    Fill(m_image.GetData(),
+         GetWidth(),
+         GetHeight(),
+         GL::ColorComp::RGBA,
+         GL::DataType::UNSIGNED_BYTE);
 }
 
 GL::BindTarget Texture2D::GetGLBindTarget() const
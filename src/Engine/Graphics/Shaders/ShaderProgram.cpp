@@ -679,10 +679,12 @@ void ShaderProgram::Reflect()
 {
     Asset::Reflect();
 
-    ReflectVar<Path>(
+    ReflectVar<ShaderProgram, Path>(
         "Unified shader",
-        [this](const Path &unifiedShaderPath) { Load(unifiedShaderPath); },
-        [this]() { return GetUnifiedShaderPath(); },
+        [](ShaderProgram *sp, Path unifiedShaderPath) {
+            sp->Load(unifiedShaderPath);
+        },
+        [](const ShaderProgram *sp) { return sp->GetUnifiedShaderPath(); },
         BANG_REFLECT_HINT_ZOOMABLE_PREVIEW(false) +
             BANG_REFLECT_HINT_EXTENSIONS(
                 Extensions::GetUnifiedShaderExtension()));
@@ -0,0 +1,394 @@
+#include "Bang/CookedCache.h"
+
+#include <sys/stat.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#ifdef __linux__
+#include <utime.h>
+#elif _WIN32
+#include <sys/utime.h>
+#endif
+
+#include "Bang/Array.tcc"
+#include "Bang/File.h"
+#include "Bang/MappedFile.h"
+#include "Bang/Paths.h"
+#include "Bang/Thread.h"
+
+using namespace Bang;
+
+namespace
+{
+std::atomic<bool> s_cookedCacheEnabled(true);
+
+// Entries of edited sources are never read again, so they age until removed
+constexpr uint64_t MaxUnusedTimeSecs = 30ull * 24 * 60 * 60;
+constexpr uint64_t MaxTotalSize = 1024ull * 1024 * 1024;
+
+// Left by writers that did not finish, if they are older than this
+constexpr uint64_t MaxTmpEntryTimeSecs = 60 * 60;
+
+struct CookedEntry
+{
+    Path path;
+    uint64_t lastUseTimeSecs = 0;
+    uint64_t size = 0;
+};
+
+bool GetEntryStamp(const Path &entryPath, CookedEntry *entry)
+{
+#ifdef __linux__
+    struct stat attr;
+    if (stat(entryPath.GetAbsolute().ToCString(), &attr) == 0)
+#elif _WIN32
+    struct _stat64 attr;
+    if (_stat64(entryPath.GetAbsolute().ToCString(), &attr) == 0)
+#endif
+    {
+        entry->path = entryPath;
+        entry->lastUseTimeSecs = SCAST<uint64_t>(attr.st_mtime);
+        entry->size = SCAST<uint64_t>(attr.st_size);
+        return true;
+    }
+    return false;
+}
+
+void MarkEntryAsUsed(const Path &entryPath)
+{
+#ifdef __linux__
+    utime(entryPath.GetAbsolute().ToCString(), nullptr);
+#elif _WIN32
+    _utime(entryPath.GetAbsolute().ToCString(), nullptr);
+#endif
+}
+
+// Content hashes are only trusted for sources that had not changed for this
+// long when hashed, since modification times have the resolution of the
+// filesystem clock, and a source edited again within it would keep its time
+constexpr uint64_t MinStableSourceTimeNanos = 2000000000ull;
+
+// Modification time and size of a source, and the hash of its contents
+struct SourceStamp
+{
+    uint64_t modificationTimeNanos = 0;
+    uint64_t size = 0;
+    uint64_t hashTimeNanos = 0;
+    uint64_t hash = 0;
+};
+
+bool GetSourceStamp(const Path &sourceFilepath, SourceStamp *stamp)
+{
+#ifdef __linux__
+    struct stat attr;
+    if (stat(sourceFilepath.GetAbsolute().ToCString(), &attr) == 0)
+    {
+        stamp->modificationTimeNanos =
+            SCAST<uint64_t>(attr.st_mtim.tv_sec) * 1000000000ull +
+            SCAST<uint64_t>(attr.st_mtim.tv_nsec);
+        stamp->size = SCAST<uint64_t>(attr.st_size);
+        return true;
+    }
+#elif _WIN32
+    struct _stat64 attr;
+    if (_stat64(sourceFilepath.GetAbsolute().ToCString(), &attr) == 0)
+    {
+        stamp->modificationTimeNanos =
+            SCAST<uint64_t>(attr.st_mtime) * 1000000000ull;
+        stamp->size = SCAST<uint64_t>(attr.st_size);
+        return true;
+    }
+#endif
+    return false;
+}
+
+uint64_t GetNowNanos()
+{
+    return SCAST<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+}
+
+uint64_t HashBytes(const Byte *data, std::size_t size)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+}
+
+String CookedCache::GetKey(const Path &sourceFilepath,
+                           const String &kind,
+                           uint version)
+{
+    if (!CookedCache::IsEnabled())
+    {
+        return "";
+    }
+
+    SourceStamp stamp;
+    if (!GetSourceStamp(sourceFilepath, &stamp))
+    {
+        return "";
+    }
+
+    // The contents are only hashed again if the source changed since the
+    // stamp of its last hash
+    const String stampKey = CookedCache::GetSourceStampKey(sourceFilepath);
+    bool hasHash = false;
+    MappedFile stampFile;
+    if (CookedCache::Read(stampKey, &stampFile))
+    {
+        SourceStamp prevStamp;
+        CookedReader reader(stampFile.GetData(), stampFile.GetSize());
+        reader.ReadData(&prevStamp);
+        if (reader.IsOk() && reader.IsAtEnd() &&
+            prevStamp.modificationTimeNanos == stamp.modificationTimeNanos &&
+            prevStamp.size == stamp.size &&
+            prevStamp.modificationTimeNanos + MinStableSourceTimeNanos <
+                prevStamp.hashTimeNanos)
+        {
+            stamp.hash = prevStamp.hash;
+            hasHash = true;
+        }
+    }
+
+    if (!hasHash)
+    {
+        MappedFile sourceFile(sourceFilepath);
+        if (!sourceFile.IsOpen())
+        {
+            return "";
+        }
+
+        stamp.hashTimeNanos = GetNowNanos();
+        stamp.hash = HashBytes(sourceFile.GetData(), sourceFile.GetSize());
+        if (sourceFile.GetSize() == stamp.size)
+        {
+            CookedWriter writer;
+            writer.WriteData(stamp);
+            CookedCache::Write(stampKey, writer.GetBytes());
+        }
+        stamp.size = sourceFile.GetSize();
+    }
+
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0') << std::setw(16) << stamp.hash << "_"
+        << std::dec << stamp.size << "." << kind << version;
+    return String(oss.str());
+}
+
+String CookedCache::GetSourceStampKey(const Path &sourceFilepath)
+{
+    const String &sourceFilepathStr = sourceFilepath.GetAbsolute();
+    std::ostringstream oss;
+    oss << "Source_" << std::hex << std::setfill('0') << std::setw(16)
+        << HashBytes(RCAST<const Byte *>(sourceFilepathStr.ToCString()),
+                     sourceFilepathStr.Size())
+        << ".stamp";
+    return String(oss.str());
+}
+
+bool CookedCache::Read(const String &key, MappedFile *mappedFile)
+{
+    if (key.IsEmpty())
+    {
+        return false;
+    }
+
+    const Path entryPath = CookedCache::GetEntryPath(key);
+    if (!mappedFile->Open(entryPath))
+    {
+        return false;
+    }
+    MarkEntryAsUsed(entryPath);
+    return true;
+}
+
+void CookedCache::Write(const String &key, const Array<Byte> &bytes)
+{
+    if (key.IsEmpty() || bytes.IsEmpty())
+    {
+        return;
+    }
+
+    const Path cacheDir = CookedCache::GetDirectory();
+    File::CreateDir(cacheDir.GetDirectory());
+    File::CreateDir(cacheDir);
+
+    // Written aside and then renamed, so that readers never see a half
+    // written entry, even if several threads cook the same contents
+    const Path entryPath = CookedCache::GetEntryPath(key);
+    const Path tmpEntryPath = cacheDir.Append(
+        key + "." + Thread::GetCurrentThreadId() + ".tmp");
+    File::Write(tmpEntryPath, bytes.Data(), bytes.Size());
+    File::Rename(tmpEntryPath, entryPath);
+}
+
+void CookedCache::CollectGarbage()
+{
+    const Path cacheDir = CookedCache::GetDirectory();
+    if (!cacheDir.IsDir())
+    {
+        return;
+    }
+
+    const uint64_t nowSecs = SCAST<uint64_t>(std::time(nullptr));
+    Array<CookedEntry> entries;
+    for (const Path &entryPath : cacheDir.GetFiles(FindFlag::SIMPLE_HIDDEN))
+    {
+        CookedEntry entry;
+        if (!GetEntryStamp(entryPath, &entry))
+        {
+            continue;
+        }
+
+        const uint64_t unusedTimeSecs =
+            (nowSecs > entry.lastUseTimeSecs) ? nowSecs - entry.lastUseTimeSecs
+                                              : 0;
+        const bool isTmpEntry = entryPath.HasExtension("tmp");
+        if (unusedTimeSecs > MaxUnusedTimeSecs ||
+            (isTmpEntry && unusedTimeSecs > MaxTmpEntryTimeSecs))
+        {
+            File::Remove(entryPath);
+        }
+        else if (!isTmpEntry)
+        {
+            entries.PushBack(entry);
+        }
+    }
+
+    uint64_t totalSize = 0;
+    for (const CookedEntry &entry : entries)
+    {
+        totalSize += entry.size;
+    }
+
+    if (totalSize > MaxTotalSize)
+    {
+        entries.Sort([](const CookedEntry &lhs, const CookedEntry &rhs) {
+            return lhs.lastUseTimeSecs < rhs.lastUseTimeSecs;
+        });
+        for (const CookedEntry &entry : entries)
+        {
+            if (totalSize <= MaxTotalSize)
+            {
+                break;
+            }
+            File::Remove(entry.path);
+            totalSize -= entry.size;
+        }
+    }
+}
+
+Path CookedCache::GetDirectory()
+{
+    const Path &projectDir = Paths::GetProjectDir();
+    const Path &rootDir =
+        projectDir.IsEmpty() ? Paths::GetEngineDir() : projectDir;
+    return rootDir.Append("Cache").Append("Cooked");
+}
+
+Path CookedCache::GetEntryPath(const String &key)
+{
+    return CookedCache::GetDirectory().Append(key);
+}
+
+void CookedCache::SetEnabled(bool enabled)
+{
+    s_cookedCacheEnabled = enabled;
+}
+
+bool CookedCache::IsEnabled()
+{
+    return s_cookedCacheEnabled;
+}
+
+void CookedWriter::Write(uint32_t value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+void CookedWriter::Write(float value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+void CookedWriter::Write(const String &str)
+{
+    Write(SCAST<uint32_t>(str.Size()));
+    WriteBytes(str.ToCString(), str.Size());
+}
+
+const Array<Byte> &CookedWriter::GetBytes() const
+{
+    return m_bytes;
+}
+
+void CookedWriter::WriteBytes(const void *data, std::size_t size)
+{
+    const Byte *bytes = SCAST<const Byte *>(data);
+    m_bytes.PushBack(bytes, bytes + size);
+}
+
+CookedReader::CookedReader(const Byte *data, std::size_t size)
+    : p_data(data), m_size(size)
+{
+}
+
+bool CookedReader::Read(uint32_t *value)
+{
+    return ReadBytes(value, sizeof(*value));
+}
+
+bool CookedReader::Read(float *value)
+{
+    return ReadBytes(value, sizeof(*value));
+}
+
+bool CookedReader::Read(String *str)
+{
+    uint32_t strSize = 0;
+    if (!Read(&strSize) || strSize > m_size - m_pos)
+    {
+        m_ok = false;
+        return false;
+    }
+
+    const char *strBegin = RCAST<const char *>(p_data + m_pos);
+    *str = String(strBegin, strBegin + strSize);
+    m_pos += strSize;
+    return true;
+}
+
+bool CookedReader::IsOk() const
+{
+    return m_ok;
+}
+
+bool CookedReader::IsAtEnd() const
+{
+    return (m_pos == m_size);
+}
+
+bool CookedReader::ReadBytes(void *data, std::size_t size)
+{
+    if (!m_ok || size > m_size - m_pos)
+    {
+        m_ok = false;
+        return false;
+    }
+
+    std::memcpy(data, p_data + m_pos, size);
+    m_pos += size;
+    return true;
+}
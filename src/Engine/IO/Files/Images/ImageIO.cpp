@@ -9,16 +9,20 @@
 #include <pngconf.h>
 #include <setjmp.h>
 #include <stdint.h>
+#include <zlib.h>
+#include <algorithm>
 #include <fstream>
 
 #include "Bang/Array.h"
 #include "Bang/Array.tcc"
 #include "Bang/Assert.h"
 #include "BangMath/Color.h"
+#include "Bang/CookedCache.h"
 #include "Bang/Debug.h"
 #include "Bang/Image.h"
 #include "Bang/ImageIODDS.h"
 #include "Bang/ImageIOTGA.h"
+#include "Bang/MappedFile.h"
 #include "Bang/Path.h"
 #include "Bang/StreamOperators.h"
 #include "Bang/String.h"
@@ -54,7 +58,19 @@ void ImageIO::Import(const Path &filepath, Image *img, bool *_ok)
 {
     bool ok = false;
 
-    if (filepath.HasExtension("png"))
+    // Decoded images are cooked, so that importing them again is a copy
+    String cookedKey = "";
+    if (filepath.HasExtension(Array<String>({"png", "jpg", "jpeg", "tga"})))
+    {
+        cookedKey = CookedCache::GetKey(filepath, "image", 2);
+    }
+
+    const bool cooked = ImageIO::ImportCooked(cookedKey, img);
+    if (cooked)
+    {
+        ok = true;
+    }
+    else if (filepath.HasExtension("png"))
     {
         ImageIO::ImportPNG(filepath, img, &ok);
     }
@@ -80,12 +96,84 @@ void ImageIO::Import(const Path &filepath, Image *img, bool *_ok)
                                                       << "'");
     }
 
+    if (ok && !cooked)
+    {
+        ImageIO::ExportCooked(cookedKey, *img);
+    }
+
     if (_ok)
     {
         *_ok = ok;
     }
 }
 
+bool ImageIO::ImportCooked(const String &cookedKey, Image *img)
+{
+    MappedFile cookedFile;
+    if (!CookedCache::Read(cookedKey, &cookedFile))
+    {
+        return false;
+    }
+
+    CookedReader reader(cookedFile.GetData(), cookedFile.GetSize());
+    uint32_t width = 0, height = 0, pixelsSize = 0, compressedSize = 0;
+    reader.Read(&width);
+    reader.Read(&height);
+    reader.Read(&pixelsSize);
+    reader.Read(&compressedSize);
+    if (!reader.IsOk() ||
+        SCAST<uint64_t>(pixelsSize) != SCAST<uint64_t>(width) * height * 4 ||
+        SCAST<uint64_t>(compressedSize) + 4 * sizeof(uint32_t) !=
+            cookedFile.GetSize())
+    {
+        return false;
+    }
+
+    // The compressed pixels go last, inflated straight from the mapped entry
+    img->Create(SCAST<int>(width), SCAST<int>(height));
+    const Byte *compressedPixels = cookedFile.GetData() + 4 * sizeof(uint32_t);
+    uLongf uncompressedSize = pixelsSize;
+    return (uncompress(img->GetData(),
+                       &uncompressedSize,
+                       compressedPixels,
+                       compressedSize) == Z_OK) &&
+           (uncompressedSize == pixelsSize);
+}
+
+void ImageIO::ExportCooked(const String &cookedKey, const Image &img)
+{
+    if (cookedKey.IsEmpty())
+    {
+        return;
+    }
+
+    // Raw RGBA would make the entries several times bigger than the source
+    // files. The fastest deflate level keeps most of the gain, and inflating
+    // is still much faster than decoding the source.
+    const uint32_t width = SCAST<uint32_t>(img.GetWidth());
+    const uint32_t height = SCAST<uint32_t>(img.GetHeight());
+    const uint32_t pixelsSize = width * height * 4;
+    uLongf compressedSize = compressBound(pixelsSize);
+    Array<Byte> compressedPixels;
+    compressedPixels.Resize(compressedSize);
+    if (compress2(compressedPixels.Data(),
+                  &compressedSize,
+                  img.GetData(),
+                  pixelsSize,
+                  Z_BEST_SPEED) != Z_OK)
+    {
+        return;
+    }
+    compressedPixels.Resize(compressedSize);
+
+    CookedWriter writer;
+    writer.Write(width);
+    writer.Write(height);
+    writer.Write(pixelsSize);
+    writer.WriteArray(compressedPixels);
+    CookedCache::Write(cookedKey, writer.GetBytes());
+}
+
 void ImageIO::Import(const Path &filepath,
                      Image *img,
                      Texture2D *tex,
@@ -0,0 +1,130 @@
+#include "Bang/MappedFile.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif _WIN32
+#include <Windows.h>
+#endif
+
+using namespace Bang;
+
+MappedFile::MappedFile()
+{
+}
+
+MappedFile::MappedFile(const Path &filepath)
+{
+    Open(filepath);
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const Path &filepath)
+{
+    Close();
+    if (!filepath.IsFile())
+    {
+        return false;
+    }
+
+    // The handles can be closed right after mapping, the mapping keeps the
+    // file alive until it is unmapped
+#ifdef __linux__
+    int fd = open(filepath.GetAbsolute().ToCString(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        const std::size_t size = SCAST<std::size_t>(fileStat.st_size);
+        void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            p_data = SCAST<const Byte *>(data);
+            m_size = size;
+        }
+    }
+    close(fd);
+#elif _WIN32
+    HANDLE file = CreateFileA(filepath.GetAbsolute().ToCString(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              NULL,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        HANDLE mapping =
+            CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping)
+        {
+            void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (data)
+            {
+                p_data = SCAST<const Byte *>(data);
+                m_size = SCAST<std::size_t>(fileSize.QuadPart);
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#endif
+
+    if (IsOpen())
+    {
+        m_path = filepath;
+    }
+    return IsOpen();
+}
+
+void MappedFile::Close()
+{
+    if (p_data)
+    {
+#ifdef __linux__
+        munmap(const_cast<Byte *>(p_data), m_size);
+#elif _WIN32
+        UnmapViewOfFile(p_data);
+#endif
+    }
+
+    p_data = nullptr;
+    m_size = 0;
+    m_path = Path::Empty();
+}
+
+bool MappedFile::IsOpen() const
+{
+    return (p_data != nullptr);
+}
+
+const Byte *MappedFile::GetData() const
+{
+    return p_data;
+}
+
+std::size_t MappedFile::GetSize() const
+{
+    return m_size;
+}
+
+const Path &MappedFile::GetPath() const
+{
+    return m_path;
+}
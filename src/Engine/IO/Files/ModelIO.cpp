@@ -29,11 +29,13 @@
 #include "Bang/Assets.h"
 #include "Bang/Assets.tcc"
 #include "BangMath/Color.h"
+#include "Bang/CookedCache.h"
 #include "Bang/Debug.h"
 #include "Bang/Extensions.h"
 #include "Bang/GameObject.h"
 #include "Bang/GameObject.tcc"
 #include "Bang/List.tcc"
+#include "Bang/MappedFile.h"
 #include "Bang/Material.h"
 #include "Bang/Mesh.h"
 #include "Bang/MeshRenderer.h"
@@ -133,6 +135,82 @@ Matrix4 AiMatrix4ToMatrix4(const aiMatrix4x4 &m)
 }
 // ==================================================
 
+namespace Bang
+{
+// What is read from the model file, before creating any asset. It is what
+// gets cooked, so that importing the model again does not need assimp.
+struct ModelIORawMaterial
+{
+    String name;
+    Color albedoColor = Color::White();
+    String albedoTexturePath;
+    String normalsTexturePath;
+};
+
+struct ModelIORawBone
+{
+    String name;
+    Matrix4 offsetMatrix;
+    Array<Mesh::VertexId> vertexIds;
+    Array<float> weights;
+};
+
+struct ModelIORawMesh
+{
+    String name;
+    Array<Mesh::VertexId> vertexIndices;
+    Array<Vector3> positions;
+    Array<Vector3> normals;
+    Array<Vector2> uvs;
+    Array<Vector3> tangents;
+    Array<ModelIORawBone> bones;
+};
+
+struct ModelIORawAnimationChannel
+{
+    String boneName;
+    Array<Animation::KeyFrame<Vector3>> positionKeyFrames;
+    Array<Animation::KeyFrame<Quaternion>> rotationKeyFrames;
+    Array<Animation::KeyFrame<Vector3>> scaleKeyFrames;
+};
+
+struct ModelIORawAnimation
+{
+    String name;
+    float durationInFrames = 0.0f;
+    float framesPerSecond = 0.0f;
+    Array<ModelIORawAnimationChannel> channels;
+};
+
+struct ModelIORawScene
+{
+    Array<ModelIORawMaterial> materials;
+    Array<ModelIORawMesh> meshes;
+    Array<ModelIORawAnimation> animations;
+    String rootName;
+    Tree<ModelIONode> *modelTree = nullptr;
+
+    ModelIORawScene() = default;
+    ModelIORawScene(const ModelIORawScene &) = delete;
+    ModelIORawScene &operator=(const ModelIORawScene &) = delete;
+
+    ~ModelIORawScene()
+    {
+        Clear();
+    }
+
+    void Clear()
+    {
+        materials.Clear();
+        meshes.Clear();
+        animations.Clear();
+        rootName = "";
+        delete modelTree;
+        modelTree = nullptr;
+    }
+};
+}
+
 Tree<ModelIONode> *ReadModelNode(const aiScene *scene, aiNode *node)
 {
     Tree<ModelIONode> *modelNodeTree = new Tree<ModelIONode>();
@@ -160,23 +238,256 @@ Tree<ModelIONode> *ReadModelNode(const aiScene *scene, aiNode *node)
     return modelNodeTree;
 }
 
+void ReadRawMesh(aiMesh *aMesh, ModelIORawMesh *rawMesh)
+{
+    rawMesh->name = AiStringToString(aMesh->mName);
+
+    for (uint i = 0; i < aMesh->mNumFaces; ++i)
+    {
+        for (uint j = 0; j < aMesh->mFaces[i].mNumIndices; ++j)
+        {
+            Mesh::VertexId vIndex = aMesh->mFaces[i].mIndices[j];
+            rawMesh->vertexIndices.PushBack(vIndex);
+        }
+    }
+
+    // Positions
+    rawMesh->positions.Reserve(aMesh->mNumVertices);
+    for (uint i = 0; i < aMesh->mNumVertices; ++i)
+    {
+        rawMesh->positions.PushBack(AiVec3ToVec3(aMesh->mVertices[i]));
+    }
+
+    // Normals
+    rawMesh->normals.Reserve(aMesh->mNumVertices);
+    for (uint i = 0; i < aMesh->mNumVertices; ++i)
+    {
+        rawMesh->normals.PushBack(AiVec3ToVec3(aMesh->mNormals[i]));
+    }
+
+    // Uvs
+    if (aMesh->GetNumUVChannels() > 0)
+    {
+        rawMesh->uvs.Reserve(aMesh->mNumVertices);
+        for (uint i = 0; i < aMesh->mNumVertices; ++i)
+        {
+            Vector3 uvs = AiVec3ToVec3(aMesh->mTextureCoords[0][i]);
+            rawMesh->uvs.PushBack(uvs.xy());
+        }
+    }
+
+    // Tangents
+    if (aMesh->HasTangentsAndBitangents())
+    {
+        rawMesh->tangents.Reserve(aMesh->mNumVertices);
+        for (uint i = 0; i < aMesh->mNumVertices; ++i)
+        {
+            rawMesh->tangents.PushBack(AiVec3ToVec3(aMesh->mTangents[i]));
+        }
+    }
+
+    // Bones
+    if (aMesh->HasBones())
+    {
+        for (uint boneIdx = 0; boneIdx < aMesh->mNumBones; ++boneIdx)
+        {
+            aiBone *aBone = aMesh->mBones[boneIdx];
+            ModelIORawBone rawBone;
+            rawBone.name = AiStringToString(aBone->mName);
+            rawBone.offsetMatrix = AiMatrix4ToMatrix4(aBone->mOffsetMatrix);
+            for (uint j = 0; j < aBone->mNumWeights; ++j)
+            {
+                const aiVertexWeight &aVertWeight = aBone->mWeights[j];
+                rawBone.vertexIds.PushBack(aVertWeight.mVertexId);
+                rawBone.weights.PushBack(aVertWeight.mWeight);
+            }
+            rawMesh->bones.PushBack(rawBone);
+        }
+    }
+}
+
+void ReadRawMaterial(aiMaterial *aMaterial, ModelIORawMaterial *rawMaterial)
+{
+    aiString aMatName;
+    aiGetMaterialString(aMaterial, AI_MATKEY_NAME, &aMatName);
+    rawMaterial->name = AiStringToString(aMatName);
+
+    aiColor3D aDiffuseColor = aiColor3D(1.0f, 1.0f, 1.0f);
+    aMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aDiffuseColor);
+    rawMaterial->albedoColor = AiColor3ToColor(aDiffuseColor);
+
+    aiString aAlbedoTexturePath;
+    aMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &aAlbedoTexturePath);
+    rawMaterial->albedoTexturePath = String(aAlbedoTexturePath.C_Str());
+
+    aiString aNormalsTexturePath;
+    aMaterial->GetTexture(aiTextureType_NORMALS, 0, &aNormalsTexturePath);
+    rawMaterial->normalsTexturePath = String(aNormalsTexturePath.C_Str());
+}
+
+void ReadRawAnimation(aiAnimation *aAnimation,
+                      ModelIORawAnimation *rawAnimation)
+{
+    rawAnimation->name = AiStringToString(aAnimation->mName);
+    rawAnimation->durationInFrames = aAnimation->mDuration;
+    rawAnimation->framesPerSecond = aAnimation->mTicksPerSecond;
+    for (uint j = 0; j < aAnimation->mNumChannels; ++j)
+    {
+        aiNodeAnim *aNodeAnim = aAnimation->mChannels[j];
+        ModelIORawAnimationChannel channel;
+        channel.boneName = AiStringToString(aNodeAnim->mNodeName);
+
+        for (uint k = 0; k < aNodeAnim->mNumPositionKeys; ++k)
+        {
+            Animation::KeyFrame<Vector3> keyFrame;
+            keyFrame.timeInFrames = aNodeAnim->mPositionKeys[k].mTime;
+            keyFrame.value = AiVec3ToVec3(aNodeAnim->mPositionKeys[k].mValue);
+            channel.positionKeyFrames.PushBack(keyFrame);
+        }
+
+        for (uint k = 0; k < aNodeAnim->mNumRotationKeys; ++k)
+        {
+            Animation::KeyFrame<Quaternion> keyFrame;
+            keyFrame.timeInFrames = aNodeAnim->mRotationKeys[k].mTime;
+            keyFrame.value = AiQuatToQuat(aNodeAnim->mRotationKeys[k].mValue);
+            channel.rotationKeyFrames.PushBack(keyFrame);
+        }
+
+        for (uint k = 0; k < aNodeAnim->mNumScalingKeys; ++k)
+        {
+            Animation::KeyFrame<Vector3> keyFrame;
+            keyFrame.timeInFrames = aNodeAnim->mScalingKeys[k].mTime;
+            keyFrame.value = AiVec3ToVec3(aNodeAnim->mScalingKeys[k].mValue);
+            channel.scaleKeyFrames.PushBack(keyFrame);
+        }
+        rawAnimation->channels.PushBack(channel);
+    }
+}
+
+void BuildRawMeshBones(const ModelIORawMesh &rawMesh,
+                       Map<String, Mesh::Bone> *bones,
+                       Map<String, uint> *bonesIndices)
+{
+    for (uint boneIdx = 0; boneIdx < rawMesh.bones.Size(); ++boneIdx)
+    {
+        const ModelIORawBone &rawBone = rawMesh.bones[boneIdx];
+        Mesh::Bone bone;
+        for (uint j = 0; j < rawBone.vertexIds.Size(); ++j)
+        {
+            bone.weights.Add(rawBone.vertexIds[j], rawBone.weights[j]);
+        }
+        bone.rootSpaceToBoneBindSpaceTransformation =
+            Transformation(rawBone.offsetMatrix);
+
+        bonesIndices->Add(rawBone.name, boneIdx);
+        bones->Add(rawBone.name, bone);
+    }
+}
+
+void CookModelNode(const Tree<ModelIONode> *modelNodeTree,
+                   CookedWriter *writer)
+{
+    const ModelIONode &modelNode = modelNodeTree->GetData();
+    writer->Write(modelNode.name);
+    writer->WriteData(modelNode.localToParent);
+    writer->WriteArray(modelNode.meshIndices);
+    writer->WriteArray(modelNode.meshMaterialIndices);
+
+    const auto &children = modelNodeTree->GetChildren();
+    writer->Write(SCAST<uint32_t>(children.Size()));
+    for (const Tree<ModelIONode> *child : children)
+    {
+        CookModelNode(child, writer);
+    }
+}
+
+Tree<ModelIONode> *UncookModelNode(CookedReader *reader)
+{
+    Tree<ModelIONode> *modelNodeTree = new Tree<ModelIONode>();
+    ModelIONode &modelNode = modelNodeTree->GetData();
+    reader->Read(&modelNode.name);
+    reader->ReadData(&modelNode.localToParent);
+    reader->ReadArray(&modelNode.meshIndices);
+    reader->ReadArray(&modelNode.meshMaterialIndices);
+
+    uint32_t numChildren = 0;
+    reader->Read(&numChildren);
+    for (uint32_t i = 0; i < numChildren && reader->IsOk(); ++i)
+    {
+        Tree<ModelIONode> *childModelTree = UncookModelNode(reader);
+        childModelTree->SetParent(modelNodeTree);
+    }
+    return modelNodeTree;
+}
+
+void CookRawScene(const ModelIORawScene &rawScene, CookedWriter *writer)
+{
+    writer->Write(SCAST<uint32_t>(rawScene.materials.Size()));
+    for (const ModelIORawMaterial &rawMaterial : rawScene.materials)
+    {
+        writer->Write(rawMaterial.name);
+        writer->WriteData(rawMaterial.albedoColor);
+        writer->Write(rawMaterial.albedoTexturePath);
+        writer->Write(rawMaterial.normalsTexturePath);
+    }
+
+    writer->Write(SCAST<uint32_t>(rawScene.meshes.Size()));
+    for (const ModelIORawMesh &rawMesh : rawScene.meshes)
+    {
+        writer->Write(rawMesh.name);
+        writer->WriteArray(rawMesh.vertexIndices);
+        writer->WriteArray(rawMesh.positions);
+        writer->WriteArray(rawMesh.normals);
+        writer->WriteArray(rawMesh.uvs);
+        writer->WriteArray(rawMesh.tangents);
+
+        writer->Write(SCAST<uint32_t>(rawMesh.bones.Size()));
+        for (const ModelIORawBone &rawBone : rawMesh.bones)
+        {
+            writer->Write(rawBone.name);
+            writer->WriteData(rawBone.offsetMatrix);
+            writer->WriteArray(rawBone.vertexIds);
+            writer->WriteArray(rawBone.weights);
+        }
+    }
+
+    writer->Write(SCAST<uint32_t>(rawScene.animations.Size()));
+    for (const ModelIORawAnimation &rawAnimation : rawScene.animations)
+    {
+        writer->Write(rawAnimation.name);
+        writer->Write(rawAnimation.durationInFrames);
+        writer->Write(rawAnimation.framesPerSecond);
+
+        writer->Write(SCAST<uint32_t>(rawAnimation.channels.Size()));
+        for (const ModelIORawAnimationChannel &channel : rawAnimation.channels)
+        {
+            writer->Write(channel.boneName);
+            writer->WriteArray(channel.positionKeyFrames);
+            writer->WriteArray(channel.rotationKeyFrames);
+            writer->WriteArray(channel.scaleKeyFrames);
+        }
+    }
+
+    writer->Write(rawScene.rootName);
+    CookModelNode(rawScene.modelTree, writer);
+}
+
 bool ModelIO::ImportModel(const Path &modelFilepath,
                           Model *model,
                           ModelIOScene *modelScene)
 {
-    Assimp::Importer importer;
-    const aiScene *aScene = ImportScene(&importer, modelFilepath);
-    if (!aScene)
+    ModelIORawScene rawScene;
+    if (!ModelIO::ImportRawScene(modelFilepath, &rawScene))
     {
         return false;
     }
 
     // Load materials
-    for (int i = 0; i < SCAST<int>(aScene->mNumMaterials); ++i)
+    for (const ModelIORawMaterial &rawMaterial : rawScene.materials)
     {
         String materialName;
         AH<Material> materialAH;
-        ModelIO::ImportEmbeddedMaterial(aScene->mMaterials[i],
+        ModelIO::ImportEmbeddedMaterial(rawMaterial,
                                         modelFilepath.GetDirectory(),
                                         model,
                                         &materialAH,
@@ -187,12 +498,11 @@ bool ModelIO::ImportModel(const Path &modelFilepath,
 
     // Load meshes
     Map<String, Mesh::Bone> allBones;
-    for (int i = 0; i < SCAST<int>(aScene->mNumMeshes); ++i)
+    for (const ModelIORawMesh &rawMesh : rawScene.meshes)
     {
         AH<Mesh> meshAH;
         String meshName;
-        ModelIO::ImportEmbeddedMesh(
-            aScene->mMeshes[i], model, &meshAH, &meshName);
+        ModelIO::ImportEmbeddedMesh(rawMesh, model, &meshAH, &meshName);
         modelScene->meshes.PushBack(meshAH);
         modelScene->meshesNames.PushBack(meshName);
 
@@ -204,10 +514,9 @@ bool ModelIO::ImportModel(const Path &modelFilepath,
     }
 
     // Load animations and store them into arrays
-    for (int i = 0; i < SCAST<int>(aScene->mNumAnimations); ++i)
+    for (const ModelIORawAnimation &rawAnimation : rawScene.animations)
     {
-        aiAnimation *aAnimation = aScene->mAnimations[i];
-        String animationName = AiStringToString(aAnimation->mName);
+        String animationName = rawAnimation.name;
         if (animationName.IsEmpty())
         {
             animationName = "Animation";
@@ -218,41 +527,21 @@ bool ModelIO::ImportModel(const Path &modelFilepath,
         AH<Animation> animationAH =
             Assets::CreateEmbeddedAsset<Animation>(model, animationName);
         Animation *animation = animationAH.Get();
-        double animDuration = aAnimation->mDuration;
-        animation->SetDurationInFrames(animDuration);
-        animation->SetFramesPerSecond(aAnimation->mTicksPerSecond);
-        for (int j = 0; j < SCAST<int>(aAnimation->mNumChannels); ++j)
+        animation->SetDurationInFrames(rawAnimation.durationInFrames);
+        animation->SetFramesPerSecond(rawAnimation.framesPerSecond);
+        for (const ModelIORawAnimationChannel &channel : rawAnimation.channels)
         {
-            aiNodeAnim *aNodeAnim = aAnimation->mChannels[j];
-            String boneName = AiStringToString(aNodeAnim->mNodeName);
-
-            for (uint k = 0; k < aNodeAnim->mNumPositionKeys;
-                 ++k)  // Position keys
+            for (const auto &keyFrame : channel.positionKeyFrames)
             {
-                Animation::KeyFrame<Vector3> keyFrame;
-                keyFrame.timeInFrames = aNodeAnim->mPositionKeys[k].mTime;
-                keyFrame.value =
-                    AiVec3ToVec3(aNodeAnim->mPositionKeys[k].mValue);
-                animation->AddPositionKeyFrame(boneName, keyFrame);
+                animation->AddPositionKeyFrame(channel.boneName, keyFrame);
             }
-
-            for (uint k = 0; k < aNodeAnim->mNumRotationKeys;
-                 ++k)  // Rotation keys
+            for (const auto &keyFrame : channel.rotationKeyFrames)
             {
-                Animation::KeyFrame<Quaternion> keyFrame;
-                keyFrame.timeInFrames = aNodeAnim->mRotationKeys[k].mTime;
-                keyFrame.value =
-                    AiQuatToQuat(aNodeAnim->mRotationKeys[k].mValue);
-                animation->AddRotationKeyFrame(boneName, keyFrame);
+                animation->AddRotationKeyFrame(channel.boneName, keyFrame);
             }
-
-            for (uint k = 0; k < aNodeAnim->mNumScalingKeys; ++k)  // Scale keys
+            for (const auto &keyFrame : channel.scaleKeyFrames)
             {
-                Animation::KeyFrame<Vector3> keyFrame;
-                keyFrame.timeInFrames = aNodeAnim->mScalingKeys[k].mTime;
-                keyFrame.value =
-                    AiVec3ToVec3(aNodeAnim->mScalingKeys[k].mValue);
-                animation->AddScaleKeyFrame(boneName, keyFrame);
+                animation->AddScaleKeyFrame(channel.boneName, keyFrame);
             }
         }
         modelScene->animations.PushBack(animationAH);
@@ -260,86 +549,192 @@ bool ModelIO::ImportModel(const Path &modelFilepath,
     }
 
     modelScene->allBones = allBones;
-    modelScene->rootGameObjectName = AiStringToString(aScene->mRootNode->mName);
-    modelScene->modelTree = ReadModelNode(aScene, aScene->mRootNode);
+    modelScene->rootGameObjectName = rawScene.rootName;
+    modelScene->modelTree = rawScene.modelTree;
+    rawScene.modelTree = nullptr;
 
     return true;
 }
 
-void ModelIO::ImportMeshRaw(aiMesh *aMesh,
-                            Array<Mesh::VertexId> *vertexIndices,
-                            Array<Vector3> *vertexPositionsPool,
-                            Array<Vector3> *vertexNormalsPool,
-                            Array<Vector2> *vertexUvsPool,
-                            Array<Vector3> *vertexTangentsPool,
-                            Map<String, Mesh::Bone> *bones,
-                            Map<String, uint> *bonesIndices)
+bool ModelIO::ImportModelRaw(const Path &modelFilepath,
+                             Array<Byte> *rawSceneBytes)
 {
-    for (uint i = 0; i < aMesh->mNumFaces; ++i)
+    ModelIORawScene rawScene;
+    if (!ModelIO::ImportRawScene(modelFilepath, &rawScene))
     {
-        for (uint j = 0; j < aMesh->mFaces[i].mNumIndices; ++j)
+        return false;
+    }
+
+    CookedWriter writer;
+    CookRawScene(rawScene, &writer);
+    *rawSceneBytes = writer.GetBytes();
+    return true;
+}
+
+bool ModelIO::ImportRawScene(const Path &modelFilepath,
+                             ModelIORawScene *rawScene)
+{
+    // Read the model from the cooked cache, or from the model file with
+    // assimp, cooking it for the next time
+    const String cookedKey = CookedCache::GetKey(modelFilepath, "model", 1);
+    if (!ModelIO::ImportCookedRawScene(cookedKey, rawScene))
+    {
+        rawScene->Clear();
+        if (!ModelIO::ReadRawScene(modelFilepath, rawScene))
         {
-            Mesh::VertexId vIndex = aMesh->mFaces[i].mIndices[j];
-            vertexIndices->PushBack(vIndex);
+            return false;
         }
+        ModelIO::ExportCookedRawScene(cookedKey, *rawScene);
     }
+    return true;
+}
 
-    // Positions
-    for (uint i = 0; i < aMesh->mNumVertices; ++i)
+bool ModelIO::ReadRawScene(const Path &modelFilepath,
+                           ModelIORawScene *rawScene)
+{
+    Assimp::Importer importer;
+    const aiScene *aScene = ImportScene(&importer, modelFilepath);
+    if (!aScene)
     {
-        Vector3 pos = AiVec3ToVec3(aMesh->mVertices[i]);
-        vertexPositionsPool->PushBack(pos);
+        return false;
     }
 
-    // Normals
-    for (uint i = 0; i < aMesh->mNumVertices; ++i)
+    rawScene->materials.Resize(aScene->mNumMaterials);
+    for (uint i = 0; i < aScene->mNumMaterials; ++i)
     {
-        Vector3 normal = AiVec3ToVec3(aMesh->mNormals[i]);
-        vertexNormalsPool->PushBack(normal);
+        ReadRawMaterial(aScene->mMaterials[i], &rawScene->materials[i]);
     }
 
-    // Uvs
-    if (aMesh->GetNumUVChannels() > 0)
+    rawScene->meshes.Resize(aScene->mNumMeshes);
+    for (uint i = 0; i < aScene->mNumMeshes; ++i)
     {
-        for (uint i = 0; i < aMesh->mNumVertices; ++i)
-        {
-            Vector3 uvs = AiVec3ToVec3(aMesh->mTextureCoords[0][i]);
-            vertexUvsPool->PushBack(uvs.xy());
-        }
+        ReadRawMesh(aScene->mMeshes[i], &rawScene->meshes[i]);
     }
 
-    // Tangents
-    if (aMesh->HasTangentsAndBitangents())
+    rawScene->animations.Resize(aScene->mNumAnimations);
+    for (uint i = 0; i < aScene->mNumAnimations; ++i)
     {
-        for (uint i = 0; i < aMesh->mNumVertices; ++i)
-        {
-            Vector3 tangent = AiVec3ToVec3(aMesh->mTangents[i]);
-            vertexTangentsPool->PushBack(tangent);
-        }
+        ReadRawAnimation(aScene->mAnimations[i], &rawScene->animations[i]);
     }
 
-    // Bones
-    if (aMesh->HasBones())
+    rawScene->rootName = AiStringToString(aScene->mRootNode->mName);
+    rawScene->modelTree = ReadModelNode(aScene, aScene->mRootNode);
+    return true;
+}
+
+bool ModelIO::ImportCookedRawScene(const String &cookedKey,
+                                   ModelIORawScene *rawScene)
+{
+    MappedFile cookedFile;
+    if (!CookedCache::Read(cookedKey, &cookedFile))
     {
-        for (uint boneIdx = 0; boneIdx < aMesh->mNumBones; ++boneIdx)
-        {
-            Mesh::Bone bone;
-            aiBone *aBone = aMesh->mBones[boneIdx];
-            String boneName = AiStringToString(aBone->mName);
+        return false;
+    }
 
-            // Set weights
-            for (uint j = 0; j < aBone->mNumWeights; ++j)
+    CookedReader reader(cookedFile.GetData(), cookedFile.GetSize());
+    uint32_t numMaterials = 0;
+    reader.Read(&numMaterials);
+    for (uint32_t i = 0; i < numMaterials && reader.IsOk(); ++i)
+    {
+        ModelIORawMaterial rawMaterial;
+        reader.Read(&rawMaterial.name);
+        reader.ReadData(&rawMaterial.albedoColor);
+        reader.Read(&rawMaterial.albedoTexturePath);
+        reader.Read(&rawMaterial.normalsTexturePath);
+        rawScene->materials.PushBack(rawMaterial);
+    }
+
+    uint32_t numMeshes = 0;
+    reader.Read(&numMeshes);
+    for (uint32_t i = 0; i < numMeshes && reader.IsOk(); ++i)
+    {
+        rawScene->meshes.PushBack(ModelIORawMesh());
+        ModelIORawMesh &rawMesh = rawScene->meshes.Back();
+        reader.Read(&rawMesh.name);
+        reader.ReadArray(&rawMesh.vertexIndices);
+        reader.ReadArray(&rawMesh.positions);
+        reader.ReadArray(&rawMesh.normals);
+        reader.ReadArray(&rawMesh.uvs);
+        reader.ReadArray(&rawMesh.tangents);
+
+        uint32_t numBones = 0;
+        reader.Read(&numBones);
+        for (uint32_t j = 0; j < numBones && reader.IsOk(); ++j)
+        {
+            ModelIORawBone rawBone;
+            reader.Read(&rawBone.name);
+            reader.ReadData(&rawBone.offsetMatrix);
+            reader.ReadArray(&rawBone.vertexIds);
+            reader.ReadArray(&rawBone.weights);
+            if (rawBone.weights.Size() != rawBone.vertexIds.Size())
             {
-                const aiVertexWeight &aVertWeight = aBone->mWeights[j];
-                bone.weights.Add(aVertWeight.mVertexId, aVertWeight.mWeight);
+                return false;
             }
-            bone.rootSpaceToBoneBindSpaceTransformation =
-                Transformation(AiMatrix4ToMatrix4(aBone->mOffsetMatrix));
+            rawMesh.bones.PushBack(rawBone);
+        }
+    }
 
-            bonesIndices->Add(boneName, boneIdx);
-            bones->Add(boneName, bone);
+    uint32_t numAnimations = 0;
+    reader.Read(&numAnimations);
+    for (uint32_t i = 0; i < numAnimations && reader.IsOk(); ++i)
+    {
+        rawScene->animations.PushBack(ModelIORawAnimation());
+        ModelIORawAnimation &rawAnimation = rawScene->animations.Back();
+        reader.Read(&rawAnimation.name);
+        reader.Read(&rawAnimation.durationInFrames);
+        reader.Read(&rawAnimation.framesPerSecond);
+
+        uint32_t numChannels = 0;
+        reader.Read(&numChannels);
+        for (uint32_t j = 0; j < numChannels && reader.IsOk(); ++j)
+        {
+            ModelIORawAnimationChannel channel;
+            reader.Read(&channel.boneName);
+            reader.ReadArray(&channel.positionKeyFrames);
+            reader.ReadArray(&channel.rotationKeyFrames);
+            reader.ReadArray(&channel.scaleKeyFrames);
+            rawAnimation.channels.PushBack(channel);
         }
     }
+
+    reader.Read(&rawScene->rootName);
+    rawScene->modelTree = UncookModelNode(&reader);
+
+    // If the entry is broken, the model file is read instead
+    return reader.IsOk() && reader.IsAtEnd();
+}
+
+void ModelIO::ExportCookedRawScene(const String &cookedKey,
+                                   const ModelIORawScene &rawScene)
+{
+    if (cookedKey.IsEmpty())
+    {
+        return;
+    }
+
+    CookedWriter writer;
+    CookRawScene(rawScene, &writer);
+    CookedCache::Write(cookedKey, writer.GetBytes());
+}
+
+void ModelIO::ImportMeshRaw(aiMesh *aMesh,
+                            Array<Mesh::VertexId> *vertexIndices,
+                            Array<Vector3> *vertexPositionsPool,
+                            Array<Vector3> *vertexNormalsPool,
+                            Array<Vector2> *vertexUvsPool,
+                            Array<Vector3> *vertexTangentsPool,
+                            Map<String, Mesh::Bone> *bones,
+                            Map<String, uint> *bonesIndices)
+{
+    ModelIORawMesh rawMesh;
+    ReadRawMesh(aMesh, &rawMesh);
+
+    vertexIndices->PushBack(rawMesh.vertexIndices);
+    vertexPositionsPool->PushBack(rawMesh.positions);
+    vertexNormalsPool->PushBack(rawMesh.normals);
+    vertexUvsPool->PushBack(rawMesh.uvs);
+    vertexTangentsPool->PushBack(rawMesh.tangents);
+    BuildRawMeshBones(rawMesh, bones, bonesIndices);
 }
 
 void ModelIO::ExportModel(const GameObject *rootGameObject,
@@ -684,15 +1079,13 @@ Path BestEffortTextureFind(const Path &modelDirectory, const Path &texturePath)
     return Path::Empty();
 }
 
-void ModelIO::ImportEmbeddedMaterial(aiMaterial *aMaterial,
+void ModelIO::ImportEmbeddedMaterial(const ModelIORawMaterial &rawMaterial,
                                      const Path &modelDirectory,
                                      Model *model,
                                      AH<Material> *outMaterial,
                                      String *outMaterialName)
 {
-    aiString aMatName;
-    aiGetMaterialString(aMaterial, AI_MATKEY_NAME, &aMatName);
-    String materialName = AiStringToString(aMatName);
+    String materialName = rawMaterial.name;
     if (materialName.IsEmpty())
     {
         materialName = "Material";
@@ -704,13 +1097,9 @@ void ModelIO::ImportEmbeddedMaterial(aiMaterial *aMaterial,
     *outMaterialName = materialName;
     *outMaterial = Assets::CreateEmbeddedAsset<Material>(model, materialName);
 
-    aiColor3D aDiffuseColor = aiColor3D(1.0f, 1.0f, 1.0f);
-    aMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aDiffuseColor);
-    Color albedoColor = AiColor3ToColor(aDiffuseColor);
+    Color albedoColor = rawMaterial.albedoColor;
 
-    aiString aAlbedoTexturePath;
-    aMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &aAlbedoTexturePath);
-    Path albedoTexturePath(String(aAlbedoTexturePath.C_Str()));
+    Path albedoTexturePath(rawMaterial.albedoTexturePath);
     albedoTexturePath =
         BestEffortTextureFind(modelDirectory, albedoTexturePath);
     AH<Texture2D> matAlbedoTexture;
@@ -719,9 +1108,7 @@ void ModelIO::ImportEmbeddedMaterial(aiMaterial *aMaterial,
         matAlbedoTexture = Assets::Load<Texture2D>(albedoTexturePath);
     }
 
-    aiString aNormalsTexturePath;
-    aMaterial->GetTexture(aiTextureType_NORMALS, 0, &aNormalsTexturePath);
-    Path normalsTexturePath(String(aNormalsTexturePath.C_Str()));
+    Path normalsTexturePath(rawMaterial.normalsTexturePath);
     normalsTexturePath =
         BestEffortTextureFind(modelDirectory, normalsTexturePath);
     AH<Texture2D> matNormalTexture;
@@ -747,13 +1134,12 @@ void ModelIO::ImportEmbeddedMaterial(aiMaterial *aMaterial,
                                                         : albedoColor);
 }
 
-void ModelIO::ImportEmbeddedMesh(aiMesh *aMesh,
+void ModelIO::ImportEmbeddedMesh(const ModelIORawMesh &rawMesh,
                                  Model *model,
                                  AH<Mesh> *outMeshAH,
                                  String *outMeshName)
 {
-    aiString aMeshName = aMesh->mName;
-    String meshName = AiStringToString(aMeshName);
+    String meshName = rawMesh.name;
     if (meshName.IsEmpty())
     {
         meshName = "Mesh";
@@ -765,32 +1151,22 @@ void ModelIO::ImportEmbeddedMesh(aiMesh *aMesh,
     *outMeshAH = Assets::CreateEmbeddedAsset<Mesh>(model, meshName);
     *outMeshName = meshName;
 
-    Array<Mesh::VertexId> vertexIndices;
-    Array<Vector3> vertexPositionsPool;
-    Array<Vector3> vertexNormalsPool;
-    Array<Vector2> vertexUvsPool;
-    Array<Vector3> vertexTangentsPool;
     Map<String, Mesh::Bone> bonesPool;
     Map<String, uint> bonesIndices;
-
-    ModelIO::ImportMeshRaw(aMesh,
-                           &vertexIndices,
-                           &vertexPositionsPool,
-                           &vertexNormalsPool,
-                           &vertexUvsPool,
-                           &vertexTangentsPool,
-                           &bonesPool,
-                           &bonesIndices);
+    BuildRawMeshBones(rawMesh, &bonesPool, &bonesIndices);
 
     Mesh *outMesh = outMeshAH->Get();
-    outMesh->SetPositionsPool(vertexPositionsPool);
-    outMesh->SetNormalsPool(vertexNormalsPool);
-    outMesh->SetUvsPool(vertexUvsPool);
-    outMesh->SetTangentsPool(vertexTangentsPool);
-    outMesh->SetTrianglesVertexIds(vertexIndices);
+    outMesh->SetPositionsPool(rawMesh.positions);
+    outMesh->SetNormalsPool(rawMesh.normals);
+    outMesh->SetUvsPool(rawMesh.uvs);
+    outMesh->SetTangentsPool(rawMesh.tangents);
+    outMesh->SetTrianglesVertexIds(rawMesh.vertexIndices);
     outMesh->SetBonesPool(bonesPool);
     outMesh->SetBonesIds(bonesIndices);
     outMesh->UpdateVAOs();
+
+    // Built here so that the renderers never have to simplify while drawing
+    outMesh->CalculateLODs();
 }
 
 const aiScene *ModelIO::ImportScene(Assimp::Importer *importer,
@@ -1,5 +1,8 @@
 #include "Bang/MetaFilesManager.h"
 
+#include <sys/stat.h>
+#include <atomic>
+#include <string>
 #include <vector>
 
 #include "Bang/Application.h"
@@ -9,16 +12,78 @@
 #include "Bang/AssetHandle.h"
 #include "Bang/Assets.h"
 #include "Bang/Assets.tcc"
+#include "Bang/CookedCache.h"
 #include "Bang/File.h"
+#include "Bang/JobSystem.h"
 #include "Bang/Map.tcc"
+#include "Bang/MappedFile.h"
+#include "Bang/MetaAttribute.h"
 #include "Bang/MetaNode.h"
+#include "Bang/MetaNodeBinary.h"
 #include "Bang/MetaNode.tcc"
 #include "Bang/Paths.h"
+#include "Bang/UMap.tcc"
 #include "Bang/USet.h"
 #include "Bang/USet.tcc"
 
 using namespace Bang;
 
+namespace Bang
+{
+struct MetaFilesManager::MetaFileEntry
+{
+    Path metaFilepath;
+    GUID guid;
+    uint64_t modificationTime = 0;
+    uint64_t size = 0;
+    bool isMetaFile = false;
+    bool hasFile = false;
+};
+}
+
+namespace
+{
+bool GetFileStamp(const Path &filepath,
+                  uint64_t *modificationTime,
+                  uint64_t *size)
+{
+#ifdef __linux__
+    struct stat attr;
+    if (stat(filepath.GetAbsolute().ToCString(), &attr) == 0)
+    {
+        *modificationTime =
+            SCAST<uint64_t>(attr.st_mtim.tv_sec) * 1000000000ull +
+            SCAST<uint64_t>(attr.st_mtim.tv_nsec);
+        *size = SCAST<uint64_t>(attr.st_size);
+        return true;
+    }
+#elif _WIN32
+    struct _stat64 attr;
+    if (_stat64(filepath.GetAbsolute().ToCString(), &attr) == 0)
+    {
+        *modificationTime = SCAST<uint64_t>(attr.st_mtime);
+        *size = SCAST<uint64_t>(attr.st_size);
+        return true;
+    }
+#endif
+    return false;
+}
+
+bool IsHiddenBelow(const Path &filepath, const Path &directory)
+{
+    const uint dirLength = directory.GetAbsolute().Size();
+    for (Path path = filepath; path.GetAbsolute().Size() > dirLength;
+         path = path.GetDirectory())
+    {
+        if (path.GetNameExt().BeginsWith("."))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
 MetaFilesManager::MetaFilesManager()
 {
 }
@@ -29,39 +94,264 @@ MetaFilesManager::~MetaFilesManager()
 
 void MetaFilesManager::CreateMissingMetaFiles(const Path &directory)
 {
+    Array<Path> filepaths;
+    MetaFilesManager::ScanDirectory(directory, &filepaths);
+
     // First load existing meta files, to avoid creating new meta files
     // with duplicated GUIDs.
-    MetaFilesManager::LoadMetaFilepathGUIDs(directory);
+    MetaFilesManager::LoadMetaFilepathGUIDs(directory, filepaths);
+
+    USet<Path> metaFilepaths;
+    for (const Path &filepath : filepaths)
+    {
+        if (filepath.HasExtension(GetMetaExtension()))
+        {
+            metaFilepaths.Add(filepath);
+        }
+    }
 
-    Array<Path> files = directory.GetFiles(FindFlag::RECURSIVE);
-    for (const Path &filepath : files)
+    for (const Path &filepath : filepaths)
     {
-        MetaFilesManager::CreateMetaFileIfMissing(filepath);
+        // Hidden files and anything inside hidden directories are skipped,
+        // as in FindFlag::RECURSIVE
+        if (!IsHiddenBelow(filepath, directory) &&
+            !metaFilepaths.Contains(GetMetaFilepath(filepath)))
+        {
+            MetaFilesManager::CreateMetaFileIfMissing(filepath);
+        }
     }
 }
 
 void MetaFilesManager::LoadMetaFilepathGUIDs(const Path &directory)
 {
-    Array<String> extensions = {GetMetaExtension()};
-    Array<Path> metaFilepaths =
-        directory.GetFiles(FindFlag::RECURSIVE_HIDDEN, extensions);
+    Array<Path> filepaths;
+    MetaFilesManager::ScanDirectory(directory, &filepaths);
+    MetaFilesManager::LoadMetaFilepathGUIDs(directory, filepaths);
+}
+
+void MetaFilesManager::ScanDirectory(const Path &directory,
+                                     Array<Path> *filepaths)
+{
+    // Same files as FindFlag::RECURSIVE_HIDDEN, listing the directories of
+    // each level in parallel
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    const bool canRunInParallel = (jobSystem && jobSystem->GetNumWorkers() > 0);
+
+    Array<Path> levelDirs;
+    if (directory.IsDir())
+    {
+        levelDirs.PushBack(directory);
+    }
+
+    while (!levelDirs.IsEmpty())
+    {
+        Array<Array<Path>> levelSubDirs(levelDirs.Size());
+        Array<Array<Path>> levelFiles(levelDirs.Size());
+        auto scanDirs = [&](uint begin, uint end) {
+            for (uint i = begin; i < end; ++i)
+            {
+                for (const Path &subPath :
+                     levelDirs[i].GetSubPaths(FindFlag::SIMPLE_HIDDEN))
+                {
+                    if (subPath.IsDir())
+                    {
+                        levelSubDirs[i].PushBack(subPath);
+                    }
+                    else if (subPath.IsFile())
+                    {
+                        levelFiles[i].PushBack(subPath);
+                    }
+                }
+            }
+        };
+
+        if (canRunInParallel && levelDirs.Size() > 1)
+        {
+            jobSystem->ParallelFor(0, levelDirs.Size(), 1, scanDirs);
+        }
+        else
+        {
+            scanDirs(0, levelDirs.Size());
+        }
+
+        levelDirs.Clear();
+        for (uint i = 0; i < levelFiles.Size(); ++i)
+        {
+            filepaths->PushBack(levelFiles[i]);
+            levelDirs.PushBack(levelSubDirs[i]);
+        }
+    }
+}
+
+void MetaFilesManager::LoadMetaFilepathGUIDs(const Path &directory,
+                                             const Array<Path> &filepaths)
+{
+    Array<MetaFileEntry> entries;
+    for (const Path &filepath : filepaths)
+    {
+        if (filepath.HasExtension(GetMetaExtension()))
+        {
+            entries.PushBack(MetaFileEntry());
+            entries.Back().metaFilepath = filepath;
+        }
+    }
+
+    // Only the meta files that changed since the index was written are read.
+    // The rest take their GUID from the index.
+    UMap<Path, MetaFileEntry> indexEntries;
+    MetaFilesManager::ReadMetaFilesIndex(directory, &indexEntries);
+
+    std::atomic<bool> indexChanged(indexEntries.Size() != entries.Size());
+    auto readEntries = [&](uint begin, uint end) {
+        for (uint i = begin; i < end; ++i)
+        {
+            MetaFileEntry &entry = entries[i];
+            entry.isMetaFile = IsMetaFile(entry.metaFilepath);
+            entry.hasFile =
+                entry.isMetaFile && GetFilepath(entry.metaFilepath).IsFile();
+            if (!entry.hasFile ||
+                !GetFileStamp(
+                    entry.metaFilepath, &entry.modificationTime, &entry.size))
+            {
+                entry.hasFile = false;
+                continue;
+            }
+
+            auto it = indexEntries.Find(entry.metaFilepath);
+            if (it != indexEntries.End() &&
+                it->second.modificationTime == entry.modificationTime &&
+                it->second.size == entry.size)
+            {
+                entry.guid = it->second.guid;
+            }
+            else
+            {
+                entry.guid = GetGUIDReadingMetaFilepath(entry.metaFilepath);
+                indexChanged = true;
+            }
+        }
+    };
+
+    JobSystem *jobSystem = JobSystem::GetInstance();
+    if (jobSystem && jobSystem->GetNumWorkers() > 0)
+    {
+        jobSystem->ParallelFor(0, entries.Size(), 0, readEntries);
+    }
+    else
+    {
+        readEntries(0, entries.Size());
+    }
 
     // Remove alone .meta files
-    for (const Path &metaFilepath : metaFilepaths)
+    for (const MetaFileEntry &entry : entries)
     {
-        if (IsMetaFile(metaFilepath) && !GetFilepath(metaFilepath).IsFile())
+        if (entry.isMetaFile && !entry.hasFile)
         {
-            File::Remove(metaFilepath);
+            File::Remove(entry.metaFilepath);
+            indexChanged = true;
         }
     }
 
     // Load GUID's of meta files!
-    for (const Path &metaFilepath : metaFilepaths)
+    for (const MetaFileEntry &entry : entries)
+    {
+        if (entry.hasFile)
+        {
+            RegisterFilepathGUID(GetFilepath(entry.metaFilepath), entry.guid);
+        }
+    }
+
+    if (indexChanged)
     {
-        RegisterMetaFilepath(metaFilepath);
+        MetaFilesManager::WriteMetaFilesIndex(directory, entries);
+    }
+
+    MetaFilesManager *mfm = MetaFilesManager::GetInstance();
+    if (!mfm->m_indexedDirectories.Contains(directory))
+    {
+        mfm->m_indexedDirectories.PushBack(directory);
+    }
+}
+
+void MetaFilesManager::ReadMetaFilesIndex(
+    const Path &directory,
+    UMap<Path, MetaFileEntry> *indexEntries)
+{
+    MappedFile indexFile;
+    if (!CookedCache::Read(GetMetaFilesIndexKey(directory), &indexFile))
+    {
+        return;
+    }
+
+    CookedReader reader(indexFile.GetData(), indexFile.GetSize());
+    uint32_t numEntries = 0;
+    reader.Read(&numEntries);
+    for (uint32_t i = 0; i < numEntries && reader.IsOk(); ++i)
+    {
+        MetaFileEntry entry;
+        String metaFilepathStr;
+        reader.Read(&metaFilepathStr);
+        reader.ReadData(&entry.modificationTime);
+        reader.ReadData(&entry.size);
+        reader.ReadData(&entry.guid);
+        entry.metaFilepath = Path(metaFilepathStr);
+        indexEntries->Add(entry.metaFilepath, entry);
+    }
+
+    if (!reader.IsOk() || !reader.IsAtEnd())
+    {
+        indexEntries->Clear();
     }
 }
 
+void MetaFilesManager::WriteMetaFilesIndex(const Path &directory,
+                                           const Array<MetaFileEntry> &entries)
+{
+    uint32_t numEntries = 0;
+    for (const MetaFileEntry &entry : entries)
+    {
+        numEntries += (entry.hasFile ? 1 : 0);
+    }
+
+    CookedWriter writer;
+    writer.Write(numEntries);
+    for (const MetaFileEntry &entry : entries)
+    {
+        if (entry.hasFile)
+        {
+            writer.Write(entry.metaFilepath.GetAbsolute());
+            writer.WriteData(entry.modificationTime);
+            writer.WriteData(entry.size);
+            writer.WriteData(entry.guid);
+        }
+    }
+    CookedCache::Write(GetMetaFilesIndexKey(directory), writer.GetBytes());
+}
+
+String MetaFilesManager::GetMetaFilesIndexKey(const Path &directory)
+{
+    const std::size_t directoryHash = std::hash<std::string>()(
+        std::string(directory.GetAbsolute().ToCString()));
+    return "MetaFilesIndex_" + String(std::to_string(directoryHash)) + ".v1";
+}
+
+bool MetaFilesManager::IsInIndexedDirectory(const Path &filepath)
+{
+    MetaFilesManager *mfm = MetaFilesManager::GetInstance();
+    for (const Path &indexedDirectory : mfm->m_indexedDirectories)
+    {
+        const String &dirStr = indexedDirectory.GetAbsolute();
+        const String &filepathStr = filepath.GetAbsolute();
+        if (filepathStr.Size() > dirStr.Size() &&
+            filepathStr.BeginsWith(dirStr) &&
+            filepathStr[dirStr.Size()] == Path::GetSeparator())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::pair<Path, GUID> MetaFilesManager::CreateMetaFileIfMissing(
     const Path &filepath)
 {
@@ -78,6 +368,12 @@ std::pair<Path, GUID> MetaFilesManager::CreateMetaFileIfMissing(
     else
     {
         newGUID = GetGUID(filepath);
+        if (newGUID.IsEmpty() && !IsMetaFile(filepath))
+        {
+            // Written by someone else after its directory was loaded
+            RegisterMetaFilepath(metaFilepath);
+            newGUID = GetGUID(filepath);
+        }
     }
     return std::make_pair(metaFilepath, newGUID);
 }
@@ -128,9 +424,6 @@ void MetaFilesManager::RegisterMetaFilepath(const Path &metaFilepath)
 {
     if (MetaFilesManager::IsMetaFile(metaFilepath))
     {
-        MetaNode metaNode;
-        metaNode.Import(metaFilepath);
-
         Path filepath = GetFilepath(metaFilepath);
         if (!filepath.IsFile())
         {
@@ -139,7 +432,7 @@ void MetaFilesManager::RegisterMetaFilepath(const Path &metaFilepath)
 
         if (filepath.IsFile())
         {
-            GUID guid = metaNode.Get<GUID>("GUID");
+            GUID guid = GetGUIDReadingMetaFilepath(metaFilepath);
             RegisterFilepathGUID(filepath, guid);
         }
     }
@@ -232,7 +525,8 @@ GUID MetaFilesManager::GetGUID(const Path &filepath)
     {
         if (!Assets::IsEmbeddedAsset(filepath))
         {
-            if (!filepath.IsFile())
+            // All the meta files of the indexed directories are registered
+            if (IsInIndexedDirectory(filepath) || !filepath.IsFile())
             {
                 return GUID::Empty();
             }
@@ -323,9 +617,25 @@ GUID MetaFilesManager::GetGUIDReadingMetaFilepath(const Path &metaFilepath)
     GUID guid = GUID::Empty();
     if (metaFilepath.IsFile() && MetaFilesManager::IsMetaFile(metaFilepath))
     {
-        MetaNode metaNode;
-        metaNode.Import(metaFilepath);
-        guid = metaNode.Get<GUID>("GUID");
+        // Binary metas are read in place, without building their whole tree
+        MappedFile mappedFile(metaFilepath);
+        MetaNodeBinaryView metaView = MetaNodeBinaryView::FromData(
+            mappedFile.GetData(), mappedFile.GetSize());
+        if (metaView.IsValid())
+        {
+            MetaNodeBinaryString guidString;
+            if (metaView.GetAttributeValue("GUID", &guidString))
+            {
+                guid = MetaAttribute("GUID", guidString.ToString())
+                           .Get<GUID>();
+            }
+        }
+        else
+        {
+            MetaNode metaNode;
+            metaNode.Import(metaFilepath);
+            guid = metaNode.Get<GUID>("GUID");
+        }
     }
     return guid;
 }
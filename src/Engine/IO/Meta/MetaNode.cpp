@@ -6,9 +6,10 @@
 #include <utility>
 
 #include "Bang/Debug.h"
-#include "Bang/File.h"
 #include "Bang/Map.tcc"
+#include "Bang/MappedFile.h"
 #include "Bang/MetaNode.tcc"
+#include "Bang/MetaNodeBinary.h"
 #include "Bang/Path.h"
 #include "Bang/StreamOperators.h"
 #include "yaml-cpp/emitter.h"
@@ -104,15 +105,8 @@ void MetaNode::RemoveAttribute(const String &attributeName)
 
 MetaAttribute *MetaNode::GetAttribute(const String &attributeName) const
 {
-    for (auto &itPair : m_attributes)
-    {
-        MetaAttribute &attr = itPair.second;
-        if (attr.GetName() == attributeName)
-        {
-            return &attr;
-        }
-    }
-    return nullptr;
+    auto it = m_attributes.Find(attributeName);
+    return (it != m_attributes.End()) ? &(it->second) : nullptr;
 }
 
 String MetaNode::GetAttributeValue(const String &attributeName) const
@@ -202,6 +196,11 @@ void MetaNode::ToString(YAML::Emitter &out) const
     out << YAML::EndMap;
 }
 
+void MetaNode::ToBinary(Array<Byte> *bytes) const
+{
+    MetaNodeBinary::Encode(*this, bytes);
+}
+
 const String &MetaNode::GetName() const
 {
     return m_name;
@@ -238,8 +237,9 @@ void MetaNode::Import(const String &metaString)
     const YAML::Node yamlNode = YAML::Load(metaString);
     if (!yamlNode.IsNull() && yamlNode.size() >= 1)
     {
-        const YAML::Node &rootNameYAMLNode = yamlNode.begin()->first;
-        const YAML::Node &rootMapYAMLNode = yamlNode.begin()->second;
+        // Copies, the iterator (and what it points to) is a temporary
+        const YAML::Node rootNameYAMLNode = yamlNode.begin()->first;
+        const YAML::Node rootMapYAMLNode = yamlNode.begin()->second;
 
         if (rootNameYAMLNode.IsDefined())
         {
@@ -267,6 +267,7 @@ void MetaNode::Import(const YAML::Node &yamlNode)
             {
                 const String &childrenContainerName = attrYAMLName.Scalar();
                 const YAML::Node &childrenYAMLNode = attrYAMLNode;
+                CreateChildrenContainer(childrenContainerName);
                 for (const auto &childYAMLPair : childrenYAMLNode)
                 {
                     const YAML::Node &childYAMLName = childYAMLPair.first;
@@ -285,12 +286,32 @@ void MetaNode::Import(const YAML::Node &yamlNode)
     }
 }
 
+bool MetaNode::Import(const Byte *data, std::size_t size)
+{
+    return MetaNodeBinary::Decode(data, size, this);
+}
+
 void MetaNode::Import(const Path &filepath)
 {
     if (filepath.IsFile())
     {
-        String fileContents = File::GetContents(filepath);
-        Import(fileContents);
+        // Binary files are told apart from YAML ones by their header
+        MappedFile mappedFile(filepath);
+        const Byte *data = mappedFile.GetData();
+        const std::size_t size = mappedFile.GetSize();
+        if (MetaNodeBinary::IsBinary(data, size))
+        {
+            if (!Import(data, size))
+            {
+                Debug_Error("Filepath " << filepath
+                                        << " is not a valid binary meta!");
+            }
+        }
+        else if (mappedFile.IsOpen())
+        {
+            Import(String(RCAST<const char *>(data),
+                          RCAST<const char *>(data) + size));
+        }
     }
     else
     {
@@ -301,7 +322,7 @@ void MetaNode::Import(const Path &filepath)
 bool MetaNode::operator==(const MetaNode &rhs) const
 {
     return (m_name == rhs.m_name) && (m_children == rhs.m_children) &&
-           (m_attributes == m_attributes);
+           (m_attributes == rhs.m_attributes);
 }
 
 bool MetaNode::operator!=(const MetaNode &rhs) const
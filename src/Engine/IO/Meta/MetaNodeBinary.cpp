@@ -0,0 +1,445 @@
+#include "Bang/MetaNodeBinary.h"
+
+#include <cstring>
+
+#include "Bang/Array.tcc"
+#include "Bang/Map.tcc"
+#include "Bang/MetaNode.h"
+#include "Bang/UMap.tcc"
+
+using namespace Bang;
+
+namespace
+{
+const Byte Magic[4] = {'B', 'M', 'N', 'B'};
+const uint32_t Version = 1;
+
+// Magic, version, number of strings and size of the string data
+const std::size_t HeaderSize = 16;
+
+// Size, name, number of attributes and number of children containers
+const std::size_t MinNodeSize = 16;
+
+// Size, name and number of children
+const std::size_t MinChildrenContainerSize = 12;
+
+// Nesting limit, so that a malformed buffer can not overflow the stack
+const uint MaxDepth = 1024;
+
+uint32_t ReadUint(const Byte *p)
+{
+    return SCAST<uint32_t>(p[0]) | (SCAST<uint32_t>(p[1]) << 8) |
+           (SCAST<uint32_t>(p[2]) << 16) | (SCAST<uint32_t>(p[3]) << 24);
+}
+
+void WriteUint(Array<Byte> *bytes, uint32_t v)
+{
+    bytes->PushBack(SCAST<Byte>(v));
+    bytes->PushBack(SCAST<Byte>(v >> 8));
+    bytes->PushBack(SCAST<Byte>(v >> 16));
+    bytes->PushBack(SCAST<Byte>(v >> 24));
+}
+
+void WriteUintAt(Array<Byte> *bytes, std::size_t pos, uint32_t v)
+{
+    (*bytes)[pos + 0] = SCAST<Byte>(v);
+    (*bytes)[pos + 1] = SCAST<Byte>(v >> 8);
+    (*bytes)[pos + 2] = SCAST<Byte>(v >> 16);
+    (*bytes)[pos + 3] = SCAST<Byte>(v >> 24);
+}
+
+class Encoder
+{
+public:
+    Array<Byte> m_nodeBytes;
+    Array<const String *> m_strings;
+
+    uint32_t Intern(const String &str)
+    {
+        auto it = m_stringIndices.Find(str);
+        if (it != m_stringIndices.End())
+        {
+            return it->second;
+        }
+
+        const uint32_t stringIndex = m_strings.Size();
+        m_stringIndices.Add(str, stringIndex);
+        m_strings.PushBack(&str);
+        return stringIndex;
+    }
+
+    void EncodeNode(const MetaNode &metaNode)
+    {
+        const std::size_t nodeBegin = m_nodeBytes.Size();
+        WriteUint(&m_nodeBytes, 0);
+        WriteUint(&m_nodeBytes, Intern(metaNode.GetName()));
+
+        const auto &attributes = metaNode.GetAttributes();
+        WriteUint(&m_nodeBytes, SCAST<uint32_t>(attributes.Size()));
+        for (const auto &pair : attributes)
+        {
+            const MetaAttribute &attr = pair.second;
+            WriteUint(&m_nodeBytes, Intern(attr.GetName()));
+            WriteUint(&m_nodeBytes, Intern(attr.GetStringValue()));
+        }
+
+        const auto &allChildren = metaNode.GetAllChildren();
+        WriteUint(&m_nodeBytes, SCAST<uint32_t>(allChildren.Size()));
+        for (const auto &pair : allChildren)
+        {
+            const std::size_t containerBegin = m_nodeBytes.Size();
+            WriteUint(&m_nodeBytes, 0);
+            WriteUint(&m_nodeBytes, Intern(pair.first));
+            WriteUint(&m_nodeBytes, pair.second.Size());
+            for (const MetaNode &childMetaNode : pair.second)
+            {
+                EncodeNode(childMetaNode);
+            }
+            WriteUintAt(&m_nodeBytes,
+                        containerBegin,
+                        SCAST<uint32_t>(m_nodeBytes.Size() - containerBegin));
+        }
+
+        WriteUintAt(&m_nodeBytes,
+                    nodeBegin,
+                    SCAST<uint32_t>(m_nodeBytes.Size() - nodeBegin));
+    }
+
+private:
+    // The keys point to strings of the MetaNode being encoded
+    UMap<String, uint32_t> m_stringIndices;
+};
+
+bool ValidateNode(const Byte *node,
+                  const Byte *end,
+                  uint32_t numStrings,
+                  uint depth)
+{
+    const std::size_t available = SCAST<std::size_t>(end - node);
+    if (depth > MaxDepth || available < MinNodeSize)
+    {
+        return false;
+    }
+
+    const uint32_t nodeSize = ReadUint(node);
+    if (nodeSize < MinNodeSize || nodeSize > available ||
+        ReadUint(node + 4) >= numStrings)
+    {
+        return false;
+    }
+
+    const Byte *nodeEnd = node + nodeSize;
+    const uint32_t numAttributes = ReadUint(node + 8);
+    const Byte *cursor = node + 12;
+    if (numAttributes > SCAST<std::size_t>(nodeEnd - cursor - 4) / 8)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < numAttributes; ++i, cursor += 8)
+    {
+        if (ReadUint(cursor) >= numStrings ||
+            ReadUint(cursor + 4) >= numStrings)
+        {
+            return false;
+        }
+    }
+
+    const uint32_t numContainers = ReadUint(cursor);
+    cursor += 4;
+    for (uint32_t i = 0; i < numContainers; ++i)
+    {
+        const std::size_t remaining = SCAST<std::size_t>(nodeEnd - cursor);
+        if (remaining < MinChildrenContainerSize)
+        {
+            return false;
+        }
+
+        const uint32_t containerSize = ReadUint(cursor);
+        if (containerSize < MinChildrenContainerSize ||
+            containerSize > remaining || ReadUint(cursor + 4) >= numStrings)
+        {
+            return false;
+        }
+
+        const Byte *containerEnd = cursor + containerSize;
+        const uint32_t numChildren = ReadUint(cursor + 8);
+        cursor += MinChildrenContainerSize;
+        for (uint32_t j = 0; j < numChildren; ++j)
+        {
+            if (!ValidateNode(cursor, containerEnd, numStrings, depth + 1))
+            {
+                return false;
+            }
+            cursor += ReadUint(cursor);
+        }
+
+        if (cursor != containerEnd)
+        {
+            return false;
+        }
+    }
+
+    return (cursor == nodeEnd);
+}
+}
+
+void MetaNodeBinary::Encode(const MetaNode &metaNode, Array<Byte> *bytes)
+{
+    Encoder encoder;
+    encoder.EncodeNode(metaNode);
+
+    std::size_t stringDataSize = 0;
+    for (const String *str : encoder.m_strings)
+    {
+        stringDataSize += str->Size();
+    }
+
+    const uint32_t numStrings = encoder.m_strings.Size();
+    bytes->Clear();
+    bytes->Reserve(HeaderSize + (numStrings + 1) * 4 + stringDataSize +
+                   encoder.m_nodeBytes.Size());
+
+    bytes->PushBack(Magic, Magic + 4);
+    WriteUint(bytes, Version);
+    WriteUint(bytes, numStrings);
+    WriteUint(bytes, SCAST<uint32_t>(stringDataSize));
+
+    uint32_t stringOffset = 0;
+    for (const String *str : encoder.m_strings)
+    {
+        WriteUint(bytes, stringOffset);
+        stringOffset += SCAST<uint32_t>(str->Size());
+    }
+    WriteUint(bytes, stringOffset);
+
+    for (const String *str : encoder.m_strings)
+    {
+        bytes->PushBack(str->ToCString(), str->ToCString() + str->Size());
+    }
+    bytes->PushBack(encoder.m_nodeBytes.Begin(), encoder.m_nodeBytes.End());
+}
+
+bool MetaNodeBinary::Decode(const Byte *data,
+                            std::size_t size,
+                            MetaNode *metaNode)
+{
+    MetaNodeBinaryView view = MetaNodeBinaryView::FromData(data, size);
+    if (view.IsValid())
+    {
+        view.ToMetaNode(metaNode);
+    }
+    return view.IsValid();
+}
+
+bool MetaNodeBinary::IsBinary(const Byte *data, std::size_t size)
+{
+    return (size >= HeaderSize) && (std::memcmp(data, Magic, 4) == 0);
+}
+
+String MetaNodeBinaryString::ToString() const
+{
+    return String(data, data + size);
+}
+
+bool MetaNodeBinaryString::operator==(const String &rhs) const
+{
+    return (rhs.Size() == size) &&
+           (size == 0 || std::memcmp(rhs.ToCString(), data, size) == 0);
+}
+
+bool MetaNodeBinaryString::operator!=(const String &rhs) const
+{
+    return !(*this == rhs);
+}
+
+MetaNodeBinaryView::MetaNodeBinaryView(const Byte *stringOffsets,
+                                       const Byte *stringData,
+                                       const Byte *node)
+    : p_stringOffsets(stringOffsets), p_stringData(stringData), p_node(node)
+{
+}
+
+MetaNodeBinaryView MetaNodeBinaryView::FromData(const Byte *data,
+                                                std::size_t size)
+{
+    if (!MetaNodeBinary::IsBinary(data, size) ||
+        ReadUint(data + 4) != Version)
+    {
+        return MetaNodeBinaryView();
+    }
+
+    // The string offsets go from 0 to the size of the string data, one more
+    // than strings, so that each string ends where the next one begins
+    const uint32_t numStrings = ReadUint(data + 8);
+    const uint32_t stringDataSize = ReadUint(data + 12);
+    const std::size_t available = size - HeaderSize;
+    if (numStrings >= available / 4 ||
+        stringDataSize > available - (numStrings + 1) * 4)
+    {
+        return MetaNodeBinaryView();
+    }
+
+    const Byte *stringOffsets = data + HeaderSize;
+    const Byte *stringData = stringOffsets + (numStrings + 1) * 4;
+    uint32_t prevOffset = 0;
+    for (uint32_t i = 0; i <= numStrings; ++i)
+    {
+        const uint32_t offset = ReadUint(stringOffsets + i * 4);
+        if (offset < prevOffset || offset > stringDataSize ||
+            (i == 0 && offset != 0) ||
+            (i == numStrings && offset != stringDataSize))
+        {
+            return MetaNodeBinaryView();
+        }
+        prevOffset = offset;
+    }
+
+    const Byte *root = stringData + stringDataSize;
+    const Byte *end = data + size;
+    if (!ValidateNode(root, end, numStrings, 0) || root + ReadUint(root) != end)
+    {
+        return MetaNodeBinaryView();
+    }
+
+    return MetaNodeBinaryView(stringOffsets, stringData, root);
+}
+
+bool MetaNodeBinaryView::IsValid() const
+{
+    return (p_node != nullptr);
+}
+
+MetaNodeBinaryString MetaNodeBinaryView::GetName() const
+{
+    return GetString(ReadUint(p_node + 4));
+}
+
+uint MetaNodeBinaryView::GetNumAttributes() const
+{
+    return ReadUint(p_node + 8);
+}
+
+MetaNodeBinaryString MetaNodeBinaryView::GetAttributeName(uint i) const
+{
+    return GetString(ReadUint(GetAttributesBegin() + i * 8));
+}
+
+MetaNodeBinaryString MetaNodeBinaryView::GetAttributeValue(uint i) const
+{
+    return GetString(ReadUint(GetAttributesBegin() + i * 8 + 4));
+}
+
+bool MetaNodeBinaryView::GetAttributeValue(const String &attributeName,
+                                           MetaNodeBinaryString *value) const
+{
+    for (uint i = 0; i < GetNumAttributes(); ++i)
+    {
+        if (GetAttributeName(i) == attributeName)
+        {
+            *value = GetAttributeValue(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint MetaNodeBinaryView::GetNumChildrenContainers() const
+{
+    return ReadUint(GetChildrenContainersBegin() - 4);
+}
+
+MetaNodeBinaryString MetaNodeBinaryView::GetChildrenContainerName(
+    uint containerIndex) const
+{
+    return GetString(ReadUint(GetChildrenContainer(containerIndex) + 4));
+}
+
+uint MetaNodeBinaryView::GetNumChildren(uint containerIndex) const
+{
+    return ReadUint(GetChildrenContainer(containerIndex) + 8);
+}
+
+MetaNodeBinaryView MetaNodeBinaryView::GetFirstChild(
+    uint containerIndex) const
+{
+    return MetaNodeBinaryView(
+        p_stringOffsets,
+        p_stringData,
+        GetChildrenContainer(containerIndex) + MinChildrenContainerSize);
+}
+
+MetaNodeBinaryView MetaNodeBinaryView::GetNextSibling() const
+{
+    return MetaNodeBinaryView(
+        p_stringOffsets, p_stringData, p_node + ReadUint(p_node));
+}
+
+void MetaNodeBinaryView::ToMetaNode(MetaNode *metaNode) const
+{
+    metaNode->SetName(GetName().ToString());
+    for (uint i = 0; i < GetNumAttributes(); ++i)
+    {
+        metaNode->Set(GetAttributeName(i).ToString(),
+                      GetAttributeValue(i).ToString());
+    }
+
+    const Byte *container = GetChildrenContainersBegin();
+    for (uint i = 0; i < GetNumChildrenContainers(); ++i)
+    {
+        const String containerName =
+            GetString(ReadUint(container + 4)).ToString();
+        metaNode->CreateChildrenContainer(containerName);
+
+        // The children are added empty and filled in place, so that no
+        // filled subtree is ever copied
+        const uint numChildren = ReadUint(container + 8);
+        const uint firstChild = metaNode->GetChildren(containerName).Size();
+        for (uint j = 0; j < numChildren; ++j)
+        {
+            metaNode->AddChild(MetaNode(), containerName);
+        }
+
+        MetaNodeBinaryView child(p_stringOffsets,
+                                 p_stringData,
+                                 container + MinChildrenContainerSize);
+        for (uint j = 0; j < numChildren; ++j)
+        {
+            child.ToMetaNode(
+                metaNode->GetChild(containerName, firstChild + j));
+            child = child.GetNextSibling();
+        }
+        container += ReadUint(container);
+    }
+}
+
+MetaNodeBinaryString MetaNodeBinaryView::GetString(uint stringIndex) const
+{
+    const uint32_t begin = ReadUint(p_stringOffsets + stringIndex * 4);
+    const uint32_t end = ReadUint(p_stringOffsets + stringIndex * 4 + 4);
+
+    MetaNodeBinaryString str;
+    str.data = RCAST<const char *>(p_stringData + begin);
+    str.size = end - begin;
+    return str;
+}
+
+const Byte *MetaNodeBinaryView::GetAttributesBegin() const
+{
+    return p_node + 12;
+}
+
+const Byte *MetaNodeBinaryView::GetChildrenContainersBegin() const
+{
+    return GetAttributesBegin() + GetNumAttributes() * 8 + 4;
+}
+
+const Byte *MetaNodeBinaryView::GetChildrenContainer(
+    uint containerIndex) const
+{
+    const Byte *container = GetChildrenContainersBegin();
+    for (uint i = 0; i < containerIndex; ++i)
+    {
+        container += ReadUint(container);
+    }
+    return container;
+}
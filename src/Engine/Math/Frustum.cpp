@@ -0,0 +1,119 @@
+#include "Bang/Frustum.h"
+
+#include "BangMath/Math.h"
+#include "BangMath/Vector4.h"
+
+using namespace Bang;
+
+Frustum::Frustum()
+{
+    for (uint i = 0; i < NumPlanes; ++i)
+    {
+        m_planeNormals[i] = Vector3::Zero();
+        m_planeDistances[i] = Math::Infinity<float>();
+    }
+}
+
+Frustum::Frustum(const Matrix4 &viewProjectionMatrix)
+{
+    SetFromViewProjectionMatrix(viewProjectionMatrix);
+}
+
+Frustum::~Frustum()
+{
+}
+
+void Frustum::SetFromViewProjectionMatrix(const Matrix4 &vp)
+{
+    // Gribb-Hartmann plane extraction. Matrix4 is column-major (m[col][row])
+    auto GetRow = [&vp](int row) {
+        return Vector4(vp[0][row], vp[1][row], vp[2][row], vp[3][row]);
+    };
+
+    const Vector4 row0 = GetRow(0);
+    const Vector4 row1 = GetRow(1);
+    const Vector4 row2 = GetRow(2);
+    const Vector4 row3 = GetRow(3);
+    const std::array<Vector4, NumPlanes> planes = {{row3 + row0,
+                                                    row3 - row0,
+                                                    row3 + row1,
+                                                    row3 - row1,
+                                                    row3 + row2,
+                                                    row3 - row2}};
+
+    for (uint i = 0; i < NumPlanes; ++i)
+    {
+        const Vector4 &plane = planes[i];
+        const float normalLength = plane.xyz().Length();
+        const float invLength =
+            (normalLength > 0.0f) ? (1.0f / normalLength) : 0.0f;
+        m_planeNormals[i] = plane.xyz() * invLength;
+        m_planeDistances[i] = plane.w * invLength;
+    }
+}
+
+bool Frustum::Contains(const Vector3 &point) const
+{
+    for (uint i = 0; i < NumPlanes; ++i)
+    {
+        if (Vector3::Dot(m_planeNormals[i], point) + m_planeDistances[i] < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::Intersects(const AABox &aaBox, bool testDepth) const
+{
+    const Vector3 &boxMin = aaBox.GetMin();
+    const Vector3 &boxMax = aaBox.GetMax();
+    const uint numPlanesToTest = (testDepth ? NumPlanes : 4);
+    for (uint i = 0; i < numPlanesToTest; ++i)
+    {
+        // Test the box corner that is the furthest along the plane normal.
+        // If even that one is outside, the whole box is outside.
+        const Vector3 &n = m_planeNormals[i];
+        const Vector3 positiveVertex(n.x >= 0.0f ? boxMax.x : boxMin.x,
+                                     n.y >= 0.0f ? boxMax.y : boxMin.y,
+                                     n.z >= 0.0f ? boxMax.z : boxMin.z);
+        if (Vector3::Dot(n, positiveVertex) + m_planeDistances[i] < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::Intersects(const Sphere &sphere, bool testDepth) const
+{
+    const uint numPlanesToTest = (testDepth ? NumPlanes : 4);
+    for (uint i = 0; i < numPlanesToTest; ++i)
+    {
+        const float signedDist =
+            Vector3::Dot(m_planeNormals[i], sphere.GetCenter()) +
+            m_planeDistances[i];
+        if (signedDist < -sphere.GetRadius())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const Vector3 &Frustum::GetPlaneNormal(FrustumPlane plane) const
+{
+    return m_planeNormals[SCAST<uint>(plane)];
+}
+
+float Frustum::GetPlaneDistance(FrustumPlane plane) const
+{
+    return m_planeDistances[SCAST<uint>(plane)];
+}
+
+float Frustum::GetSignedDistance(FrustumPlane plane,
+                                 const Vector3 &point) const
+{
+    return Vector3::Dot(GetPlaneNormal(plane), point) +
+           GetPlaneDistance(plane);
+}
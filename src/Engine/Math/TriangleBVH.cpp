@@ -0,0 +1,244 @@
+#include "Bang/TriangleBVH.h"
+
+#include <algorithm>
+#include <array>
+
+#include "BangMath/Geometry.h"
+#include "BangMath/Math.h"
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+
+using namespace Bang;
+
+namespace
+{
+// Enough for the depth of a median split tree of 2^32 triangles
+constexpr uint MaxTraversalDepth = 64;
+
+// Slab test. tEnter is where the segment enters the box, in [0, 1].
+bool IntersectSegmentAABox(const Vector3 &origin,
+                           const Vector3 &displacement,
+                           const AABox &aaBox,
+                           float *tEnter)
+{
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+    for (uint axis = 0; axis < 3; ++axis)
+    {
+        const float boxMin = aaBox.GetMin()[axis];
+        const float boxMax = aaBox.GetMax()[axis];
+        if (displacement[axis] == 0.0f)
+        {
+            if (origin[axis] < boxMin || origin[axis] > boxMax)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const float invDisp = 1.0f / displacement[axis];
+            float t0 = (boxMin - origin[axis]) * invDisp;
+            float t1 = (boxMax - origin[axis]) * invDisp;
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+
+            tMin = Math::Max(tMin, t0);
+            tMax = Math::Min(tMax, t1);
+            if (tMin > tMax)
+            {
+                return false;
+            }
+        }
+    }
+
+    *tEnter = tMin;
+    return true;
+}
+}
+
+TriangleBVH::TriangleBVH()
+{
+}
+
+TriangleBVH::~TriangleBVH()
+{
+}
+
+void TriangleBVH::Build(const Array<Vector3> &positions,
+                        const Array<uint> &trianglesVertexIds)
+{
+    Clear();
+
+    const uint numTriangles = (trianglesVertexIds.Size() / 3);
+    Array<Vector3> centroids;
+    centroids.Reserve(numTriangles);
+    m_triangles.Reserve(numTriangles);
+    m_triangleIds.Reserve(numTriangles);
+    for (uint triId = 0; triId < numTriangles; ++triId)
+    {
+        const Vector3 &p0 = positions[trianglesVertexIds[triId * 3 + 0]];
+        const Vector3 &p1 = positions[trianglesVertexIds[triId * 3 + 1]];
+        const Vector3 &p2 = positions[trianglesVertexIds[triId * 3 + 2]];
+        m_triangles.PushBack(Triangle(p0, p1, p2));
+        m_triangleIds.PushBack(triId);
+        centroids.PushBack((p0 + p1 + p2) / 3.0f);
+    }
+
+    if (numTriangles > 0)
+    {
+        m_nodes.Reserve(2 * (numTriangles / MaxLeafTriangles) + 1);
+        BuildNode(0, numTriangles, centroids);
+    }
+}
+
+void TriangleBVH::Clear()
+{
+    m_nodes.Clear();
+    m_triangles.Clear();
+    m_triangleIds.Clear();
+}
+
+bool TriangleBVH::IntersectSegment(const Segment &segment,
+                                   Vector3 *intersectionPoint,
+                                   uint *triangleId) const
+{
+    if (IsEmpty())
+    {
+        return false;
+    }
+
+    const Vector3 &origin = segment.GetOrigin();
+    const Vector3 displacement = (segment.GetDestiny() - origin);
+    const float sqLength = segment.GetSqLength();
+
+    bool intersected = false;
+    float closestSqDist = Math::Infinity<float>();
+
+    std::array<uint, MaxTraversalDepth> nodesStack;
+    uint nodesStackSize = 0;
+    nodesStack[nodesStackSize++] = 0;
+    while (nodesStackSize > 0)
+    {
+        const uint nodeIndex = nodesStack[--nodesStackSize];
+        const Node &node = m_nodes[nodeIndex];
+
+        // Skip the nodes that start further than the closest hit so far
+        float tEnter;
+        if (!IntersectSegmentAABox(origin, displacement, node.aaBox, &tEnter) ||
+            (tEnter * tEnter * sqLength) > closestSqDist)
+        {
+            continue;
+        }
+
+        if (node.numTriangles > 0)
+        {
+            for (uint i = node.trianglesBegin;
+                 i < node.trianglesBegin + node.numTriangles;
+                 ++i)
+            {
+                const uint triId = m_triangleIds[i];
+
+                bool intersectedTri = false;
+                Vector3 triIntersectionPoint;
+                Geometry::IntersectSegmentTriangle(segment,
+                                                   m_triangles[triId],
+                                                   &intersectedTri,
+                                                   &triIntersectionPoint);
+                if (intersectedTri)
+                {
+                    const float sqDist =
+                        Vector3::SqDistance(origin, triIntersectionPoint);
+                    if (sqDist < closestSqDist)
+                    {
+                        intersected = true;
+                        closestSqDist = sqDist;
+                        *intersectionPoint = triIntersectionPoint;
+                        *triangleId = triId;
+                    }
+                }
+            }
+        }
+        else
+        {
+            ASSERT(nodesStackSize + 2 <= MaxTraversalDepth);
+            nodesStack[nodesStackSize++] = node.secondChildIndex;
+            nodesStack[nodesStackSize++] = (nodeIndex + 1);
+        }
+    }
+
+    return intersected;
+}
+
+bool TriangleBVH::IsEmpty() const
+{
+    return m_nodes.IsEmpty();
+}
+
+uint TriangleBVH::GetNumNodes() const
+{
+    return m_nodes.Size();
+}
+
+const AABox &TriangleBVH::GetAABox() const
+{
+    ASSERT(!IsEmpty());
+    return m_nodes.Front().aaBox;
+}
+
+uint TriangleBVH::BuildNode(uint begin,
+                            uint end,
+                            const Array<Vector3> &centroids)
+{
+    AABox nodeAABox;
+    AABox centroidsAABox;
+    for (uint i = begin; i < end; ++i)
+    {
+        const uint triId = m_triangleIds[i];
+        const Triangle &tri = m_triangles[triId];
+        nodeAABox.AddPoint(tri.GetPoint(0));
+        nodeAABox.AddPoint(tri.GetPoint(1));
+        nodeAABox.AddPoint(tri.GetPoint(2));
+        centroidsAABox.AddPoint(centroids[triId]);
+    }
+
+    const uint nodeIndex = m_nodes.Size();
+    m_nodes.PushBack(Node());
+    m_nodes[nodeIndex].aaBox = nodeAABox;
+
+    const uint numTriangles = (end - begin);
+    if (numTriangles <= MaxLeafTriangles)
+    {
+        m_nodes[nodeIndex].trianglesBegin = begin;
+        m_nodes[nodeIndex].numTriangles = numTriangles;
+        return nodeIndex;
+    }
+
+    const Vector3 centroidsSize = centroidsAABox.GetSize();
+    uint splitAxis = 0;
+    if (centroidsSize.y > centroidsSize[splitAxis])
+    {
+        splitAxis = 1;
+    }
+    if (centroidsSize.z > centroidsSize[splitAxis])
+    {
+        splitAxis = 2;
+    }
+
+    const uint mid = begin + (numTriangles / 2);
+    uint *triangleIds = m_triangleIds.Data();
+    std::nth_element(triangleIds + begin,
+                     triangleIds + mid,
+                     triangleIds + end,
+                     [&centroids, splitAxis](uint lhs, uint rhs) {
+                         return centroids[lhs][splitAxis] <
+                                centroids[rhs][splitAxis];
+                     });
+
+    // The first child goes right after its parent
+    BuildNode(begin, mid, centroids);
+    const uint secondChildIndex = BuildNode(mid, end, centroids);
+    m_nodes[nodeIndex].secondChildIndex = secondChildIndex;
+    return nodeIndex;
+}
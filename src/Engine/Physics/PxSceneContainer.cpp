@@ -105,6 +105,16 @@ PxSceneContainer::PxSceneContainer(Scene *scene)
     m_physicsObjectGatherer
         ->EventEmitter<IEventsObjectGatherer>::RegisterListener(this);
 
+    // Gathered in SetRoot, before listening to the gatherer
+    for (PhysicsComponent *phComp :
+         m_physicsObjectGatherer->GetGatheredObjects())
+    {
+        if (Collider *collider = DCAST<Collider *>(phComp))
+        {
+            m_colliders.PushBack(collider);
+        }
+    }
+
     p_scene = scene;
     p_pxScene = pxScene;
 }
@@ -184,19 +194,9 @@ PxScene *PxSceneContainer::GetPxScene() const
     return p_pxScene;
 }
 
-Array<Collider *> PxSceneContainer::GetColliders() const
+const Array<Collider *> &PxSceneContainer::GetColliders() const
 {
-    Array<Collider *> colliders;
-    const Array<PhysicsComponent *> &phComps =
-        m_physicsObjectGatherer->GetGatheredObjects();
-    for (PhysicsComponent *phComp : phComps)
-    {
-        if (Collider *coll = DCAST<Collider *>(phComp))
-        {
-            colliders.PushBack(coll);
-        }
-    }
-    return colliders;
+    return m_colliders;
 }
 
 Collider *PxSceneContainer::GetColliderFromPxShape(
@@ -447,6 +447,11 @@ void PxSceneContainer::OnObjectGathered(PhysicsComponent *phComp)
     // but neither do you or your ancestors
     ASSERT(phCompGo->HasComponent<PhysicsComponent>());
 
+    if (Collider *collider = DCAST<Collider *>(phComp))
+    {
+        m_colliders.PushBack(collider);
+    }
+
     PxRigidActor *pxRA =
         SCAST<PxRigidActor *>(GetAncestorOrThisPxActor(phCompGo));
     if (!pxRA)
@@ -521,6 +526,11 @@ void PxSceneContainer::OnObjectUnGathered(GameObject *prevGo,
 {
     BANG_UNUSED(prevGo);
     phComp->SetPxRigidActor(nullptr);
+
+    if (Collider *collider = DCAST<Collider *>(phComp))
+    {
+        m_colliders.Remove(collider);
+    }
 }
 
 void PxSceneContainer::OnDestroyed(EventEmitter<IEventsDestroy> *ee)
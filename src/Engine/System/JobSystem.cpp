@@ -0,0 +1,412 @@
+#include "Bang/JobSystem.h"
+
+#include <chrono>
+#include <thread>
+
+#include "BangMath/Math.h"
+#include "Bang/Application.h"
+#include "Bang/Array.tcc"
+#include "Bang/Assert.h"
+#include "Bang/Thread.h"
+
+using namespace Bang;
+
+namespace
+{
+// Set in the worker threads, so that jobs scheduled from a worker go to its
+// own queue
+thread_local const JobSystem *t_workerJobSystem = nullptr;
+thread_local int t_workerIndex = -1;
+}
+
+struct JobCounter::Continuation
+{
+    std::atomic<int> remainingDependencies{0};
+    Array<std::function<void()>> onReady;
+};
+
+bool JobCounter::IsDone() const
+{
+    return (m_pendingJobs.load() == 0);
+}
+
+bool JobHandle::IsValid() const
+{
+    return (p_counter != nullptr);
+}
+
+bool JobHandle::IsDone() const
+{
+    return !IsValid() || p_counter->IsDone();
+}
+
+JobSystem::JobSystem()
+{
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_exit = true;
+    }
+    m_sleepCondition.notify_all();
+
+    for (Thread *workerThread : m_workerThreads)
+    {
+        workerThread->Join();
+        delete workerThread;
+    }
+    m_workerThreads.Clear();
+
+    for (WorkQueue *workQueue : m_workQueues)
+    {
+        delete workQueue;
+    }
+    m_workQueues.Clear();
+}
+
+void JobSystem::Init(uint numWorkers)
+{
+    ASSERT(m_workQueues.IsEmpty());
+
+    if (numWorkers == 0)
+    {
+        const uint hwThreads = std::thread::hardware_concurrency();
+        numWorkers = Math::Max(hwThreads, 2u) - 1;
+    }
+
+    for (uint i = 0; i < numWorkers + 1; ++i)
+    {
+        m_workQueues.PushBack(new WorkQueue());
+    }
+
+    for (uint i = 0; i < numWorkers; ++i)
+    {
+        ThreadRunnableLambda *workerRunnable =
+            new ThreadRunnableLambda([this, i]() { WorkerLoop(i); });
+        Thread *workerThread = new Thread(
+            workerRunnable, "BangJobWorker" + String::ToString(i));
+        workerThread->Start();
+        m_workerThreads.PushBack(workerThread);
+    }
+}
+
+JobHandle JobSystem::Schedule(const JobFunction &jobFunction)
+{
+    return Schedule(jobFunction, Array<JobHandle>::Empty());
+}
+
+JobHandle JobSystem::Schedule(const JobFunction &jobFunction,
+                              const Array<JobHandle> &dependencies)
+{
+    JobHandle jobHandle;
+    jobHandle.p_counter = std::make_shared<JobCounter>();
+    jobHandle.p_counter->m_pendingJobs = 1;
+
+    Job job;
+    job.function = jobFunction;
+    job.counter = jobHandle.p_counter;
+    SubmitAfter({job}, dependencies);
+    return jobHandle;
+}
+
+JobHandle JobSystem::ScheduleParallelFor(uint begin,
+                                         uint end,
+                                         uint grainSize,
+                                         const ParallelForFunction &function)
+{
+    return ScheduleParallelFor(
+        begin, end, grainSize, function, Array<JobHandle>::Empty());
+}
+
+JobHandle JobSystem::ScheduleParallelFor(uint begin,
+                                         uint end,
+                                         uint grainSize,
+                                         const ParallelForFunction &function,
+                                         const Array<JobHandle> &dependencies)
+{
+    JobHandle jobHandle;
+    jobHandle.p_counter = std::make_shared<JobCounter>();
+    if (begin >= end)
+    {
+        return jobHandle;
+    }
+
+    const uint count = (end - begin);
+    if (grainSize == 0)
+    {
+        const uint numChunks = (GetNumWorkers() + 1) * 4;
+        grainSize = Math::Max((count + numChunks - 1) / numChunks, 1u);
+    }
+
+    Array<Job> jobs;
+    jobs.Reserve((count + grainSize - 1) / grainSize);
+    for (uint chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+    {
+        const uint chunkEnd = Math::Min(chunkBegin + grainSize, end);
+        Job job;
+        job.function = [function, chunkBegin, chunkEnd]() {
+            function(chunkBegin, chunkEnd);
+        };
+        job.counter = jobHandle.p_counter;
+        jobs.PushBack(job);
+    }
+
+    jobHandle.p_counter->m_pendingJobs = SCAST<int>(jobs.Size());
+    SubmitAfter(jobs, dependencies);
+    return jobHandle;
+}
+
+void JobSystem::ParallelFor(uint begin,
+                            uint end,
+                            uint grainSize,
+                            const ParallelForFunction &function)
+{
+    Wait(ScheduleParallelFor(begin, end, grainSize, function));
+}
+
+void JobSystem::Wait(const JobHandle &jobHandle)
+{
+    while (!jobHandle.IsDone())
+    {
+        if (!TryRunOneJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::Wait(const Array<JobHandle> &jobHandles)
+{
+    for (const JobHandle &jobHandle : jobHandles)
+    {
+        Wait(jobHandle);
+    }
+}
+
+uint JobSystem::GetNumWorkers() const
+{
+    return m_workerThreads.Size();
+}
+
+bool JobSystem::IsWorkerThread() const
+{
+    return (GetCurrentWorkerIndex() >= 0);
+}
+
+JobSystem *JobSystem::GetInstance()
+{
+    Application *app = Application::GetInstance();
+    return app ? app->GetJobSystem() : nullptr;
+}
+
+void JobSystem::WorkerLoop(uint workerIndex)
+{
+    t_workerJobSystem = this;
+    t_workerIndex = SCAST<int>(workerIndex);
+
+    while (!m_exit)
+    {
+        if (!TryRunOneJob())
+        {
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepCondition.wait(lock, [this]() {
+                return m_exit || (m_numQueuedJobs.load() > 0);
+            });
+        }
+    }
+
+    t_workerJobSystem = nullptr;
+    t_workerIndex = -1;
+}
+
+bool JobSystem::TryRunOneJob()
+{
+    Job job;
+    if (TryPopJob(&job))
+    {
+        RunJob(&job);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::TryPopJob(Job *job)
+{
+    if (m_numQueuedJobs.load() <= 0 || m_workQueues.IsEmpty())
+    {
+        return false;
+    }
+
+    // Own queue first, newest job first, since it is the hottest in cache
+    const int workerIndex = GetCurrentWorkerIndex();
+    WorkQueue *ownQueue =
+        (workerIndex >= 0) ? m_workQueues[workerIndex] : GetSharedQueue();
+    {
+        std::lock_guard<std::mutex> lock(ownQueue->mutex);
+        if (!ownQueue->jobs.empty())
+        {
+            *job = ownQueue->jobs.back();
+            ownQueue->jobs.pop_back();
+            --m_numQueuedJobs;
+            return true;
+        }
+    }
+
+    // Steal the oldest job of another queue, starting from a different one
+    // in each worker to spread the contention
+    const uint numQueues = m_workQueues.Size();
+    const uint firstVictim = SCAST<uint>(workerIndex + 1);
+    for (uint i = 0; i < numQueues; ++i)
+    {
+        WorkQueue *victimQueue = m_workQueues[(firstVictim + i) % numQueues];
+        if (victimQueue == ownQueue)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(victimQueue->mutex);
+        if (!victimQueue->jobs.empty())
+        {
+            *job = victimQueue->jobs.front();
+            victimQueue->jobs.pop_front();
+            --m_numQueuedJobs;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::RunJob(Job *job)
+{
+    job->function();
+    OnJobFinished(job->counter.get());
+}
+
+void JobSystem::Submit(const Array<Job> &jobs)
+{
+    if (jobs.IsEmpty())
+    {
+        return;
+    }
+
+    // Without workers (not initialized), jobs are run right away
+    if (m_workQueues.IsEmpty())
+    {
+        for (Job job : jobs)
+        {
+            RunJob(&job);
+        }
+        return;
+    }
+
+    const int workerIndex = GetCurrentWorkerIndex();
+    WorkQueue *queue =
+        (workerIndex >= 0) ? m_workQueues[workerIndex] : GetSharedQueue();
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        for (const Job &job : jobs)
+        {
+            queue->jobs.push_back(job);
+        }
+        m_numQueuedJobs += SCAST<int>(jobs.Size());
+    }
+
+    {
+        // Taking the lock avoids missing the wakeup of a worker that has just
+        // checked the queues and is about to sleep
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    if (jobs.Size() == 1)
+    {
+        m_sleepCondition.notify_one();
+    }
+    else
+    {
+        m_sleepCondition.notify_all();
+    }
+}
+
+void JobSystem::SubmitAfter(const Array<Job> &jobs,
+                            const Array<JobHandle> &dependencies)
+{
+    if (dependencies.IsEmpty())
+    {
+        Submit(jobs);
+        return;
+    }
+
+    // The extra dependency is released at the end, so that the jobs are not
+    // submitted while the continuation is still being registered
+    auto continuation = std::make_shared<JobCounter::Continuation>();
+    continuation->remainingDependencies = SCAST<int>(dependencies.Size()) + 1;
+    continuation->onReady.PushBack([this, jobs]() { Submit(jobs); });
+
+    auto ReleaseDependency = [continuation]() {
+        if (--continuation->remainingDependencies == 0)
+        {
+            for (const auto &onReady : continuation->onReady)
+            {
+                onReady();
+            }
+        }
+    };
+
+    for (const JobHandle &dependency : dependencies)
+    {
+        bool alreadyFinished = true;
+        if (JobCounter *depCounter = dependency.p_counter.get())
+        {
+            std::lock_guard<std::mutex> lock(depCounter->m_mutex);
+            if (!depCounter->m_finished && !depCounter->IsDone())
+            {
+                depCounter->m_continuations.PushBack(continuation);
+                alreadyFinished = false;
+            }
+        }
+
+        if (alreadyFinished)
+        {
+            ReleaseDependency();
+        }
+    }
+    ReleaseDependency();
+}
+
+void JobSystem::OnJobFinished(JobCounter *counter)
+{
+    if (--counter->m_pendingJobs > 0)
+    {
+        return;
+    }
+
+    Array<std::shared_ptr<JobCounter::Continuation>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        counter->m_finished = true;
+        continuations = counter->m_continuations;
+        counter->m_continuations.Clear();
+    }
+
+    for (const auto &continuation : continuations)
+    {
+        if (--continuation->remainingDependencies == 0)
+        {
+            for (const auto &onReady : continuation->onReady)
+            {
+                onReady();
+            }
+        }
+    }
+}
+
+JobSystem::WorkQueue *JobSystem::GetSharedQueue() const
+{
+    return m_workQueues.Back();
+}
+
+int JobSystem::GetCurrentWorkerIndex() const
+{
+    return (t_workerJobSystem == this) ? t_workerIndex : -1;
+}
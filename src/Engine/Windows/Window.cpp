@@ -100,6 +100,7 @@ bool Window::MainLoopIteration()
 
 void Window::Update()
 {
+    Assets::FinishAsyncLoads();
     GetSceneManager()->Update();
 }
 